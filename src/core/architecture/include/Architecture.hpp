@@ -24,7 +24,36 @@ namespace llvm::noelle {
 
         static int32_t getCacheLineBytes (void);
 
+        /*
+         * Size of the L2 cache of a core.
+         * It is read from the machine profile (key L2_CACHE_BYTES) or from the operating system; a default value is used otherwise.
+         */
+        static uint64_t getL2CacheBytes (void);
+
+        /*
+         * Latencies of the runtime operations used by the parallelization techniques.
+         *
+         * They are expressed in number of instructions to be comparable with the profiles.
+         * They are read from the machine profile generated by noelle-arch-calibrate (see the environment variable NOELLE_MACHINE_PROFILE).
+         * Default values are used if no machine profile is available.
+         */
+        static double getLatencyOfQueuePushAndPop (uint32_t bitwidth);
+
+        static double getLatencyOfSequentialSegmentSignal (void);
+
+        static double getLatencyOfDOALLDispatchPerCore (void);
+
+        static double getLatencyOfSpeculativeLoadTracking (void);
+
+        static double getLatencyOfSpeculativeStoreTracking (void);
+
       private:
+        static std::unordered_map<std::string, double> machineProfile;
+        static bool hasReadMachineProfile;
+
+        static double fetchMachineProfileValue (const std::string &key, double defaultValue);
+
+        static void readMachineProfile (void);
   };
 
 }
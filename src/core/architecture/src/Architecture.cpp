@@ -8,6 +8,8 @@
  * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
  * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
  */
+#include <fstream>
+
 #include "Architecture.hpp"
 
 using namespace llvm;
@@ -28,3 +30,155 @@ uint32_t Architecture::getNumberOfPhysicalCores (void){
 int32_t Architecture::getCacheLineBytes (void){
   return 64;
 }
+
+uint64_t Architecture::getL2CacheBytes (void){
+
+  /*
+   * Check if the machine profile specifies the size of the L2 cache.
+   */
+  if (!hasReadMachineProfile){
+    readMachineProfile();
+  }
+  auto sizeIt = machineProfile.find("L2_CACHE_BYTES");
+  if (  true
+        && (sizeIt != machineProfile.end())
+        && (sizeIt->second > 0)
+     ){
+    return (uint64_t)sizeIt->second;
+  }
+
+  /*
+   * Ask the operating system.
+   * The size is reported as, for example, "1024K".
+   */
+  std::ifstream sizeFile("/sys/devices/system/cpu/cpu0/cache/index2/size");
+  uint64_t size = 0;
+  if (sizeFile >> size){
+    char unit = ' ';
+    sizeFile >> unit;
+    if (unit == 'K'){
+      size *= 1024;
+    } else if (unit == 'M'){
+      size *= 1024 * 1024;
+    }
+  }
+  if (size > 0){
+    return size;
+  }
+
+  return 256 * 1024;
+}
+
+std::unordered_map<std::string, double> Architecture::machineProfile{};
+
+bool Architecture::hasReadMachineProfile = false;
+
+double Architecture::getLatencyOfQueuePushAndPop (uint32_t bitwidth){
+
+  /*
+   * Queues exist only for a fixed set of widths.
+   * Round the bitwidth up to the closest one.
+   */
+  uint32_t queueWidth = 64;
+  for (auto w : { 8, 16, 32, 64 }){
+    if (bitwidth <= w){
+      queueWidth = w;
+      break ;
+    }
+  }
+
+  return fetchMachineProfileValue("QUEUE_" + std::to_string(queueWidth), 100);
+}
+
+double Architecture::getLatencyOfSequentialSegmentSignal (void){
+  return fetchMachineProfileValue("HELIX_SIGNAL", 100);
+}
+
+double Architecture::getLatencyOfDOALLDispatchPerCore (void){
+  return fetchMachineProfileValue("DOALL_DISPATCH_PER_CORE", 1000);
+}
+
+double Architecture::getLatencyOfSpeculativeLoadTracking (void){
+  return fetchMachineProfileValue("DOALL_SPECULATIVE_LOAD", 75);
+}
+
+double Architecture::getLatencyOfSpeculativeStoreTracking (void){
+  return fetchMachineProfileValue("DOALL_SPECULATIVE_STORE", 600);
+}
+
+double Architecture::fetchMachineProfileValue (const std::string &key, double defaultValue){
+
+  /*
+   * Read the machine profile if we didn't do it already.
+   */
+  if (!hasReadMachineProfile){
+    readMachineProfile();
+  }
+
+  /*
+   * Check if the latency has been measured.
+   */
+  auto latencyIt = machineProfile.find(key);
+  if (latencyIt == machineProfile.end()){
+    return defaultValue;
+  }
+
+  /*
+   * Translate the latency from nanoseconds to instructions.
+   */
+  auto nanosecondsPerInstructionIt = machineProfile.find("NANOSECONDS_PER_INSTRUCTION");
+  if (  false
+        || (nanosecondsPerInstructionIt == machineProfile.end())
+        || (nanosecondsPerInstructionIt->second <= 0)
+     ){
+    return defaultValue;
+  }
+  auto latency = latencyIt->second / nanosecondsPerInstructionIt->second;
+
+  return latency;
+}
+
+void Architecture::readMachineProfile (void){
+  hasReadMachineProfile = true;
+
+  /*
+   * Fetch the name of the file that includes the machine profile.
+   */
+  auto fileName = getenv("NOELLE_MACHINE_PROFILE");
+  if (fileName == nullptr){
+    return ;
+  }
+
+  /*
+   * Open the file.
+   */
+  std::ifstream profileFile(fileName);
+  if (!profileFile.good()){
+    errs() << "Architecture: WARNING = machine profile \"" << fileName << "\" cannot be opened. Default latencies will be used\n";
+    return ;
+  }
+
+  /*
+   * Read the latencies.
+   *
+   * Each line is "KEY VALUE" and lines starting with # are comments.
+   */
+  std::string line;
+  while (std::getline(profileFile, line)){
+    if (  false
+          || (line.size() == 0)
+          || (line[0] == '#')
+       ){
+      continue ;
+    }
+    std::stringstream lineStream(line);
+    std::string key;
+    double value;
+    if (!(lineStream >> key >> value)){
+      continue ;
+    }
+    machineProfile[key] = value;
+  }
+
+  return ;
+}
@@ -0,0 +1,99 @@
+/*
+ * Copyright 2019 - 2020  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <string>
+
+#include "llvm/IR/Function.h"
+
+namespace llvm::noelle {
+
+  /*
+   * Compile-time profile of NOELLE.
+   *
+   * Each phase (e.g., "pdg-alias-edges", "ldi") is aggregated per scope (e.g., the whole module, a function, or a loop).
+   * For each pair <phase, scope>, the profiler records the number of invocations, the wall-clock seconds spent, and the maximum growth of the peak resident set size observed while the phase was running.
+   *
+   * The profiler is enabled by setting the environment variable NOELLE_COMPILE_TIME_REPORT to the JSON file to generate.
+   * When the variable is not set, a scope only checks a boolean.
+   */
+  class CompileTimeProfiler {
+    public:
+
+      /*
+       * Check whether the profiler is enabled.
+       */
+      static bool isEnabled (void) ;
+
+      /*
+       * Record an invocation of @phase within @scope.
+       */
+      static void record (const char *phase, const std::string &scope, double seconds, long peakKB) ;
+
+      /*
+       * Return the peak resident set size of the process so far (in KB).
+       */
+      static long getPeakResidentSetSize (void) ;
+
+      ~CompileTimeProfiler () ;
+
+    private:
+      struct Entry {
+        uint64_t invocations = 0;
+        double seconds = 0;
+        long peakKB = 0;
+      };
+
+      std::string outputFileName;
+      std::mutex lock;
+      std::map<std::pair<std::string, std::string>, Entry> entries;
+
+      CompileTimeProfiler (const std::string &fileName) ;
+
+      static CompileTimeProfiler * getProfiler (void) ;
+
+      static CompileTimeProfiler * createProfiler (void) ;
+
+      static std::string escape (const std::string &s) ;
+
+      void dump (void) ;
+  };
+
+  /*
+   * Scoped timer: it records the time and the peak memory spent between its construction and its destruction.
+   */
+  class CompileTimeScope {
+    public:
+      CompileTimeScope (const char *phase) ;
+
+      CompileTimeScope (const char *phase, const Function &F) ;
+
+      CompileTimeScope (const char *phase, const Function &F, uint64_t loopID) ;
+
+      ~CompileTimeScope () ;
+
+      CompileTimeScope (const CompileTimeScope &) = delete;
+      CompileTimeScope & operator= (const CompileTimeScope &) = delete;
+
+    private:
+      bool enabled;
+      const char *phase;
+      std::string scope;
+      long startPeakKB;
+      std::chrono::steady_clock::time_point start;
+
+      CompileTimeScope (const char *phase, const Function *F, uint64_t loopID, bool isLoop) ;
+  };
+
+}
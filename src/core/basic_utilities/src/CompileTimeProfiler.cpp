@@ -0,0 +1,205 @@
+/*
+ * Copyright 2019 - 2020  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include <cstdlib>
+#include <fstream>
+#include <sys/resource.h>
+
+#include "CompileTimeProfiler.hpp"
+
+namespace llvm::noelle {
+
+  bool CompileTimeProfiler::isEnabled (void) {
+    static const bool enabled = CompileTimeProfiler::getProfiler() != nullptr;
+    return enabled;
+  }
+
+  void CompileTimeProfiler::record (const char *phase, const std::string &scope, double seconds, long peakKB) {
+    auto profiler = CompileTimeProfiler::getProfiler();
+    if (profiler == nullptr){
+      return ;
+    }
+    std::lock_guard<std::mutex> guard(profiler->lock);
+
+    auto &entry = profiler->entries[std::make_pair(std::string(phase), scope)];
+    entry.invocations++;
+    entry.seconds += seconds;
+    if (peakKB > entry.peakKB){
+      entry.peakKB = peakKB;
+    }
+
+    return ;
+  }
+
+  long CompileTimeProfiler::getPeakResidentSetSize (void) {
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0){
+      return 0;
+    }
+    return usage.ru_maxrss;
+  }
+
+  CompileTimeProfiler::CompileTimeProfiler (const std::string &fileName)
+    : outputFileName{fileName}
+    {
+    return ;
+  }
+
+  CompileTimeProfiler::~CompileTimeProfiler () {
+    this->dump();
+    return ;
+  }
+
+  CompileTimeProfiler * CompileTimeProfiler::getProfiler (void) {
+
+    /*
+     * The profiler is defined in this library only, so every NOELLE library shares the same one.
+     */
+    static CompileTimeProfiler *profiler = CompileTimeProfiler::createProfiler();
+    return profiler;
+  }
+
+  CompileTimeProfiler * CompileTimeProfiler::createProfiler (void) {
+    auto fileName = std::getenv("NOELLE_COMPILE_TIME_REPORT");
+    if (  false
+          || (fileName == nullptr)
+          || (fileName[0] == '\0')
+       ){
+      return nullptr;
+    }
+
+    /*
+     * The profiler is dumped when the process exits.
+     */
+    static CompileTimeProfiler profiler(fileName);
+    return &profiler;
+  }
+
+  std::string CompileTimeProfiler::escape (const std::string &s) {
+    std::string escaped;
+    for (auto c : s){
+      if (  false
+            || (c == '"')
+            || (c == '\\')
+         ){
+        escaped.push_back('\\');
+        escaped.push_back(c);
+        continue ;
+      }
+      if (static_cast<unsigned char>(c) < 0x20){
+        continue ;
+      }
+      escaped.push_back(c);
+    }
+
+    return escaped;
+  }
+
+  void CompileTimeProfiler::dump (void) {
+    std::lock_guard<std::mutex> guard(this->lock);
+
+    /*
+     * Compute the totals per phase.
+     *
+     * Scopes of the same phase never nest, so their times can be summed.
+     */
+    std::map<std::string, Entry> totals;
+    for (auto &pair : this->entries){
+      auto &entry = pair.second;
+      auto &total = totals[pair.first.first];
+      total.invocations += entry.invocations;
+      total.seconds += entry.seconds;
+      total.peakKB = std::max(total.peakKB, entry.peakKB);
+    }
+
+    /*
+     * Emit the JSON report.
+     */
+    std::ofstream out(this->outputFileName);
+    if (!out.is_open()){
+      return ;
+    }
+    out << "{\n  \"phases\": {";
+    auto first = true;
+    for (auto &pair : totals){
+      out << (first ? "\n" : ",\n");
+      out << "    \"" << escape(pair.first) << "\": { \"invocations\": " << pair.second.invocations << ", \"seconds\": " << pair.second.seconds << ", \"peak_rss_increase_kb\": " << pair.second.peakKB << " }";
+      first = false;
+    }
+    out << "\n  },\n  \"scopes\": [";
+    first = true;
+    for (auto &pair : this->entries){
+      out << (first ? "\n" : ",\n");
+      out << "    { \"phase\": \"" << escape(pair.first.first) << "\", \"scope\": \"" << escape(pair.first.second) << "\", \"invocations\": " << pair.second.invocations << ", \"seconds\": " << pair.second.seconds << ", \"peak_rss_increase_kb\": " << pair.second.peakKB << " }";
+      first = false;
+    }
+    out << "\n  ]\n}\n";
+
+    return ;
+  }
+
+  CompileTimeScope::CompileTimeScope (const char *phase)
+    : CompileTimeScope(phase, nullptr, 0, false)
+    {
+    return ;
+  }
+
+  CompileTimeScope::CompileTimeScope (const char *phase, const Function &F)
+    : CompileTimeScope(phase, &F, 0, false)
+    {
+    return ;
+  }
+
+  CompileTimeScope::CompileTimeScope (const char *phase, const Function &F, uint64_t loopID)
+    : CompileTimeScope(phase, &F, loopID, true)
+    {
+    return ;
+  }
+
+  CompileTimeScope::CompileTimeScope (const char *phase, const Function *F, uint64_t loopID, bool isLoop)
+    : enabled{CompileTimeProfiler::isEnabled()},
+      phase{phase},
+      startPeakKB{0}
+    {
+    if (!this->enabled){
+      return ;
+    }
+
+    /*
+     * Compute the name of the scope.
+     */
+    if (F == nullptr){
+      this->scope = "module";
+    } else if (isLoop){
+      this->scope = "loop:" + F->getName().str() + ":" + std::to_string(loopID);
+    } else {
+      this->scope = "function:" + F->getName().str();
+    }
+
+    this->startPeakKB = CompileTimeProfiler::getPeakResidentSetSize();
+    this->start = std::chrono::steady_clock::now();
+
+    return ;
+  }
+
+  CompileTimeScope::~CompileTimeScope () {
+    if (!this->enabled){
+      return ;
+    }
+
+    auto end = std::chrono::steady_clock::now();
+    std::chrono::duration<double> elapsed = end - this->start;
+    auto peakIncrease = CompileTimeProfiler::getPeakResidentSetSize() - this->startPeakKB;
+    CompileTimeProfiler::record(this->phase, this->scope, elapsed.count(), peakIncrease);
+
+    return ;
+  }
+
+}
@@ -29,6 +29,11 @@ namespace llvm::noelle {
     public:
       CallGraph (Module &M, PTACallGraph *callGraph);
 
+      /*
+       * @getIndirectCallees returns the possible callees of a call instruction that does not call a function directly.
+       */
+      CallGraph (Module &M, std::function<std::set<const Function *> (CallInst *call)> getIndirectCallees);
+
       std::unordered_set<CallGraphFunctionNode *> getFunctionNodes (void) const ;
 
       std::unordered_set<CallGraphEdge *> getEdges (void) const ;
@@ -45,16 +50,25 @@ namespace llvm::noelle {
 
       bool doesItBelongToASCC (Function *f) ;
 
+      /*
+       * Recompute the edges that leave @caller.
+       * This is needed after the code of @caller has been modified (e.g., after a call has been inlined in @caller).
+       */
+      void updateCallsOf (Function &caller) ;
+
     private:
       Module &m;
       std::unordered_map<Function *, CallGraphFunctionNode *> functions;
       std::unordered_map<Instruction *, CallGraphInstructionNode *> instructionNodes;
       std::unordered_set<CallGraphEdge *> edges;
       SCCCAG *scccag;
+      std::function<std::set<const Function *> (CallInst *call)> getIndirectCallees;
 
       CallGraph (Module &M);
 
-      void handleCallInstruction (CallGraphFunctionNode *fromNode, CallBase *callInst, PTACallGraph *callGraph);
+      void addCallsOf (CallGraphFunctionNode *fromNode);
+
+      void handleCallInstruction (CallGraphFunctionNode *fromNode, CallBase *callInst, std::function<std::set<const Function *> (CallInst *call)> &getIndirectCallees);
 
       CallGraphFunctionFunctionEdge * fetchOrCreateEdge (CallGraphFunctionNode *fromNode, CallBase *callInst, Function & callee, bool isMust);
 
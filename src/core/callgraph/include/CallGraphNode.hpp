@@ -49,6 +49,10 @@ namespace llvm::noelle {
 
       void addIncomingEdge (CallGraphFunctionFunctionEdge *edge);
 
+      void removeOutgoingEdge (CallGraphFunctionFunctionEdge *edge);
+
+      void removeIncomingEdge (CallGraphFunctionFunctionEdge *edge);
+
       std::unordered_set<CallGraphFunctionFunctionEdge *> getIncomingEdges (void) const ;
 
       std::unordered_set<CallGraphFunctionFunctionEdge *> getOutgoingEdges (void) const ;
@@ -21,8 +21,21 @@ namespace llvm::noelle {
   }
 
   CallGraph::CallGraph (Module &M, PTACallGraph *callGraph)
+    : CallGraph(M, [callGraph](CallInst *call) -> std::set<const Function *> {
+        if (!callGraph->hasIndCSCallees(call)){
+          return {};
+        }
+        auto &callees = callGraph->getIndCSCallees(call);
+        return std::set<const Function *>(callees.begin(), callees.end());
+      })
+    {
+    return ;
+  }
+
+  CallGraph::CallGraph (Module &M, std::function<std::set<const Function *> (CallInst *call)> getIndirectCallees)
     : m{M},
-      scccag{nullptr}
+      scccag{nullptr},
+      getIndirectCallees{getIndirectCallees}
     {
 
     /*
@@ -50,24 +63,78 @@ namespace llvm::noelle {
       /*
        * Add the edges from this function.
        */
-      for (auto &inst : instructions(&F)){
+      this->addCallsOf(fromNode);
+    }
 
-        /*
-         * Handle call instructions.
-         */
-        if (auto callInst = dyn_cast<CallInst>(&inst)){
-          this->handleCallInstruction(fromNode, callInst, callGraph);
-          continue ;
-        }
+    return ;
+  }
 
-        /*
-         * Handle invoke instructions.
-         */
-        if (auto callInst = dyn_cast<InvokeInst>(&inst)){
-          this->handleCallInstruction(fromNode, callInst, callGraph);
-          continue ;
-        }
+  void CallGraph::addCallsOf (CallGraphFunctionNode *fromNode){
+    auto F = fromNode->getFunction();
+
+    for (auto &inst : instructions(F)){
+
+      /*
+       * Handle call instructions.
+       */
+      if (auto callInst = dyn_cast<CallInst>(&inst)){
+        this->handleCallInstruction(fromNode, callInst, this->getIndirectCallees);
+        continue ;
       }
+
+      /*
+       * Handle invoke instructions.
+       */
+      if (auto callInst = dyn_cast<InvokeInst>(&inst)){
+        this->handleCallInstruction(fromNode, callInst, this->getIndirectCallees);
+        continue ;
+      }
+    }
+
+    return ;
+  }
+
+  void CallGraph::updateCallsOf (Function &caller){
+    assert(this->getIndirectCallees);
+
+    /*
+     * Fetch the node of the caller.
+     */
+    auto fromNode = this->getFunctionNode(&caller);
+    assert(fromNode != nullptr);
+
+    /*
+     * Remove the edges that leave the caller.
+     * Some of the instructions these edges were created for might not exist anymore, so only their pointers are used.
+     */
+    std::unordered_set<CallGraphInstructionNode *> instNodes;
+    for (auto edge : fromNode->getOutgoingEdges()){
+      auto toNode = edge->getCallee();
+      fromNode->removeOutgoingEdge(edge);
+      toNode->removeIncomingEdge(edge);
+      for (auto subEdge : edge->getSubEdges()){
+        instNodes.insert(subEdge->getCaller());
+        delete subEdge;
+      }
+      this->edges.erase(edge);
+      delete edge;
+    }
+    for (auto instNode : instNodes){
+      this->instructionNodes.erase(instNode->getInstruction());
+      delete instNode;
+    }
+
+    /*
+     * Add the edges of the current calls of the caller.
+     */
+    this->addCallsOf(fromNode);
+
+    /*
+     * The SCCs of the call graph need to be recomputed.
+     */
+    if (this->scccag != nullptr){
+      delete this->scccag;
+      this->scccag = nullptr;
     }
 
     return ;
@@ -101,7 +168,7 @@ namespace llvm::noelle {
     return n;
   }
 
-  void CallGraph::handleCallInstruction (CallGraphFunctionNode *fromNode, CallBase *callInst, PTACallGraph *callGraph){
+  void CallGraph::handleCallInstruction (CallGraphFunctionNode *fromNode, CallBase *callInst, std::function<std::set<const Function *> (CallInst *call)> &getIndirectCallees){
 
     /*
      * Fetch the callee.
@@ -122,14 +189,11 @@ namespace llvm::noelle {
      */
     if (isa<CallInst>(callInst)){
       auto callInstCast = cast<CallInst>(callInst);
-      if (!callGraph->hasIndCSCallees(callInstCast)) {
-        return ;
-      }
 
       /*
        * Iterate over the possible callees.
        */
-      auto callees = callGraph->getIndCSCallees(callInstCast);
+      auto callees = getIndirectCallees(callInstCast);
       for (auto &callee : callees) {
 
         /*
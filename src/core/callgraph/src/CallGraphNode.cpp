@@ -56,6 +56,30 @@ namespace llvm::noelle {
     return ;
   }
 
+  void CallGraphFunctionNode::removeOutgoingEdge (CallGraphFunctionFunctionEdge *edge){
+    assert(edge->getCaller() == this);
+
+    /*
+     * Remove the edge.
+     */
+    this->outgoingEdges.erase(edge);
+    this->outgoingEdgesMap.erase(edge->getCallee());
+
+    return ;
+  }
+
+  void CallGraphFunctionNode::removeIncomingEdge (CallGraphFunctionFunctionEdge *edge){
+    assert(edge->getCallee() == this);
+
+    /*
+     * Remove the edge.
+     */
+    this->incomingEdges.erase(edge);
+    this->incomingEdgesMap.erase(edge->getCaller());
+
+    return ;
+  }
+
   std::unordered_set<CallGraphFunctionFunctionEdge *> CallGraphFunctionNode::getIncomingEdges (void) const {
     return this->incomingEdges;
   }
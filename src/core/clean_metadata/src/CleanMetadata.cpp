@@ -29,6 +29,9 @@ void CleanMetadata::cleanPDGMetadata(Module &M) {
     if (F.hasMetadata("noelle.pdg.edges")) {
       F.setMetadata("noelle.pdg.edges", nullptr);
     }
+    if (F.hasMetadata("noelle.pdg.function")) {
+      F.setMetadata("noelle.pdg.function", nullptr);
+    }
     
     for (auto &B : F) {
       for (auto &I : B) {
@@ -62,10 +65,20 @@ void CleanMetadata::cleanProfMetadata (Module &M){
         if (I.getMetadata("prof")){
           I.setMetadata("prof", nullptr);
         }
+        if (I.getMetadata("noelle.dependence_profiles.id")){
+          I.setMetadata("noelle.dependence_profiles.id", nullptr);
+        }
+        if (I.getMetadata("noelle.dependence_profiles.never_observed")){
+          I.setMetadata("noelle.dependence_profiles.never_observed", nullptr);
+        }
       }
     }
   }
 
+  if (auto n = M.getNamedMetadata("noelle.module.dependence_profiles")) {
+    M.eraseNamedMetadata(n);
+  }
+
   return ;
 }
 
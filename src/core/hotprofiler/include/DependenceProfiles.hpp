@@ -0,0 +1,49 @@
+/*
+ * Copyright 2016 - 2020  Angelo Matni, Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+
+#include "SystemHeaders.hpp"
+#include "LoopStructure.hpp"
+
+namespace llvm::noelle {
+
+  /*
+   * Loop-carried memory dependences observed while running the program on a training input.
+   *
+   * The profile is embedded in the IR by the DependenceProfiler tool (see noelle-prof-dependences and noelle-meta-dep-prof-embed).
+   */
+  class DependenceProfiles {
+    public:
+
+      /*
+       * Metadata used to embed the profile.
+       */
+      static const std::string moduleMetadataName;
+      static const std::string instructionIDMetadataName;
+      static const std::string neverObservedMetadataName;
+
+      DependenceProfiles (Module &M);
+
+      bool isAvailable (void) const ;
+
+      /*
+       * Return true if the memory dependence from @from to @to has been profiled across iterations of @loop and it never manifested.
+       */
+      bool isNeverObserved (Instruction *from, Instruction *to, LoopStructure *loop) const ;
+
+      uint64_t getNumberOfNeverObservedDependences (void) const ;
+
+    private:
+      bool available;
+      std::unordered_map<Instruction *, std::unordered_map<Instruction *, std::unordered_set<BasicBlock *>>> neverObserved;
+  };
+
+}
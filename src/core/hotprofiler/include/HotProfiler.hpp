@@ -32,6 +32,11 @@ namespace llvm::noelle {
 
       Hot& getHot (void);
 
+      /*
+       * Recompute the profiles after the code of @M has been modified.
+       */
+      void updateProfiles (Module &M);
+
     private:
       Hot hot;
 
@@ -0,0 +1,115 @@
+/*
+ * Copyright 2016 - 2020  Angelo Matni, Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "DependenceProfiles.hpp"
+
+using namespace llvm;
+using namespace llvm::noelle;
+
+const std::string DependenceProfiles::moduleMetadataName = "noelle.module.dependence_profiles";
+const std::string DependenceProfiles::instructionIDMetadataName = "noelle.dependence_profiles.id";
+const std::string DependenceProfiles::neverObservedMetadataName = "noelle.dependence_profiles.never_observed";
+
+DependenceProfiles::DependenceProfiles (Module &M)
+  : available{false}
+  {
+
+  /*
+   * Check if the profile has been embedded.
+   */
+  if (M.getNamedMetadata(DependenceProfiles::moduleMetadataName) == nullptr){
+    return ;
+  }
+  this->available = true;
+
+  /*
+   * Fetch the instructions that have been profiled.
+   */
+  std::unordered_map<uint64_t, Instruction *> idToInstruction;
+  for (auto &F : M){
+    for (auto &I : instructions(F)){
+      auto idM = I.getMetadata(DependenceProfiles::instructionIDMetadataName);
+      if (idM == nullptr){
+        continue ;
+      }
+      auto id = cast<ConstantInt>(cast<ConstantAsMetadata>(idM->getOperand(0))->getValue())->getZExtValue();
+      idToInstruction[id] = &I;
+    }
+  }
+
+  /*
+   * Fetch the dependences that never manifested.
+   * Each of them is attached to its destination as a pair of IDs: the source of the dependence and the terminator of the header of the loop.
+   */
+  for (auto &F : M){
+    for (auto &I : instructions(F)){
+      auto depsM = I.getMetadata(DependenceProfiles::neverObservedMetadataName);
+      if (depsM == nullptr){
+        continue ;
+      }
+      for (auto &depOperand : depsM->operands()){
+        auto depM = cast<MDNode>(depOperand);
+        auto fromID = cast<ConstantInt>(cast<ConstantAsMetadata>(depM->getOperand(0))->getValue())->getZExtValue();
+        auto loopID = cast<ConstantInt>(cast<ConstantAsMetadata>(depM->getOperand(1))->getValue())->getZExtValue();
+
+        /*
+         * The instructions might have been removed by transformations that run after embedding the profile.
+         */
+        if (  false
+              || (idToInstruction.find(fromID) == idToInstruction.end())
+              || (idToInstruction.find(loopID) == idToInstruction.end())
+           ){
+          continue ;
+        }
+        auto from = idToInstruction[fromID];
+        auto header = idToInstruction[loopID]->getParent();
+        this->neverObserved[&I][from].insert(header);
+      }
+    }
+  }
+
+  return ;
+}
+
+bool DependenceProfiles::isAvailable (void) const {
+  return this->available;
+}
+
+bool DependenceProfiles::isNeverObserved (Instruction *from, Instruction *to, LoopStructure *loop) const {
+
+  /*
+   * Fetch the dependences that reach @to.
+   */
+  auto toIt = this->neverObserved.find(to);
+  if (toIt == this->neverObserved.end()){
+    return false;
+  }
+  auto fromIt = toIt->second.find(from);
+  if (fromIt == toIt->second.end()){
+    return false;
+  }
+
+  /*
+   * Check the loop.
+   */
+  auto &headers = fromIt->second;
+  return headers.find(loop->getHeader()) != headers.end();
+}
+
+uint64_t DependenceProfiles::getNumberOfNeverObservedDependences (void) const {
+  uint64_t deps = 0;
+  for (auto &toPair : this->neverObserved){
+    for (auto &fromPair : toPair.second){
+      deps += fromPair.second.size();
+    }
+  }
+
+  return deps;
+}
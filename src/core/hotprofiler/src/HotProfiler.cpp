@@ -85,3 +85,18 @@ void HotProfiler::analyzeProfiles (Module &M){
 Hot& HotProfiler::getHot (void){
   return this->hot;
 }
+
+void HotProfiler::updateProfiles (Module &M){
+
+  /*
+   * Discard the current profiles as they might refer to code that does not exist anymore.
+   */
+  this->hot = Hot();
+
+  /*
+   * Compute the profiles of the current code.
+   */
+  this->analyzeProfiles(M);
+
+  return ;
+}
@@ -0,0 +1,51 @@
+/*
+ * Copyright 2019 - 2020  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+
+#include "SystemHeaders.hpp"
+#include "LoopDependenceInfo.hpp"
+#include "PerfectLoopNest.hpp"
+#include "SCC.hpp"
+
+namespace llvm::noelle {
+
+  class LoopCollapse {
+    public:
+
+      /*
+       * Constructor
+       */
+      LoopCollapse ();
+
+      /*
+       * Collapse the loop nest rooted at the loop given as input into a single loop.
+       *
+       * The nest is collapsed only if it is perfectly nested (i.e., the outer loop only contains the inner loop and the code to evolve its induction variable),
+       * if the iteration space of the inner loop does not depend on the outer loop,
+       * and if the outer loop does not have enough iterations to saturate the cores given as input.
+       */
+      bool collapseLoopNest (
+        LoopDependenceInfo const &LDI,
+        LoopInfo &LI,
+        ScalarEvolution &SE,
+        uint32_t numberOfCores
+        );
+
+    private:
+      APInt getMaximumBackedgeTakenCount (
+        InductionVariable &IV,
+        Loop *loop,
+        const SCEV *backedgeTakenCount,
+        ScalarEvolution &SE
+        ) const ;
+  };
+
+}
@@ -0,0 +1,259 @@
+/*
+ * Copyright 2019 - 2020  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "LoopCollapse.hpp"
+#include "ScalarEvolutionExpander.h"
+
+using namespace llvm;
+using namespace llvm::noelle;
+
+bool LoopCollapse::collapseLoopNest (
+  LoopDependenceInfo const &LDI,
+  LoopInfo &LI,
+  ScalarEvolution &SE,
+  uint32_t numberOfCores
+  ){
+
+  /*
+   * Fetch the outermost loop of the nest.
+   */
+  auto outerLoop = LDI.getLoopStructure();
+
+  /*
+   * Check if the outer loop has enough iterations to keep all cores busy.
+   * In this case, there is no benefit to collapse the nest.
+   */
+  if (  true
+        && LDI.doesHaveCompileTimeKnownTripCount()
+        && (LDI.getCompileTimeTripCount() >= numberOfCores)
+     ){
+    return false;
+  }
+
+  /*
+   * Check the shape of the nest.
+   * The iteration space of the inner loop must not depend on the outer loop.
+   */
+  PerfectLoopNest nest(LDI);
+  if (  false
+        || (!nest.isPerfectlyNested())
+        || (!nest.isInnerIterationSpaceInvariant())
+     ){
+    return false;
+  }
+  auto innerLoop = nest.getInnerLoop();
+  auto outerAttr = nest.getOuterLoopGoverningIVAttribution();
+  auto innerAttr = nest.getInnerLoopGoverningIVAttribution();
+  auto outerPreheader = outerLoop->getPreHeader();
+  auto outerHeader = outerLoop->getHeader();
+  auto innerPreheader = innerLoop->getPreHeader();
+  auto innerHeader = innerLoop->getHeader();
+  auto &outerIV = outerAttr->getInductionVariable();
+  auto &innerIV = innerAttr->getInductionVariable();
+  auto outerPHI = outerIV.getLoopEntryPHI();
+  auto innerPHI = innerIV.getLoopEntryPHI();
+  auto innerStartValue = innerPHI->getIncomingValueForBlock(innerPreheader);
+
+  /*
+   * Compute the number of iterations of both loops.
+   */
+  auto outerLLVMLoop = LI.getLoopFor(outerHeader);
+  auto innerLLVMLoop = LI.getLoopFor(innerHeader);
+  if (  false
+        || (outerLLVMLoop == nullptr)
+        || (innerLLVMLoop == nullptr)
+        || (innerLLVMLoop->getParentLoop() != outerLLVMLoop)
+     ){
+    return false;
+  }
+  auto outerTripCountSCEV = SE.getBackedgeTakenCount(outerLLVMLoop);
+  auto innerTripCountSCEV = SE.getBackedgeTakenCount(innerLLVMLoop);
+  if (  false
+        || isa<SCEVCouldNotCompute>(outerTripCountSCEV)
+        || isa<SCEVCouldNotCompute>(innerTripCountSCEV)
+        || (!SE.isLoopInvariant(innerTripCountSCEV, outerLLVMLoop))
+     ){
+    return false;
+  }
+
+  /*
+   * Check that the number of iterations of the collapsed loop fits in 64 bits.
+   */
+  auto outerMaxTripCount = this->getMaximumBackedgeTakenCount(outerIV, outerLLVMLoop, outerTripCountSCEV, SE);
+  auto innerMaxTripCount = this->getMaximumBackedgeTakenCount(innerIV, innerLLVMLoop, innerTripCountSCEV, SE);
+  auto maxTotalTripCount = outerMaxTripCount * innerMaxTripCount;
+  if (maxTotalTripCount.getActiveBits() > 64){
+    return false;
+  }
+  errs() << "LoopCollapse:   Collapse the loop nest rooted at " << *outerHeader->getFirstNonPHI() << "\n";
+
+  /*
+   * Fetch the types and the constants we need.
+   */
+  auto &cxt = outerHeader->getContext();
+  auto F = outerHeader->getParent();
+  auto int64Type = IntegerType::get(cxt, 64);
+  auto outerType = outerPHI->getType();
+  auto innerType = innerPHI->getType();
+  auto outerStep = cast<ConstantInt>(outerIV.getSingleComputedStepValue());
+  auto innerStep = cast<ConstantInt>(innerIV.getSingleComputedStepValue());
+  auto outerStartValue = outerPHI->getIncomingValueForBlock(outerPreheader);
+  auto outerExit = outerAttr->getExitBlockFromHeader();
+  auto outerBr = outerAttr->getHeaderBrInst();
+  auto outerCmp = outerAttr->getHeaderCmpInst();
+  auto innerExit = innerAttr->getExitBlockFromHeader();
+  auto innerBr = innerAttr->getHeaderBrInst();
+  auto innerCmp = innerAttr->getHeaderCmpInst();
+  auto innerIVInstructions = innerIV.getAllInstructions();
+  auto blocksToDelete = nest.getBasicBlocksBetweenInnerAndOuterLatches();
+
+  /*
+   * Compute the number of iterations of the collapsed loop in the preheader of the outer loop.
+   */
+  SCEVExpander expander(SE, F->getParent()->getDataLayout(), "collapse");
+  auto outerPreheaderTerminator = outerPreheader->getTerminator();
+  auto outerTripCount = expander.expandCodeFor(SE.getTruncateOrZeroExtend(outerTripCountSCEV, int64Type), int64Type, outerPreheaderTerminator);
+  auto innerTripCount = expander.expandCodeFor(SE.getTruncateOrZeroExtend(innerTripCountSCEV, int64Type), int64Type, outerPreheaderTerminator);
+  IRBuilder<> preheaderBuilder(outerPreheaderTerminator);
+  auto totalTripCount = preheaderBuilder.CreateMul(outerTripCount, innerTripCount, "collapse.tripcount", true, false);
+
+  /*
+   * Create the induction variable of the collapsed loop.
+   */
+  IRBuilder<> headerBuilder(&*outerHeader->begin());
+  auto collapsedIV = headerBuilder.CreatePHI(int64Type, 2, "collapse.iv");
+  collapsedIV->addIncoming(ConstantInt::get(int64Type, 0), outerPreheader);
+
+  /*
+   * Create the latch of the collapsed loop.
+   */
+  auto collapsedLatch = BasicBlock::Create(cxt, "collapse.latch", F);
+  IRBuilder<> latchBuilder(collapsedLatch);
+  auto collapsedIVNext = latchBuilder.CreateAdd(collapsedIV, ConstantInt::get(int64Type, 1), "collapse.iv.next", true, false);
+  latchBuilder.CreateBr(outerHeader);
+  collapsedIV->addIncoming(collapsedIVNext, collapsedLatch);
+
+  /*
+   * The collapsed loop is now governed by the new induction variable.
+   */
+  IRBuilder<> outerBrBuilder(outerBr);
+  auto newOuterCmp = (outerBr->getSuccessor(0) == outerExit)
+    ? outerBrBuilder.CreateICmpUGE(collapsedIV, totalTripCount)
+    : outerBrBuilder.CreateICmpULT(collapsedIV, totalTripCount);
+  outerBr->setCondition(newOuterCmp);
+  outerCmp->eraseFromParent();
+
+  /*
+   * Recover the values of the original induction variables from the one of the collapsed loop.
+   * DOALL computes the division and the remainder only at the beginning of each chunk, and it steps them within the chunk.
+   */
+  IRBuilder<> recoveryBuilder(innerPreheader->getFirstNonPHI());
+  auto outerIteration = recoveryBuilder.CreateUDiv(collapsedIV, innerTripCount);
+  auto innerIteration = recoveryBuilder.CreateURem(collapsedIV, innerTripCount);
+  auto outerOffset = recoveryBuilder.CreateMul(recoveryBuilder.CreateZExtOrTrunc(outerIteration, outerType), ConstantInt::get(outerType, outerStep->getSExtValue()));
+  auto innerOffset = recoveryBuilder.CreateMul(recoveryBuilder.CreateZExtOrTrunc(innerIteration, innerType), ConstantInt::get(innerType, innerStep->getSExtValue()));
+  auto recoveredOuterIV = recoveryBuilder.CreateAdd(outerStartValue, outerOffset);
+  auto recoveredInnerIV = recoveryBuilder.CreateAdd(innerStartValue, innerOffset);
+
+  /*
+   * The header of the inner loop always jumps to the body now.
+   */
+  auto innerBody = (innerBr->getSuccessor(0) == innerExit) ? innerBr->getSuccessor(1) : innerBr->getSuccessor(0);
+  BranchInst::Create(innerBody, innerBr);
+  innerBr->eraseFromParent();
+  innerCmp->eraseFromParent();
+
+  /*
+   * Every iteration of the inner loop is an iteration of the collapsed loop.
+   */
+  for (auto latch : innerLoop->getLatches()){
+    auto latchTerminator = latch->getTerminator();
+    for (auto i = 0u; i < latchTerminator->getNumSuccessors(); i++){
+      if (latchTerminator->getSuccessor(i) == innerHeader){
+        latchTerminator->setSuccessor(i, collapsedLatch);
+      }
+    }
+  }
+
+  /*
+   * Replace the original induction variables with the recovered ones.
+   */
+  innerPHI->replaceAllUsesWith(recoveredInnerIV);
+  innerPHI->eraseFromParent();
+  innerIVInstructions.erase(innerPHI);
+  auto modified = true;
+  while (modified){
+    modified = false;
+    for (auto inst : innerIVInstructions){
+      if (inst->use_empty()){
+        inst->eraseFromParent();
+        innerIVInstructions.erase(inst);
+        modified = true;
+        break ;
+      }
+    }
+  }
+  outerPHI->replaceAllUsesWith(recoveredOuterIV);
+  outerPHI->eraseFromParent();
+
+  /*
+   * Delete the code that was evolving the outer induction variable.
+   */
+  for (auto bb : blocksToDelete){
+    bb->dropAllReferences();
+  }
+  for (auto bb : blocksToDelete){
+    bb->eraseFromParent();
+  }
+
+  return true;
+}
+
+APInt LoopCollapse::getMaximumBackedgeTakenCount (
+  InductionVariable &IV,
+  Loop *loop,
+  const SCEV *backedgeTakenCount,
+  ScalarEvolution &SE
+  ) const {
+  auto maxCount = SE.getUnsignedRangeMax(backedgeTakenCount).zextOrTrunc(128);
+
+  /*
+   * Fetch the update of the induction variable.
+   */
+  auto phi = IV.getLoopEntryPHI();
+  auto latch = loop->getLoopLatch();
+  if (  false
+        || (latch == nullptr)
+        || (phi->getBasicBlockIndex(latch) == -1)
+     ){
+    return maxCount;
+  }
+  auto update = dyn_cast<OverflowingBinaryOperator>(phi->getIncomingValueForBlock(latch));
+  if (  false
+        || (update == nullptr)
+        || ((update->getOperand(0) != phi) && (update->getOperand(1) != phi))
+        || ((!update->hasNoSignedWrap()) && (!update->hasNoUnsignedWrap()))
+     ){
+    return maxCount;
+  }
+
+  /*
+   * The update cannot wrap and the loop exits by comparing the induction variable.
+   * Hence, the header sees a different value of the induction variable every time it executes, and the backedge cannot be taken more times than the number of values of its type minus one.
+   * This bounds the count when SCEV cannot (e.g., an int IV compared against a sign-extended long long).
+   */
+  auto bits = phi->getType()->getPrimitiveSizeInBits();
+  auto maxValuesOfIV = APInt::getMaxValue(bits).zextOrTrunc(128);
+  if (maxValuesOfIV.ult(maxCount)){
+    return maxValuesOfIV;
+  }
+
+  return maxCount;
+}
@@ -0,0 +1,71 @@
+/*
+ * Copyright 2019 - 2020  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+
+#include "SystemHeaders.hpp"
+#include "LoopDependenceInfo.hpp"
+#include "PDG.hpp"
+#include "SCC.hpp"
+
+namespace llvm::noelle {
+
+  class LoopFusion {
+    public:
+
+      /*
+       * Constructor
+       */
+      LoopFusion ();
+
+      /*
+       * Fuse two loops where the second one starts right after the first one exits.
+       *
+       * The loops are fused only if they execute the same number of iterations and no dependence between them prevents the fusion.
+       * The dependences are fetched from the dependence graph of the function that includes the loops.
+       */
+      bool fuseLoops (
+        LoopDependenceInfo const &firstLDI,
+        LoopDependenceInfo const &secondLDI,
+        PDG *functionDG,
+        LoopInfo &LI,
+        ScalarEvolution &SE
+        );
+
+    private:
+
+      /*
+       * Methods
+       */
+      bool areLoopsAdjacent (
+        LoopStructure *firstLoop,
+        LoopStructure *secondLoop
+        ) const ;
+
+      bool hasLiveOutValues (LoopStructure *loop) const ;
+
+      bool isThereAFusionPreventingDependence (
+        LoopStructure *firstLoop,
+        LoopStructure *secondLoop,
+        PDG *functionDG,
+        ScalarEvolution &SE
+        ) const ;
+
+      bool doInstructionsAccessTheSameMemoryAtTheSameIteration (
+        Instruction *firstInst,
+        LoopStructure *firstLoop,
+        Instruction *secondInst,
+        LoopStructure *secondLoop,
+        ScalarEvolution &SE
+        ) const ;
+
+  };
+
+}
@@ -0,0 +1,332 @@
+/*
+ * Copyright 2019 - 2020  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "LoopFusion.hpp"
+
+using namespace llvm;
+using namespace llvm::noelle;
+
+bool LoopFusion::fuseLoops (
+  LoopDependenceInfo const &firstLDI,
+  LoopDependenceInfo const &secondLDI,
+  PDG *functionDG,
+  LoopInfo &LI,
+  ScalarEvolution &SE
+  ){
+
+  /*
+   * Fetch the loops.
+   */
+  auto firstLoop = firstLDI.getLoopStructure();
+  auto secondLoop = secondLDI.getLoopStructure();
+
+  /*
+   * Both loops must be governed by an induction variable that is checked only at their headers.
+   */
+  auto firstAttr = firstLDI.getInductionVariableManager()->getLoopGoverningIVAttribution(*firstLoop);
+  auto secondAttr = secondLDI.getInductionVariableManager()->getLoopGoverningIVAttribution(*secondLoop);
+  if (  false
+        || (firstAttr == nullptr)
+        || (secondAttr == nullptr)
+        || (firstLoop->getLatches().size() != 1)
+        || (secondLoop->getLatches().size() != 1)
+        || (*firstLoop->getLatches().begin() == firstLoop->getHeader())
+        || (*secondLoop->getLatches().begin() == secondLoop->getHeader())
+     ){
+    return false;
+  }
+
+  /*
+   * The second loop must start right after the first one exits.
+   */
+  if (!this->areLoopsAdjacent(firstLoop, secondLoop)){
+    return false;
+  }
+
+  /*
+   * The header of the second loop is going to be executed within the body of the fused loop.
+   * Hence, it must only include its PHIs and the code that decides whether to exit.
+   */
+  auto secondHeader = secondLoop->getHeader();
+  auto secondCmp = secondAttr->getHeaderCmpInst();
+  auto secondBr = secondAttr->getHeaderBrInst();
+  if (  false
+        || (secondCmp->getParent() != secondHeader)
+        || (!secondCmp->hasOneUse())
+     ){
+    return false;
+  }
+  for (auto &inst : *secondHeader){
+    if (  false
+          || isa<PHINode>(&inst)
+          || isa<DbgInfoIntrinsic>(&inst)
+          || (&inst == secondCmp)
+          || (&inst == secondBr)
+       ){
+      continue ;
+    }
+    return false;
+  }
+
+  /*
+   * The first loop cannot produce values used after it.
+   * Otherwise, the second loop would need them before the first loop completes.
+   */
+  if (this->hasLiveOutValues(firstLoop)){
+    return false;
+  }
+
+  /*
+   * Both loops must execute the same number of iterations.
+   */
+  auto firstLLVMLoop = LI.getLoopFor(firstLoop->getHeader());
+  auto secondLLVMLoop = LI.getLoopFor(secondHeader);
+  if (  false
+        || (firstLLVMLoop == nullptr)
+        || (secondLLVMLoop == nullptr)
+     ){
+    return false;
+  }
+  auto firstTripCount = SE.getBackedgeTakenCount(firstLLVMLoop);
+  auto secondTripCount = SE.getBackedgeTakenCount(secondLLVMLoop);
+  if (  false
+        || isa<SCEVCouldNotCompute>(firstTripCount)
+        || (firstTripCount != secondTripCount)
+     ){
+    return false;
+  }
+
+  /*
+   * Check the dependences between the two loops.
+   */
+  if (this->isThereAFusionPreventingDependence(firstLoop, secondLoop, functionDG, SE)){
+    return false;
+  }
+  errs() << "LoopFusion:   Fuse the loop " << *firstLoop->getHeader()->getFirstNonPHI() << " with the loop " << *secondHeader->getFirstNonPHI() << "\n";
+
+  /*
+   * Fetch the basic blocks we need to rewire.
+   */
+  auto firstPreheader = firstLoop->getPreHeader();
+  auto firstHeader = firstLoop->getHeader();
+  auto firstLatch = *firstLoop->getLatches().begin();
+  auto firstBr = firstAttr->getHeaderBrInst();
+  auto secondPreheader = secondLoop->getPreHeader();
+  auto secondLatch = *secondLoop->getLatches().begin();
+  auto secondExit = secondAttr->getExitBlockFromHeader();
+  auto secondBody = (secondBr->getSuccessor(0) == secondExit) ? secondBr->getSuccessor(1) : secondBr->getSuccessor(0);
+
+  /*
+   * Move the PHIs of the second loop to the header of the fused loop.
+   */
+  std::vector<PHINode *> secondPHIs;
+  for (auto &phi : secondHeader->phis()){
+    secondPHIs.push_back(&phi);
+  }
+  auto firstInsertionPoint = firstHeader->getFirstNonPHI();
+  for (auto phi : secondPHIs){
+    phi->moveBefore(firstInsertionPoint);
+    phi->setIncomingBlock(phi->getBasicBlockIndex(secondPreheader), firstPreheader);
+  }
+
+  /*
+   * The PHIs of the first loop now receive their values from the latch of the second loop.
+   */
+  for (auto &phi : firstHeader->phis()){
+    auto index = phi.getBasicBlockIndex(firstLatch);
+    if (index >= 0){
+      phi.setIncomingBlock(index, secondLatch);
+    }
+  }
+
+  /*
+   * Execute the body of the second loop after the one of the first loop.
+   */
+  firstLatch->getTerminator()->replaceUsesOfWith(firstHeader, secondHeader);
+  BranchInst::Create(secondBody, secondBr);
+  secondBr->eraseFromParent();
+  secondCmp->eraseFromParent();
+  secondLatch->getTerminator()->replaceUsesOfWith(secondHeader, firstHeader);
+
+  /*
+   * The fused loop exits where the second loop exited.
+   */
+  firstBr->replaceUsesOfWith(secondPreheader, secondExit);
+  for (auto &phi : secondExit->phis()){
+    auto index = phi.getBasicBlockIndex(secondHeader);
+    if (index >= 0){
+      phi.setIncomingBlock(index, firstHeader);
+    }
+  }
+
+  /*
+   * The preheader of the second loop is now unreachable.
+   */
+  secondPreheader->eraseFromParent();
+
+  return true;
+}
+
+bool LoopFusion::areLoopsAdjacent (
+  LoopStructure *firstLoop,
+  LoopStructure *secondLoop
+  ) const {
+
+  /*
+   * The first loop must exit only to the preheader of the second loop.
+   */
+  auto secondPreheader = secondLoop->getPreHeader();
+  auto firstExits = firstLoop->getLoopExitBasicBlocks();
+  if (  false
+        || (secondPreheader == nullptr)
+        || (firstLoop->getPreHeader() == nullptr)
+        || (firstExits.size() != 1)
+        || (firstExits[0] != secondPreheader)
+        || (secondPreheader->getSinglePredecessor() != firstLoop->getHeader())
+        || (secondLoop->numberOfExitBasicBlocks() != 1)
+     ){
+    return false;
+  }
+
+  /*
+   * Nothing can be executed between the two loops.
+   */
+  for (auto &inst : *secondPreheader){
+    if (  false
+          || isa<DbgInfoIntrinsic>(&inst)
+          || (&inst == secondPreheader->getTerminator())
+       ){
+      continue ;
+    }
+    return false;
+  }
+  if (secondPreheader->getSingleSuccessor() != secondLoop->getHeader()){
+    return false;
+  }
+
+  return true;
+}
+
+bool LoopFusion::hasLiveOutValues (LoopStructure *loop) const {
+  for (auto inst : loop->getInstructions()){
+    for (auto user : inst->users()){
+      auto userInst = dyn_cast<Instruction>(user);
+      if (  false
+            || (userInst == nullptr)
+            || (!loop->isIncluded(userInst))
+         ){
+        return true;
+      }
+    }
+  }
+
+  return false;
+}
+
+bool LoopFusion::isThereAFusionPreventingDependence (
+  LoopStructure *firstLoop,
+  LoopStructure *secondLoop,
+  PDG *functionDG,
+  ScalarEvolution &SE
+  ) const {
+
+  /*
+   * After the fusion, an iteration i of the second loop executes before the iterations of the first loop that come after i.
+   * Hence, a dependence between the two loops is preserved only if it connects the same iteration of both loops.
+   */
+  for (auto inst : firstLoop->getInstructions()){
+    auto isPreventingFusion = [this, inst, firstLoop, secondLoop, &SE](Value *other, DGEdge<Value> *dep) -> bool {
+      auto otherInst = dyn_cast<Instruction>(other);
+      if (  false
+            || (otherInst == nullptr)
+            || (!secondLoop->isIncluded(otherInst))
+         ){
+        return false;
+      }
+      return !this->doInstructionsAccessTheSameMemoryAtTheSameIteration(inst, firstLoop, otherInst, secondLoop, SE);
+    };
+    if (functionDG->iterateOverDependencesFrom(inst, false, true, true, isPreventingFusion)){
+      return true;
+    }
+    if (functionDG->iterateOverDependencesTo(inst, false, true, true, isPreventingFusion)){
+      return true;
+    }
+  }
+
+  return false;
+}
+
+bool LoopFusion::doInstructionsAccessTheSameMemoryAtTheSameIteration (
+  Instruction *firstInst,
+  LoopStructure *firstLoop,
+  Instruction *secondInst,
+  LoopStructure *secondLoop,
+  ScalarEvolution &SE
+  ) const {
+
+  /*
+   * Fetch the memory accessed.
+   */
+  auto getPointerAndSize = [](Instruction *inst, Value *&pointer, uint64_t &size) -> bool {
+    auto &DL = inst->getModule()->getDataLayout();
+    if (auto load = dyn_cast<LoadInst>(inst)){
+      pointer = load->getPointerOperand();
+      size = DL.getTypeStoreSize(load->getType());
+      return true;
+    }
+    if (auto store = dyn_cast<StoreInst>(inst)){
+      pointer = store->getPointerOperand();
+      size = DL.getTypeStoreSize(store->getValueOperand()->getType());
+      return true;
+    }
+    return false;
+  };
+  Value *firstPointer = nullptr;
+  Value *secondPointer = nullptr;
+  uint64_t firstSize = 0;
+  uint64_t secondSize = 0;
+  if (  false
+        || (!getPointerAndSize(firstInst, firstPointer, firstSize))
+        || (!getPointerAndSize(secondInst, secondPointer, secondSize))
+        || (firstSize != secondSize)
+     ){
+    return false;
+  }
+
+  /*
+   * Both addresses must evolve as base + (stride * iteration) with the same base and stride.
+   * Also, the stride must be large enough for different iterations to access disjoint memory.
+   */
+  auto firstAddRec = dyn_cast<SCEVAddRecExpr>(SE.getSCEV(firstPointer));
+  auto secondAddRec = dyn_cast<SCEVAddRecExpr>(SE.getSCEV(secondPointer));
+  if (  false
+        || (firstAddRec == nullptr)
+        || (secondAddRec == nullptr)
+        || (!firstAddRec->isAffine())
+        || (!secondAddRec->isAffine())
+        || (firstAddRec->getLoop()->getHeader() != firstLoop->getHeader())
+        || (secondAddRec->getLoop()->getHeader() != secondLoop->getHeader())
+        || (firstAddRec->getStart() != secondAddRec->getStart())
+     ){
+    return false;
+  }
+  auto firstStride = dyn_cast<SCEVConstant>(firstAddRec->getStepRecurrence(SE));
+  auto secondStride = dyn_cast<SCEVConstant>(secondAddRec->getStepRecurrence(SE));
+  if (  false
+        || (firstStride == nullptr)
+        || (secondStride == nullptr)
+        || (firstStride->getAPInt() != secondStride->getAPInt())
+        || (firstStride->getAPInt().abs().getZExtValue() < firstSize)
+     ){
+    return false;
+  }
+
+  return true;
+}
@@ -17,7 +17,7 @@ namespace llvm::noelle {
 
   class EnvUserBuilder {
    public:
-    EnvUserBuilder ();
+    EnvUserBuilder (std::unordered_map<int, int> &envIndexToOffset);
     ~EnvUserBuilder ();
 
     void setEnvArray (Value *envArr) { this->envArray = envArr; }
@@ -45,6 +45,11 @@ namespace llvm::noelle {
    private:
     Value *envArray;
 
+    /*
+     * Maps from environment index to the position of the variable within the environment array
+     */
+    std::unordered_map<int, int> envIndexToOffset;
+
 		/*
 		 * Maps from environment index to load/stores
 		 */
@@ -69,6 +74,18 @@ namespace llvm::noelle {
       int reducerCount
     );
 
+    /*
+     * Read-only variables (e.g., live-ins) are packed contiguously in the environment array.
+     * All the other variables are padded to a cache line as they are written by different cores.
+     */
+    void createEnvVariables (
+      std::vector<Type *> &varTypes,
+      std::set<int> &singleVarIndices,
+      std::set<int> &reducableVarIndices,
+      int reducerCount,
+      std::set<int> &readOnlyVarIndices
+    );
+
     /*
      * Generate code to create environment array/variable allocations
      */
@@ -78,12 +95,18 @@ namespace llvm::noelle {
     /*
      * Reduce live out variables given binary operators to reduce
      * with and initial values to start at
+     *
+     * Min/max variables are reduced with the predicate P(new, current) that selects a new value
+     * Indices of min/max variables (e.g., argmin/argmax) are reduced along with their min/max, given by its environment index,
+     * and ties are broken by picking the index that satisfies the tie predicate
      */
     BasicBlock * reduceLiveOutVariables (
       BasicBlock *bb,
       IRBuilder<>,
       std::unordered_map<int, int> &reducableBinaryOps,
       std::unordered_map<int, Value *> &initialValues,
+      std::unordered_map<int, CmpInst::Predicate> &minMaxPredicates,
+      std::unordered_map<int, std::pair<int, CmpInst::Predicate>> &indicesOfMinMax,
       Value *numberOfThreadsExecuted
     );
 
@@ -99,6 +122,7 @@ namespace llvm::noelle {
     int getNumUsers () { return envUsers.size(); }
 
     Value *getEnvVar (int ind) ;
+    int getEnvVarOffset (int ind) ;
     Value *getAccumulatedReducableEnvVar (int ind) ;
     Value *getReducableEnvVar (int ind, int reducerInd) ;
     bool isReduced (int ind) ;
@@ -118,6 +142,7 @@ namespace llvm::noelle {
     int envSize;
     ArrayType *envArrayType;
     std::vector<Type *> envTypes;
+    std::unordered_map<int, int> envIndexToOffset;
     std::unordered_map<int, Value *> envIndexToVar;
     std::unordered_map<int, Value *> envIndexToAccumulatedReducableVar;
     std::unordered_map<int, std::vector<Value *>> envIndexToReducableVar;
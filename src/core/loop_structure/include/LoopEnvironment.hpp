@@ -43,9 +43,14 @@ namespace llvm::noelle {
 
       bool isProducer (Value *producer) const ;
 
+      /*
+       * Live-out values can also be added after the environment is built
+       * even if no code outside the loop consumes them (e.g., the min/max needed to reduce its index)
+       */
+      void addLiveOutProducer (Value *producer);
+
     private:
       void addLiveInProducer (Value *producer);
-      void addLiveOutProducer (Value *producer);
       void addProducer (Value *producer, bool liveIn);
 
       /*
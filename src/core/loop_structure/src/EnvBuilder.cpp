@@ -14,8 +14,8 @@
 using namespace llvm;
 using namespace llvm::noelle;
 
-EnvUserBuilder::EnvUserBuilder ()
-  : envIndexToPtr{}, liveInInds{}, liveOutInds{} {
+EnvUserBuilder::EnvUserBuilder (std::unordered_map<int, int> &envIndexToOffset)
+  : envIndexToOffset{envIndexToOffset}, envIndexToPtr{}, liveInInds{}, liveOutInds{} {
   envIndexToPtr.clear();
   liveInInds.clear();
   liveOutInds.clear();
@@ -38,11 +38,10 @@ void EnvUserBuilder::createEnvPtr (
   auto zeroV = cast<Value>(ConstantInt::get(int64, 0));
 
   /*
-   * Compute how many values can fit in a cache line.
+   * Fetch the position of the variable within the environment array.
    */
-  auto valuesInCacheLine = Architecture::getCacheLineBytes() / sizeof(int64_t);
-
-  auto envIndV = cast<Value>(ConstantInt::get(int64, envIndex * valuesInCacheLine));
+  assert(this->envIndexToOffset.find(envIndex) != this->envIndexToOffset.end());
+  auto envIndV = cast<Value>(ConstantInt::get(int64, this->envIndexToOffset[envIndex]));
 
   auto envGEP = builder.CreateInBoundsGEP(
     this->envArray,
@@ -74,7 +73,8 @@ void EnvUserBuilder::createReducableEnvPtr (
   auto ptrTy_int8 = PointerType::getUnqual(int8);
   auto int64 = IntegerType::get(builder.getContext(), 64);
   auto zeroV = cast<Value>(ConstantInt::get(int64, 0));
-  auto envIndV = cast<Value>(ConstantInt::get(int64, envIndex * valuesInCacheLine));
+  assert(this->envIndexToOffset.find(envIndex) != this->envIndexToOffset.end());
+  auto envIndV = cast<Value>(ConstantInt::get(int64, this->envIndexToOffset[envIndex]));
 
   auto envReduceGEP = builder.CreateInBoundsGEP(
     this->envArray,
@@ -113,16 +113,30 @@ EnvBuilder::~EnvBuilder () {
 
 void EnvBuilder::createEnvUsers (int numUsers) {
   for (int i = 0; i < numUsers; ++i) {
-    this->envUsers.push_back(new EnvUserBuilder());
+    this->envUsers.push_back(new EnvUserBuilder(this->envIndexToOffset));
   }
 }
 
-// TODO: Adjust users of createEnvVariables to pass the Type map
 void EnvBuilder::createEnvVariables (
   std::vector<Type *> &varTypes,
   std::set<int> &singleVarIndices,
   std::set<int> &reducableVarIndices,
   int reducerCount
+) {
+  std::set<int> readOnlyVarIndices{};
+
+  this->createEnvVariables(varTypes, singleVarIndices, reducableVarIndices, reducerCount, readOnlyVarIndices);
+
+  return ;
+}
+
+// TODO: Adjust users of createEnvVariables to pass the Type map
+void EnvBuilder::createEnvVariables (
+  std::vector<Type *> &varTypes,
+  std::set<int> &singleVarIndices,
+  std::set<int> &reducableVarIndices,
+  int reducerCount,
+  std::set<int> &readOnlyVarIndices
 ) {
   assert(envSize == -1 && "Environment variables must be fully determined at once\n");
   this->envSize = singleVarIndices.size() + reducableVarIndices.size();
@@ -136,8 +150,59 @@ void EnvBuilder::createEnvVariables (
    */
   auto valuesInCacheLine = Architecture::getCacheLineBytes() / sizeof(int64_t);
 
+  /*
+   * Check if a variable can be packed with others.
+   * This is the case for read-only variables that fit in a single slot of the environment array.
+   */
+  auto canBePacked = [this, &readOnlyVarIndices, &reducableVarIndices](int envIndex) -> bool {
+    if (readOnlyVarIndices.find(envIndex) == readOnlyVarIndices.end()){
+      return false;
+    }
+    if (reducableVarIndices.find(envIndex) != reducableVarIndices.end()){
+      return false;
+    }
+    auto varType = this->envTypes[envIndex];
+    if (varType->isPointerTy()){
+      return true;
+    }
+    if (  true
+          && (varType->isIntegerTy() || varType->isFloatingPointTy())
+          && (varType->getPrimitiveSizeInBits() <= 64)
+      ){
+      return true;
+    }
+
+    return false;
+  };
+
+  /*
+   * Define the layout of the environment array.
+   *
+   * Read-only variables are only loaded by the tasks when they start.
+   * Hence, they are packed contiguously at the beginning of the array so that all tasks can fetch them with few cache misses.
+   * The other variables are written by different cores, so each of them gets its own cache line to avoid false sharing.
+   */
+  auto offset = 0;
+  for (auto envIndex = 0; envIndex < this->envSize; envIndex++){
+    if (!canBePacked(envIndex)){
+      continue ;
+    }
+    this->envIndexToOffset[envIndex] = offset;
+    offset++;
+  }
+  if ((offset % valuesInCacheLine) != 0){
+    offset += valuesInCacheLine - (offset % valuesInCacheLine);
+  }
+  for (auto envIndex = 0; envIndex < this->envSize; envIndex++){
+    if (canBePacked(envIndex)){
+      continue ;
+    }
+    this->envIndexToOffset[envIndex] = offset;
+    offset += valuesInCacheLine;
+  }
+
   auto int64 = IntegerType::get(this->CXT, 64);
-  this->envArrayType = ArrayType::get(int64, this->envSize * valuesInCacheLine);
+  this->envArrayType = ArrayType::get(int64, offset);
 
   numReducers = reducerCount;
   for (auto envIndex : singleVarIndices) {
@@ -176,19 +241,13 @@ void EnvBuilder::generateEnvVariables (IRBuilder<> builder) {
   auto ptrTy_int8 = PointerType::getUnqual(int8);
   auto int64 = IntegerType::get(builder.getContext(), 64);
   auto zeroV = cast<Value>(ConstantInt::get(int64, 0));
-  auto fetchCastedEnvPtr = [&](Value *arr, int envIndex, Type *ptrType) -> Value * {
-
-    /*
-     * Compute the offset of the variable with index "envIndex" that is stored inside the environment.
-     *
-     * Compute how many values can fit in a cache line.
-     */
-    auto valuesInCacheLine = Architecture::getCacheLineBytes() / sizeof(int64_t);
-    auto indValue = cast<Value>(ConstantInt::get(int64, envIndex * valuesInCacheLine));
+  auto valuesInCacheLine = Architecture::getCacheLineBytes() / sizeof(int64_t);
+  auto fetchCastedEnvPtr = [&](Value *arr, int offset, Type *ptrType) -> Value * {
 
     /*
-     * Compute the address of the variable with index "envIndex".
+     * Compute the address of the variable stored at "offset".
      */
+    auto indValue = cast<Value>(ConstantInt::get(int64, offset));
     auto envPtr = builder.CreateInBoundsGEP(arr, ArrayRef<Value*>({ zeroV, indValue }));
 
     /*
@@ -210,7 +269,7 @@ void EnvBuilder::generateEnvVariables (IRBuilder<> builder) {
   }
   for (auto envIndex : singleIndices) {
     auto ptrType = PointerType::getUnqual(envTypes[envIndex]);
-    envIndexToVar[envIndex] = fetchCastedEnvPtr(this->envArray, envIndex, ptrType);
+    envIndexToVar[envIndex] = fetchCastedEnvPtr(this->envArray, envIndexToOffset[envIndex], ptrType);
   }
 
   /*
@@ -234,7 +293,6 @@ void EnvBuilder::generateEnvVariables (IRBuilder<> builder) {
     /*
      * Define the type of the vectorized form of the reducable variable.
      */
-    auto valuesInCacheLine = Architecture::getCacheLineBytes() / sizeof(int64_t);
     auto reduceArrType = ArrayType::get(int64, numReducers * valuesInCacheLine);
 
     /*
@@ -247,14 +305,14 @@ void EnvBuilder::generateEnvVariables (IRBuilder<> builder) {
      * Store the pointer of the vector of the reducable variable inside the environment.
      */
     auto reduceArrPtrType = PointerType::getUnqual(reduceArrAlloca->getType());
-    auto envPtr = fetchCastedEnvPtr(this->envArray, envIndex, reduceArrPtrType);
+    auto envPtr = fetchCastedEnvPtr(this->envArray, envIndexToOffset[envIndex], reduceArrPtrType);
     builder.CreateStore(reduceArrAlloca, envPtr);
 
     /*
      * Compute and cache the pointer of each element of the vectorized variable.
      */
     for (auto i = 0; i < numReducers; ++i) {
-      auto reducePtr = fetchCastedEnvPtr(reduceArrAlloca, i, ptrType);
+      auto reducePtr = fetchCastedEnvPtr(reduceArrAlloca, i * valuesInCacheLine, ptrType);
       envIndexToReducableVar[envIndex].push_back(reducePtr);
     }
   }
@@ -267,6 +325,8 @@ BasicBlock * EnvBuilder::reduceLiveOutVariables (
   IRBuilder<> builder,
   std::unordered_map<int, int> &reducableBinaryOps,
   std::unordered_map<int, Value *> &initialValues,
+  std::unordered_map<int, CmpInst::Predicate> &minMaxPredicates,
+  std::unordered_map<int, std::pair<int, CmpInst::Predicate>> &indicesOfMinMax,
   Value *numberOfThreadsExecuted
 ) {
 
@@ -300,6 +360,22 @@ BasicBlock * EnvBuilder::reduceLiveOutVariables (
     bbTerminator->eraseFromParent();
   }
   IRBuilder<> bbBuilder{bb};
+
+  /*
+   * Min/max values tracked by an index (e.g., argmin/argmax) and their indices are first reduced across threads
+   * and only then compared with their initial values.
+   * This is because ties with the initial value must keep the initial index.
+   * Hence, their accumulators start from the partial values of the first thread.
+   */
+  std::unordered_map<int, Value *> firstPartialValues;
+  for (auto indexPair : indicesOfMinMax) {
+    auto indexEnvIndex = indexPair.first;
+    auto minMaxEnvIndex = indexPair.second.first;
+    for (auto envIndex : { indexEnvIndex, minMaxEnvIndex }) {
+      if (firstPartialValues.find(envIndex) != firstPartialValues.end()) continue;
+      firstPartialValues[envIndex] = bbBuilder.CreateLoad(envIndexToReducableVar[envIndex][0]);
+    }
+  }
   bbBuilder.CreateBr(loopBodyBB);
 
   /*
@@ -315,10 +391,15 @@ BasicBlock * EnvBuilder::reduceLiveOutVariables (
    * Add the PHI nodes about the current accumulated value
    */
   std::vector<PHINode *> phiNodes;
+  std::unordered_map<int, int> positionOfEnvIndex;
   auto count = 0;
   for (auto envIndexInitValue : initialValues) {
     auto envIndex = envIndexInitValue.first;
     auto initialValue = envIndexInitValue.second;
+    if (firstPartialValues.find(envIndex) != firstPartialValues.end()) {
+      initialValue = firstPartialValues[envIndex];
+    }
+    positionOfEnvIndex[envIndex] = count++;
 
     /*
      * Create a PHI node for the current reduced variable.
@@ -379,6 +460,16 @@ BasicBlock * EnvBuilder::reduceLiveOutVariables (
     loadedValues.push_back(envVar);
   }
 
+  /*
+   * Min/max values are compared with P(new, current), and ties of their indices are broken by a second predicate.
+   */
+  auto createComparison = [](IRBuilder<> &builder, CmpInst::Predicate predicate, Value *lhs, Value *rhs) -> Value * {
+    if (CmpInst::isFPPredicate(predicate)) {
+      return builder.CreateFCmp(predicate, lhs, rhs);
+    }
+    return builder.CreateICmp(predicate, lhs, rhs);
+  };
+
   /*
    * Accumulate values to the appropriate accumulators.
    */
@@ -387,19 +478,53 @@ BasicBlock * EnvBuilder::reduceLiveOutVariables (
     auto envIndex = envIndexInitValue.first;
 
     /*
-     * Fetch the information about the operation to perform to accumulate values.
+     * Fetch the accumulator, which is the PHI node related to the current reduced variable.
      */
-    auto binOp = (Instruction::BinaryOps)reducableBinaryOps[envIndex];
+    auto accumVal = phiNodes[count];
+    auto privateCurrentCopy = loadedValues[count];
 
     /*
-     * Fetch the accumulator, which is the PHI node related to the current reduced variable.
+     * Check if the variable is the index of a min/max.
+     * The partial index is picked if its min/max wins, or if it ties and its index comes first.
      */
-    auto accumVal = phiNodes[count];
+    if (indicesOfMinMax.find(envIndex) != indicesOfMinMax.end()) {
+      auto minMaxEnvIndex = indicesOfMinMax[envIndex].first;
+      auto tiePredicate = indicesOfMinMax[envIndex].second;
+      auto minMaxPredicate = minMaxPredicates[minMaxEnvIndex];
+      auto minMaxAccumVal = phiNodes[positionOfEnvIndex[minMaxEnvIndex]];
+      auto minMaxPrivateCurrentCopy = loadedValues[positionOfEnvIndex[minMaxEnvIndex]];
+
+      auto isNewMinMax = createComparison(loopBodyBuilder, minMaxPredicate, minMaxPrivateCurrentCopy, minMaxAccumVal);
+      auto equalPredicate = CmpInst::isFPPredicate(minMaxPredicate) ? CmpInst::FCMP_OEQ : CmpInst::ICMP_EQ;
+      auto isTie = createComparison(loopBodyBuilder, equalPredicate, minMaxPrivateCurrentCopy, minMaxAccumVal);
+      auto isIndexFirst = createComparison(loopBodyBuilder, tiePredicate, privateCurrentCopy, accumVal);
+      auto isTieWon = loopBodyBuilder.CreateAnd(isTie, isIndexFirst);
+      auto isPicked = loopBodyBuilder.CreateOr(isNewMinMax, isTieWon);
+      envIndexToAccumulatedReducableVar[envIndex] = loopBodyBuilder.CreateSelect(isPicked, privateCurrentCopy, accumVal);
+
+      count++;
+      continue;
+    }
+
+    /*
+     * Check if the variable is a min/max.
+     */
+    if (minMaxPredicates.find(envIndex) != minMaxPredicates.end()) {
+      auto isNewMinMax = createComparison(loopBodyBuilder, minMaxPredicates[envIndex], privateCurrentCopy, accumVal);
+      envIndexToAccumulatedReducableVar[envIndex] = loopBodyBuilder.CreateSelect(isNewMinMax, privateCurrentCopy, accumVal);
+
+      count++;
+      continue;
+    }
+
+    /*
+     * Fetch the information about the operation to perform to accumulate values.
+     */
+    auto binOp = (Instruction::BinaryOps)reducableBinaryOps[envIndex];
 
     /*
      * Accumulate values to the accumulator of the current reduced variable.
      */
-    auto privateCurrentCopy = loadedValues[count];
     auto newAccumulatorValue = loopBodyBuilder.CreateBinOp(binOp, accumVal, privateCurrentCopy);
 
     /*
@@ -452,6 +577,35 @@ BasicBlock * EnvBuilder::reduceLiveOutVariables (
    */
   loopBodyBuilder.CreateCondBr(continueToReduceVariables, loopBodyBB, afterReductionBB);
 
+  /*
+   * Combine the min/max values tracked by indices, and their indices, with their initial values.
+   * Only a min/max that wins against the initial one replaces the initial index.
+   */
+  IRBuilder<> afterReductionBuilder{afterReductionBB};
+  std::unordered_map<int, Value *> isInitialValueReplaced;
+  for (auto envIndexPartialValue : firstPartialValues) {
+    auto envIndex = envIndexPartialValue.first;
+    if (minMaxPredicates.find(envIndex) == minMaxPredicates.end()) continue;
+    isInitialValueReplaced[envIndex] = createComparison(
+      afterReductionBuilder,
+      minMaxPredicates[envIndex],
+      envIndexToAccumulatedReducableVar[envIndex],
+      initialValues[envIndex]
+    );
+  }
+  for (auto envIndexPartialValue : firstPartialValues) {
+    auto envIndex = envIndexPartialValue.first;
+    auto minMaxEnvIndex = envIndex;
+    if (indicesOfMinMax.find(envIndex) != indicesOfMinMax.end()) {
+      minMaxEnvIndex = indicesOfMinMax[envIndex].first;
+    }
+    envIndexToAccumulatedReducableVar[envIndex] = afterReductionBuilder.CreateSelect(
+      isInitialValueReplaced[minMaxEnvIndex],
+      envIndexToAccumulatedReducableVar[envIndex],
+      initialValues[envIndex]
+    );
+  }
+
   return afterReductionBB;
 }
 
@@ -471,6 +625,12 @@ Value *EnvBuilder::getEnvVar (int ind) {
   return (*iter).second;
 }
 
+int EnvBuilder::getEnvVarOffset (int ind) {
+  auto iter = envIndexToOffset.find(ind);
+  assert(iter != envIndexToOffset.end());
+  return (*iter).second;
+}
+
 Value *EnvBuilder::getAccumulatedReducableEnvVar (int ind) {
   auto iter = envIndexToAccumulatedReducableVar.find(ind);
   assert(iter != envIndexToAccumulatedReducableVar.end());
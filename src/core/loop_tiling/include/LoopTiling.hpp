@@ -0,0 +1,57 @@
+/*
+ * Copyright 2019 - 2020  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+
+#include "SystemHeaders.hpp"
+#include "LoopDependenceInfo.hpp"
+#include "PerfectLoopNest.hpp"
+#include "SCC.hpp"
+
+namespace llvm::noelle {
+
+  class LoopTiling {
+    public:
+
+      /*
+       * Constructor
+       */
+      LoopTiling ();
+
+      /*
+       * Tile the inner loop of the perfect loop nest rooted at the loop given as input so that the data accessed by a tile fits in a cache of the given size.
+       *
+       * The loop that iterates over tiles becomes the outermost loop of the nest.
+       * Hence, a parallelization technique applied to the nest distributes tiles among cores.
+       */
+      bool tileLoopNest (
+        LoopDependenceInfo const &LDI,
+        LoopInfo &LI,
+        ScalarEvolution &SE,
+        uint64_t cacheBytes,
+        uint32_t cacheLineBytes
+        );
+
+    private:
+
+      /*
+       * Methods
+       */
+      uint64_t computeTileSize (
+        LoopDependenceInfo const &LDI,
+        PerfectLoopNest &nest,
+        uint64_t innerTripCount,
+        uint64_t cacheBytes,
+        uint32_t cacheLineBytes
+        ) const ;
+
+  };
+
+}
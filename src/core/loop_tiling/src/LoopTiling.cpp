@@ -0,0 +1,304 @@
+/*
+ * Copyright 2019 - 2020  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "LoopTiling.hpp"
+#include "ScalarEvolutionExpander.h"
+
+using namespace llvm;
+using namespace llvm::noelle;
+
+bool LoopTiling::tileLoopNest (
+  LoopDependenceInfo const &LDI,
+  LoopInfo &LI,
+  ScalarEvolution &SE,
+  uint64_t cacheBytes,
+  uint32_t cacheLineBytes
+  ){
+
+  /*
+   * Check the shape of the nest.
+   * The iteration space of the inner loop must not depend on the outer loop.
+   * Also, we only tile the innermost loop of a program.
+   */
+  PerfectLoopNest nest(LDI);
+  if (  false
+        || (!nest.isPerfectlyNested())
+        || (!nest.isInnerIterationSpaceInvariant())
+        || (nest.getInnerLoop()->getChildren().size() > 0)
+     ){
+    return false;
+  }
+  auto outerLoop = nest.getOuterLoop();
+  auto innerLoop = nest.getInnerLoop();
+  auto outerAttr = nest.getOuterLoopGoverningIVAttribution();
+  auto innerAttr = nest.getInnerLoopGoverningIVAttribution();
+  auto outerPreheader = outerLoop->getPreHeader();
+  auto outerHeader = outerLoop->getHeader();
+  auto innerPreheader = innerLoop->getPreHeader();
+  auto innerHeader = innerLoop->getHeader();
+
+  /*
+   * Compute the number of iterations of the inner loop.
+   */
+  auto outerLLVMLoop = LI.getLoopFor(outerHeader);
+  auto innerLLVMLoop = LI.getLoopFor(innerHeader);
+  if (  false
+        || (outerLLVMLoop == nullptr)
+        || (innerLLVMLoop == nullptr)
+        || (innerLLVMLoop->getParentLoop() != outerLLVMLoop)
+     ){
+    return false;
+  }
+  auto innerTripCountSCEV = SE.getBackedgeTakenCount(innerLLVMLoop);
+  if (  false
+        || isa<SCEVCouldNotCompute>(innerTripCountSCEV)
+        || (!SE.isLoopInvariant(innerTripCountSCEV, outerLLVMLoop))
+        || (SE.getUnsignedRangeMax(innerTripCountSCEV).getActiveBits() >= 63)
+     ){
+    return false;
+  }
+  auto innerMaxTripCount = std::numeric_limits<uint64_t>::max();
+  if (auto innerTripCountConstant = dyn_cast<SCEVConstant>(innerTripCountSCEV)){
+    innerMaxTripCount = innerTripCountConstant->getValue()->getZExtValue();
+  }
+
+  /*
+   * Check if tiling improves the locality of the memory accesses and compute the size of the tiles.
+   */
+  auto tileSize = this->computeTileSize(LDI, nest, innerMaxTripCount, cacheBytes, cacheLineBytes);
+  if (tileSize == 0){
+    return false;
+  }
+  errs() << "LoopTiling:   Tile the loop nest rooted at " << *outerHeader->getFirstNonPHI() << " with tiles of " << tileSize << " iterations\n";
+
+  /*
+   * Fetch the types and the constants we need.
+   */
+  auto &cxt = outerHeader->getContext();
+  auto F = outerHeader->getParent();
+  auto int64Type = IntegerType::get(cxt, 64);
+  auto &innerIV = innerAttr->getInductionVariable();
+  auto innerPHI = innerIV.getLoopEntryPHI();
+  auto innerType = innerPHI->getType();
+  auto innerStep = cast<ConstantInt>(innerIV.getSingleComputedStepValue());
+  auto innerStartValue = innerPHI->getIncomingValueForBlock(innerPreheader);
+  auto outerExit = outerAttr->getExitBlockFromHeader();
+  auto outerBr = outerAttr->getHeaderBrInst();
+  auto innerExit = innerAttr->getExitBlockFromHeader();
+  auto innerBr = innerAttr->getHeaderBrInst();
+  auto innerCmp = innerAttr->getHeaderCmpInst();
+
+  /*
+   * Compute the number of iterations of the inner loop in the preheader of the outer loop.
+   */
+  SCEVExpander expander(SE, F->getParent()->getDataLayout(), "tiling");
+  auto innerTripCount = expander.expandCodeFor(SE.getTruncateOrZeroExtend(innerTripCountSCEV, int64Type), int64Type, outerPreheader->getTerminator());
+
+  /*
+   * If the number of iterations is unknown at compile time, then cap the size of the tiles at run time so there is at least one tile per core.
+   */
+  Value *tileSizeValue = ConstantInt::get(int64Type, tileSize);
+  if (innerMaxTripCount == std::numeric_limits<uint64_t>::max()){
+    IRBuilder<> outerPreheaderBuilder(outerPreheader->getTerminator());
+    auto coresValue = ConstantInt::get(int64Type, LDI.getMaximumNumberOfCores());
+    auto tileSizeForAllCores = outerPreheaderBuilder.CreateUDiv(innerTripCount, coresValue);
+    auto isTileSizeTooSmall = outerPreheaderBuilder.CreateICmpULT(tileSizeForAllCores, ConstantInt::get(int64Type, 1));
+    tileSizeForAllCores = outerPreheaderBuilder.CreateSelect(isTileSizeTooSmall, ConstantInt::get(int64Type, 1), tileSizeForAllCores);
+    auto isTileTooBig = outerPreheaderBuilder.CreateICmpULT(tileSizeForAllCores, tileSizeValue);
+    tileSizeValue = outerPreheaderBuilder.CreateSelect(isTileTooBig, tileSizeForAllCores, tileSizeValue, "tile.size");
+  }
+
+  /*
+   * Create the loop that iterates over tiles.
+   * Its header checks whether there is another tile to execute, and its body computes where the current tile ends.
+   */
+  auto tileHeader = BasicBlock::Create(cxt, "tile.header", F, outerHeader);
+  auto tileBody = BasicBlock::Create(cxt, "tile.body", F, outerHeader);
+  auto tileLatch = BasicBlock::Create(cxt, "tile.latch", F, outerHeader);
+  IRBuilder<> tileHeaderBuilder(tileHeader);
+  auto tileStart = tileHeaderBuilder.CreatePHI(int64Type, 2, "tile.start");
+  tileStart->addIncoming(ConstantInt::get(int64Type, 0), outerPreheader);
+  auto isThereAnotherTile = tileHeaderBuilder.CreateICmpULT(tileStart, innerTripCount);
+  tileHeaderBuilder.CreateCondBr(isThereAnotherTile, tileBody, outerExit);
+  IRBuilder<> tileBodyBuilder(tileBody);
+  auto nextTileStart = tileBodyBuilder.CreateAdd(tileStart, tileSizeValue, "", true, false);
+  auto isTheLastTile = tileBodyBuilder.CreateICmpUGE(nextTileStart, innerTripCount);
+  auto tileEnd = tileBodyBuilder.CreateSelect(isTheLastTile, innerTripCount, nextTileStart, "tile.end");
+  tileBodyBuilder.CreateBr(outerHeader);
+  IRBuilder<> tileLatchBuilder(tileLatch);
+  auto tileNext = tileLatchBuilder.CreateAdd(tileStart, tileSizeValue, "tile.next", true, false);
+  tileLatchBuilder.CreateBr(tileHeader);
+  tileStart->addIncoming(tileNext, tileLatch);
+
+  /*
+   * Wrap the outer loop within the loop of tiles.
+   */
+  outerPreheader->getTerminator()->replaceUsesOfWith(outerHeader, tileHeader);
+  for (auto &phi : outerHeader->phis()){
+    for (auto i = 0u; i < phi.getNumIncomingValues(); i++){
+      if (phi.getIncomingBlock(i) == outerPreheader){
+        phi.setIncomingBlock(i, tileBody);
+      }
+    }
+  }
+  for (auto i = 0u; i < outerBr->getNumSuccessors(); i++){
+    if (outerBr->getSuccessor(i) == outerExit){
+      outerBr->setSuccessor(i, tileLatch);
+    }
+  }
+  for (auto &phi : outerExit->phis()){
+    for (auto i = 0u; i < phi.getNumIncomingValues(); i++){
+      if (phi.getIncomingBlock(i) == outerHeader){
+        phi.setIncomingBlock(i, tileHeader);
+      }
+    }
+  }
+
+  /*
+   * The inner loop now only executes the iterations of the current tile.
+   *
+   * Start the inner induction variable from the first iteration of the tile.
+   */
+  IRBuilder<> innerPreheaderBuilder(innerPreheader->getTerminator());
+  auto innerOffset = innerPreheaderBuilder.CreateMul(innerPreheaderBuilder.CreateZExtOrTrunc(tileStart, innerType), ConstantInt::get(innerType, innerStep->getSExtValue()));
+  auto innerTileStartValue = innerPreheaderBuilder.CreateAdd(innerStartValue, innerOffset);
+  innerPHI->setIncomingValue(innerPHI->getBasicBlockIndex(innerPreheader), innerTileStartValue);
+
+  /*
+   * Exit the inner loop at the end of the tile.
+   */
+  IRBuilder<> innerPHIBuilder(innerHeader->getFirstNonPHI());
+  auto tileIteration = innerPHIBuilder.CreatePHI(int64Type, 2, "tile.iteration");
+  tileIteration->addIncoming(tileStart, innerPreheader);
+  IRBuilder<> innerBrBuilder(innerBr);
+  auto tileIterationNext = innerBrBuilder.CreateAdd(tileIteration, ConstantInt::get(int64Type, 1), "tile.iteration.next", true, false);
+  for (auto latch : innerLoop->getLatches()){
+    tileIteration->addIncoming(tileIterationNext, latch);
+  }
+  auto newInnerCmp = (innerBr->getSuccessor(0) == innerExit)
+    ? innerBrBuilder.CreateICmpUGE(tileIteration, tileEnd)
+    : innerBrBuilder.CreateICmpULT(tileIteration, tileEnd);
+  innerBr->setCondition(newInnerCmp);
+  innerCmp->eraseFromParent();
+
+  return true;
+}
+
+uint64_t LoopTiling::computeTileSize (
+  LoopDependenceInfo const &LDI,
+  PerfectLoopNest &nest,
+  uint64_t innerTripCount,
+  uint64_t cacheBytes,
+  uint32_t cacheLineBytes
+  ) const {
+
+  /*
+   * Fetch the information about the memory accessed by the nest.
+   */
+  auto domainSpaceAnalysis = LDI.getLoopIterationDomainSpaceAnalysis();
+  auto outerIV = &nest.getOuterLoopGoverningIVAttribution()->getInductionVariable();
+  auto innerIV = &nest.getInnerLoopGoverningIVAttribution()->getInductionVariable();
+  auto innerLoop = nest.getInnerLoop();
+  auto &DL = innerLoop->getFunction()->getParent()->getDataLayout();
+
+  /*
+   * Estimate the bytes accessed by an iteration of the inner loop.
+   *
+   * There are two kinds of accesses that tiling improves:
+   * 1) accesses whose contiguous dimension is driven by the outer loop (e.g., B[j][i]).
+   *    Each iteration of the inner loop touches a different cache line, which can be reused by the next iterations of the outer loop only if the lines of a tile stay in the cache.
+   * 2) accesses that do not depend on the outer loop (e.g., x[j]).
+   *    They are reused by every iteration of the outer loop, which is only effective if the data accessed by the inner loop fits in the cache.
+   */
+  uint64_t bytesPerInnerIteration = 0;
+  auto hasAccessesAcrossContiguousDimension = false;
+  auto hasAccessesReusedByOuterLoop = false;
+  for (auto inst : innerLoop->getInstructions()){
+    Type *accessedType = nullptr;
+    if (auto load = dyn_cast<LoadInst>(inst)){
+      accessedType = load->getType();
+    } else if (auto store = dyn_cast<StoreInst>(inst)){
+      accessedType = store->getValueOperand()->getType();
+    } else {
+      continue ;
+    }
+    auto accessedBytes = DL.getTypeStoreSize(accessedType);
+
+    /*
+     * Fetch the induction variables that drive the dimensions of the memory accessed.
+     */
+    std::vector<InductionVariable *> dimensionIVs;
+    if (!domainSpaceAnalysis->getInductionVariablesOfMemoryAccessDimensions(inst, dimensionIVs)){
+      bytesPerInnerIteration += accessedBytes;
+      continue ;
+    }
+    auto isDrivenByOuterLoop = std::find(dimensionIVs.begin(), dimensionIVs.end(), outerIV) != dimensionIVs.end();
+    auto isDrivenByInnerLoop = std::find(dimensionIVs.begin(), dimensionIVs.end(), innerIV) != dimensionIVs.end();
+    if (!isDrivenByInnerLoop){
+      continue ;
+    }
+    if (dimensionIVs.back() == outerIV){
+      hasAccessesAcrossContiguousDimension = true;
+      bytesPerInnerIteration += cacheLineBytes;
+      continue ;
+    }
+    if (!isDrivenByOuterLoop){
+      hasAccessesReusedByOuterLoop = true;
+    }
+    bytesPerInnerIteration += accessedBytes;
+  }
+  if (bytesPerInnerIteration == 0){
+    return 0;
+  }
+
+  /*
+   * Check if the data accessed by the whole inner loop already fits in the cache.
+   */
+  auto doesInnerLoopFitInCache = (innerTripCount <= (cacheBytes / bytesPerInnerIteration));
+  if (  true
+        && (!hasAccessesAcrossContiguousDimension)
+        && (!hasAccessesReusedByOuterLoop || doesInnerLoopFitInCache)
+     ){
+    return 0;
+  }
+
+  /*
+   * Use half of the cache for the data of a tile to leave room for the data that is only streamed through.
+   * Round the tile size down to a power of two.
+   */
+  auto maxTileSize = (cacheBytes / 2) / bytesPerInnerIteration;
+  if (maxTileSize < 2){
+    return 0;
+  }
+  uint64_t tileSize = 1;
+  while ((tileSize * 2) <= maxTileSize){
+    tileSize *= 2;
+  }
+  if (tileSize >= innerTripCount){
+    return 0;
+  }
+
+  /*
+   * The loop of tiles is the one that gets parallelized.
+   * Hence, shrink the tiles until there is at least one per core.
+   * When the number of iterations of the inner loop is unknown at compile time, the tiles are shrunk at run time instead (see tileLoopNest).
+   */
+  if (innerTripCount != std::numeric_limits<uint64_t>::max()){
+    auto maxTileSizeForAllCores = innerTripCount / LDI.getMaximumNumberOfCores();
+    while (tileSize > maxTileSizeForAllCores){
+      tileSize /= 2;
+    }
+    if (tileSize < 2){
+      return 0;
+    }
+  }
+
+  return tileSize;
+}
@@ -29,6 +29,14 @@ namespace llvm::noelle {
       bool isSubOp (unsigned op);
       unsigned accumOpForType (unsigned op, Type *type);
       Value *generateIdentityFor (Instruction *accumulator, Type *castType);
+
+      /*
+       * Min/max reductions are described by the predicate P that selects a new value x over the current one (i.e., P(x, current))
+       */
+      static bool isMinMaxPredicate (CmpInst::Predicate predicate);
+      static bool isStrictMinMaxPredicate (CmpInst::Predicate predicate);
+      static CmpInst::Predicate getMinMaxPredicateOfIntrinsic (CallInst *call);
+      Value *generateIdentityForMinMax (CmpInst::Predicate predicate, Type *castType);
   };
 
 }
@@ -63,6 +63,12 @@ namespace llvm::noelle {
 
       LoopGoverningIVAttribution * getLoopGoverningIVAttribution (LoopStructure &LS) const ;
 
+      /*
+       * Return the attribution of the IV that governs @LS when other conditional branches can leave @LS earlier (e.g., search loops).
+       * These loops are not returned by getLoopGoverningIVAttribution.
+       */
+      LoopGoverningIVAttribution * getLoopGoverningIVAttributionOfLoopWithEarlyExits (LoopStructure &LS) const ;
+
       InductionVariable * getDerivingInductionVariable (LoopStructure &LS, Instruction *derivedInstruction) const ;
 
       ~InductionVariableManager ();
@@ -71,6 +77,7 @@ namespace llvm::noelle {
       LoopsSummary &LIS;
       std::unordered_map<LoopStructure *, std::unordered_set<InductionVariable *>> loopToIVsMap;
       std::unordered_map<LoopStructure *, LoopGoverningIVAttribution *> loopToGoverningIVAttrMap;
+      std::unordered_map<LoopStructure *, LoopGoverningIVAttribution *> loopToEarlyExitingGoverningIVAttrMap;
   };
 
   class InductionVariable {
@@ -176,6 +176,8 @@ namespace llvm::noelle {
 
       uint32_t getMaximumNumberOfCores (void) const ;
 
+      void setMaximumNumberOfCores (uint32_t cores) ;
+
       /*
        * Deconstructor.
        */
@@ -244,6 +246,8 @@ namespace llvm::noelle {
         DominatorSummary &DS
       ) ;
 
+      void addLiveOutsNeededToReduceIndicesOfMinMax (void) ;
+
   };
 
 }
@@ -38,6 +38,13 @@ namespace llvm::noelle {
 
       Instruction *getIntermediateValueUsedInCompare () ;
 
+      /*
+       * Early exits are conditional branches of the SCC of the IV, other than the one of the header, that leave the loop.
+       */
+      bool hasEarlyExits (void) const ;
+
+      std::set<BranchInst *> getEarlyExitBranches (void) const ;
+
     private:
       InductionVariable &IV;
       SCC &scc;
@@ -47,6 +54,7 @@ namespace llvm::noelle {
       CmpInst *headerCmp;
       BranchInst *headerBr;
       BasicBlock *exitBlock;
+      std::set<BranchInst *> earlyExitBranches;
       bool isWellFormed;
   };
 
@@ -44,6 +44,28 @@ namespace llvm::noelle {
         Instruction *to
       ) const ;
 
+      /*
+       * Describe the memory accessed by an instruction at the iteration i of the loop as base + offset + (stride * i),
+       * where base is a loop-invariant pointer.
+       * Return false if the instruction does not access memory this way.
+       */
+      bool getLinearMemoryAccessAcrossIterations (
+        Instruction *I,
+        Value *&base,
+        int64_t &offset,
+        int64_t &stride
+      ) const ;
+
+      /*
+       * Fetch the induction variable that drives each dimension of the memory accessed by an instruction, from the outermost dimension to the innermost one.
+       * Dimensions that do not evolve with an induction variable are associated with nullptr.
+       * Return false if the memory accessed by the instruction has not been delinearized.
+       */
+      bool getInductionVariablesOfMemoryAccessDimensions (
+        Instruction *I,
+        std::vector<InductionVariable *> &dimensionIVs
+      ) const ;
+
     private:
 
       /*
@@ -88,6 +110,13 @@ namespace llvm::noelle {
          */
         SmallVector<std::pair<Instruction *, InductionVariable *>, 4> subscriptIVs;
 
+        /*
+         * For accesses that evolve linearly in the top-most loop, track base + offset + (stride * iteration)
+         */
+        Value *linearBase;
+        int64_t linearOffset;
+        int64_t linearStride;
+
       };
 
       /*
@@ -99,6 +128,7 @@ namespace llvm::noelle {
 
       void computeMemoryAccessSpace (ScalarEvolution &SE) ;
       void identifyIVForMemoryAccessSubscripts (ScalarEvolution &SE) ;
+      void identifyLinearAccessesAcrossIterations (ScalarEvolution &SE) ;
 
       /*
        * Cache memory access spaces with certain properties
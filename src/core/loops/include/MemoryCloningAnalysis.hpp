@@ -38,13 +38,23 @@ namespace llvm::noelle {
   class ClonableMemoryLocation {
     public:
       ClonableMemoryLocation (
-        AllocaInst *allocation,
+        Value *allocation,
+        Type *allocatedType,
         uint64_t sizeInBits,
         LoopStructure *loop,
         DominatorSummary &DS
       ) ;
 
-      AllocaInst *getAllocation (void) const ;
+      /*
+       * The allocation is either an AllocaInst, a call to a heap allocator, or a global variable.
+       */
+      Value *getAllocation (void) const ;
+
+      uint64_t getSizeInBits (void) const ;
+
+      bool isStackAllocation (void) const ;
+      bool isHeapAllocation (void) const ;
+      bool isGlobalVariable (void) const ;
 
       std::unordered_set<Instruction *> getLoopInstructionsUsingLocation (void) const ;
 
@@ -56,8 +66,17 @@ namespace llvm::noelle {
 
       static bool isMemCpyInstrinsicCall (CallInst *call) ;
 
+      static bool isMemSetInstrinsicCall (CallInst *call) ;
+
+      /*
+       * Return the number of bytes allocated by a call to malloc or calloc with constant arguments, 0 otherwise.
+       */
+      static uint64_t getHeapAllocationSizeInBytes (CallInst *call) ;
+
+      static bool isHeapDeallocationCall (CallInst *call) ;
+
     private:
-      AllocaInst *allocation;
+      Value *allocation;
       Type *allocatedType;
       uint64_t sizeInBits;
       LoopStructure *loop;
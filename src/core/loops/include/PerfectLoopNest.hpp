@@ -0,0 +1,67 @@
+/*
+ * Copyright 2019 - 2020  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+
+#include "SystemHeaders.hpp"
+#include "LoopDependenceInfo.hpp"
+
+namespace llvm::noelle {
+
+  /*
+   * A loop with a single sub-loop such that the outer loop only contains the sub-loop and the code to evolve its governing induction variable.
+   * Both loops are governed by induction variables that evolve by constant steps and that are only used within the nest.
+   */
+  class PerfectLoopNest {
+    public:
+      PerfectLoopNest (LoopDependenceInfo const &LDI) ;
+
+      PerfectLoopNest () = delete ;
+
+      bool isPerfectlyNested (void) const ;
+
+      /*
+       * Return true if the start value and the exit condition of the inner loop do not depend on the outer loop.
+       */
+      bool isInnerIterationSpaceInvariant (void) const ;
+
+      LoopStructure * getOuterLoop (void) const ;
+
+      LoopStructure * getInnerLoop (void) const ;
+
+      LoopGoverningIVAttribution * getOuterLoopGoverningIVAttribution (void) const ;
+
+      LoopGoverningIVAttribution * getInnerLoopGoverningIVAttribution (void) const ;
+
+      /*
+       * Return the basic blocks of the outer loop that are executed after the inner loop exits (e.g., the latch of the outer loop).
+       */
+      std::vector<BasicBlock *> getBasicBlocksBetweenInnerAndOuterLatches (void) const ;
+
+    private:
+      LoopStructure *outerLoop;
+      LoopStructure *innerLoop;
+      LoopGoverningIVAttribution *outerAttr;
+      LoopGoverningIVAttribution *innerAttr;
+      bool isPerfect;
+
+      bool checkIfPerfectlyNested (void) const ;
+
+      bool isHeaderOnlyEvolvingTheIV (
+        LoopStructure *loop,
+        LoopGoverningIVAttribution *attr
+      ) const ;
+
+      bool isIVOnlyUsedWithinTheNest (LoopGoverningIVAttribution *attr) const ;
+
+      bool isInvariantOfTheNest (Value *value) const ;
+  };
+
+}
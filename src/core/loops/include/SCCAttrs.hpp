@@ -95,7 +95,7 @@ namespace llvm::noelle {
       bool canBeCloned (void) const ;
 
       /*
-       * Return true if cloning is possible through memory AllocaInst cloning
+       * Return true if cloning is possible through cloning memory locations (stack, heap, or global)
        */
       bool canBeClonedUsingLocalMemoryLocations (void) const;
 
@@ -160,6 +160,13 @@ namespace llvm::noelle {
        */
       void addLoopCarriedVariable (LoopCarriedVariable *variable) ;
 
+      /*
+       * If only one loop carried memory location (e.g., a histogram) is contained, return that memory location
+       */
+      LoopCarriedMemoryLocation * getSingleLoopCarriedMemoryLocation (void) const ;
+
+      void addLoopCarriedMemoryLocation (LoopCarriedMemoryLocation *memoryLocation) ;
+
       /*
        * Set the type of SCC.
        */
@@ -183,7 +190,7 @@ namespace llvm::noelle {
 
       void addClonableMemoryLocationsContainedInSCC (std::unordered_set<const ClonableMemoryLocation *> locations) ;
 
-      std::unordered_set<AllocaInst *> getMemoryLocationsToClone (void) const ;
+      std::unordered_set<Value *> getMemoryLocationsToClone (void) const ;
 
     private:
       SCC *scc;
@@ -195,6 +202,7 @@ namespace llvm::noelle {
       std::set<Instruction *> accumulators;
       std::set<PHINode *> headerPHINodes;
       std::unordered_set<LoopCarriedVariable *> loopCarriedVariables;
+      std::unordered_set<LoopCarriedMemoryLocation *> loopCarriedMemoryLocations;
 
       std::unordered_set<const ClonableMemoryLocation *> clonableMemoryLocations;
       bool isSCCClonableIntoLocalMemory;
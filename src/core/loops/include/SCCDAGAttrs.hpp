@@ -106,6 +106,12 @@
         SCCDAG *sccdag;     /* SCCDAG of the related loop.  */
         MemoryCloningAnalysis *memoryCloningAnalysis;
 
+        /*
+         * Variables that select an external value (e.g., the index of argmin/argmax)
+         * They can be reduced only together with the min/max reduction that drives their selection
+         */
+        std::unordered_map<SCC *, LoopCarriedVariable *> selectionVariableCandidates;
+
         /*
          * Helper methods on SCCDAG
          */
@@ -116,6 +122,14 @@
          * Helper methods on single SCC
          */
         bool checkIfReducible (SCC *scc, LoopsSummary &LIS);
+        bool checkIfMemoryLocationIsReducible (SCC *scc, LoopsSummary &LIS);
+        void checkIfIndicesOfMinMaxAreReducible (LoopsSummary &LIS, std::set<InductionVariable *> &IVs);
+        CmpInst::Predicate getTiePredicateOfIndex (
+          LoopsSummary &LIS,
+          LoopCarriedVariable *minMaxVariable,
+          LoopCarriedVariable *indexVariable,
+          std::set<InductionVariable *> &IVs
+        );
         bool checkIfIndependent (SCC *scc);
         bool checkIfSCCOnlyContainsInductionVariables (
           SCC *scc,
@@ -35,12 +35,13 @@ namespace llvm::noelle {
 
   };
 
+  /*
+   * A LoopCarriedMemoryLocation is an array of statically known size (e.g., a histogram)
+   * that evolves only through commutative and associative updates of its elements (e.g., a[idx[i]] += x)
+   */
   class LoopCarriedMemoryLocation : public LoopCarriedCycle {
     public:
 
-      /*
-       * TODO: Implement
-       */
       LoopCarriedMemoryLocation (
         const LoopStructure &loop,
         PDG &loopDG,
@@ -50,10 +51,46 @@ namespace llvm::noelle {
 
       LoopCarriedMemoryLocation () = delete ;
 
+      ~LoopCarriedMemoryLocation () ;
+
+      bool isEvolutionReducibleAcrossLoopIterations (void) const override ;
+
       /*
-       * TODO: Implement
+       * The allocation of the array: an AllocaInst, a call to a heap allocator, or a global variable.
        */
-      bool isEvolutionReducibleAcrossLoopIterations (void) const override ;
+      Value *getMemoryLocation (void) const ;
+
+      Type *getElementType (void) const ;
+
+      uint64_t getNumberOfElements (void) const ;
+
+      /*
+       * Loop invariant pointers to the beginning of the array used within the loop to access its elements
+       */
+      std::unordered_set<Value *> getPointersToMemoryLocation (void) const ;
+
+      /*
+       * The operator that combines partial values of an element (e.g., Add for both additions and subtractions)
+       */
+      unsigned getReducingOperator (void) const ;
+
+    private:
+
+      bool isValid;
+
+      Value *memoryLocation;
+
+      Type *elementType;
+
+      uint64_t numberOfElements;
+
+      unsigned reducingOperator;
+
+      std::unordered_set<Value *> pointersToMemoryLocation;
+
+      std::unordered_set<EvolutionUpdate *> memoryLocationUpdates;
+
+      bool computeNumberOfElements (const DataLayout &DL, uint64_t elementSize) ;
 
   };
 
@@ -76,8 +113,60 @@ namespace llvm::noelle {
 
       PHINode *getLoopEntryPHIForValueOfVariable (Value *value) const ;
 
+      /*
+       * Min/max reductions (e.g., m = x > m ? x : m, or m = llvm.maxnum(x, m))
+       * The predicate P is such that each update sets the variable to x when P(x, m) holds
+       * BAD_ICMP_PREDICATE is returned if the variable is not a min/max reduction
+       */
+      CmpInst::Predicate getMinMaxPredicate (void) const ;
+
+      /*
+       * The select or intrinsic call that updates a min/max reduction
+       */
+      Instruction *getMinMaxUpdate (void) const ;
+
+      /*
+       * The comparison that drives the select of a min/max reduction (nullptr for intrinsics)
+       */
+      CmpInst *getMinMaxComparison (void) const ;
+
+      /*
+       * Variables that select a new value using the comparison of a min/max reduction
+       * (e.g., the index of argmin/argmax: idx = x > m ? i : idx)
+       */
+      std::unordered_set<SelectInst *> getSelectsTrackingMinMax (void) const ;
+
+      /*
+       * A variable whose only update selects an external value when an external comparison holds
+       * These can be reduced only together with the min/max reduction that owns the comparison
+       */
+      SelectInst *getSelectionUpdate (void) const ;
+      CmpInst *getSelectingComparison (void) const ;
+      Value *getSelectedValue (void) const ;
+
+      /*
+       * Whether the select picks the new value when its condition is true
+       */
+      bool isNewValueSelectedWhenConditionHolds (void) const ;
+
+      /*
+       * Mark this variable as the index of the min/max reduction provided
+       * Ties across partial results are broken by picking the index that satisfies tiePredicate(index, other)
+       */
+      void setAsIndexOfMinMax (LoopCarriedVariable *minMaxVariable, CmpInst::Predicate tiePredicate) ;
+
+      LoopCarriedVariable *getMinMaxVariableOfIndex (void) const ;
+
+      CmpInst::Predicate getIndexTiePredicate (void) const ;
+
     private:
 
+      void identifyMinMaxReduction (void) ;
+
+      void identifySelectionOfExternalValue (void) ;
+
+      bool isEvolutionOfMinMaxReducible (void) const ;
+
       PDG *produceDataAndMemoryOnlyDGFromVariableDG (PDG &variableDG) const ;
 
       std::unordered_set<Value *> getConsumersOfVariable (void) const ;
@@ -141,6 +230,25 @@ namespace llvm::noelle {
        */
       std::unordered_set<CastInst *> castsInternalToVariableComputation;
 
+      /*
+       * Min/max reduction: P(x, m), the update, its comparison, and the selects of other variables driven by it
+       */
+      CmpInst::Predicate minMaxPredicate;
+      Instruction *minMaxUpdate;
+      CmpInst *minMaxComparison;
+      std::unordered_set<SelectInst *> selectsTrackingMinMax;
+
+      /*
+       * Selection of an external value driven by an external comparison (e.g., the index of argmin/argmax)
+       */
+      SelectInst *selectionUpdate;
+      CmpInst *selectingComparison;
+      Value *selectedValue;
+      bool isNewValueSelectedWhenTrue;
+
+      LoopCarriedVariable *minMaxVariableOfIndex;
+      CmpInst::Predicate indexTiePredicate;
+
   };
 
   /*
@@ -22,7 +22,8 @@ AccumulatorOpInfo::AccumulatorOpInfo () {
     Instruction::Sub,
     Instruction::FSub,
     Instruction::Or,
-    Instruction::And
+    Instruction::And,
+    Instruction::Xor
   };
 
   this->accumOps = std::set<unsigned>(sideEffectFreeOps.begin(), sideEffectFreeOps.end());
@@ -35,7 +36,8 @@ AccumulatorOpInfo::AccumulatorOpInfo () {
     { Instruction::Sub, 0 },
     { Instruction::FSub, 0 },
     { Instruction::Or, 0 },
-    { Instruction::And, 1 }
+    { Instruction::And, 1 },
+    { Instruction::Xor, 0 }
   };
 
   this->integerReducingOperators = {
@@ -46,7 +48,8 @@ AccumulatorOpInfo::AccumulatorOpInfo () {
     { Instruction::Sub, Instruction::Add },
     { Instruction::FSub, Instruction::Add },
     { Instruction::Or, Instruction::Or },
-    { Instruction::And, Instruction::And }
+    { Instruction::And, Instruction::And },
+    { Instruction::Xor, Instruction::Xor }
   };
 
   this->floatingReducingOperators = {
@@ -91,6 +94,17 @@ unsigned AccumulatorOpInfo::accumOpForType (unsigned op, Type *type) {
 
 Value *AccumulatorOpInfo::generateIdentityFor (Instruction *accumulator, Type *castType) {
   Value *initVal = nullptr;
+
+  /*
+   * The identity of a bitwise and has all bits set, whatever the width of the integer
+   */
+  if (  true
+        && accumulator->getOpcode() == Instruction::And
+        && castType->isIntegerTy()
+    ){
+    return Constant::getAllOnesValue(castType);
+  }
+
   auto opIdentity = this->opIdentities[accumulator->getOpcode()];
   if (castType->isIntegerTy()) initVal = ConstantInt::get(castType, opIdentity);
   if (castType->isFloatTy()) initVal = ConstantFP::get(castType, (float)opIdentity);
@@ -98,3 +112,106 @@ Value *AccumulatorOpInfo::generateIdentityFor (Instruction *accumulator, Type *c
   assert(initVal != nullptr);
   return initVal;
 }
+
+bool AccumulatorOpInfo::isMinMaxPredicate (CmpInst::Predicate predicate) {
+  switch (predicate) {
+    case CmpInst::ICMP_SGT:
+    case CmpInst::ICMP_SGE:
+    case CmpInst::ICMP_SLT:
+    case CmpInst::ICMP_SLE:
+    case CmpInst::ICMP_UGT:
+    case CmpInst::ICMP_UGE:
+    case CmpInst::ICMP_ULT:
+    case CmpInst::ICMP_ULE:
+    case CmpInst::FCMP_OGT:
+    case CmpInst::FCMP_OGE:
+    case CmpInst::FCMP_OLT:
+    case CmpInst::FCMP_OLE:
+    case CmpInst::FCMP_UGT:
+    case CmpInst::FCMP_UGE:
+    case CmpInst::FCMP_ULT:
+    case CmpInst::FCMP_ULE:
+      return true;
+    default:
+      return false;
+  }
+}
+
+bool AccumulatorOpInfo::isStrictMinMaxPredicate (CmpInst::Predicate predicate) {
+  switch (predicate) {
+    case CmpInst::ICMP_SGT:
+    case CmpInst::ICMP_SLT:
+    case CmpInst::ICMP_UGT:
+    case CmpInst::ICMP_ULT:
+    case CmpInst::FCMP_OGT:
+    case CmpInst::FCMP_OLT:
+    case CmpInst::FCMP_UGT:
+    case CmpInst::FCMP_ULT:
+      return true;
+    default:
+      return false;
+  }
+}
+
+CmpInst::Predicate AccumulatorOpInfo::getMinMaxPredicateOfIntrinsic (CallInst *call) {
+  auto callee = call->getCalledFunction();
+  if (  false
+        || callee == nullptr
+        || !callee->isIntrinsic()
+    ){
+    return CmpInst::BAD_ICMP_PREDICATE;
+  }
+
+  /*
+   * Floating point min/max intrinsics never return NaN unless both operands are NaN
+   */
+  switch (callee->getIntrinsicID()) {
+    case Intrinsic::maxnum:
+      return CmpInst::FCMP_OGT;
+    case Intrinsic::minnum:
+      return CmpInst::FCMP_OLT;
+    default:
+      break;
+  }
+
+  /*
+   * Integer min/max intrinsics are identified by name as not all LLVM versions we support define them
+   */
+  auto name = callee->getName();
+  if (name.startswith("llvm.smax.")) return CmpInst::ICMP_SGT;
+  if (name.startswith("llvm.smin.")) return CmpInst::ICMP_SLT;
+  if (name.startswith("llvm.umax.")) return CmpInst::ICMP_UGT;
+  if (name.startswith("llvm.umin.")) return CmpInst::ICMP_ULT;
+
+  return CmpInst::BAD_ICMP_PREDICATE;
+}
+
+Value *AccumulatorOpInfo::generateIdentityForMinMax (CmpInst::Predicate predicate, Type *castType) {
+  assert(isMinMaxPredicate(predicate));
+
+  /*
+   * A running maximum starts from the smallest value of the type and a running minimum from the largest one
+   */
+  auto isMax = false
+    || predicate == CmpInst::ICMP_SGT
+    || predicate == CmpInst::ICMP_SGE
+    || predicate == CmpInst::ICMP_UGT
+    || predicate == CmpInst::ICMP_UGE
+    || predicate == CmpInst::FCMP_OGT
+    || predicate == CmpInst::FCMP_OGE
+    || predicate == CmpInst::FCMP_UGT
+    || predicate == CmpInst::FCMP_UGE;
+
+  if (auto intType = dyn_cast<IntegerType>(castType)) {
+    auto bitWidth = intType->getBitWidth();
+    if (ICmpInst::isSigned(predicate)) {
+      auto identity = isMax ? APInt::getSignedMinValue(bitWidth) : APInt::getSignedMaxValue(bitWidth);
+      return ConstantInt::get(castType, identity);
+    }
+    auto identity = isMax ? APInt::getMinValue(bitWidth) : APInt::getMaxValue(bitWidth);
+    return ConstantInt::get(castType, identity);
+  }
+
+  assert(castType->isFloatingPointTy());
+  return ConstantFP::getInfinity(castType, isMax);
+}
@@ -20,7 +20,7 @@ InductionVariableManager::InductionVariableManager (
   ScalarEvolution &SE,
   SCCDAG &sccdag,
   LoopEnvironment &loopEnv
-) : LIS{LIS}, loopToIVsMap{}, loopToGoverningIVAttrMap{} {
+) : LIS{LIS}, loopToIVsMap{}, loopToGoverningIVAttrMap{}, loopToEarlyExitingGoverningIVAttrMap{} {
 
   /*
    * Fetch the loop to analyze.
@@ -91,8 +91,18 @@ InductionVariableManager::InductionVariableManager (
       this->loopToIVsMap[loop.get()].insert(IV);
       auto exitBlocks = LIS.getLoop(phi)->getLoopExitBasicBlocks();
       auto attribution = new LoopGoverningIVAttribution(*IV, *sccContainingIV, exitBlocks);
-      if (attribution->isSCCContainingIVWellFormed()) {
+      if (  true
+            && attribution->isSCCContainingIVWellFormed()
+            && !attribution->hasEarlyExits()
+         ) {
         loopToGoverningIVAttrMap[loop.get()] = attribution;
+      } else if (attribution->isSCCContainingIVWellFormed()) {
+
+        /*
+         * The IV governs the loop, but other branches can leave it earlier.
+         * Only clients that explicitly ask for this case can see it.
+         */
+        loopToEarlyExitingGoverningIVAttrMap[loop.get()] = attribution;
       } else {
         delete attribution;
       }
@@ -162,6 +172,10 @@ InductionVariableManager::~InductionVariableManager () {
     delete ivAttributions.second;
   }
   loopToGoverningIVAttrMap.clear();
+  for (auto ivAttributions : loopToEarlyExitingGoverningIVAttrMap) {
+    delete ivAttributions.second;
+  }
+  loopToEarlyExitingGoverningIVAttrMap.clear();
 
   for (auto loopIVs : loopToIVsMap) {
     for (auto IV : loopIVs.second) {
@@ -228,3 +242,8 @@ LoopGoverningIVAttribution * InductionVariableManager::getLoopGoverningIVAttribu
   if (loopToGoverningIVAttrMap.find(&LS) == loopToGoverningIVAttrMap.end()) return nullptr;
   return loopToGoverningIVAttrMap.at(&LS);
 }
+
+LoopGoverningIVAttribution * InductionVariableManager::getLoopGoverningIVAttributionOfLoopWithEarlyExits (LoopStructure &LS) const {
+  if (loopToEarlyExitingGoverningIVAttrMap.find(&LS) == loopToEarlyExitingGoverningIVAttrMap.end()) return nullptr;
+  return loopToEarlyExitingGoverningIVAttrMap.at(&LS);
+}
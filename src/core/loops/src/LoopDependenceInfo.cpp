@@ -11,6 +11,7 @@
 #include "PDG.hpp"
 #include "SCCDAG.hpp"
 #include "Architecture.hpp"
+#include "CompileTimeProfiler.hpp"
 #include "LoopDependenceInfo.hpp"
 #include "LoopAwareMemDepAnalysis.hpp"
 
@@ -94,6 +95,7 @@ LoopDependenceInfo::LoopDependenceInfo(
    */
   this->fetchLoopAndBBInfo(l, SE);
   auto ls = this->getLoopStructure();
+  CompileTimeScope profile("ldi", *ls->getFunction(), ls->getID());
   auto loopExitBlocks = ls->getLoopExitBasicBlocks();
   auto DGs = this->createDGsForLoop(l, fG, DS, SE, loopAA);
   this->loopDG = DGs.first;
@@ -114,7 +116,11 @@ LoopDependenceInfo::LoopDependenceInfo(
    * Calculate various attributes on SCCs
    */
   this->inductionVariables = new InductionVariableManager(liSummary, *invariantManager, SE, *loopSCCDAG, *environment);
-  this->sccdagAttrs = new SCCDAGAttrs(enableFloatAsReal, loopDG, loopSCCDAG, this->liSummary, SE, *inductionVariables, DS);
+  {
+    CompileTimeScope profileAttributes("sccdag-attributes", *ls->getFunction(), ls->getID());
+    this->sccdagAttrs = new SCCDAGAttrs(enableFloatAsReal, loopDG, loopSCCDAG, this->liSummary, SE, *inductionVariables, DS);
+  }
+  this->addLiveOutsNeededToReduceIndicesOfMinMax();
   this->domainSpaceAnalysis = new LoopIterationDomainSpaceAnalysis(liSummary, *this->inductionVariables, SE);
 
   /*
@@ -261,6 +267,64 @@ std::pair<PDG *, SCCDAG *> LoopDependenceInfo::createDGsForLoop (
   return std::make_pair(loopDG, loopSCCDAG);
 }
 
+void LoopDependenceInfo::addLiveOutsNeededToReduceIndicesOfMinMax (void) {
+
+  /*
+   * The index of a min/max reduction (e.g., argmin/argmax) is reduced by comparing the partial min/max values it belongs to.
+   * Hence, the min/max must be part of the environment even when no code outside the loop uses it.
+   */
+  auto sccdag = this->sccdagAttrs->getSCCDAG();
+  std::vector<Value *> producersToAdd;
+  for (auto envIndex : this->environment->getEnvIndicesOfLiveOutVars()) {
+
+    /*
+     * Check if the live-out variable is the index of a min/max reduction.
+     */
+    auto producer = this->environment->producerAt(envIndex);
+    auto producerSCC = sccdag->sccOfValue(producer);
+    auto sccInfo = this->sccdagAttrs->getSCCAttrs(producerSCC);
+    if (sccInfo->getType() != SCCAttrs::SCCType::REDUCIBLE) continue;
+    auto indexVariable = sccInfo->getSingleLoopCarriedVariable();
+    if (  false
+          || indexVariable == nullptr
+          || indexVariable->getMinMaxVariableOfIndex() == nullptr
+      ){
+      continue ;
+    }
+
+    /*
+     * Check if the min/max is already a live-out variable.
+     */
+    auto minMaxVariable = indexVariable->getMinMaxVariableOfIndex();
+    auto minMaxUpdate = minMaxVariable->getMinMaxUpdate();
+    auto minMaxSCC = sccdag->sccOfValue(minMaxUpdate);
+    auto isMinMaxLiveOut = false;
+    for (auto otherEnvIndex : this->environment->getEnvIndicesOfLiveOutVars()) {
+      if (minMaxSCC->isInternal(this->environment->producerAt(otherEnvIndex))) {
+        isMinMaxLiveOut = true;
+        break;
+      }
+    }
+    if (isMinMaxLiveOut) continue;
+
+    /*
+     * Propagate the value of the min/max that corresponds to the live-out value of the index.
+     */
+    Value *minMaxProducer = minMaxUpdate;
+    if (isa<PHINode>(producer)) {
+      minMaxProducer = minMaxVariable->getLoopEntryPHIForValueOfVariable(minMaxUpdate);
+    }
+    if (std::find(producersToAdd.begin(), producersToAdd.end(), minMaxProducer) != producersToAdd.end()) continue;
+    producersToAdd.push_back(minMaxProducer);
+  }
+
+  for (auto producer : producersToAdd) {
+    this->environment->addLiveOutProducer(producer);
+  }
+
+  return ;
+}
+
 void LoopDependenceInfo::removeUnnecessaryDependenciesThatCloningMemoryNegates (
   PDG *loopInternalDG,
   DominatorSummary &DS
@@ -406,6 +470,13 @@ uint32_t LoopDependenceInfo::getMaximumNumberOfCores (void) const {
   return this->maximumNumberOfCoresForTheParallelization;
 }
 
+void LoopDependenceInfo::setMaximumNumberOfCores (uint32_t cores) {
+  assert(cores > 1);
+  this->maximumNumberOfCoresForTheParallelization = cores;
+
+  return ;
+}
+
 InvariantManager * LoopDependenceInfo::getInvariantManager (void) const {
   return this->invariantManager;
 }
@@ -15,7 +15,7 @@ using namespace llvm::noelle;
 
 LoopGoverningIVAttribution::LoopGoverningIVAttribution (InductionVariable &iv, SCC &scc, std::vector<BasicBlock *> &exitBlocks)
   : IV{iv}, scc{scc}, headerCmp{nullptr}, conditionValueDerivation{},
-    intermediateValueUsedInCompare{nullptr}, isWellFormed{false} {
+    intermediateValueUsedInCompare{nullptr}, earlyExitBranches{}, isWellFormed{false} {
 
   /*
    * To understand how to transform the loop governing condition, it is far simpler to
@@ -34,17 +34,34 @@ LoopGoverningIVAttribution::LoopGoverningIVAttribution (InductionVariable &iv, S
 
   /*
    * Fetch the loop governing terminator.
-   * NOTE: It should be the only conditional branch in the IV's SCC
+   * NOTE: It should be the only conditional branch in the header that belongs to the IV's SCC.
+   *       Other conditional branches of the SCC are tolerated only if they leave the loop (early exits, e.g., the break of a search loop).
    */
+  std::set<BasicBlock *> exitBlockSet(exitBlocks.begin(), exitBlocks.end());
   BranchInst *loopGoverningTerminator = nullptr;
+  std::set<BranchInst *> otherConditionalBranches;
   for (auto internalNodePair : iv.getSCC()->internalNodePairs()) {
     auto value = internalNodePair.first;
     if (!isa<BranchInst>(value)) continue;
     auto br = cast<BranchInst>(value);
     if (!br->isConditional()) continue;
+    if (br->getParent() != headerPHI->getParent()){
+      otherConditionalBranches.insert(br);
+      continue ;
+    }
     if (loopGoverningTerminator) return;
     loopGoverningTerminator = br;
   }
+  for (auto br : otherConditionalBranches){
+    auto isExiting = false;
+    for (auto succ : br->successors()){
+      if (exitBlockSet.find(succ) != exitBlockSet.end()){
+        isExiting = true;
+      }
+    }
+    if (!isExiting) return;
+  }
+  this->earlyExitBranches = otherConditionalBranches;
 
   /*
    * Ensure the branch is in the header as this analysis does not understand do-while loops
@@ -78,7 +95,6 @@ LoopGoverningIVAttribution::LoopGoverningIVAttribution (InductionVariable &iv, S
   // this->conditionValue = isOpLHSAnIntermediate ? opR : opL;
   // this->intermediateValueUsedInCompare = cast<Instruction>(isOpLHSAnIntermediate ? opL : opR);
 
-  std::set<BasicBlock *> exitBlockSet(exitBlocks.begin(), exitBlocks.end());
   if (exitBlockSet.find(headerBr->getSuccessor(0)) != exitBlockSet.end()) {
     this->exitBlock = headerBr->getSuccessor(0);
   } else if (exitBlockSet.find(headerBr->getSuccessor(1)) != exitBlockSet.end()) {
@@ -167,3 +183,11 @@ std::set<Instruction *> &LoopGoverningIVAttribution::getConditionValueDerivation
 Instruction *LoopGoverningIVAttribution::getIntermediateValueUsedInCompare () {
   return intermediateValueUsedInCompare;
 }
+
+bool LoopGoverningIVAttribution::hasEarlyExits (void) const {
+  return earlyExitBranches.size() > 0;
+}
+
+std::set<BranchInst *> LoopGoverningIVAttribution::getEarlyExitBranches (void) const {
+  return earlyExitBranches;
+}
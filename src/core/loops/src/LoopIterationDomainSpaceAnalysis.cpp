@@ -33,6 +33,7 @@ LoopIterationDomainSpaceAnalysis::LoopIterationDomainSpaceAnalysis (
    */
   computeMemoryAccessSpace(SE);
   identifyIVForMemoryAccessSubscripts(SE);
+  identifyLinearAccessesAcrossIterations(SE);
   identifyNonOverlappingAccessesBetweenIterationsAcrossOneLoopInvocation(SE);
 
   return;
@@ -67,6 +68,49 @@ bool LoopIterationDomainSpaceAnalysis::areInstructionsAccessingDisjointMemoryLoc
   return (accessSpaceI == accessSpaceJ) || isMemoryAccessSpaceEquivalentForTopLoopIVSubscript(accessSpaceI, accessSpaceJ);
 }
 
+bool LoopIterationDomainSpaceAnalysis::getLinearMemoryAccessAcrossIterations (
+  Instruction *I,
+  Value *&base,
+  int64_t &offset,
+  int64_t &stride
+) const {
+  if (accessSpaceByInstruction.find(I) == accessSpaceByInstruction.end()) {
+    return false;
+  }
+
+  auto accessSpace = accessSpaceByInstruction.at(I);
+  if (!accessSpace->linearBase) {
+    return false;
+  }
+  base = accessSpace->linearBase;
+  offset = accessSpace->linearOffset;
+  stride = accessSpace->linearStride;
+
+  return true;
+}
+
+bool LoopIterationDomainSpaceAnalysis::getInductionVariablesOfMemoryAccessDimensions (
+  Instruction *I,
+  std::vector<InductionVariable *> &dimensionIVs
+) const {
+  if (accessSpaceByInstruction.find(I) == accessSpaceByInstruction.end()) {
+    return false;
+  }
+
+  auto accessSpace = accessSpaceByInstruction.at(I);
+  if (  false
+        || (accessSpace->subscriptIVs.size() == 0)
+        || (accessSpace->subscriptIVs.size() != accessSpace->sizes.size())
+     ){
+    return false;
+  }
+  for (auto instIVPair : accessSpace->subscriptIVs) {
+    dimensionIVs.push_back(instIVPair.second);
+  }
+
+  return true;
+}
+
 bool LoopIterationDomainSpaceAnalysis::isMemoryAccessSpaceEquivalentForTopLoopIVSubscript (
   MemoryAccessSpace *space1,
   MemoryAccessSpace *space2
@@ -296,6 +340,42 @@ void LoopIterationDomainSpaceAnalysis::computeMemoryAccessSpace (ScalarEvolution
   return;
 }
 
+void LoopIterationDomainSpaceAnalysis::identifyLinearAccessesAcrossIterations (ScalarEvolution &SE) {
+
+  auto rootLoopStructure = loops.getLoopNestingTreeRoot();
+  for (auto &memAccessSpace : this->accessSpaces) {
+
+    /*
+     * The accessor must evolve in the top-most loop by a constant stride
+     */
+    auto addRec = dyn_cast<SCEVAddRecExpr>(memAccessSpace->memoryAccessorSCEV);
+    if (!addRec || !addRec->isAffine()) continue;
+    if (addRec->getLoop()->getHeader() != rootLoopStructure->getHeader()) continue;
+    auto stride = dyn_cast<SCEVConstant>(addRec->getStepRecurrence(SE));
+    if (!stride || stride->getValue()->isZero()) continue;
+
+    /*
+     * The accessor must start from a loop-invariant pointer, optionally offset by a constant
+     */
+    auto start = addRec->getStart();
+    const SCEVConstant *offset = nullptr;
+    if (auto startAdd = dyn_cast<SCEVAddExpr>(start)) {
+      if (startAdd->getNumOperands() != 2) continue;
+      offset = dyn_cast<SCEVConstant>(startAdd->getOperand(0));
+      start = startAdd->getOperand(1);
+      if (!offset) continue;
+    }
+    auto base = dyn_cast<SCEVUnknown>(start);
+    if (!base || !base->getValue()->getType()->isPointerTy()) continue;
+
+    memAccessSpace->linearBase = base->getValue();
+    memAccessSpace->linearOffset = offset ? offset->getValue()->getSExtValue() : 0;
+    memAccessSpace->linearStride = stride->getValue()->getSExtValue();
+  }
+
+  return;
+}
+
 // TODO: Make this examine the IV and the subscript SCEV separately
 // The IV should be used in conjunction with the subscript SCEV to determine boundedness
 // The subscript SCEV alone should be used to determine whether it is one to one
@@ -460,7 +540,7 @@ void LoopIterationDomainSpaceAnalysis::identifyIVForMemoryAccessSubscripts (Scal
 }
 
 LoopIterationDomainSpaceAnalysis::MemoryAccessSpace::MemoryAccessSpace (Instruction *memoryAccessor)
-  : memoryAccessor{memoryAccessor} {
+  : memoryAccessor{memoryAccessor}, linearBase{nullptr}, linearOffset{0}, linearStride{0} {
 }
 
 LoopIterationDomainSpaceAnalysis::~LoopIterationDomainSpaceAnalysis () {
@@ -26,11 +26,11 @@ MemoryCloningAnalysis::MemoryCloningAnalysis (LoopStructure *loop, DominatorSumm
     if (auto alloca = dyn_cast<AllocaInst>(&I)) {
 
       /*
-       * Only consider struct and integer types
-       * TODO: Expand this to array/vector types
+       * Only consider struct, integer, and array types
+       * TODO: Expand this to vector types
        */
       auto allocatedType = alloca->getAllocatedType();
-      if (!allocatedType->isStructTy() && !allocatedType->isIntegerTy()) continue;
+      if (!allocatedType->isStructTy() && !allocatedType->isIntegerTy() && !allocatedType->isArrayTy()) continue;
 
       allocations.insert(alloca);
     }
@@ -43,7 +43,7 @@ MemoryCloningAnalysis::MemoryCloningAnalysis (LoopStructure *loop, DominatorSumm
     if (!sizeInBitsOptional.hasValue()) continue;
 
     auto sizeInBits = sizeInBitsOptional.getValue();
-    auto location = std::make_unique<ClonableMemoryLocation>(allocation, sizeInBits, loop, DS);
+    auto location = std::make_unique<ClonableMemoryLocation>(allocation, allocation->getAllocatedType(), sizeInBits, loop, DS);
     if (!location->isClonableLocation()) continue;
 
     this->clonableMemoryLocations.insert(std::move(location));
@@ -51,6 +51,59 @@ MemoryCloningAnalysis::MemoryCloningAnalysis (LoopStructure *loop, DominatorSumm
     // allocation->print(errs() << "Found clonable allocation: "); errs() << "\n";
 
   }
+
+  /*
+   * Collect heap allocations of constant size that are executed before the loop
+   * NOTE: Allocations within the loop already give each iteration its own memory
+   */
+  auto header = loop->getHeader();
+  auto &cxt = function->getContext();
+  for (auto &B : *function) {
+    if (!DS.DT.dominates(&B, header) || loop->isIncluded(&B)) continue;
+    for (auto &I : B) {
+      auto call = dyn_cast<CallInst>(&I);
+      if (!call) continue;
+      auto sizeInBytes = ClonableMemoryLocation::getHeapAllocationSizeInBytes(call);
+      if (sizeInBytes == 0) continue;
+
+      /*
+       * The allocated type is the one the allocation is casted to, if unique
+       */
+      Type *allocatedType = ArrayType::get(IntegerType::get(cxt, 8), sizeInBytes);
+      std::unordered_set<Type *> castedTypes;
+      for (auto user : call->users()) {
+        if (auto cast = dyn_cast<BitCastInst>(user)) {
+          castedTypes.insert(cast->getDestTy()->getPointerElementType());
+        }
+      }
+      if (castedTypes.size() == 1) {
+        auto castedType = *castedTypes.begin();
+        if (castedType->isSized() && DL.getTypeAllocSize(castedType) == sizeInBytes) {
+          allocatedType = castedType;
+        }
+      }
+
+      auto location = std::make_unique<ClonableMemoryLocation>(call, allocatedType, sizeInBytes * 8, loop, DS);
+      if (!location->isClonableLocation()) continue;
+
+      this->clonableMemoryLocations.insert(std::move(location));
+    }
+  }
+
+  /*
+   * Collect global variables that are only used within the loop
+   */
+  for (auto &global : function->getParent()->globals()) {
+    if (!global.hasLocalLinkage() || global.isConstant()) continue;
+
+    auto allocatedType = global.getValueType();
+    if (!allocatedType->isSized()) continue;
+    auto sizeInBits = DL.getTypeAllocSizeInBits(allocatedType);
+    auto location = std::make_unique<ClonableMemoryLocation>(&global, allocatedType, sizeInBits, loop, DS);
+    if (!location->isClonableLocation()) continue;
+
+    this->clonableMemoryLocations.insert(std::move(location));
+  }
 }
 
 std::unordered_set<ClonableMemoryLocation *> MemoryCloningAnalysis::getClonableMemoryLocations (void) const {
@@ -94,19 +147,19 @@ std::unordered_set<Instruction *> ClonableMemoryLocation::getLoopInstructionsUsi
 }
 
 ClonableMemoryLocation::ClonableMemoryLocation (
-  AllocaInst *allocation,
+  Value *allocation,
+  Type *allocatedType,
   uint64_t sizeInBits,
   LoopStructure *loop,
   DominatorSummary &DS
-) : allocation{allocation}, sizeInBits{sizeInBits}, loop{loop}, isClonable{false} {
+) : allocation{allocation}, allocatedType{allocatedType}, sizeInBits{sizeInBits}, loop{loop}, isClonable{false} {
 
   /*
-   * TODO: Remove this when array/vector types are supported
+   * TODO: Remove this when vector types are supported
    */
-  this->allocatedType = allocation->getAllocatedType();
   // this->allocation->print(errs() << "Allocation: "); errs() << "\n";
   // this->allocatedType->print(errs() << "Allocation type: "); errs() << "\n";
-  if (!allocatedType->isStructTy() && !allocatedType->isIntegerTy()) return;
+  if (!allocatedType->isStructTy() && !allocatedType->isIntegerTy() && !allocatedType->isArrayTy()) return;
 
   if (!identifyStoresAndOtherUsers(loop, DS)) return;
 
@@ -118,10 +171,26 @@ ClonableMemoryLocation::ClonableMemoryLocation (
   return;
 }
 
-AllocaInst *ClonableMemoryLocation::getAllocation (void) const {
+Value *ClonableMemoryLocation::getAllocation (void) const {
   return this->allocation;
 }
 
+uint64_t ClonableMemoryLocation::getSizeInBits (void) const {
+  return this->sizeInBits;
+}
+
+bool ClonableMemoryLocation::isStackAllocation (void) const {
+  return isa<AllocaInst>(this->allocation);
+}
+
+bool ClonableMemoryLocation::isHeapAllocation (void) const {
+  return isa<CallInst>(this->allocation);
+}
+
+bool ClonableMemoryLocation::isGlobalVariable (void) const {
+  return isa<GlobalVariable>(this->allocation);
+}
+
 bool ClonableMemoryLocation::isClonableLocation (void) const {
   return this->isClonable;
 }
@@ -149,13 +218,48 @@ bool ClonableMemoryLocation::isMemCpyInstrinsicCall (CallInst *call) {
   return nameString.find("llvm.memcpy") != std::string::npos;
 }
 
+bool ClonableMemoryLocation::isMemSetInstrinsicCall (CallInst *call) {
+  auto calledFn = call->getCalledFunction();
+  if (!calledFn || !calledFn->hasName()) return false;
+  auto name = calledFn->getName();
+  std::string nameString = std::string(name.bytes_begin(), name.bytes_end());
+  return nameString.find("llvm.memset") != std::string::npos;
+}
+
+uint64_t ClonableMemoryLocation::getHeapAllocationSizeInBytes (CallInst *call) {
+  auto calledFn = call->getCalledFunction();
+  if (!calledFn || !calledFn->hasName()) return 0;
+  auto name = calledFn->getName();
+
+  if (name == "malloc" && call->getNumArgOperands() == 1) {
+    auto size = dyn_cast<ConstantInt>(call->getArgOperand(0));
+    if (!size) return 0;
+    return size->getZExtValue();
+  }
+
+  if (name == "calloc" && call->getNumArgOperands() == 2) {
+    auto elements = dyn_cast<ConstantInt>(call->getArgOperand(0));
+    auto elementSize = dyn_cast<ConstantInt>(call->getArgOperand(1));
+    if (!elements || !elementSize) return 0;
+    return elements->getZExtValue() * elementSize->getZExtValue();
+  }
+
+  return 0;
+}
+
+bool ClonableMemoryLocation::isHeapDeallocationCall (CallInst *call) {
+  auto calledFn = call->getCalledFunction();
+  if (!calledFn || !calledFn->hasName()) return false;
+  return calledFn->getName() == "free";
+}
+
 bool ClonableMemoryLocation::identifyStoresAndOtherUsers (LoopStructure *loop, DominatorSummary &DS) {
 
   /*
    * Determine all stores and non-store uses
    * Ensure they only exist within the loop provided
    */
-  std::queue<Instruction *> allocationUses{};
+  std::queue<Value *> allocationUses{};
   allocationUses.push(allocation);
 
   while (!allocationUses.empty()) {
@@ -166,6 +270,21 @@ bool ClonableMemoryLocation::identifyStoresAndOtherUsers (LoopStructure *loop, D
 
     for (auto user : I->users()) {
 
+      /*
+       * Global variables can be referenced through constant casts and GEPs
+       */
+      if (auto constantExpr = dyn_cast<ConstantExpr>(user)) {
+        if (!constantExpr->isCast() && constantExpr->getOpcode() != Instruction::GetElementPtr) return false;
+        allocationUses.push(constantExpr);
+        continue;
+      }
+
+      /*
+       * All users must be instructions of the function that includes the loop
+       */
+      auto userInst = dyn_cast<Instruction>(user);
+      if (!userInst || userInst->getFunction() != loop->getFunction()) return false;
+
       /*
        * Find storing and non-storing instructions
        */
@@ -191,6 +310,11 @@ bool ClonableMemoryLocation::identifyStoresAndOtherUsers (LoopStructure *loop, D
 
       } else if (auto store = dyn_cast<StoreInst>(user)) {
 
+        /*
+         * The location must not escape through memory
+         */
+        if (store->getValueOperand() == I) return false;
+
         /*
          * As straightforward as it gets
          */
@@ -205,9 +329,19 @@ bool ClonableMemoryLocation::identifyStoresAndOtherUsers (LoopStructure *loop, D
         if (call->isLifetimeStartOrEnd()) continue;
 
         /*
-         * We consider llvm.memcpy as a storing instruction if the use is the dest (first operand) 
+         * Ignore the deallocation of the location after the loop
+         * The private copies are deallocated separately
+         */
+        if (ClonableMemoryLocation::isHeapDeallocationCall(call)) {
+          if (loop->isIncluded(call)) return false;
+          continue;
+        }
+
+        /*
+         * We consider llvm.memcpy and llvm.memset as storing instructions if the use is the dest (first operand) 
          */
-        bool isMemCpy = ClonableMemoryLocation::isMemCpyInstrinsicCall(call);
+        bool isMemCpy = ClonableMemoryLocation::isMemCpyInstrinsicCall(call)
+          || ClonableMemoryLocation::isMemSetInstrinsicCall(call);
         bool isUseTheDestinationOp = call->getNumArgOperands() == 4
           && call->getArgOperand(0) == I;
         if (isMemCpy && isUseTheDestinationOp) {
@@ -237,6 +371,12 @@ bool ClonableMemoryLocation::identifyStoresAndOtherUsers (LoopStructure *loop, D
       auto inst = cast<Instruction>(user);
       // if (!loop->isIncluded(inst)) { inst->print(errs() << "Outside loop!: "); errs() << "\n"; }
       if (!loop->isIncluded(inst)) {
+
+        /*
+         * Global variables outlive the function, so they must be used only within the loop
+         */
+        if (isGlobalVariable()) return false;
+
         auto block = inst->getParent();
         auto header = loop->getHeader();
         if (!DS.DT.dominates(block, header)) return false;
@@ -356,6 +496,15 @@ bool ClonableMemoryLocation::isOverrideSetFullyCoveringTheAllocationSpace (
          */
         return true;
 
+      } else if (pointerOperand->stripPointerCasts() == this->allocation) {
+
+        /*
+         * The location is stored directly to; check that all of it is overriden
+         */
+        auto &DL = store->getModule()->getDataLayout();
+        auto bitsStored = DL.getTypeStoreSizeInBits(store->getValueOperand()->getType());
+        if (this->sizeInBits == bitsStored) return true;
+
       } else if (auto gep = dyn_cast<GetElementPtrInst>(pointerOperand)) {
 
         // gep->print(errs() << "Examining GEP for coverage: "); errs() << "\n";
@@ -386,7 +535,8 @@ bool ClonableMemoryLocation::isOverrideSetFullyCoveringTheAllocationSpace (
       }
 
     } else if (auto call = dyn_cast<CallInst>(storingInstruction)) {
-      assert(ClonableMemoryLocation::isMemCpyInstrinsicCall(call));
+      assert(ClonableMemoryLocation::isMemCpyInstrinsicCall(call)
+        || ClonableMemoryLocation::isMemSetInstrinsicCall(call));
 
       // call->print(errs() << "Examining llvm.memcpy call: "); errs() << "\n";
 
@@ -402,7 +552,7 @@ bool ClonableMemoryLocation::isOverrideSetFullyCoveringTheAllocationSpace (
     }
   }
 
-  if (this->allocation->getAllocatedType()->isStructTy()) {
+  if (this->allocatedType->isStructTy()) {
 
     // errs() << "Number of elements covered: " << structElementsStoredTo.size()
       // << " versus struct element number: " << this->allocatedType->getStructNumElements() << "\n";
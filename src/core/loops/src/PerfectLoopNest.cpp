@@ -0,0 +1,300 @@
+/*
+ * Copyright 2019 - 2020  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "PerfectLoopNest.hpp"
+
+using namespace llvm;
+using namespace llvm::noelle;
+
+PerfectLoopNest::PerfectLoopNest (LoopDependenceInfo const &LDI)
+  : outerLoop{LDI.getLoopStructure()}, innerLoop{nullptr}, outerAttr{nullptr}, innerAttr{nullptr}, isPerfect{false}
+  {
+
+  /*
+   * Fetch the only loop included in the outer loop.
+   */
+  auto subLoops = this->outerLoop->getChildren();
+  if (subLoops.size() != 1){
+    return ;
+  }
+  this->innerLoop = *subLoops.begin();
+
+  /*
+   * Fetch the governing induction variables of both loops.
+   */
+  auto IVM = LDI.getInductionVariableManager();
+  this->outerAttr = IVM->getLoopGoverningIVAttribution(*this->outerLoop);
+  this->innerAttr = IVM->getLoopGoverningIVAttribution(*this->innerLoop);
+  if (  false
+        || (this->outerAttr == nullptr)
+        || (this->innerAttr == nullptr)
+     ){
+    return ;
+  }
+
+  /*
+   * Check the shape of the nest.
+   */
+  this->isPerfect = this->checkIfPerfectlyNested();
+
+  return ;
+}
+
+bool PerfectLoopNest::isPerfectlyNested (void) const {
+  return this->isPerfect;
+}
+
+bool PerfectLoopNest::isInnerIterationSpaceInvariant (void) const {
+  if (!this->isPerfect){
+    return false;
+  }
+
+  auto innerPHI = this->innerAttr->getInductionVariable().getLoopEntryPHI();
+  auto innerStartValue = innerPHI->getIncomingValueForBlock(this->innerLoop->getPreHeader());
+  if (  false
+        || (!this->isInvariantOfTheNest(innerStartValue))
+        || (!this->isInvariantOfTheNest(this->innerAttr->getHeaderCmpInstConditionValue()))
+        || (!this->isInvariantOfTheNest(this->outerAttr->getHeaderCmpInstConditionValue()))
+     ){
+    return false;
+  }
+
+  return true;
+}
+
+LoopStructure * PerfectLoopNest::getOuterLoop (void) const {
+  return this->outerLoop;
+}
+
+LoopStructure * PerfectLoopNest::getInnerLoop (void) const {
+  return this->innerLoop;
+}
+
+LoopGoverningIVAttribution * PerfectLoopNest::getOuterLoopGoverningIVAttribution (void) const {
+  return this->outerAttr;
+}
+
+LoopGoverningIVAttribution * PerfectLoopNest::getInnerLoopGoverningIVAttribution (void) const {
+  return this->innerAttr;
+}
+
+std::vector<BasicBlock *> PerfectLoopNest::getBasicBlocksBetweenInnerAndOuterLatches (void) const {
+  std::vector<BasicBlock *> blocks;
+
+  auto outerHeader = this->outerLoop->getHeader();
+  auto innerPreheader = this->innerLoop->getPreHeader();
+  for (auto &bb : *this->outerLoop->getFunction()){
+    if (  false
+          || (&bb == outerHeader)
+          || (&bb == innerPreheader)
+          || (!this->outerLoop->isIncluded(&bb))
+          || this->innerLoop->isIncluded(&bb)
+       ){
+      continue ;
+    }
+    blocks.push_back(&bb);
+  }
+
+  return blocks;
+}
+
+bool PerfectLoopNest::checkIfPerfectlyNested (void) const {
+
+  /*
+   * Both loops must have a single exit and their preheaders.
+   */
+  auto outerPreheader = this->outerLoop->getPreHeader();
+  auto innerPreheader = this->innerLoop->getPreHeader();
+  if (  false
+        || (outerPreheader == nullptr)
+        || (innerPreheader == nullptr)
+        || (this->outerLoop->numberOfExitBasicBlocks() != 1)
+        || (this->innerLoop->numberOfExitBasicBlocks() != 1)
+     ){
+    return false;
+  }
+
+  /*
+   * The headers of both loops must only evolve their governing induction variables.
+   */
+  if (  false
+        || (!this->isHeaderOnlyEvolvingTheIV(this->outerLoop, this->outerAttr))
+        || (!this->isHeaderOnlyEvolvingTheIV(this->innerLoop, this->innerAttr))
+     ){
+    return false;
+  }
+
+  /*
+   * The induction variables must not be used outside the nest.
+   */
+  if (  false
+        || (!this->isIVOnlyUsedWithinTheNest(this->outerAttr))
+        || (!this->isIVOnlyUsedWithinTheNest(this->innerAttr))
+     ){
+    return false;
+  }
+
+  /*
+   * The header of the outer loop must jump straight to the preheader of the inner loop.
+   */
+  auto outerHeader = this->outerLoop->getHeader();
+  auto outerBr = this->outerAttr->getHeaderBrInst();
+  auto outerExit = this->outerAttr->getExitBlockFromHeader();
+  auto outerBody = (outerBr->getSuccessor(0) == outerExit) ? outerBr->getSuccessor(1) : outerBr->getSuccessor(0);
+  if (  false
+        || (outerBody != innerPreheader)
+        || (innerPreheader->getSinglePredecessor() != outerHeader)
+        || (innerPreheader->getSingleSuccessor() != this->innerLoop->getHeader())
+     ){
+    return false;
+  }
+
+  /*
+   * The preheader of the inner loop must not include code that can change the semantics of the program when executed a different number of times.
+   */
+  for (auto &inst : *innerPreheader){
+    if (  false
+          || isa<DbgInfoIntrinsic>(&inst)
+          || inst.isTerminator()
+       ){
+      continue ;
+    }
+    if (  false
+          || isa<PHINode>(&inst)
+          || isa<AllocaInst>(&inst)
+          || inst.mayReadOrWriteMemory()
+          || inst.mayHaveSideEffects()
+       ){
+      return false;
+    }
+  }
+
+  /*
+   * The code executed between the exit of the inner loop and the latch of the outer one must only evolve the outer induction variable.
+   */
+  auto outerIVInstructions = this->outerAttr->getInductionVariable().getAllInstructions();
+  auto innerExit = this->innerAttr->getExitBlockFromHeader();
+  auto blocksAfterInnerLoop = this->getBasicBlocksBetweenInnerAndOuterLatches();
+  if (std::find(blocksAfterInnerLoop.begin(), blocksAfterInnerLoop.end(), innerExit) == blocksAfterInnerLoop.end()){
+    return false;
+  }
+  for (auto bb : blocksAfterInnerLoop){
+    for (auto &inst : *bb){
+      if (isa<DbgInfoIntrinsic>(&inst)){
+        continue ;
+      }
+      if (auto br = dyn_cast<BranchInst>(&inst)){
+        if (br->isUnconditional()){
+          continue ;
+        }
+        return false;
+      }
+      if (  false
+            || isa<PHINode>(&inst)
+            || (outerIVInstructions.find(&inst) == outerIVInstructions.end())
+         ){
+        return false;
+      }
+    }
+  }
+
+  return true;
+}
+
+bool PerfectLoopNest::isHeaderOnlyEvolvingTheIV (
+  LoopStructure *loop,
+  LoopGoverningIVAttribution *attr
+  ) const {
+
+  /*
+   * The induction variable must be an integer that evolves by a constant step.
+   */
+  auto &IV = attr->getInductionVariable();
+  auto phi = IV.getLoopEntryPHI();
+  if (  false
+        || (!phi->getType()->isIntegerTy())
+        || (!isa<ConstantInt>(IV.getSingleComputedStepValue()))
+     ){
+    return false;
+  }
+
+  /*
+   * The header must only include the PHI of the induction variable, the comparison, and the branch.
+   */
+  auto header = loop->getHeader();
+  auto cmp = attr->getHeaderCmpInst();
+  auto br = attr->getHeaderBrInst();
+  if (  false
+        || (cmp->getParent() != header)
+        || (br->getParent() != header)
+        || (!cmp->hasOneUse())
+     ){
+    return false;
+  }
+  for (auto &inst : *header){
+    if (  false
+          || (&inst == phi)
+          || (&inst == cmp)
+          || (&inst == br)
+          || isa<DbgInfoIntrinsic>(&inst)
+       ){
+      continue ;
+    }
+    return false;
+  }
+
+  return true;
+}
+
+bool PerfectLoopNest::isIVOnlyUsedWithinTheNest (LoopGoverningIVAttribution *attr) const {
+  auto &IV = attr->getInductionVariable();
+  auto phi = IV.getLoopEntryPHI();
+  auto cmp = attr->getHeaderCmpInst();
+  auto IVInstructions = IV.getAllInstructions();
+
+  for (auto inst : IVInstructions){
+    for (auto user : inst->users()){
+      auto userInst = dyn_cast<Instruction>(user);
+      if (userInst == nullptr){
+        return false;
+      }
+
+      /*
+       * The PHI of the induction variable can be used anywhere within the nest.
+       */
+      if (inst == phi){
+        if (!this->outerLoop->isIncluded(userInst)){
+          return false;
+        }
+        continue ;
+      }
+
+      /*
+       * The other instructions of the induction variable must only be used to evolve the induction variable and to compute the exit condition.
+       */
+      if (  true
+            && (userInst != cmp)
+            && (IVInstructions.find(userInst) == IVInstructions.end())
+         ){
+        return false;
+      }
+    }
+  }
+
+  return true;
+}
+
+bool PerfectLoopNest::isInvariantOfTheNest (Value *value) const {
+  if (auto inst = dyn_cast<Instruction>(value)){
+    return !this->outerLoop->isIncluded(inst);
+  }
+
+  return true;
+}
@@ -329,6 +329,15 @@ LoopCarriedVariable * SCCAttrs::getSingleLoopCarriedVariable (void) const {
   return *loopCarriedVariables.begin();
 }
 
+void SCCAttrs::addLoopCarriedMemoryLocation (LoopCarriedMemoryLocation *memoryLocation) {
+  loopCarriedMemoryLocations.insert(memoryLocation);
+}
+
+LoopCarriedMemoryLocation * SCCAttrs::getSingleLoopCarriedMemoryLocation (void) const {
+  if (loopCarriedMemoryLocations.size() != 1) return nullptr;
+  return *loopCarriedMemoryLocations.begin();
+}
+
 void SCCAttrs::setSCCToBeClonableUsingLocalMemory (void) {
   this->isSCCClonableIntoLocalMemory = true;
 }
@@ -341,8 +350,8 @@ void SCCAttrs::addClonableMemoryLocationsContainedInSCC (std::unordered_set<cons
   this->clonableMemoryLocations = locations;
 }
 
-std::unordered_set<AllocaInst *> SCCAttrs::getMemoryLocationsToClone (void) const {
-  std::unordered_set<AllocaInst *> allocations;
+std::unordered_set<Value *> SCCAttrs::getMemoryLocationsToClone (void) const {
+  std::unordered_set<Value *> allocations;
   for (auto location : clonableMemoryLocations) {
     allocations.insert(location->getAllocation());
   }
@@ -373,4 +382,7 @@ SCCAttrs::~SCCAttrs () {
   for (auto var : loopCarriedVariables) {
     delete var;
   }
+  for (auto memoryLocation : loopCarriedMemoryLocations) {
+    delete memoryLocation;
+  }
 }
@@ -9,6 +9,7 @@
  * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
  */
 #include "SCCDAGAttrs.hpp"
+#include "llvm/Analysis/ValueTracking.h"
 #include "PDGPrinter.hpp"
 #include "LoopCarriedDependencies.hpp"
 
@@ -98,6 +99,11 @@ SCCDAGAttrs::SCCDAGAttrs (
     return false;
   });
 
+  /*
+   * Indices of min/max reductions (e.g., argmin/argmax) depend on the categorization of the min/max they track
+   */
+  this->checkIfIndicesOfMinMaxAreReducible(LIS, ivs);
+
   collectSCCGraphAssumingDistributedClones();
 
   return ;
@@ -376,7 +382,10 @@ bool SCCDAGAttrs::checkIfSCCOnlyContainsInductionVariables (
     if (loopGoverningIVs.find(containedIV) == loopGoverningIVs.end()) continue;
     auto exitBlocks = LIS.getLoop(*containedIV->getLoopEntryPHI()->getParent())->getLoopExitBasicBlocks();
     LoopGoverningIVAttribution attribution(*containedIV, *scc, exitBlocks);
-    if (!attribution.isSCCContainingIVWellFormed()) {
+    if (  false
+          || !attribution.isSCCContainingIVWellFormed()
+          || attribution.hasEarlyExits()
+       ) {
       // containedIV->getLoopEntryPHI()->print(errs() << "Not well formed SCC for loop governing IV!\n"); errs() << "\n";
       return false;
     }
@@ -427,9 +436,9 @@ bool SCCDAGAttrs::checkIfReducible (SCC *scc, LoopsSummary &LIS) {
   for (auto dependency : sccToLoopCarriedDependencies.at(scc)) {
 
     /*
-     * We do not handle reducibility of memory locations
+     * Memory locations are handled separately
      */
-    if (dependency->isMemoryDependence()) return false;
+    if (dependency->isMemoryDependence()) return this->checkIfMemoryLocationIsReducible(scc, LIS);
 
     /*
      * Ingore external control dependencies, do not allow internal ones
@@ -476,6 +485,15 @@ bool SCCDAGAttrs::checkIfReducible (SCC *scc, LoopsSummary &LIS) {
 
   auto variable = new LoopCarriedVariable(*rootLoop, LIS, *loopDG, *sccdag, *scc, singleLoopCarriedPHI);
   if (!variable->isEvolutionReducibleAcrossLoopIterations()) {
+
+    /*
+     * A variable that selects an external value may still be reduced along with the min/max that drives it
+     */
+    if (variable->getSelectionUpdate() != nullptr) {
+      this->selectionVariableCandidates[scc] = variable;
+      return false;
+    }
+
     delete variable;
     return false;
   }
@@ -486,9 +504,14 @@ bool SCCDAGAttrs::checkIfReducible (SCC *scc, LoopsSummary &LIS) {
    * Check if the reducable variable is a floating point and check if floating point variables can be considered as real numbers.
    */
   auto variableType = singleLoopCarriedPHI->getType();
+  auto minMaxPredicate = variable->getMinMaxPredicate();
+  auto isExactMinMax = true
+    && (minMaxPredicate != CmpInst::BAD_ICMP_PREDICATE)
+    && (!CmpInst::isUnordered(minMaxPredicate));
   if (  true
         && (variableType->isFloatTy() || variableType->isDoubleTy())
         && (!this->enableFloatAsReal)
+        && (!isExactMinMax)
     ){
 
     /*
@@ -505,6 +528,217 @@ bool SCCDAGAttrs::checkIfReducible (SCC *scc, LoopsSummary &LIS) {
   return true;
 }
 
+void SCCDAGAttrs::checkIfIndicesOfMinMaxAreReducible (LoopsSummary &LIS, std::set<InductionVariable *> &IVs) {
+
+  /*
+   * Map the selects of candidate indices to their variables
+   */
+  std::unordered_map<SelectInst *, std::pair<SCC *, LoopCarriedVariable *>> candidateOfSelect;
+  for (auto candidatePair : this->selectionVariableCandidates) {
+    auto variable = candidatePair.second;
+    candidateOfSelect[variable->getSelectionUpdate()] = candidatePair;
+  }
+
+  /*
+   * Iterate over the min/max reductions that drive other selects
+   */
+  std::unordered_set<LoopCarriedVariable *> indexVariables;
+  for (auto sccInfoPair : this->sccToInfo) {
+    auto sccInfo = sccInfoPair.second;
+    if (sccInfo->getType() != SCCAttrs::SCCType::REDUCIBLE) continue;
+    auto minMaxVariable = sccInfo->getSingleLoopCarriedVariable();
+    if (  false
+          || minMaxVariable == nullptr
+          || minMaxVariable->getMinMaxComparison() == nullptr
+      ){
+      continue ;
+    }
+    auto trackingSelects = minMaxVariable->getSelectsTrackingMinMax();
+    if (trackingSelects.size() == 0) continue;
+
+    /*
+     * Every select driven by the comparison of the min/max must be an index we can reduce.
+     * Otherwise, the select would observe partial min/max values, so the min/max cannot be reduced either.
+     */
+    std::unordered_map<SCC *, LoopCarriedVariable *> indices;
+    auto areAllIndicesReducible = true;
+    for (auto trackingSelect : trackingSelects) {
+      if (candidateOfSelect.find(trackingSelect) == candidateOfSelect.end()) {
+        areAllIndicesReducible = false;
+        break;
+      }
+      auto indexSCC = candidateOfSelect[trackingSelect].first;
+      auto indexVariable = candidateOfSelect[trackingSelect].second;
+
+      auto tiePredicate = this->getTiePredicateOfIndex(LIS, minMaxVariable, indexVariable, IVs);
+      if (tiePredicate == CmpInst::BAD_ICMP_PREDICATE) {
+        areAllIndicesReducible = false;
+        break;
+      }
+      indexVariable->setAsIndexOfMinMax(minMaxVariable, tiePredicate);
+      if (!indexVariable->isEvolutionReducibleAcrossLoopIterations()) {
+        areAllIndicesReducible = false;
+        break;
+      }
+      indices[indexSCC] = indexVariable;
+    }
+    if (!areAllIndicesReducible) {
+      sccInfo->setType(SCCAttrs::SCCType::SEQUENTIAL);
+      continue ;
+    }
+
+    /*
+     * The indices can be reduced along with the min/max they track
+     */
+    for (auto indexPair : indices) {
+      auto indexSCCInfo = this->getSCCAttrs(indexPair.first);
+      indexSCCInfo->addLoopCarriedVariable(indexPair.second);
+      indexSCCInfo->setType(SCCAttrs::SCCType::REDUCIBLE);
+      indexVariables.insert(indexPair.second);
+    }
+  }
+
+  /*
+   * Free the candidates that have not been reduced.
+   */
+  for (auto candidatePair : this->selectionVariableCandidates) {
+    auto variable = candidatePair.second;
+    if (indexVariables.find(variable) != indexVariables.end()) continue;
+    delete variable;
+  }
+  this->selectionVariableCandidates.clear();
+
+  return ;
+}
+
+CmpInst::Predicate SCCDAGAttrs::getTiePredicateOfIndex (
+  LoopsSummary &LIS,
+  LoopCarriedVariable *minMaxVariable,
+  LoopCarriedVariable *indexVariable,
+  std::set<InductionVariable *> &IVs
+) {
+
+  /*
+   * The index must be selected exactly when the min/max selects the new value
+   */
+  if (  false
+        || indexVariable->getSelectingComparison() != minMaxVariable->getMinMaxComparison()
+        || indexVariable->isNewValueSelectedWhenConditionHolds() != minMaxVariable->isNewValueSelectedWhenConditionHolds()
+        || !indexVariable->getSelectionUpdate()->getType()->isIntegerTy()
+    ){
+    return CmpInst::BAD_ICMP_PREDICATE;
+  }
+
+  /*
+   * Only strict comparisons keep the first occurrence of the min/max, which makes ties across partial results decidable by the index alone
+   */
+  if (!AccumulatorOpInfo::isStrictMinMaxPredicate(minMaxVariable->getMinMaxPredicate())) {
+    return CmpInst::BAD_ICMP_PREDICATE;
+  }
+
+  /*
+   * The selected value must be an induction variable of the loop (possibly extended) with a constant step
+   */
+  auto selectedValue = indexVariable->getSelectedValue();
+  auto isZeroExtended = false;
+  if (auto castInst = dyn_cast<CastInst>(selectedValue)) {
+    if (  false
+          || isa<SExtInst>(castInst)
+          || isa<ZExtInst>(castInst)
+      ){
+      isZeroExtended = isa<ZExtInst>(castInst);
+      selectedValue = castInst->getOperand(0);
+    }
+  }
+  auto rootLoopHeader = LIS.getLoopNestingTreeRoot()->getHeader();
+  InductionVariable *indexIV = nullptr;
+  for (auto iv : IVs) {
+    auto loopEntryPHI = iv->getLoopEntryPHI();
+    if (  true
+          && loopEntryPHI == selectedValue
+          && loopEntryPHI->getParent() == rootLoopHeader
+      ){
+      indexIV = iv;
+      break;
+    }
+  }
+  if (indexIV == nullptr) return CmpInst::BAD_ICMP_PREDICATE;
+  auto step = dyn_cast_or_null<ConstantInt>(indexIV->getSingleComputedStepValue());
+  if (  false
+        || step == nullptr
+        || step->isZero()
+    ){
+    return CmpInst::BAD_ICMP_PREDICATE;
+  }
+
+  /*
+   * The first occurrence has the smallest index for increasing induction variables, and the largest one otherwise
+   */
+  if (step->isNegative()) {
+    return isZeroExtended ? CmpInst::ICMP_UGT : CmpInst::ICMP_SGT;
+  }
+  return isZeroExtended ? CmpInst::ICMP_ULT : CmpInst::ICMP_SLT;
+}
+
+bool SCCDAGAttrs::checkIfMemoryLocationIsReducible (SCC *scc, LoopsSummary &LIS) {
+
+  /*
+   * All loop-carried data dependences must go through memory
+   * Ignore external control dependences, do not allow internal ones
+   */
+  for (auto dependency : sccToLoopCarriedDependencies.at(scc)) {
+    if (dependency->isControlDependence()) {
+      if (scc->isInternal(dependency->getOutgoingT())) return false;
+      continue;
+    }
+    if (!dependency->isMemoryDependence()) return false;
+  }
+
+  /*
+   * All stores of the SCC must update the same memory location
+   */
+  Value *memoryLocation = nullptr;
+  for (auto nodePair : scc->internalNodePairs()) {
+    auto store = dyn_cast<StoreInst>(nodePair.first);
+    if (!store) continue;
+    auto &DL = store->getModule()->getDataLayout();
+    auto object = GetUnderlyingObject(store->getPointerOperand(), DL);
+    if (  true
+          && (memoryLocation != nullptr)
+          && (memoryLocation != object)
+       ){
+      return false;
+    }
+    memoryLocation = object;
+  }
+  if (memoryLocation == nullptr) return false;
+
+  auto rootLoop = LIS.getLoopNestingTreeRoot();
+  auto location = new LoopCarriedMemoryLocation(*rootLoop, *loopDG, *scc, memoryLocation);
+  if (!location->isEvolutionReducibleAcrossLoopIterations()) {
+    delete location;
+    return false;
+  }
+
+  /*
+   * Check if floating point values can be considered as real numbers.
+   */
+  if (  true
+        && location->getElementType()->isFloatingPointTy()
+        && (!this->enableFloatAsReal)
+    ){
+    delete location;
+    return false;
+  }
+
+  /*
+   * This SCC can be reduced.
+   */
+  auto sccInfo = this->getSCCAttrs(scc);
+  sccInfo->addLoopCarriedMemoryLocation(location);
+  return true;
+}
+
 /*
  * The SCC is independent if it doesn't have loop carried data dependencies
  */
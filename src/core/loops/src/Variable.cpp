@@ -10,6 +10,8 @@
  */
 #include "Variable.hpp"
 #include "LoopCarriedDependencies.hpp"
+#include "MemoryCloningAnalysis.hpp"
+#include "AccumulatorOpInfo.hpp"
 
 using namespace llvm;
 using namespace llvm::noelle;
@@ -30,6 +32,16 @@ LoopCarriedVariable::LoopCarriedVariable (
   assert(sccContainingVariable.isInternal(declarationPHI)
     && "Declaration PHI node is not internal to the SCC provided!");
 
+  this->minMaxPredicate = CmpInst::BAD_ICMP_PREDICATE;
+  this->minMaxUpdate = nullptr;
+  this->minMaxComparison = nullptr;
+  this->selectionUpdate = nullptr;
+  this->selectingComparison = nullptr;
+  this->selectedValue = nullptr;
+  this->isNewValueSelectedWhenTrue = false;
+  this->minMaxVariableOfIndex = nullptr;
+  this->indexTiePredicate = CmpInst::BAD_ICMP_PREDICATE;
+
   /*
    * Ensure the loop is in a normalized form
    */
@@ -144,6 +156,14 @@ LoopCarriedVariable::LoopCarriedVariable (
     loopCarriedVariableUpdates.insert(variableUpdate);
   }
 
+  /*
+   * Recognize min/max reductions and selections of external values (e.g., the index of argmin/argmax)
+   */
+  this->identifyMinMaxReduction();
+  if (this->minMaxPredicate == CmpInst::BAD_ICMP_PREDICATE) {
+    this->identifySelectionOfExternalValue();
+  }
+
   this->isValid = true;
 }
 
@@ -161,6 +181,21 @@ bool LoopCarriedVariable::isEvolutionReducibleAcrossLoopIterations (void) const
 
   if (!isValid) return false;
 
+  /*
+   * Min/max reductions override the variable by design: they are checked separately
+   */
+  if (minMaxPredicate != CmpInst::BAD_ICMP_PREDICATE) {
+    return isEvolutionOfMinMaxReducible();
+  }
+
+  /*
+   * The index of a min/max reduction is reduced together with it: it cannot be used for further computation within the loop
+   */
+  if (minMaxVariableOfIndex != nullptr) {
+    auto consumers = getConsumersOfVariable();
+    return areValuesPropagatingVariableIntermediatesOutsideLoop(consumers);
+  }
+
   // declarationValue->print(errs() << "Declaration: "); errs() << "\n";
   // sccOfDataAndMemoryVariableValuesOnly->printMinimal(errs() << "Data and memory SCC\n");
   // errs() << "Number of internal control values: " << controlValuesGoverningEvolution.size() << "\n";
@@ -225,6 +260,257 @@ bool LoopCarriedVariable::isEvolutionReducibleAcrossLoopIterations (void) const
   return true;
 }
 
+void LoopCarriedVariable::identifyMinMaxReduction (void) {
+
+  /*
+   * All values of the variable that are carried to the next iteration must come from a single update
+   */
+  auto declarationPHI = cast<PHINode>(declarationValue);
+  auto preHeaderBlock = outermostLoopOfVariable.getPreHeader();
+  Value *singleLoopCarriedValue = nullptr;
+  for (auto i = 0; i < declarationPHI->getNumIncomingValues(); ++i) {
+    if (declarationPHI->getIncomingBlock(i) == preHeaderBlock) continue;
+    auto incomingValue = declarationPHI->getIncomingValue(i);
+    if (  true
+          && singleLoopCarriedValue != nullptr
+          && singleLoopCarriedValue != incomingValue
+      ){
+      return ;
+    }
+    singleLoopCarriedValue = incomingValue;
+  }
+  if (  false
+        || singleLoopCarriedValue == nullptr
+        || !isa<Instruction>(singleLoopCarriedValue)
+        || !sccOfVariableOnly->isInternal(singleLoopCarriedValue)
+    ){
+    return ;
+  }
+  auto update = cast<Instruction>(singleLoopCarriedValue);
+
+  /*
+   * Case 1: the update is a min/max intrinsic (e.g., m = llvm.maxnum(x, m))
+   */
+  if (auto call = dyn_cast<CallInst>(update)) {
+    auto predicate = AccumulatorOpInfo::getMinMaxPredicateOfIntrinsic(call);
+    if (predicate == CmpInst::BAD_ICMP_PREDICATE) return ;
+    if (call->getNumArgOperands() != 2) return ;
+
+    Value *newValue = nullptr;
+    if (call->getArgOperand(0) == declarationPHI) {
+      newValue = call->getArgOperand(1);
+    } else if (call->getArgOperand(1) == declarationPHI) {
+      newValue = call->getArgOperand(0);
+    }
+    if (  false
+          || newValue == nullptr
+          || sccOfVariableOnly->isInternal(newValue)
+          || sccOfVariableOnly->numInternalNodes() != 2
+      ){
+      return ;
+    }
+
+    this->minMaxPredicate = predicate;
+    this->minMaxUpdate = call;
+    return ;
+  }
+
+  /*
+   * Case 2: the update is a select driven by a comparison between the new value and the variable (e.g., m = x > m ? x : m)
+   */
+  auto select = dyn_cast<SelectInst>(update);
+  if (select == nullptr) return ;
+  auto comparison = dyn_cast<CmpInst>(select->getCondition());
+  if (  false
+        || comparison == nullptr
+        || !sccOfVariableOnly->isInternal(comparison)
+        || sccOfVariableOnly->numInternalNodes() != 3
+    ){
+    return ;
+  }
+
+  Value *newValue = nullptr;
+  if (select->getFalseValue() == declarationPHI) {
+    newValue = select->getTrueValue();
+  } else if (select->getTrueValue() == declarationPHI) {
+    newValue = select->getFalseValue();
+  }
+  if (  false
+        || newValue == nullptr
+        || sccOfVariableOnly->isInternal(newValue)
+    ){
+    return ;
+  }
+
+  /*
+   * Normalize the comparison to P(x, m)
+   */
+  CmpInst::Predicate predicate;
+  if (  true
+        && comparison->getOperand(0) == newValue
+        && comparison->getOperand(1) == declarationPHI
+    ){
+    predicate = comparison->getPredicate();
+  } else if (  true
+               && comparison->getOperand(0) == declarationPHI
+               && comparison->getOperand(1) == newValue
+    ){
+    predicate = comparison->getSwappedPredicate();
+  } else {
+    return ;
+  }
+  auto isNewValueSelectedWhenTrue = select->getTrueValue() == newValue;
+  if (!isNewValueSelectedWhenTrue) {
+    predicate = CmpInst::getInversePredicate(predicate);
+  }
+  if (!AccumulatorOpInfo::isMinMaxPredicate(predicate)) return ;
+
+  /*
+   * The comparison can only drive selects: the update itself and the selects of variables tracking the min/max (e.g., the index)
+   */
+  std::unordered_set<SelectInst *> trackingSelects;
+  for (auto user : comparison->users()) {
+    if (user == select) continue;
+    auto trackingSelect = dyn_cast<SelectInst>(user);
+    if (  false
+          || trackingSelect == nullptr
+          || trackingSelect->getCondition() != comparison
+          || trackingSelect->getTrueValue() == comparison
+          || trackingSelect->getFalseValue() == comparison
+      ){
+      return ;
+    }
+    trackingSelects.insert(trackingSelect);
+  }
+
+  this->minMaxPredicate = predicate;
+  this->minMaxUpdate = select;
+  this->minMaxComparison = comparison;
+  this->selectsTrackingMinMax = trackingSelects;
+  this->isNewValueSelectedWhenTrue = isNewValueSelectedWhenTrue;
+
+  return ;
+}
+
+void LoopCarriedVariable::identifySelectionOfExternalValue (void) {
+
+  /*
+   * The variable must be updated only by a select between its previous value and an external one
+   */
+  auto declarationPHI = cast<PHINode>(declarationValue);
+  auto preHeaderBlock = outermostLoopOfVariable.getPreHeader();
+  SelectInst *select = nullptr;
+  for (auto i = 0; i < declarationPHI->getNumIncomingValues(); ++i) {
+    if (declarationPHI->getIncomingBlock(i) == preHeaderBlock) continue;
+    auto incomingSelect = dyn_cast<SelectInst>(declarationPHI->getIncomingValue(i));
+    if (  false
+          || incomingSelect == nullptr
+          || (select != nullptr && select != incomingSelect)
+      ){
+      return ;
+    }
+    select = incomingSelect;
+  }
+  if (  false
+        || select == nullptr
+        || !sccOfVariableOnly->isInternal(select)
+        || sccOfVariableOnly->numInternalNodes() != 2
+    ){
+    return ;
+  }
+
+  auto comparison = dyn_cast<CmpInst>(select->getCondition());
+  if (  false
+        || comparison == nullptr
+        || sccOfVariableOnly->isInternal(comparison)
+    ){
+    return ;
+  }
+
+  Value *newValue = nullptr;
+  if (select->getFalseValue() == declarationPHI) {
+    newValue = select->getTrueValue();
+  } else if (select->getTrueValue() == declarationPHI) {
+    newValue = select->getFalseValue();
+  }
+  if (  false
+        || newValue == nullptr
+        || sccOfVariableOnly->isInternal(newValue)
+    ){
+    return ;
+  }
+
+  this->selectionUpdate = select;
+  this->selectingComparison = comparison;
+  this->selectedValue = newValue;
+  this->isNewValueSelectedWhenTrue = select->getTrueValue() == newValue;
+
+  return ;
+}
+
+bool LoopCarriedVariable::isEvolutionOfMinMaxReducible (void) const {
+
+  /*
+   * All consumers, except the selects tracking the min/max, must be live out intermediate values of the variable
+   */
+  auto consumers = getConsumersOfVariable();
+  for (auto trackingSelect : selectsTrackingMinMax) {
+    consumers.erase(trackingSelect);
+  }
+  if (!areValuesPropagatingVariableIntermediatesOutsideLoop(consumers)) return false;
+
+  return true;
+}
+
+CmpInst::Predicate LoopCarriedVariable::getMinMaxPredicate (void) const {
+  return minMaxPredicate;
+}
+
+Instruction *LoopCarriedVariable::getMinMaxUpdate (void) const {
+  return minMaxUpdate;
+}
+
+CmpInst *LoopCarriedVariable::getMinMaxComparison (void) const {
+  return minMaxComparison;
+}
+
+std::unordered_set<SelectInst *> LoopCarriedVariable::getSelectsTrackingMinMax (void) const {
+  return selectsTrackingMinMax;
+}
+
+SelectInst *LoopCarriedVariable::getSelectionUpdate (void) const {
+  return selectionUpdate;
+}
+
+CmpInst *LoopCarriedVariable::getSelectingComparison (void) const {
+  return selectingComparison;
+}
+
+Value *LoopCarriedVariable::getSelectedValue (void) const {
+  return selectedValue;
+}
+
+bool LoopCarriedVariable::isNewValueSelectedWhenConditionHolds (void) const {
+  return isNewValueSelectedWhenTrue;
+}
+
+void LoopCarriedVariable::setAsIndexOfMinMax (LoopCarriedVariable *minMaxVariable, CmpInst::Predicate tiePredicate) {
+  assert(selectionUpdate != nullptr
+    && "Only variables selecting an external value can be the index of a min/max reduction");
+  this->minMaxVariableOfIndex = minMaxVariable;
+  this->indexTiePredicate = tiePredicate;
+
+  return ;
+}
+
+LoopCarriedVariable *LoopCarriedVariable::getMinMaxVariableOfIndex (void) const {
+  return minMaxVariableOfIndex;
+}
+
+CmpInst::Predicate LoopCarriedVariable::getIndexTiePredicate (void) const {
+  return indexTiePredicate;
+}
+
 PDG *LoopCarriedVariable::produceDataAndMemoryOnlyDGFromVariableDG(PDG &variableDG) const {
 
   /*
@@ -422,18 +708,258 @@ bool LoopCarriedVariable::hasRoundingError (std::unordered_set<EvolutionUpdate *
  * LoopCarriedMemoryLocation implementation
  */
 
-/*
- * TODO: Implement
- */
 LoopCarriedMemoryLocation::LoopCarriedMemoryLocation (
   const LoopStructure &loop,
   PDG &loopDG,
   SCC &memoryLocationSCC,
   Value *memoryLocation
-) {}
+) : isValid{false}, memoryLocation{memoryLocation}, elementType{nullptr}, numberOfElements{0}, reducingOperator{0} {
+
+  /*
+   * The array must be allocated outside the loop
+   */
+  if (auto allocation = dyn_cast<Instruction>(memoryLocation)) {
+    if (loop.isIncluded(allocation)) return;
+  }
+
+  /*
+   * The SCC must be composed only by loads of elements, their updates, and stores of the updated elements
+   */
+  std::unordered_set<LoadInst *> loads;
+  std::unordered_set<StoreInst *> stores;
+  for (auto nodePair : memoryLocationSCC.internalNodePairs()) {
+    auto value = nodePair.first;
+    if (auto load = dyn_cast<LoadInst>(value)) {
+      loads.insert(load);
+    } else if (auto store = dyn_cast<StoreInst>(value)) {
+      stores.insert(store);
+    } else if (!isa<BinaryOperator>(value)) {
+      return;
+    }
+  }
+  if (  false
+        || (stores.size() == 0)
+        || (loads.size() != stores.size())
+     ){
+    return;
+  }
+
+  /*
+   * Each store must save the update of the element it loaded: a[j] = a[j] OP x
+   * The loaded element must be used only by the update, and the update must be used only by the store
+   */
+  std::unordered_set<Value *> accesses;
+  for (auto store : stores) {
+    auto update = dyn_cast<BinaryOperator>(store->getValueOperand());
+    if (  false
+          || !store->isSimple()
+          || !update
+          || !memoryLocationSCC.isInternal(update)
+          || !update->hasOneUse()
+       ){
+      return;
+    }
+
+    LoadInst *load = nullptr;
+    for (auto &op : update->operands()) {
+      if (!memoryLocationSCC.isInternal(op.get())) continue;
+      if (load != nullptr) return;
+      load = dyn_cast<LoadInst>(op.get());
+    }
+    if (  false
+          || !load
+          || !load->isSimple()
+          || !load->hasOneUse()
+          || (loads.find(load) == loads.end())
+          || (load->getPointerOperand() != store->getPointerOperand())
+       ){
+      return;
+    }
+
+    /*
+     * All elements must have the same type
+     */
+    auto type = load->getType();
+    if (  false
+          || (!type->isIntegerTy() && !type->isFloatingPointTy())
+          || (this->elementType && (this->elementType != type))
+       ){
+      return;
+    }
+    this->elementType = type;
+
+    /*
+     * The element must be accessed by indexing a loop invariant pointer to the beginning of the array
+     */
+    auto gep = dyn_cast<GetElementPtrInst>(store->getPointerOperand());
+    if (  false
+          || !gep
+          || !loop.isIncluded(gep)
+          || (gep->getResultElementType() != type)
+       ){
+      return;
+    }
+    auto pointer = gep->getPointerOperand();
+    if (pointer->stripPointerCasts() != memoryLocation) return;
+    if (auto pointerInst = dyn_cast<Instruction>(pointer)) {
+      if (loop.isIncluded(pointerInst)) return;
+    }
+    for (auto user : gep->users()) {
+      if (  true
+            && (user != load)
+            && (user != store)
+         ){
+        return;
+      }
+    }
+    this->pointersToMemoryLocation.insert(pointer);
+    accesses.insert(load);
+    accesses.insert(store);
+
+    this->memoryLocationUpdates.insert(new EvolutionUpdate(update, &memoryLocationSCC));
+  }
+
+  /*
+   * All updates must be commutative and associative with each other
+   */
+  for (auto update : this->memoryLocationUpdates) {
+    if (  false
+          || !update->isTransformablyCommutativeWithSelf()
+          || !update->isAssociativeWithSelf()
+       ){
+      return;
+    }
+    for (auto otherUpdate : this->memoryLocationUpdates) {
+      if (  false
+            || !update->isTransformablyCommutativeWith(*otherUpdate)
+            || !update->isAssociativeWith(*otherUpdate)
+         ){
+        return;
+      }
+    }
+  }
+
+  /*
+   * Partial values of an element must be combinable atomically
+   */
+  auto anyUpdate = (*this->memoryLocationUpdates.begin())->getUpdateInstruction();
+  switch (anyUpdate->getOpcode()) {
+    case Instruction::Add:
+    case Instruction::Sub:
+      this->reducingOperator = Instruction::Add;
+      break ;
+    case Instruction::FAdd:
+    case Instruction::FSub:
+      this->reducingOperator = Instruction::FAdd;
+      break ;
+    case Instruction::Or:
+    case Instruction::And:
+    case Instruction::Xor:
+      this->reducingOperator = anyUpdate->getOpcode();
+      break ;
+    default:
+      return;
+  }
+
+  /*
+   * The loop must not access the array other than through the updates
+   */
+  for (auto pointer : this->pointersToMemoryLocation) {
+    for (auto user : pointer->users()) {
+      auto userInst = dyn_cast<Instruction>(user);
+      if (  false
+            || !userInst
+            || !loop.isIncluded(userInst)
+         ){
+        continue;
+      }
+      auto gep = dyn_cast<GetElementPtrInst>(userInst);
+      if (!gep) return;
+      for (auto gepUser : gep->users()) {
+        if (accesses.find(gepUser) == accesses.end()) return;
+      }
+    }
+  }
+  for (auto access : accesses) {
+    auto node = loopDG.fetchNode(access);
+    for (auto edge : node->getAllConnectedEdges()) {
+      if (!edge->isMemoryDependence()) continue;
+      auto other = (edge->getOutgoingT() == access) ? edge->getIncomingT() : edge->getOutgoingT();
+      auto otherInst = dyn_cast<Instruction>(other);
+      if (  true
+            && otherInst
+            && loop.isIncluded(otherInst)
+            && (accesses.find(otherInst) == accesses.end())
+         ){
+        return;
+      }
+    }
+  }
+
+  /*
+   * The size of the array must be known at compile time
+   */
+  auto &DL = loop.getHeader()->getModule()->getDataLayout();
+  if (!this->computeNumberOfElements(DL, DL.getTypeAllocSize(this->elementType))) return;
+
+  this->isValid = true;
+}
+
+LoopCarriedMemoryLocation::~LoopCarriedMemoryLocation () {
+  for (auto update : this->memoryLocationUpdates) {
+    delete update;
+  }
+}
+
+bool LoopCarriedMemoryLocation::computeNumberOfElements (const DataLayout &DL, uint64_t elementSize) {
+  uint64_t sizeInBytes = 0;
+  if (auto global = dyn_cast<GlobalVariable>(this->memoryLocation)) {
+    auto type = global->getValueType();
+    if (!type->isSized()) return false;
+    sizeInBytes = DL.getTypeAllocSize(type);
+
+  } else if (auto alloca = dyn_cast<AllocaInst>(this->memoryLocation)) {
+    auto sizeInBits = alloca->getAllocationSizeInBits(DL);
+    if (!sizeInBits.hasValue()) return false;
+    sizeInBytes = sizeInBits.getValue() / 8;
+
+  } else if (auto call = dyn_cast<CallInst>(this->memoryLocation)) {
+    sizeInBytes = ClonableMemoryLocation::getHeapAllocationSizeInBytes(call);
+  }
+  if (  false
+        || (sizeInBytes == 0)
+        || (elementSize == 0)
+        || ((sizeInBytes % elementSize) != 0)
+     ){
+    return false;
+  }
+
+  this->numberOfElements = sizeInBytes / elementSize;
+  return true;
+}
 
 bool LoopCarriedMemoryLocation::isEvolutionReducibleAcrossLoopIterations (void) const {
-  return false;
+  return this->isValid;
+}
+
+Value *LoopCarriedMemoryLocation::getMemoryLocation (void) const {
+  return this->memoryLocation;
+}
+
+Type *LoopCarriedMemoryLocation::getElementType (void) const {
+  return this->elementType;
+}
+
+uint64_t LoopCarriedMemoryLocation::getNumberOfElements (void) const {
+  return this->numberOfElements;
+}
+
+std::unordered_set<Value *> LoopCarriedMemoryLocation::getPointersToMemoryLocation (void) const {
+  return this->pointersToMemoryLocation;
+}
+
+unsigned LoopCarriedMemoryLocation::getReducingOperator (void) const {
+  return this->reducingOperator;
 }
 
 /************************************************************************************
@@ -16,6 +16,7 @@
 #include "LoopDependenceInfo.hpp"
 #include "Queue.hpp"
 #include "HotProfiler.hpp"
+#include "DependenceProfiles.hpp"
 #include "DataFlow.hpp"
 #include "Scheduler.hpp"
 #include "StayConnectedNestedLoopForest.hpp"
@@ -138,10 +139,29 @@ namespace llvm::noelle {
 
       Hot * getProfiles (void) ;
 
+      /*
+       * Recompute the profiles after the code of the program has been modified.
+       */
+      void updateProfiles (void) ;
+
+      DependenceProfiles * getDependenceProfiles (void) ;
+
       PDG * getProgramDependenceGraph (void) ;
 
       PDG * getFunctionDependenceGraph (Function *f) ;
 
+      /*
+       * Discard the dependences of @f because its code has been modified.
+       * The PDG of the program and the dependence graph of @f will be recomputed the next time they are requested.
+       */
+      void invalidateFunctionDependenceGraph (Function *f) ;
+
+      /*
+       * Discard the dependences of @f because @addedInstructions have been added to it (e.g., by inlining a call in @f).
+       * The analyses keep using what they know about the other instructions of @f.
+       */
+      void invalidateFunctionDependenceGraph (Function *f, const std::unordered_set<Instruction *> &addedInstructions) ;
+
       DataFlowAnalysis getDataFlowAnalyses (void) const ;
 
       DataFlowEngine getDataFlowEngine (void) const ;
@@ -185,14 +205,21 @@ namespace llvm::noelle {
         Function *startingPoint
         );
 
+      /*
+       * Link the parallelized loop to the function that includes the original loop.
+       *
+       * @envOffsetForExitVariable is the position of the exit block variable within the environment array @envArray.
+       * This is the offset given by the layout of the environment (see EnvBuilder::getEnvVarOffset), not the index of the variable in the environment.
+       */
       void linkTransformedLoopToOriginalFunction (
         Module *module,
         BasicBlock *originalPreHeader,
         BasicBlock *startOfParLoopInOriginalFunc,
         BasicBlock *endOfParLoopInOriginalFunc,
         Value *envArray,
-        Value *envIndexForExitVariable,
-        std::vector<BasicBlock *> &loopExitBlocks
+        Value *envOffsetForExitVariable,
+        std::vector<BasicBlock *> &loopExitBlocks,
+        BasicBlock *misspeculationOfParLoopInOriginalFunc = nullptr
         );
 
       ~Noelle();
@@ -203,6 +230,7 @@ namespace llvm::noelle {
       double minHot;
       Module *program;
       Hot *profiles;
+      DependenceProfiles *dependenceProfiles;
       PDG *programDependenceGraph;
       std::unordered_set<Transformation> enabledTransformations;
       uint32_t maxCores;
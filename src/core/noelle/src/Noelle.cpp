@@ -21,6 +21,7 @@ Noelle::Noelle()
   , minHot{0.0}
   , program{nullptr}
   , profiles{nullptr}
+  , dependenceProfiles{nullptr}
   , programDependenceGraph{nullptr}
   , maxCores{Architecture::getNumberOfPhysicalCores()}
   , hoistLoopsToMain{false}
@@ -103,8 +104,9 @@ void Noelle::linkTransformedLoopToOriginalFunction (
     BasicBlock *startOfParLoopInOriginalFunc,
     BasicBlock *endOfParLoopInOriginalFunc,
     Value *envArray,
-    Value *envIndexForExitVariable,
-    std::vector<BasicBlock *> &loopExitBlocks
+    Value *envOffsetForExitVariable,
+    std::vector<BasicBlock *> &loopExitBlocks,
+    BasicBlock *misspeculationOfParLoopInOriginalFunc
     ){
 
   /*
@@ -147,15 +149,13 @@ void Noelle::linkTransformedLoopToOriginalFunction (
   } else {
 
     /*
-     * Compute how many values can fit in a cache line.
+     * Fetch the exit block variable, which is stored at "envOffsetForExitVariable" within the environment array (see EnvBuilder).
      */
-    auto valuesInCacheLine = Architecture::getCacheLineBytes() / sizeof(int64_t);
-
     auto exitEnvPtr = endBuilder.CreateInBoundsGEP(
         envArray,
         ArrayRef<Value*>({
           cast<Value>(ConstantInt::get(int64, 0)),
-          endBuilder.CreateMul(envIndexForExitVariable, ConstantInt::get(int64, valuesInCacheLine))
+          envOffsetForExitVariable
           })
         );
     auto exitEnvCast = endBuilder.CreateIntCast(endBuilder.CreateLoad(exitEnvPtr), int32, /*isSigned=*/false);
@@ -175,6 +175,13 @@ void Noelle::linkTransformedLoopToOriginalFunction (
         if (bbIndex == -1) {
           continue;
         }
+
+        /*
+         * The parallelization technique might have already set the value coming from the parallelized loop (e.g., DOALL with early exits).
+         */
+        if (phi->getBasicBlockIndex(endOfParLoopInOriginalFunc) != -1) {
+          continue;
+        }
         auto val = phi->getIncomingValue(bbIndex);
         if (isa<Constant>(val)) {
           phi->addIncoming(val, endOfParLoopInOriginalFunc);
@@ -198,6 +205,24 @@ void Noelle::linkTransformedLoopToOriginalFunction (
   endBuilder.SetInsertPoint(endOfParLoopInOriginalFunc->getTerminator());
   endBuilder.CreateStore(const0, globalBool);
 
+  /*
+   * If the parallelized loop cannot be used for the current invocation (e.g., it misspeculated), then the original loop executes sequentially.
+   * Its header receives the same values it would have received from the pre-header.
+   */
+  if (misspeculationOfParLoopInOriginalFunc != nullptr){
+    IRBuilder<> misspeculationBuilder(misspeculationOfParLoopInOriginalFunc);
+    misspeculationBuilder.CreateStore(const0, globalBool);
+    misspeculationBuilder.CreateBr(originalHeader);
+    for (auto &I : *originalHeader){
+      auto phi = dyn_cast<PHINode>(&I);
+      if (phi == nullptr){
+        break ;
+      }
+      auto initialValue = phi->getIncomingValueForBlock(originalPreHeader);
+      phi->addIncoming(initialValue, misspeculationOfParLoopInOriginalFunc);
+    }
+  }
+
   return ;
 }
 
@@ -251,6 +276,25 @@ Hot * Noelle::getProfiles (void) {
   return this->profiles;
 }
 
+void Noelle::updateProfiles (void) {
+
+  /*
+   * The profiles are updated in place, so the pointer returned by getProfiles stays valid.
+   */
+  getAnalysis<HotProfiler>().updateProfiles(*this->program);
+  this->profiles = &getAnalysis<HotProfiler>().getHot();
+
+  return ;
+}
+
+DependenceProfiles * Noelle::getDependenceProfiles (void) {
+  if (this->dependenceProfiles == nullptr){
+    this->dependenceProfiles = new DependenceProfiles(*this->program);
+  }
+
+  return this->dependenceProfiles;
+}
+
 uint32_t Noelle::getMaximumNumberOfCores (void) const {
   return this->maxCores;
 }
@@ -294,6 +338,9 @@ noelle::CallGraph * Noelle::getProgramCallGraph (void) {
 }
 
 Noelle::~Noelle(){
+  if (this->dependenceProfiles != nullptr){
+    delete this->dependenceProfiles;
+  }
 
   return ;
 }
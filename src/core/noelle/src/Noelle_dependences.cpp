@@ -24,4 +24,26 @@ PDG * Noelle::getFunctionDependenceGraph (Function *f) {
   return this->pdgAnalysis->getFunctionPDG(*f);
 }
 
+void Noelle::invalidateFunctionDependenceGraph (Function *f) {
+  this->pdgAnalysis->invalidateFunctionPDG(*f);
+
+  /*
+   * The PDG of the program is outdated.
+   */
+  this->programDependenceGraph = nullptr;
+
+  return ;
+}
+
+void Noelle::invalidateFunctionDependenceGraph (Function *f, const std::unordered_set<Instruction *> &addedInstructions) {
+  this->pdgAnalysis->invalidateFunctionPDG(*f, addedInstructions);
+
+  /*
+   * The PDG of the program is outdated.
+   */
+  this->programDependenceGraph = nullptr;
+
+  return ;
+}
+
 }
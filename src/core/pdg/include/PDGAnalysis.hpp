@@ -50,10 +50,24 @@ namespace llvm::noelle {
 
       noelle::CallGraph * getProgramCallGraph (void);
 
+      /*
+       * Discard the dependences of @F because its code has been modified (e.g., a call has been inlined in @F).
+       * The dependence graph of @F, and the PDG of the program, will be recomputed the next time they are requested.
+       */
+      void invalidateFunctionPDG (Function &F) ;
+
+      /*
+       * Discard the dependences of @F because instructions have been added to it (e.g., by inlining a call in @F).
+       * All the other instructions of @F must have existed when the dependences of @F have been computed.
+       */
+      void invalidateFunctionPDG (Function &F, const std::unordered_set<Instruction *> &addedInstructions) ;
+
     private:
       Module *M;
       PDG *programDependenceGraph;
       std::unordered_map<Function *, PDG *> functionToFDGMap;
+      std::unordered_set<Function *> modifiedFunctions;
+      std::unordered_set<Function *> functionsModifiedAfterPDG;
       AllocAA *allocAA;
       std::set<Function *> CGUnderMain;
       TalkDown *talkdown;
@@ -70,11 +84,48 @@ namespace llvm::noelle {
       PTACallGraph *callGraph;
       MemSSA *mssa;
 
+      /*
+       * Results of SVF persisted across invocations on the same module.
+       */
+      bool forceSVF;
+      std::string svfResultsDirectory;
+      std::string svfResultsFileName;
+      std::string svfModuleHash;
+      bool svfResultsLoaded;
+      bool svfResultsModified;
+      std::vector<const Function *> svfFunctions;
+      std::unordered_map<const Function *, uint64_t> svfFunctionIDs;
+      std::vector<uint64_t> svfFunctionFirstInstructionIDs;
+      std::vector<Instruction *> svfInstructions;
+      std::unordered_map<Instruction *, uint64_t> svfInstructionIDs;
+      std::unordered_map<CallInst *, std::set<const Function *>> svfIndirectCallees;
+      std::unordered_map<CallInst *, ModRefInfo> svfModRefOfCalls;
+      std::map<std::pair<Instruction *, Instruction *>, ModRefInfo> svfModRefOfCallsToMemory;
+      std::map<std::pair<Instruction *, Instruction *>, AliasResult> svfAliases;
+      std::unordered_set<const Function *> functionsModifiedAfterSVF;
+      std::unordered_set<const Instruction *> instructionsAddedAfterSVF;
+
       std::unordered_set<const Function *> internalFuncs;
       std::unordered_set<const Function *> unhandledExternalFuncs;
       std::unordered_map<const Function *, std::unordered_set<const Function *>> reachableUnhandledExternalFuncs;
       
       void initializeSVF(Module &M);
+      void computeSVF(Module &M);
+      std::string computeSVFResultsFileName(Module &M);
+      bool loadSVFResults(Module &M);
+      void saveSVFResults(void);
+      void stopSavingSVFResults(void);
+      bool hasSVFResultsOf(Instruction *inst) const;
+      void invalidateSVFResultsOf(Function &F);
+      void invalidateSVFResultsOf(Function &F, const std::unordered_set<Instruction *> &addedInstructions);
+      void forgetSVFResultsOf(Function &F);
+      bool isAddedAfterSVF(Instruction *inst) const;
+      bool canSVFAnalyze(Instruction *inst) const;
+      std::set<const Function *> getSVFIndirectCallees(CallInst *call);
+      ModRefInfo getSVFModRefInfo(CallInst *call);
+      ModRefInfo getSVFModRefInfo(CallInst *call, Instruction *memoryInst);
+      ModRefInfo getSVFModRefInfo(CallInst *call, CallInst *otherCall);
+      AliasResult getSVFAliasResult(Instruction *instI, Instruction *instJ);
       void identifyFunctionsThatInvokeUnhandledLibrary(Module &M);
       void printFunctionReachabilityResult();
       bool isSafeToQueryModRefOfSVF(CallInst *call, BitVector &bv);
@@ -88,6 +139,7 @@ namespace llvm::noelle {
       bool compareEdges(PDG *, PDG *);
 
       bool hasPDGAsMetadata(Module &);
+      bool hasFunctionDGAsMetadata(Function &);
 
       PDG * constructPDGFromMetadata(Module &);
       PDG * constructFunctionDGFromMetadata(Function &);
@@ -108,6 +160,7 @@ namespace llvm::noelle {
 
       PDG * constructPDGFromAnalysis(Module &M);
       PDG * constructFunctionDGFromAnalysis(Function &F);
+      void discardFunctionPDG (Function &F);
       void constructEdgesFromUseDefs (PDG *pdg);
       void constructEdgesFromAliases (PDG *pdg, Module &M);
       void constructEdgesFromControl (PDG *pdg, Module &M);
@@ -9,6 +9,7 @@
  * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
  */
 #include "SystemHeaders.hpp"
+#include "CompileTimeProfiler.hpp"
 
 #include "Util/SVFModule.h"
 #include "WPA/Andersen.h"
@@ -32,22 +33,29 @@ PDGAnalysis::PDGAnalysis()
     , disableAllocAA{false}
     , disableRA{false}
     , printer{} 
+    , pta{nullptr}
+    , callGraph{nullptr}
+    , mssa{nullptr}
+    , forceSVF{false}
+    , svfResultsDirectory{}
+    , svfResultsFileName{}
+    , svfModuleHash{}
+    , svfResultsLoaded{false}
+    , svfResultsModified{false}
   {
 
   return ;
 }
 
-void PDGAnalysis::initializeSVF(Module &M) {
-  SVFModule svfModule{M};
-  this->pta = new AndersenWaveDiff();
-  this->pta->analyze(svfModule);
-  this->callGraph = this->pta->getPTACallGraph();
-  this->mssa = new MemSSA((BVDataPTAImpl *)this->pta, false);
+void PDGAnalysis::releaseMemory () {
 
-  return;
-}
+  /*
+   * Persist the results of SVF queried since the last time they have been saved.
+   */
+  if (this->M != nullptr) {
+    this->saveSVFResults();
+  }
 
-void PDGAnalysis::releaseMemory () {
   if (this->programDependenceGraph) delete this->programDependenceGraph;
   this->programDependenceGraph = nullptr;
 
@@ -94,7 +102,10 @@ PDG * PDGAnalysis::getFunctionPDG (Function &F) {
    * Else, construct the function DG from scratch (or from metadata)
    */
   PDG *pdg = nullptr;
-  if (this->programDependenceGraph){
+  if (  true
+        && (this->programDependenceGraph != nullptr)
+        && (this->functionsModifiedAfterPDG.find(&F) == this->functionsModifiedAfterPDG.end())
+     ){
 
     /*
      * Check and get/update the function cache
@@ -122,7 +133,7 @@ PDG * PDGAnalysis::getFunctionPDG (Function &F) {
       /*
        * Determine whether metadata can be used to construct the graph
        */
-      if (this->hasPDGAsMetadata(*this->M)) {
+      if (this->hasFunctionDGAsMetadata(F)){
         pdg = constructFunctionDGFromMetadata(F);
         for (auto edge : pdg->getEdges()) {
           assert(!edge->isLoopCarriedDependence() && "Flag was already set");
@@ -160,7 +171,16 @@ PDG * PDGAnalysis::getPDG (void){
    * Check if we have already built the PDG.
    */
   if (this->programDependenceGraph){
-    return this->programDependenceGraph;
+    if (this->functionsModifiedAfterPDG.empty()){
+      return this->programDependenceGraph;
+    }
+
+    /*
+     * Some functions have been modified after the PDG has been built.
+     */
+    delete this->programDependenceGraph;
+    this->programDependenceGraph = nullptr;
+    this->functionsModifiedAfterPDG.clear();
   }
 
   /*
@@ -168,14 +188,36 @@ PDG * PDGAnalysis::getPDG (void){
    *
    * Check if we have already done it and the PDG has been embedded in the IR.
    */
-  if (this->hasPDGAsMetadata(*this->M)) {
+  if (this->hasPDGAsMetadata(*this->M)){
 
     /*
      * The PDG has been embedded in the IR.
      *
      * Load the embedded PDG.
+     * The dependences of the functions that have been modified after the PDG was embedded are computed again.
      */
+    auto isPDGFullyEmbedded = true;
+    for (auto &F : *this->M){
+      if (  true
+            && (!F.empty())
+            && (!this->hasFunctionDGAsMetadata(F))
+         ){
+        isPDGFullyEmbedded = false;
+        break ;
+      }
+    }
     this->programDependenceGraph = constructPDGFromMetadata(*this->M);
+
+    /*
+     * Check if we should embed the dependences computed again.
+     */
+    if (  true
+          && this->embedPDG
+          && (!isPDGFullyEmbedded)
+       ){
+      embedPDGAsMetadata(this->programDependenceGraph);
+      this->modifiedFunctions.clear();
+    }
     if (this->performThePDGComparison){
       auto PDGFromAnalysis = constructPDGFromAnalysis(*this->M);
       auto arePDGsEquivalent = this->comparePDGs(PDGFromAnalysis, this->programDependenceGraph);
@@ -200,6 +242,7 @@ PDG * PDGAnalysis::getPDG (void){
      */
     if (this->embedPDG){
       embedPDGAsMetadata(this->programDependenceGraph);
+      this->modifiedFunctions.clear();
       if (this->performThePDGComparison){
         auto PDGFromMetadata = this->constructPDGFromMetadata(*this->M);
         auto arePDGsEquivalen = this->comparePDGs(this->programDependenceGraph, PDGFromMetadata);
@@ -215,6 +258,54 @@ PDG * PDGAnalysis::getPDG (void){
   return this->programDependenceGraph;
 }
 
+void PDGAnalysis::invalidateFunctionPDG (Function &F) {
+  this->discardFunctionPDG(F);
+
+  /*
+   * Forget the results of SVF that are related to the old code of @F.
+   * SVF does not know any instruction of the new code of @F.
+   */
+  this->invalidateSVFResultsOf(F);
+
+  return ;
+}
+
+void PDGAnalysis::invalidateFunctionPDG (Function &F, const std::unordered_set<Instruction *> &addedInstructions) {
+  this->discardFunctionPDG(F);
+
+  /*
+   * Forget the results of SVF that are related to the old code of @F.
+   * SVF still knows the instructions of @F that have not been added.
+   */
+  this->invalidateSVFResultsOf(F, addedInstructions);
+
+  return ;
+}
+
+void PDGAnalysis::discardFunctionPDG (Function &F) {
+
+  /*
+   * Free the dependence graph of @F.
+   */
+  auto fdgIt = this->functionToFDGMap.find(&F);
+  if (fdgIt != this->functionToFDGMap.end()){
+    delete fdgIt->second;
+    this->functionToFDGMap.erase(fdgIt);
+  }
+
+  /*
+   * Keep track of the modification.
+   *
+   * The PDG of the program is now outdated only for @F, so it can still be used to extract the dependence graphs of the other functions.
+   */
+  if (this->programDependenceGraph != nullptr){
+    this->functionsModifiedAfterPDG.insert(&F);
+  }
+  this->modifiedFunctions.insert(&F);
+
+  return ;
+}
+
 bool PDGAnalysis::hasPDGAsMetadata(Module &M) {
   if (auto n = M.getNamedMetadata("noelle.module.pdg")) {
     if (auto m = dyn_cast<MDNode>(n->getOperand(0))) {
@@ -227,6 +318,24 @@ bool PDGAnalysis::hasPDGAsMetadata(Module &M) {
   return false;
 }
 
+bool PDGAnalysis::hasFunctionDGAsMetadata(Function &F) {
+
+  /*
+   * The metadata of functions modified after the PDG has been embedded are outdated.
+   */
+  if (  false
+        || (!this->hasPDGAsMetadata(*this->M))
+        || (this->modifiedFunctions.find(&F) != this->modifiedFunctions.end())
+     ){
+    return false;
+  }
+
+  /*
+   * Tools that transform the code drop the tag of the functions they modify (e.g., noelle-pipeline).
+   */
+  return F.getMetadata("noelle.pdg.function") != nullptr;
+}
+
 PDG * PDGAnalysis::constructPDGFromAnalysis(Module &M) {
   if (verbose >= PDGVerbosity::Maximal) {
     errs() << "PDGAnalysis: Construct PDG from Analysis\n";
@@ -271,6 +380,23 @@ PDG * PDGAnalysis::constructPDGFromMetadata(Module &M) {
    */
   std::unordered_map<MDNode *, Value *> IDNodeMap;
   for (auto &F : M) {
+
+    /*
+     * Compute the dependences of the functions whose graph has not been embedded.
+     */
+    if (!this->hasFunctionDGAsMetadata(F)) {
+      if (F.empty()) {
+        continue ;
+      }
+      auto fdg = this->constructFunctionDGFromAnalysis(F);
+      this->trimDGUsingCustomAliasAnalysis(fdg);
+      for (auto edge : fdg->getEdges()) {
+        pdg->copyAddEdge(*edge);
+      }
+      delete fdg;
+      continue ;
+    }
+
     constructNodesFromMetadata(pdg, F, IDNodeMap);
     constructEdgesFromMetadata(pdg, F, IDNodeMap);
   }
@@ -519,6 +645,7 @@ void PDGAnalysis::constructEdgesFromAliases (PDG *pdg, Module &M){
 }
 
 void PDGAnalysis::constructEdgesFromAliasesForFunction (PDG *pdg, Function &F){
+  CompileTimeScope profile("pdg-alias-edges", F);
 
   /*
    * Fetch the alias analysis.
@@ -20,7 +20,9 @@ using namespace llvm;
 using namespace llvm::noelle;
 
 noelle::CallGraph * PDGAnalysis::getProgramCallGraph (void){
-  auto cg = new noelle::CallGraph(*M, this->callGraph);
+  auto cg = new noelle::CallGraph(*M, [this](CallInst *call) -> std::set<const Function *> {
+    return this->getSVFIndirectCallees(call);
+  });
 
   return cg;
 }
@@ -44,7 +46,12 @@ void PDGAnalysis::identifyFunctionsThatInvokeUnhandledLibrary(Module &M) {
 
   /*
    * Identify function reachability.
+   *
+   * Check if it has been loaded together with the other results of SVF.
    */
+  if (this->svfResultsLoaded) {
+    return ;
+  }
   for (auto &internal : this->internalFuncs) {
     for (auto &external : this->unhandledExternalFuncs) {
       if (this->callGraph->isReachableBetweenFunctions(internal, external)) {
@@ -57,8 +64,8 @@ void PDGAnalysis::identifyFunctionsThatInvokeUnhandledLibrary(Module &M) {
 }
 
 bool PDGAnalysis::cannotReachUnhandledExternalFunction(CallInst *call) {
-  if (this->callGraph->hasIndCSCallees(call)) {
-    const set<const Function *> callees = this->callGraph->getIndCSCallees(call);
+  auto callees = this->getSVFIndirectCallees(call);
+  if (callees.size() > 0) {
     for (auto &callee : callees) {
       if (this->isUnhandledExternalFunction(callee) || isInternalFunctionThatReachUnhandledExternalFunction(callee)) return false;
     }
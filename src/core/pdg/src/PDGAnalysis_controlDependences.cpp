@@ -9,6 +9,7 @@
  * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
  */
 #include "SystemHeaders.hpp"
+#include "CompileTimeProfiler.hpp"
 
 #include "Util/SVFModule.h"
 #include "WPA/Andersen.h"
@@ -42,6 +43,7 @@ void PDGAnalysis::constructEdgesFromControl (PDG *pdg, Module &M){
 
 void PDGAnalysis::constructEdgesFromControlForFunction (PDG *pdg, Function &F) {
   assert(pdg != nullptr);
+  CompileTimeScope profile("pdg-control-dependences", F);
 
   /*
    * Fetch the post-dominator tree of the function.
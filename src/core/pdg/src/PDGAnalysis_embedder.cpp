@@ -25,9 +25,26 @@ void PDGAnalysis::embedPDGAsMetadata(PDG *pdg) {
   auto &C = this->M->getContext();
   unordered_map<Value *, MDNode *> nodeIDMap;
 
+  /*
+   * Drop the edges embedded before, so functions that have no edges now do not keep outdated ones.
+   */
+  for (auto &F : *this->M) {
+    F.setMetadata("noelle.pdg.edges", nullptr);
+  }
+
   embedNodesAsMetadata(pdg, C, nodeIDMap);
   embedEdgesAsMetadata(pdg, C, nodeIDMap);
 
+  /*
+   * Tag the functions whose dependence graph has been embedded.
+   */
+  for (auto &F : *this->M) {
+    if (F.empty()) {
+      continue ;
+    }
+    F.setMetadata("noelle.pdg.function", MDNode::get(C, MDString::get(C, "true")));
+  }
+
   auto n = this->M->getOrInsertNamedMetadata("noelle.module.pdg");
   n->addOperand(MDNode::get(C, MDString::get(C, "true")));
 
@@ -90,7 +90,7 @@ bool PDGAnalysis::hasNoMemoryOperations (CallInst *call) {
    * SVF is enabled.
    * We can use it.
    */
-  if (this->mssa->getMRGenerator()->getModRefInfo(call) == ModRefInfo::NoModRef) {
+  if (this->getSVFModRefInfo(call) == ModRefInfo::NoModRef) {
     return true;
   }
 
@@ -138,7 +138,7 @@ void PDGAnalysis::addEdgeFromFunctionModRef (PDG *pdg, Function &F, AAResults &A
      * This is due to a bug in SVF that doesn't model I/O library calls correctly.
      */
     if (isSafeToQueryModRefOfSVF(call, bv)) {
-      switch (this->mssa->getMRGenerator()->getModRefInfo(call, MemoryLocation::get(store))) {
+      switch (this->getSVFModRefInfo(call, (Instruction *)store)) {
         case ModRefInfo::NoModRef:
           return;
         case ModRefInfo::Ref:
@@ -224,7 +224,7 @@ void PDGAnalysis::addEdgeFromFunctionModRef (PDG *pdg, Function &F, AAResults &A
      * This is due to a bug in SVF that doesn't model I/O library calls correctly.
      */
     if (isSafeToQueryModRefOfSVF(call, bv)) {
-      switch (this->mssa->getMRGenerator()->getModRefInfo(call, MemoryLocation::get(load))) {
+      switch (this->getSVFModRefInfo(call, (Instruction *)load)) {
         case ModRefInfo::NoModRef:
         case ModRefInfo::Ref:
           return;
@@ -312,7 +312,7 @@ void PDGAnalysis::addEdgeFromFunctionModRef (PDG *pdg, Function &F, AAResults &A
           && isSafeToQueryModRefOfSVF(call, bv) 
           && isSafeToQueryModRefOfSVF(otherCall, bv)
       ) {
-      switch (this->mssa->getMRGenerator()->getModRefInfo(call, otherCall)) {
+      switch (this->getSVFModRefInfo(call, otherCall)) {
         case ModRefInfo::NoModRef:
           return;
         case ModRefInfo::Ref:
@@ -320,7 +320,7 @@ void PDGAnalysis::addEdgeFromFunctionModRef (PDG *pdg, Function &F, AAResults &A
           break;
         case ModRefInfo::Mod:
           bv[1] = true;
-          switch (this->mssa->getMRGenerator()->getModRefInfo(otherCall, call)) {
+          switch (this->getSVFModRefInfo(otherCall, call)) {
             case ModRefInfo::NoModRef:
               return;
             case ModRefInfo::Ref:
@@ -408,8 +408,8 @@ bool PDGAnalysis::isSafeToQueryModRefOfSVF(CallInst *call, BitVector &bv) {
     return false;
   }
 
-  if (this->callGraph->hasIndCSCallees(call)) {
-    const set<const Function *> callees = this->callGraph->getIndCSCallees(call);
+  auto callees = this->getSVFIndirectCallees(call);
+  if (callees.size() > 0) {
     for (auto &callee : callees) {
       if (this->isUnhandledExternalFunction(callee) || isInternalFunctionThatReachUnhandledExternalFunction(callee)) {
         return false;
@@ -465,7 +465,7 @@ void PDGAnalysis::addEdgeFromMemoryAlias (PDG *pdg, Function &F, AAResults &AA,
     /*
      * SVF is enabled, so let's use it.
      */
-    switch (this->pta->alias(MemoryLocation::get(instI), MemoryLocation::get(instJ))) {
+    switch (this->getSVFAliasResult(instI, instJ)) {
       case NoAlias:
         return;
       case PartialAlias:
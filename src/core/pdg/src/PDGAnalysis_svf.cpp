@@ -0,0 +1,628 @@
+/*
+ * Copyright 2016 - 2020  Angelo Matni, Yian Su, Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include <fstream>
+#include <unistd.h>
+
+#include "llvm/Bitcode/BitcodeWriter.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/MD5.h"
+#include "llvm/Support/Path.h"
+
+#include "Util/SVFModule.h"
+#include "WPA/Andersen.h"
+#include "CompileTimeProfiler.hpp"
+#include "PDGAnalysis.hpp"
+
+using namespace llvm;
+using namespace llvm::noelle;
+
+/*
+ * Version of the format of the files that store the results of SVF.
+ * It must change whenever the format does.
+ */
+static const uint64_t svfResultsFormatVersion = 1;
+
+static MemoryLocation getMemoryLocationOf (Instruction *memoryInst) {
+  if (auto load = dyn_cast<LoadInst>(memoryInst)) {
+    return MemoryLocation::get(load);
+  }
+  if (auto store = dyn_cast<StoreInst>(memoryInst)) {
+    return MemoryLocation::get(store);
+  }
+  assert(false && "The instruction does not access a single memory location");
+  abort();
+}
+
+void PDGAnalysis::initializeSVF(Module &M) {
+
+  /*
+   * Number the functions and instructions of the module.
+   * These numbers identify the values of the results of SVF stored in a file.
+   */
+  for (auto &F : M) {
+    this->svfFunctionIDs[&F] = this->svfFunctions.size();
+    this->svfFunctions.push_back(&F);
+    this->svfFunctionFirstInstructionIDs.push_back(this->svfInstructions.size());
+    for (auto &I : instructions(F)) {
+      this->svfInstructionIDs[&I] = this->svfInstructions.size();
+      this->svfInstructions.push_back(&I);
+    }
+  }
+
+  /*
+   * Check if the results of SVF have been already computed for this module.
+   */
+  this->svfResultsFileName = this->computeSVFResultsFileName(M);
+  if (  true
+        && (!this->forceSVF)
+        && (!this->svfResultsFileName.empty())
+        && this->loadSVFResults(M)
+     ){
+    if (this->verbose >= PDGVerbosity::Minimal) {
+      errs() << "PDGAnalysis: SVF results loaded from " << this->svfResultsFileName << "\n";
+    }
+    return ;
+  }
+
+  /*
+   * Run SVF.
+   */
+  this->computeSVF(M);
+
+  return;
+}
+
+void PDGAnalysis::computeSVF(Module &M) {
+  CompileTimeScope profile("svf");
+
+  /*
+   * Run the pointer analysis.
+   */
+  SVFModule svfModule{M};
+  this->pta = new AndersenWaveDiff();
+  this->pta->analyze(svfModule);
+  this->callGraph = this->pta->getPTACallGraph();
+  this->mssa = new MemSSA((BVDataPTAImpl *)this->pta, false);
+
+  /*
+   * Record the callees of the indirect calls.
+   */
+  for (auto &F : M) {
+    for (auto &I : instructions(F)) {
+      auto call = dyn_cast<CallInst>(&I);
+      if (  false
+            || (call == nullptr)
+            || (!this->hasSVFResultsOf(call))
+         ) {
+        continue ;
+      }
+      if (!this->callGraph->hasIndCSCallees(call)) {
+        continue ;
+      }
+      auto &callees = this->callGraph->getIndCSCallees(call);
+      this->svfIndirectCallees[call] = std::set<const Function *>(callees.begin(), callees.end());
+    }
+  }
+  this->svfResultsModified = true;
+
+  return;
+}
+
+std::string PDGAnalysis::computeSVFResultsFileName(Module &M) {
+
+  /*
+   * Hash the bitcode of the module.
+   * The name of the file the module has been read from is excluded because the scripts of NOELLE use temporary files.
+   */
+  auto moduleIdentifier = M.getModuleIdentifier();
+  auto sourceFileName = M.getSourceFileName();
+  M.setModuleIdentifier("");
+  M.setSourceFileName("");
+  SmallVector<char, 0> bitcode;
+  raw_svector_ostream bitcodeStream(bitcode);
+  WriteBitcodeToFile(M, bitcodeStream);
+  M.setModuleIdentifier(moduleIdentifier);
+  M.setSourceFileName(sourceFileName);
+  MD5 hasher;
+  hasher.update(StringRef(bitcode.data(), bitcode.size()));
+  MD5::MD5Result hash;
+  hasher.final(hash);
+  SmallString<32> hashString;
+  MD5::stringifyResult(hash, hashString);
+  this->svfModuleHash = std::string(hashString.str());
+
+  /*
+   * Compute the name of the file.
+   * By default, the file is in the cache directory of the user so other users cannot tamper with it.
+   * The results are not saved if there is no such directory.
+   */
+  SmallString<128> fileName;
+  if (this->svfResultsDirectory.empty()) {
+    if (!sys::path::cache_directory(fileName)) {
+      return "";
+    }
+    sys::path::append(fileName, "noelle", "svf");
+  } else {
+    fileName = this->svfResultsDirectory;
+  }
+  sys::path::append(fileName, this->svfModuleHash + ".svf");
+
+  return std::string(fileName.str());
+}
+
+bool PDGAnalysis::loadSVFResults(Module &M) {
+
+  /*
+   * Open the file.
+   */
+  std::ifstream resultsFile(this->svfResultsFileName);
+  if (!resultsFile.good()) {
+    return false;
+  }
+
+  /*
+   * Check the file describes the module.
+   * The name of the file is not trusted: the hash of the module is checked as well.
+   */
+  std::string header, moduleHash;
+  uint64_t formatVersion, numberOfFunctions, numberOfInstructions;
+  resultsFile >> header >> formatVersion >> moduleHash >> numberOfFunctions >> numberOfInstructions;
+  if (  false
+        || (header != "NOELLE_SVF")
+        || (formatVersion != svfResultsFormatVersion)
+        || (moduleHash != this->svfModuleHash)
+        || (numberOfFunctions != this->svfFunctions.size())
+        || (numberOfInstructions != this->svfInstructions.size())
+     ){
+    return false;
+  }
+
+  /*
+   * Load the results.
+   */
+  auto isInstructionID = [this](uint64_t ID) -> bool {
+    return ID < this->svfInstructions.size();
+  };
+  auto isCallID = [this, &isInstructionID](uint64_t ID) -> bool {
+    return isInstructionID(ID) && isa<CallInst>(this->svfInstructions[ID]);
+  };
+  auto isFunctionID = [this](uint64_t ID) -> bool {
+    return ID < this->svfFunctions.size();
+  };
+  std::string kind;
+  while (resultsFile >> kind) {
+    if (kind == "callees") {
+      uint64_t callID, numberOfCallees;
+      resultsFile >> callID >> numberOfCallees;
+      if (!isCallID(callID)) {
+        return false;
+      }
+      auto &callees = this->svfIndirectCallees[cast<CallInst>(this->svfInstructions[callID])];
+      for (auto i = 0; i < numberOfCallees; i++) {
+        uint64_t calleeID;
+        resultsFile >> calleeID;
+        if (!isFunctionID(calleeID)) {
+          return false;
+        }
+        callees.insert(this->svfFunctions[calleeID]);
+      }
+
+    } else if (kind == "reach") {
+      uint64_t internalID, externalID;
+      resultsFile >> internalID >> externalID;
+      if (!isFunctionID(internalID) || !isFunctionID(externalID)) {
+        return false;
+      }
+      this->reachableUnhandledExternalFuncs[this->svfFunctions[internalID]].insert(this->svfFunctions[externalID]);
+
+    } else if (kind == "modref") {
+      uint64_t callID;
+      int result;
+      resultsFile >> callID >> result;
+      if (!isCallID(callID)) {
+        return false;
+      }
+      this->svfModRefOfCalls[cast<CallInst>(this->svfInstructions[callID])] = static_cast<ModRefInfo>(result);
+
+    } else if (kind == "modrefmem") {
+      uint64_t callID, instID;
+      int result;
+      resultsFile >> callID >> instID >> result;
+      if (!isCallID(callID) || !isInstructionID(instID)) {
+        return false;
+      }
+      auto key = std::make_pair(this->svfInstructions[callID], this->svfInstructions[instID]);
+      this->svfModRefOfCallsToMemory[key] = static_cast<ModRefInfo>(result);
+
+    } else if (kind == "alias") {
+      uint64_t instIID, instJID;
+      int result;
+      resultsFile >> instIID >> instJID >> result;
+      if (!isInstructionID(instIID) || !isInstructionID(instJID)) {
+        return false;
+      }
+      auto key = std::make_pair(this->svfInstructions[instIID], this->svfInstructions[instJID]);
+      this->svfAliases[key] = static_cast<AliasResult>(result);
+
+    } else {
+      return false;
+    }
+  }
+  this->svfResultsLoaded = true;
+
+  return true;
+}
+
+void PDGAnalysis::saveSVFResults(void) {
+
+  /*
+   * Check if there is something new to save.
+   * Nothing can be saved once the module can be transformed (see stopSavingSVFResults).
+   */
+  if (  false
+        || (!this->svfResultsModified)
+        || this->svfResultsFileName.empty()
+        || this->svfFunctionFirstInstructionIDs.empty()
+     ) {
+    return ;
+  }
+
+  /*
+   * Write the results to a temporary file first.
+   * This avoids concurrent invocations of NOELLE from reading a partially written file.
+   */
+  auto directory = sys::path::parent_path(this->svfResultsFileName);
+  if (sys::fs::create_directories(directory)) {
+    return ;
+  }
+  auto temporaryFileName = this->svfResultsFileName + "." + std::to_string(getpid());
+  std::ofstream resultsFile(temporaryFileName);
+  if (!resultsFile.good()) {
+    return ;
+  }
+  resultsFile << "NOELLE_SVF " << svfResultsFormatVersion << " " << this->svfModuleHash << " " << this->svfFunctions.size() << " " << this->svfInstructions.size() << "\n";
+  for (auto &pair : this->svfIndirectCallees) {
+    resultsFile << "callees " << this->svfInstructionIDs.at(pair.first) << " " << pair.second.size();
+    for (auto callee : pair.second) {
+      resultsFile << " " << this->svfFunctionIDs.at(callee);
+    }
+    resultsFile << "\n";
+  }
+  for (auto &pair : this->reachableUnhandledExternalFuncs) {
+    if (this->svfFunctionIDs.find(pair.first) == this->svfFunctionIDs.end()) {
+      continue ;
+    }
+    for (auto external : pair.second) {
+      if (this->svfFunctionIDs.find(external) == this->svfFunctionIDs.end()) {
+        continue ;
+      }
+      resultsFile << "reach " << this->svfFunctionIDs.at(pair.first) << " " << this->svfFunctionIDs.at(external) << "\n";
+    }
+  }
+  for (auto &pair : this->svfModRefOfCalls) {
+    resultsFile << "modref " << this->svfInstructionIDs.at(pair.first) << " " << static_cast<int>(pair.second) << "\n";
+  }
+  for (auto &pair : this->svfModRefOfCallsToMemory) {
+    resultsFile << "modrefmem " << this->svfInstructionIDs.at(pair.first.first) << " " << this->svfInstructionIDs.at(pair.first.second) << " " << static_cast<int>(pair.second) << "\n";
+  }
+  for (auto &pair : this->svfAliases) {
+    resultsFile << "alias " << this->svfInstructionIDs.at(pair.first.first) << " " << this->svfInstructionIDs.at(pair.first.second) << " " << static_cast<int>(pair.second) << "\n";
+  }
+  resultsFile.close();
+  sys::fs::rename(temporaryFileName, this->svfResultsFileName);
+  this->svfResultsModified = false;
+
+  return;
+}
+
+void PDGAnalysis::stopSavingSVFResults(void) {
+
+  /*
+   * The file describes the module as it was when the instructions have been numbered.
+   * Once the module is transformed, SVF could be invoked on the new code and its answers would not describe that module anymore.
+   * The results kept in memory are still used: the ones about the functions that are modified are forgotten (see forgetSVFResultsOf).
+   */
+  this->svfResultsFileName.clear();
+  this->svfResultsModified = false;
+
+  return;
+}
+
+bool PDGAnalysis::hasSVFResultsOf(Instruction *inst) const {
+
+  /*
+   * Check if the instruction has been numbered and its function has not been modified since then.
+   */
+  auto IDIt = this->svfInstructionIDs.find(inst);
+  if (IDIt == this->svfInstructionIDs.end()) {
+    return false;
+  }
+
+  /*
+   * The instruction could have been deleted without invalidating its function (e.g., when its function has been deleted).
+   * Then, its pointer could be reused by a new instruction of another function.
+   */
+  auto &firstIDs = this->svfFunctionFirstInstructionIDs;
+  auto functionID = (std::upper_bound(firstIDs.begin(), firstIDs.end(), IDIt->second) - firstIDs.begin()) - 1;
+
+  return this->svfFunctions[functionID] == inst->getFunction();
+}
+
+void PDGAnalysis::invalidateSVFResultsOf(Function &F) {
+
+  /*
+   * If SVF already ran, then it does not know the new code of @F.
+   */
+  if (this->pta != nullptr) {
+    this->functionsModifiedAfterSVF.insert(&F);
+  }
+  this->forgetSVFResultsOf(F);
+
+  return ;
+}
+
+void PDGAnalysis::invalidateSVFResultsOf(Function &F, const std::unordered_set<Instruction *> &addedInstructions) {
+
+  /*
+   * If SVF already ran, then it only knows the instructions of @F that have not been added.
+   * Its answers about them remain valid as transformations like inlining do not change the values pointers can point to.
+   */
+  if (this->pta != nullptr) {
+    this->instructionsAddedAfterSVF.insert(addedInstructions.begin(), addedInstructions.end());
+  }
+
+  /*
+   * The pointers of the instructions of @F that have been deleted can be reused by the added ones.
+   * Hence, the results cached about @F cannot be trusted anymore.
+   */
+  this->forgetSVFResultsOf(F);
+
+  return ;
+}
+
+void PDGAnalysis::forgetSVFResultsOf(Function &F) {
+
+  /*
+   * Check if the results about the instructions of @F are still kept.
+   */
+  auto functionIDIt = this->svfFunctionIDs.find(&F);
+  if (  false
+        || (functionIDIt == this->svfFunctionIDs.end())
+        || this->svfFunctionFirstInstructionIDs.empty()
+     ) {
+    return ;
+  }
+  auto functionID = functionIDIt->second;
+
+  /*
+   * Fetch the instructions that @F had when they have been numbered.
+   * Some of them might not exist anymore, so only their pointers are used.
+   */
+  auto firstID = this->svfFunctionFirstInstructionIDs[functionID];
+  auto lastID = (functionID + 1) < this->svfFunctionFirstInstructionIDs.size() ? this->svfFunctionFirstInstructionIDs[functionID + 1] : this->svfInstructions.size();
+  std::unordered_set<Instruction *> oldInstructions;
+  for (auto ID = firstID; ID < lastID; ID++) {
+    auto inst = this->svfInstructions[ID];
+    oldInstructions.insert(inst);
+    this->svfInstructionIDs.erase(inst);
+  }
+
+  /*
+   * Forget the results about these instructions.
+   */
+  auto isOld = [&oldInstructions](Instruction *inst) -> bool {
+    return oldInstructions.find(inst) != oldInstructions.end();
+  };
+  for (auto it = this->svfIndirectCallees.begin(); it != this->svfIndirectCallees.end(); ) {
+    it = isOld(it->first) ? this->svfIndirectCallees.erase(it) : std::next(it);
+  }
+  for (auto it = this->svfModRefOfCalls.begin(); it != this->svfModRefOfCalls.end(); ) {
+    it = isOld(it->first) ? this->svfModRefOfCalls.erase(it) : std::next(it);
+  }
+  for (auto it = this->svfModRefOfCallsToMemory.begin(); it != this->svfModRefOfCallsToMemory.end(); ) {
+    it = (isOld(it->first.first) || isOld(it->first.second)) ? this->svfModRefOfCallsToMemory.erase(it) : std::next(it);
+  }
+  for (auto it = this->svfAliases.begin(); it != this->svfAliases.end(); ) {
+    it = (isOld(it->first.first) || isOld(it->first.second)) ? this->svfAliases.erase(it) : std::next(it);
+  }
+
+  return ;
+}
+
+bool PDGAnalysis::isAddedAfterSVF(Instruction *inst) const {
+  return this->instructionsAddedAfterSVF.find(inst) != this->instructionsAddedAfterSVF.end();
+}
+
+bool PDGAnalysis::canSVFAnalyze(Instruction *inst) const {
+
+  /*
+   * SVF does not know the code of the functions that have been modified after it ran.
+   */
+  if (this->functionsModifiedAfterSVF.find(inst->getFunction()) != this->functionsModifiedAfterSVF.end()) {
+    return false;
+  }
+
+  /*
+   * SVF does not know the instructions that have been added after it ran (e.g., the code of an inlined call).
+   * Instructions that SVF knows can now use added ones (e.g., the value returned by an inlined call), so their operands are checked as well.
+   */
+  if (this->isAddedAfterSVF(inst)) {
+    return false;
+  }
+  for (auto &operand : inst->operands()) {
+    auto operandInst = dyn_cast<Instruction>(operand.get());
+    if (  true
+          && (operandInst != nullptr)
+          && this->isAddedAfterSVF(operandInst)
+       ) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+std::set<const Function *> PDGAnalysis::getSVFIndirectCallees(CallInst *call) {
+
+  /*
+   * The callees of all indirect calls that existed when SVF ran have been recorded.
+   */
+  if (this->hasSVFResultsOf(call)) {
+    auto calleesIt = this->svfIndirectCallees.find(call);
+    if (calleesIt == this->svfIndirectCallees.end()) {
+      return {};
+    }
+    return calleesIt->second;
+  }
+
+  /*
+   * The call has been added after the instructions have been numbered.
+   *
+   * If SVF ran before the call has been added, then every function that has its address taken and that has the same type of the call is a possible callee.
+   */
+  if (!this->canSVFAnalyze(call)) {
+    if (call->getCalledFunction() != nullptr) {
+      return {};
+    }
+    std::set<const Function *> callees;
+    for (auto &F : *this->M) {
+      if (  true
+            && F.hasAddressTaken()
+            && (F.getFunctionType() == call->getFunctionType())
+         ) {
+        callees.insert(&F);
+      }
+    }
+    return callees;
+  }
+  if (this->callGraph == nullptr) {
+    this->computeSVF(*this->M);
+  }
+  if (!this->callGraph->hasIndCSCallees(call)) {
+    return {};
+  }
+  auto &callees = this->callGraph->getIndCSCallees(call);
+
+  return std::set<const Function *>(callees.begin(), callees.end());
+}
+
+ModRefInfo PDGAnalysis::getSVFModRefInfo(CallInst *call) {
+
+  /*
+   * Check if the result is known.
+   */
+  auto isKnown = this->hasSVFResultsOf(call);
+  auto resultIt = this->svfModRefOfCalls.find(call);
+  if (  true
+        && isKnown
+        && (resultIt != this->svfModRefOfCalls.end())
+     ) {
+    return resultIt->second;
+  }
+
+  /*
+   * Query SVF.
+   */
+  if (!this->canSVFAnalyze(call)) {
+    return ModRefInfo::ModRef;
+  }
+  if (this->mssa == nullptr) {
+    this->computeSVF(*this->M);
+  }
+  auto result = this->mssa->getMRGenerator()->getModRefInfo(call);
+  if (isKnown) {
+    this->svfModRefOfCalls[call] = result;
+    this->svfResultsModified = true;
+  }
+
+  return result;
+}
+
+ModRefInfo PDGAnalysis::getSVFModRefInfo(CallInst *call, Instruction *memoryInst) {
+
+  /*
+   * Check if the result is known.
+   */
+  auto isKnown = this->hasSVFResultsOf(call) && this->hasSVFResultsOf(memoryInst);
+  auto key = std::make_pair((Instruction *)call, memoryInst);
+  auto resultIt = this->svfModRefOfCallsToMemory.find(key);
+  if (  true
+        && isKnown
+        && (resultIt != this->svfModRefOfCallsToMemory.end())
+     ) {
+    return resultIt->second;
+  }
+
+  /*
+   * Query SVF.
+   */
+  if (  false
+        || !this->canSVFAnalyze(call)
+        || !this->canSVFAnalyze(memoryInst)
+     ) {
+    return ModRefInfo::ModRef;
+  }
+  if (this->mssa == nullptr) {
+    this->computeSVF(*this->M);
+  }
+  ModRefInfo result;
+  if (auto otherCall = dyn_cast<CallInst>(memoryInst)) {
+    result = this->mssa->getMRGenerator()->getModRefInfo(call, otherCall);
+  } else {
+    result = this->mssa->getMRGenerator()->getModRefInfo(call, getMemoryLocationOf(memoryInst));
+  }
+  if (isKnown) {
+    this->svfModRefOfCallsToMemory[key] = result;
+    this->svfResultsModified = true;
+  }
+
+  return result;
+}
+
+ModRefInfo PDGAnalysis::getSVFModRefInfo(CallInst *call, CallInst *otherCall) {
+  return this->getSVFModRefInfo(call, (Instruction *)otherCall);
+}
+
+AliasResult PDGAnalysis::getSVFAliasResult(Instruction *instI, Instruction *instJ) {
+
+  /*
+   * Check if the result is known.
+   */
+  auto isKnown = this->hasSVFResultsOf(instI) && this->hasSVFResultsOf(instJ);
+  auto key = std::make_pair(instI, instJ);
+  auto resultIt = this->svfAliases.find(key);
+  if (  true
+        && isKnown
+        && (resultIt != this->svfAliases.end())
+     ) {
+    return resultIt->second;
+  }
+
+  /*
+   * Query SVF.
+   */
+  if (  false
+        || !this->canSVFAnalyze(instI)
+        || !this->canSVFAnalyze(instJ)
+     ) {
+    return MayAlias;
+  }
+  if (this->pta == nullptr) {
+    this->computeSVF(*this->M);
+  }
+  auto result = this->pta->alias(getMemoryLocationOf(instI), getMemoryLocationOf(instJ));
+  if (isKnown) {
+    this->svfAliases[key] = result;
+    this->svfResultsModified = true;
+  }
+
+  return result;
+}
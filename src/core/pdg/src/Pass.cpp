@@ -25,6 +25,8 @@ static cl::opt<bool> PDGDump("noelle-pdg-dump", cl::ZeroOrMore, cl::Hidden, cl::
 static cl::opt<bool> PDGCheck("noelle-pdg-check", cl::ZeroOrMore, cl::Hidden, cl::desc("Check the PDG"));
 static cl::opt<bool> PDGSVFDisable("noelle-disable-pdg-svf", cl::ZeroOrMore, cl::Hidden, cl::desc("Disable SVF"));
 static cl::opt<bool> PDGAllocAADisable("noelle-disable-pdg-allocaa", cl::ZeroOrMore, cl::Hidden, cl::desc("Disable our custom alias analysis"));
+static cl::opt<bool> PDGSVFForce("noelle-pdg-svf-force", cl::ZeroOrMore, cl::Hidden, cl::desc("Run SVF even if its results for the module have been saved"));
+static cl::opt<std::string> PDGSVFResultsDirectory("noelle-pdg-svf-dir", cl::ZeroOrMore, cl::Hidden, cl::desc("Directory where the results of SVF are saved (default: noelle/svf in the cache directory of the user)"));
 static cl::opt<bool> PDGRADisable("noelle-disable-pdg-reaching-analysis", cl::ZeroOrMore, cl::Hidden, cl::desc("Disable the use of reaching analysis to compute the PDG"));
 
 bool PDGAnalysis::doInitialization (Module &M){
@@ -35,6 +37,8 @@ bool PDGAnalysis::doInitialization (Module &M){
   this->disableSVF = (PDGSVFDisable.getNumOccurrences() > 0) ? true : false;
   this->disableAllocAA = (PDGAllocAADisable.getNumOccurrences() > 0) ? true : false;
   this->disableRA = (PDGRADisable.getNumOccurrences() > 0) ? true : false;
+  this->forceSVF = (PDGSVFForce.getNumOccurrences() > 0) ? true : false;
+  this->svfResultsDirectory = PDGSVFResultsDirectory.getValue();
 
   return false;
 }
@@ -72,6 +76,7 @@ bool PDGAnalysis::runOnModule (Module &M){
 
   /*
    * Initialize SVF.
+   * Its results are loaded if they have been already computed for this module.
    */
   initializeSVF(M);
 
@@ -85,6 +90,14 @@ bool PDGAnalysis::runOnModule (Module &M){
    */
   auto currentPDG = this->getPDG();
 
+  /*
+   * Save the results of SVF to reuse them in later invocations on the same module.
+   * The module can be transformed from now on, so the file is not updated anymore.
+   * The results are still used to answer the queries about the functions that have not been modified (e.g., the indirect callees needed by the call graph).
+   */
+  this->saveSVFResults();
+  this->stopSavingSVFResults();
+
   /*
    * Check if we should dumpt the PDG
    */
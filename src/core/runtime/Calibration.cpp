@@ -0,0 +1,241 @@
+/*
+ * Copyright 2016 - 2020  Angelo Matni, Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+ * Measure the latencies of the runtime operations used by the parallelized code on the current machine.
+ *
+ * The measurements are stored in a machine profile that is read by the Architecture abstraction of NOELLE (see NOELLE_MACHINE_PROFILE).
+ * All latencies are in nanoseconds.
+ */
+#include <chrono>
+#include <fstream>
+
+#include "Parallelizer_utils.cpp"
+
+#define CALIBRATION_QUEUE_VALUES 1000000
+#define CALIBRATION_SIGNALS 1000000
+#define CALIBRATION_DISPATCHES 1000
+#define CALIBRATION_SPECULATIVE_ACCESSES 1000000
+#define CALIBRATION_INSTRUCTION_ITERATIONS 100000000
+
+/*
+ * Number of LLVM IR instructions executed by each iteration of the loop used to measure the latency of a single instruction.
+ * This is the unit used by the profiles of NOELLE.
+ */
+#define CALIBRATION_INSTRUCTIONS_PER_ITERATION 6
+
+static double nanosecondsSince (std::chrono::steady_clock::time_point start){
+  auto end = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::nano>(end - start).count();
+}
+
+static double measureInstruction (void){
+  int64_t v = 1;
+
+  auto start = std::chrono::steady_clock::now();
+  for (int64_t i = 0; i < CALIBRATION_INSTRUCTION_ITERATIONS; i++){
+    v += i ^ (v >> 3);
+  }
+  auto elapsed = nanosecondsSince(start);
+
+  /*
+   * Make the result of the loop observable so the loop cannot be removed.
+   */
+  asm volatile("" : : "r"(v) : "memory");
+
+  return elapsed / (((double)CALIBRATION_INSTRUCTION_ITERATIONS) * CALIBRATION_INSTRUCTIONS_PER_ITERATION);
+}
+
+template<typename T>
+static double measureQueue (
+  void (*pushFunction)(ThreadSafeQueue<T> *, T *),
+  void (*popFunction)(ThreadSafeQueue<T> *, T *)
+  ){
+
+  /*
+   * Allocate the queue the same way the DSWP dispatcher does.
+   */
+  auto queue = (ThreadSafeQueue<T> *) new ThreadSafeLockFreeQueue<T>();
+
+  /*
+   * Stream values from a producer core to a consumer core.
+   */
+  auto start = std::chrono::steady_clock::now();
+  std::thread producer([queue, pushFunction](){
+    for (int64_t i = 0; i < CALIBRATION_QUEUE_VALUES; i++){
+      T value = (T) i;
+      pushFunction(queue, &value);
+    }
+  });
+  for (int64_t i = 0; i < CALIBRATION_QUEUE_VALUES; i++){
+    T value;
+    popFunction(queue, &value);
+  }
+  auto elapsed = nanosecondsSince(start);
+  producer.join();
+
+  /*
+   * Free the memory.
+   */
+  delete (ThreadSafeLockFreeQueue<T> *)queue;
+
+  return elapsed / CALIBRATION_QUEUE_VALUES;
+}
+
+static double measureSequentialSegmentSignal (void){
+
+  /*
+   * Allocate two sequential segments the same way the HELIX dispatcher does.
+   * The one of the second core starts locked.
+   */
+  void *ssArrays = nullptr;
+  posix_memalign(&ssArrays, CACHE_LINE_SIZE, CACHE_LINE_SIZE * 2);
+  auto ss0 = ssArrays;
+  auto ss1 = (void *)(((uint64_t)ssArrays) + CACHE_LINE_SIZE);
+  pthread_spin_init((pthread_spinlock_t *)ss0, PTHREAD_PROCESS_PRIVATE);
+  pthread_spin_init((pthread_spinlock_t *)ss1, PTHREAD_PROCESS_PRIVATE);
+  pthread_spin_lock((pthread_spinlock_t *)ss1);
+
+  /*
+   * Ping-pong the ownership of the sequential segment between two cores.
+   */
+  auto start = std::chrono::steady_clock::now();
+  std::thread otherCore([ss0, ss1](){
+    for (int64_t i = 0; i < CALIBRATION_SIGNALS; i++){
+      HELIX_wait(ss1);
+      HELIX_signal(ss0);
+    }
+  });
+  for (int64_t i = 0; i < CALIBRATION_SIGNALS; i++){
+    HELIX_wait(ss0);
+    HELIX_signal(ss1);
+  }
+  otherCore.join();
+  auto elapsed = nanosecondsSince(start);
+
+  /*
+   * Free the memory.
+   */
+  free(ssArrays);
+
+  /*
+   * Each iteration includes two hand-offs between cores.
+   */
+  return elapsed / (((double)CALIBRATION_SIGNALS) * 2);
+}
+
+static void emptyDOALLTask (void *env, int64_t coreID, int64_t numCores, int64_t chunkSize){
+  return ;
+}
+
+static double measureDOALLDispatchPerCore (int64_t cores){
+  int64_t env[8];
+
+  /*
+   * Warm up the thread pool.
+   */
+  NOELLE_DOALLDispatcher(emptyDOALLTask, env, cores, 1);
+
+  /*
+   * Measure the dispatches.
+   */
+  auto start = std::chrono::steady_clock::now();
+  for (auto i = 0; i < CALIBRATION_DISPATCHES; i++){
+    NOELLE_DOALLDispatcher(emptyDOALLTask, env, cores, 1);
+  }
+  auto elapsed = nanosecondsSince(start);
+
+  return elapsed / (((double)CALIBRATION_DISPATCHES) * cores);
+}
+
+static double measureSpeculativeAccess (void (*hook)(void *, int64_t)){
+
+  /*
+   * Track accesses to distinct granules the same way a core of the speculative DOALL dispatcher does.
+   */
+  std::vector<SpeculativeDOALL_accessSet_t> accessSets(1);
+  std::atomic<uint64_t> clock{0};
+  accessSets[0].clock = &clock;
+  auto values = (int64_t *) calloc(CALIBRATION_SPECULATIVE_ACCESSES, sizeof(int64_t));
+
+  /*
+   * Measure the tracking of the accesses and the detection of conflicts at the end of the invocation.
+   */
+  auto start = std::chrono::steady_clock::now();
+  speculativeDOALLAccessSet = &accessSets[0];
+  for (int64_t i = 0; i < CALIBRATION_SPECULATIVE_ACCESSES; i++){
+    hook(&values[i], sizeof(int64_t));
+  }
+  speculativeDOALLAccessSet = nullptr;
+  NOELLE_SpeculativeDOALLHasConflicts(accessSets);
+  auto elapsed = nanosecondsSince(start);
+
+  /*
+   * Free the memory.
+   */
+  free(values);
+
+  return elapsed / CALIBRATION_SPECULATIVE_ACCESSES;
+}
+
+int main (int argc, char *argv[]){
+
+  /*
+   * Fetch the output file.
+   */
+  std::string fileName{"machine.prof"};
+  if (argc > 1){
+    fileName = argv[1];
+  }
+
+  /*
+   * Measure the latencies.
+   */
+  auto cores = NOELLE_getNumberOfCores();
+  std::cerr << "NOELLE: Calibration: Start (" << cores << " cores)" << std::endl;
+  auto instruction = measureInstruction();
+  std::cerr << "NOELLE: Calibration:   Instruction = " << instruction << " ns" << std::endl;
+  auto queue8 = measureQueue<int8_t>(queuePush8, queuePop8);
+  auto queue16 = measureQueue<int16_t>(queuePush16, queuePop16);
+  auto queue32 = measureQueue<int32_t>(queuePush32, queuePop32);
+  auto queue64 = measureQueue<int64_t>(queuePush64, queuePop64);
+  std::cerr << "NOELLE: Calibration:   Queue push/pop = " << queue8 << " " << queue16 << " " << queue32 << " " << queue64 << " ns" << std::endl;
+  auto signal = measureSequentialSegmentSignal();
+  std::cerr << "NOELLE: Calibration:   HELIX wait/signal = " << signal << " ns" << std::endl;
+  auto dispatch = measureDOALLDispatchPerCore(cores);
+  std::cerr << "NOELLE: Calibration:   DOALL dispatch per core = " << dispatch << " ns" << std::endl;
+  auto speculativeLoad = measureSpeculativeAccess(NOELLE_SpeculativeDOALL_load);
+  auto speculativeStore = measureSpeculativeAccess(NOELLE_SpeculativeDOALL_store);
+  std::cerr << "NOELLE: Calibration:   Speculative DOALL load/store tracking = " << speculativeLoad << " " << speculativeStore << " ns" << std::endl;
+
+  /*
+   * Write the machine profile.
+   */
+  std::ofstream profile(fileName);
+  if (!profile.good()){
+    std::cerr << "NOELLE: Calibration: ERROR = cannot write " << fileName << std::endl;
+    return 1;
+  }
+  profile << "# NOELLE machine profile (latencies in nanoseconds)" << std::endl;
+  profile << "CORES " << cores << std::endl;
+  profile << "NANOSECONDS_PER_INSTRUCTION " << instruction << std::endl;
+  profile << "QUEUE_8 " << queue8 << std::endl;
+  profile << "QUEUE_16 " << queue16 << std::endl;
+  profile << "QUEUE_32 " << queue32 << std::endl;
+  profile << "QUEUE_64 " << queue64 << std::endl;
+  profile << "HELIX_SIGNAL " << signal << std::endl;
+  profile << "DOALL_DISPATCH_PER_CORE " << dispatch << std::endl;
+  profile << "DOALL_SPECULATIVE_LOAD " << speculativeLoad << std::endl;
+  profile << "DOALL_SPECULATIVE_STORE " << speculativeStore << std::endl;
+  std::cerr << "NOELLE: Calibration: Exit (machine profile written to " << fileName << ")" << std::endl;
+
+  return 0;
+}
@@ -0,0 +1,202 @@
+/*
+ * Copyright 2016 - 2020  Angelo Matni, Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+ * Runtime of the loop-carried dependence profiler.
+ *
+ * The program instrumented by the DependenceProfiler tool reports
+ * 1) the loop-carried memory dependences of the PDG it wants to check,
+ * 2) the invocations and the iterations of the loops these dependences belong to, and
+ * 3) the memory accessed by the instructions at the end points of these dependences.
+ *
+ * A dependence manifests when its destination accesses memory that has been accessed by its source in a previous iteration of the same invocation of its loop.
+ * At exit, the number of times each dependence manifested is written to the dependence profile (see NOELLE_DEPENDENCE_PROFILE).
+ * The profile also includes how many times the loop and the end points of each dependence executed.
+ * This allows telling a dependence that never manifested apart from one that has never been exercised.
+ */
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <unordered_map>
+#include <vector>
+
+/*
+ * Memory is tracked at the granularity of 8 bytes.
+ */
+#define DEPENDENCE_PROFILER_GRANULARITY 8
+
+namespace {
+
+  struct Dependence {
+    uint64_t loopID;
+    uint64_t fromID;
+    uint64_t toID;
+    uint64_t manifested;
+  };
+
+  struct LoopState {
+    uint64_t invocationStart;
+    uint64_t iterationStart;
+    uint64_t invocations;
+    uint64_t iterations;
+  };
+
+  /*
+   * Logical time of the events reported by the instrumented program.
+   */
+  uint64_t currentTime = 0;
+
+  std::vector<Dependence> dependences;
+  std::unordered_map<uint64_t, std::vector<uint64_t>> dependencesToInstruction;
+  std::unordered_map<uint64_t, LoopState> loops;
+
+  /*
+   * Number of times each instrumented instruction executed.
+   */
+  std::unordered_map<uint64_t, uint64_t> executions;
+
+  /*
+   * Last time each instrumented instruction accessed a memory granule.
+   */
+  std::unordered_map<uint64_t, std::unordered_map<uint64_t, uint64_t>> lastAccesses;
+
+  void dumpDependenceProfile (void){
+
+    /*
+     * Fetch the name of the profile.
+     */
+    auto profileName = getenv("NOELLE_DEPENDENCE_PROFILE");
+    if (profileName == nullptr){
+      profileName = (char *)"dependences.prof";
+    }
+
+    /*
+     * Write the profile.
+     * Each line is a dependence: loop ID, source ID, destination ID, number of times it manifested,
+     * number of invocations and iterations of the loop, number of executions of the source and of the destination.
+     */
+    auto profile = fopen(profileName, "w");
+    if (profile == nullptr){
+      fprintf(stderr, "DependenceProfiler: ERROR = the profile %s could not be written\n", profileName);
+      return ;
+    }
+    for (auto &dep : dependences){
+      auto &loop = loops[dep.loopID];
+      fprintf(profile, "%lu %lu %lu %lu %lu %lu %lu %lu\n", dep.loopID, dep.fromID, dep.toID, dep.manifested, loop.invocations, loop.iterations, executions[dep.fromID], executions[dep.toID]);
+    }
+    fclose(profile);
+
+    return ;
+  }
+}
+
+extern "C" {
+
+  void NOELLE_DependenceProfiler_registerDependence (
+    uint64_t loopID,
+    uint64_t fromID,
+    uint64_t toID
+    ){
+
+    /*
+     * Dump the profile at exit.
+     */
+    if (dependences.size() == 0){
+      atexit(dumpDependenceProfile);
+    }
+
+    /*
+     * Register the dependence.
+     */
+    dependencesToInstruction[toID].push_back(dependences.size());
+    dependences.push_back({loopID, fromID, toID, 0});
+    loops[loopID] = {0, 0, 0, 0};
+
+    return ;
+  }
+
+  void NOELLE_DependenceProfiler_loopInvocation (
+    uint64_t loopID
+    ){
+    currentTime++;
+    auto &loop = loops[loopID];
+    loop.invocationStart = currentTime;
+    loop.iterationStart = currentTime;
+    loop.invocations++;
+
+    return ;
+  }
+
+  void NOELLE_DependenceProfiler_loopIteration (
+    uint64_t loopID
+    ){
+    currentTime++;
+    auto &loop = loops[loopID];
+    loop.iterationStart = currentTime;
+    loop.iterations++;
+
+    return ;
+  }
+
+  void NOELLE_DependenceProfiler_memoryAccess (
+    uint64_t instructionID,
+    void *address,
+    uint64_t bytes
+    ){
+    currentTime++;
+    executions[instructionID]++;
+
+    /*
+     * Fetch the dependences that the current instruction is the destination of.
+     */
+    std::vector<uint64_t> *depsToCheck = nullptr;
+    auto depsIt = dependencesToInstruction.find(instructionID);
+    if (depsIt != dependencesToInstruction.end()){
+      depsToCheck = &depsIt->second;
+    }
+
+    /*
+     * Check and update each granule accessed.
+     */
+    auto firstGranule = ((uint64_t)address) / DEPENDENCE_PROFILER_GRANULARITY;
+    auto lastGranule = (((uint64_t)address) + (bytes > 0 ? bytes - 1 : 0)) / DEPENDENCE_PROFILER_GRANULARITY;
+    for (auto granule = firstGranule; granule <= lastGranule; granule++){
+      auto &accesses = lastAccesses[granule];
+
+      if (depsToCheck != nullptr){
+        for (auto depIndex : *depsToCheck){
+          auto &dep = dependences[depIndex];
+          auto lastAccessOfSource = accesses.find(dep.fromID);
+          if (lastAccessOfSource == accesses.end()){
+            continue ;
+          }
+
+          /*
+           * Check if the source accessed the granule in a previous iteration of the current invocation of the loop.
+           */
+          auto &loop = loops[dep.loopID];
+          auto accessTime = lastAccessOfSource->second;
+          if (  true
+                && (accessTime >= loop.invocationStart)
+                && (accessTime < loop.iterationStart)
+             ){
+            dep.manifested++;
+          }
+        }
+      }
+
+      accesses[instructionID] = currentTime;
+    }
+
+    return ;
+  }
+
+}
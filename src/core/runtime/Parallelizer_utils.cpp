@@ -19,6 +19,8 @@
 #include <queue>
 #include <utility>
 #include <iostream>
+#include <cstring>
+#include <unordered_map>
 
 using namespace MARC;
 
@@ -29,6 +31,7 @@ static int64_t numberOfPushes8 = 0;
 static int64_t numberOfPushes16 = 0;
 static int64_t numberOfPushes32 = 0;
 static int64_t numberOfPushes64 = 0;
+static int64_t numberOfPushesPacked = 0;
 #endif
 
 static ThreadPool pool{true, std::thread::hardware_concurrency()};
@@ -43,6 +46,12 @@ extern "C" {
       int64_t unusedVariableToPreventOptIfStructHasOnlyOneVariable;
   };
 
+  class SpeculativeDispatcherInfo {
+    public:
+      int32_t numberOfThreadsUsed;
+      int64_t misspeculated;
+  };
+
   /*
    * Return the number of cores to use for the parallelization.
    */
@@ -58,6 +67,24 @@ extern "C" {
     int64_t chunkSize
     );
 
+  /*
+   * Dispatch threads to run a DOALL loop speculatively.
+   * If the cores conflicted on memory, then the invocation is undone and the caller must execute the loop sequentially.
+   */
+  SpeculativeDispatcherInfo NOELLE_SpeculativeDOALLDispatcher (
+    void (*parallelizedLoop)(void *, int64_t, int64_t, int64_t), 
+    void *env, 
+    int64_t maxNumberOfCores, 
+    int64_t chunkSize
+    );
+
+  /*
+   * Track the memory accessed by the speculative DOALL loop that runs on the current thread.
+   * These must be invoked just before the access.
+   */
+  void NOELLE_SpeculativeDOALL_load (void *address, int64_t bytes);
+  void NOELLE_SpeculativeDOALL_store (void *address, int64_t bytes);
+
 
   /******************************************** NOELLE API implementations ***********************************************/
 
@@ -88,8 +115,132 @@ extern "C" {
     return cores;
   }
 
+  /*
+   * Policies to run a parallelized loop invoked by a task of another parallelized loop (e.g., through a call).
+   * They are selected by the environment variable NOELLE_NESTED_PARALLELISM.
+   *
+   * inline (default): the nested loop runs sequentially on the thread of the task that invokes it.
+   * split: the cores of the outer loop are split between its tasks, and each task runs its nested loops on its own share.
+   */
+  typedef enum {
+    NOELLE_NESTED_PARALLELISM_INLINE,
+    NOELLE_NESTED_PARALLELISM_SPLIT
+  } NOELLE_nestedParallelismPolicy_t ;
+
+  /*
+   * Number of parallelized loops that include the code running on the current thread, and cores that code can use to run nested parallelized loops.
+   * The main thread runs outside any parallelized loop and it can use all cores.
+   */
+  static thread_local int64_t parallelNestingDepth = 0;
+  static thread_local int64_t coresOfCurrentThread = 0;
+
+  static NOELLE_nestedParallelismPolicy_t NOELLE_getNestedParallelismPolicy (void){
+    static NOELLE_nestedParallelismPolicy_t policy = NOELLE_NESTED_PARALLELISM_INLINE;
+    static std::once_flag policyRead;
+
+    /*
+     * Read the policy only once.
+     */
+    std::call_once(policyRead, [](){
+      auto envVar = getenv("NOELLE_NESTED_PARALLELISM");
+      if (  true
+            && (envVar != nullptr)
+            && (strcmp(envVar, "split") == 0)
+         ){
+        policy = NOELLE_NESTED_PARALLELISM_SPLIT;
+      }
+    });
+
+    return policy;
+  }
+
+  static int64_t NOELLE_getNumberOfCoresOfCurrentThread (void){
+    if (parallelNestingDepth == 0){
+      return NOELLE_getNumberOfCores();
+    }
+    if (NOELLE_getNestedParallelismPolicy() == NOELLE_NESTED_PARALLELISM_INLINE){
+      return 1;
+    }
+
+    return coresOfCurrentThread;
+  }
+
+  /*
+   * Return the number of tasks to use for a parallelized loop invoked by the current thread.
+   */
+  static int64_t NOELLE_getNumberOfCoresForDispatch (int64_t maxNumberOfCores){
+    auto cores = NOELLE_getNumberOfCoresOfCurrentThread();
+    if (cores > maxNumberOfCores){
+      cores = maxNumberOfCores;
+    }
+    if (cores < 1){
+      cores = 1;
+    }
+
+    return cores;
+  }
+
+  /*
+   * Return the cores that the task @taskID out of @numberOfTasks, dispatched by the current thread, can use for its nested parallelized loops.
+   */
+  static int64_t NOELLE_getNumberOfCoresOfTask (int64_t taskID, int64_t numberOfTasks){
+    if (NOELLE_getNestedParallelismPolicy() == NOELLE_NESTED_PARALLELISM_INLINE){
+      return 1;
+    }
+
+    /*
+     * Split the cores of the current thread between the tasks.
+     * The cores used by nested loops cannot exceed the threads of the pool that runs them.
+     */
+    auto cores = NOELLE_getNumberOfCoresOfCurrentThread();
+    int64_t threadsOfPool = std::thread::hardware_concurrency();
+    if (cores > threadsOfPool){
+      cores = threadsOfPool;
+    }
+    auto coresOfTask = (cores / numberOfTasks) + ((taskID < (cores % numberOfTasks)) ? 1 : 0);
+    if (coresOfTask < 1){
+      coresOfTask = 1;
+    }
+
+    return coresOfTask;
+  }
+
+  /*
+   * Set the nesting of the task that is about to run on the current thread.
+   * The nesting of the code that was running before the task is returned to be restored by NOELLE_exitParallelTask.
+   */
+  static std::pair<int64_t, int64_t> NOELLE_enterParallelTask (int64_t nestingDepth, int64_t cores){
+    auto previousNesting = std::make_pair(parallelNestingDepth, coresOfCurrentThread);
+    parallelNestingDepth = nestingDepth;
+    coresOfCurrentThread = cores;
+
+    return previousNesting;
+  }
+
+  static void NOELLE_exitParallelTask (std::pair<int64_t, int64_t> previousNesting){
+    parallelNestingDepth = previousNesting.first;
+    coresOfCurrentThread = previousNesting.second;
+
+    return ;
+  }
+
   typedef void (*stageFunctionPtr_t)(void *, void*);
 
+  /*
+   * Elements of the queues that carry several values packed together.
+   */
+  typedef struct {
+    int64_t values[2];
+  } queueElement128_t;
+
+  typedef struct {
+    int64_t values[4];
+  } queueElement256_t;
+
+  typedef struct {
+    int64_t values[8];
+  } queueElement512_t;
+
   void printReachedS(std::string s)
   {
     auto outS = "Reached: " + s;
@@ -167,6 +318,54 @@ extern "C" {
     return ;
   }
 
+  void queuePush128(ThreadSafeQueue<queueElement128_t> *queue, queueElement128_t *val) { 
+    queue->push(*val); 
+
+    #ifdef DSWP_STATS
+    numberOfPushesPacked++;
+    #endif
+
+    return ;
+  }
+
+  void queuePop128(ThreadSafeQueue<queueElement128_t> *queue, queueElement128_t *val) { 
+    queue->waitPop(*val); 
+
+    return ;
+  }
+
+  void queuePush256(ThreadSafeQueue<queueElement256_t> *queue, queueElement256_t *val) { 
+    queue->push(*val); 
+
+    #ifdef DSWP_STATS
+    numberOfPushesPacked++;
+    #endif
+
+    return ;
+  }
+
+  void queuePop256(ThreadSafeQueue<queueElement256_t> *queue, queueElement256_t *val) { 
+    queue->waitPop(*val); 
+
+    return ;
+  }
+
+  void queuePush512(ThreadSafeQueue<queueElement512_t> *queue, queueElement512_t *val) { 
+    queue->push(*val); 
+
+    #ifdef DSWP_STATS
+    numberOfPushesPacked++;
+    #endif
+
+    return ;
+  }
+
+  void queuePop512(ThreadSafeQueue<queueElement512_t> *queue, queueElement512_t *val) { 
+    queue->waitPop(*val); 
+
+    return ;
+  }
+
 
   /**********************************************************************
    *                DOALL
@@ -177,6 +376,8 @@ extern "C" {
     int64_t coreID ;
     int64_t numCores;
     int64_t chunkSize ;
+    int64_t nestingDepth ;
+    int64_t coresOfTask ;
   } DOALL_args_t ;
 
   static void NOELLE_DOALLTrampoline (void *args){
@@ -189,7 +390,9 @@ extern "C" {
     /*
      * Invoke
      */
+    auto previousNesting = NOELLE_enterParallelTask(DOALLArgs->nestingDepth, DOALLArgs->coresOfTask);
     DOALLArgs->parallelizedLoop(DOALLArgs->env, DOALLArgs->coreID, DOALLArgs->numCores, DOALLArgs->chunkSize);
+    NOELLE_exitParallelTask(previousNesting);
 
     return ;
   }
@@ -203,11 +406,12 @@ extern "C" {
 
     /*
      * Set the number of cores to use.
+     * A loop invoked by a task of another parallelized loop uses only the cores given to that task.
      */
-    auto runtimeNumberOfCores = NOELLE_getNumberOfCores();
-    auto numCores = runtimeNumberOfCores > maxNumberOfCores ? maxNumberOfCores : runtimeNumberOfCores;
+    auto isNested = (parallelNestingDepth > 0);
+    auto numCores = NOELLE_getNumberOfCoresForDispatch(maxNumberOfCores);
     #ifdef RUNTIME_PRINT
-    std::cerr << "Starting dispatcher: num cores " << numCores << ", chunk size: " << chunkSize << std::endl;
+    std::cerr << "Starting dispatcher: num cores " << numCores << ", chunk size: " << chunkSize << ", nesting depth: " << parallelNestingDepth << std::endl;
     #endif
 
     /*
@@ -231,6 +435,18 @@ extern "C" {
       argsPerCore->coreID = i;
       argsPerCore->numCores = numCores;
       argsPerCore->chunkSize = chunkSize;
+      argsPerCore->nestingDepth = parallelNestingDepth + 1;
+      argsPerCore->coresOfTask = NOELLE_getNumberOfCoresOfTask(i, numCores);
+
+      /*
+       * The current thread of a nested loop runs the first task itself rather than blocking a thread of the pool while waiting.
+       */
+      if (  true
+            && isNested
+            && (i == 0)
+         ){
+        continue ;
+      }
 
       /*
        * Submit
@@ -243,6 +459,9 @@ extern "C" {
     #ifdef RUNTIME_PRINT
     std::cerr << "Submitted pool" << std::endl;
     #endif
+    if (isNested){
+      NOELLE_DOALLTrampoline(&argsForAllCores[0]);
+    }
 
     /*
      * Wait for DOALL tasks.
@@ -264,6 +483,327 @@ extern "C" {
     return dispatcherInfo;
   }
 
+
+  /**********************************************************************
+   *                SPECULATIVE DOALL
+   **********************************************************************/
+
+  /*
+   * Memory is tracked at the granularity of 8 bytes.
+   */
+  #define SPECULATIVE_DOALL_GRANULARITY 8
+
+  /*
+   * Value a granule had right before a core stored to it.
+   * The ticket orders the checkpoints of all cores of an invocation.
+   */
+  typedef struct {
+    uint64_t granule;
+    uint64_t oldValue;
+    uint64_t ticket;
+  } SpeculativeDOALL_checkpoint_t ;
+
+  typedef struct {
+    std::vector<uint64_t> readGranules;
+    std::vector<uint64_t> writtenGranules;
+    std::vector<SpeculativeDOALL_checkpoint_t> checkpoints;
+    std::atomic<uint64_t> *clock;
+  } SpeculativeDOALL_accessSet_t ;
+
+  typedef struct {
+    DOALL_args_t doallArgs;
+    SpeculativeDOALL_accessSet_t *accessSet;
+  } SpeculativeDOALL_args_t ;
+
+  /*
+   * Accesses of the speculative task that runs on the current thread.
+   */
+  static thread_local SpeculativeDOALL_accessSet_t *speculativeDOALLAccessSet = nullptr;
+
+  /*
+   * Statistics.
+   */
+  static std::atomic<uint64_t> speculativeDOALLInvocations{0};
+  static std::atomic<uint64_t> speculativeDOALLMisspeculations{0};
+
+  void NOELLE_SpeculativeDOALL_load (void *address, int64_t bytes){
+
+    /*
+     * Fetch the access set of the current core.
+     */
+    auto accessSet = speculativeDOALLAccessSet;
+    if (accessSet == nullptr){
+      return ;
+    }
+
+    /*
+     * Add the granules read.
+     */
+    auto firstGranule = ((uint64_t)address) / SPECULATIVE_DOALL_GRANULARITY;
+    auto lastGranule = ((uint64_t)address + bytes - 1) / SPECULATIVE_DOALL_GRANULARITY;
+    for (auto granule = firstGranule; granule <= lastGranule; granule++){
+      accessSet->readGranules.push_back(granule);
+    }
+
+    return ;
+  }
+
+  void NOELLE_SpeculativeDOALL_store (void *address, int64_t bytes){
+
+    /*
+     * Fetch the access set of the current core.
+     */
+    auto accessSet = speculativeDOALLAccessSet;
+    if (accessSet == nullptr){
+      return ;
+    }
+
+    /*
+     * Add the granules written.
+     */
+    auto firstGranule = ((uint64_t)address) / SPECULATIVE_DOALL_GRANULARITY;
+    auto lastGranule = ((uint64_t)address + bytes - 1) / SPECULATIVE_DOALL_GRANULARITY;
+    for (auto granule = firstGranule; granule <= lastGranule; granule++){
+      accessSet->writtenGranules.push_back(granule);
+    }
+
+    /*
+     * Checkpoint the granules about to be overwritten in the log of the current core.
+     *
+     * This function runs before the store it tracks, and the ticket is taken after the granule is read.
+     * Hence, any store of another core to the granule comes after a larger ticket.
+     * So the checkpoint of a granule with the smallest ticket holds the value it had before the invocation.
+     */
+    for (auto granule = firstGranule; granule <= lastGranule; granule++){
+      SpeculativeDOALL_checkpoint_t checkpoint;
+      checkpoint.granule = granule;
+      memcpy(&checkpoint.oldValue, (void *)(granule * SPECULATIVE_DOALL_GRANULARITY), SPECULATIVE_DOALL_GRANULARITY);
+      checkpoint.ticket = accessSet->clock->fetch_add(1);
+      accessSet->checkpoints.push_back(checkpoint);
+    }
+
+    return ;
+  }
+
+  static void NOELLE_SpeculativeDOALLTrampoline (void *args){
+
+    /*
+     * Fetch the arguments.
+     */
+    auto speculativeArgs = (SpeculativeDOALL_args_t *) args;
+
+    /*
+     * Invoke while tracking the memory accessed.
+     */
+    auto previousAccessSet = speculativeDOALLAccessSet;
+    speculativeDOALLAccessSet = speculativeArgs->accessSet;
+    NOELLE_DOALLTrampoline(&speculativeArgs->doallArgs);
+    speculativeDOALLAccessSet = previousAccessSet;
+
+    return ;
+  }
+
+  static bool NOELLE_SpeculativeDOALLHasConflicts (std::vector<SpeculativeDOALL_accessSet_t> &accessSets){
+
+    /*
+     * Map each granule written to the core that wrote it.
+     * A granule written by more than one core is a conflict.
+     */
+    std::unordered_map<uint64_t, int64_t> writers;
+    for (int64_t core = 0; core < accessSets.size(); core++){
+      for (auto granule : accessSets[core].writtenGranules){
+        auto writer = writers.find(granule);
+        if (writer == writers.end()){
+          writers[granule] = core;
+          continue ;
+        }
+        if (writer->second != core){
+          return true;
+        }
+      }
+    }
+
+    /*
+     * A granule read by a core and written by another one is a conflict.
+     */
+    for (int64_t core = 0; core < accessSets.size(); core++){
+      for (auto granule : accessSets[core].readGranules){
+        auto writer = writers.find(granule);
+        if (  true
+              && (writer != writers.end())
+              && (writer->second != core)
+           ){
+          return true;
+        }
+      }
+    }
+
+    return false;
+  }
+
+  static void NOELLE_SpeculativeDOALLRollback (std::vector<SpeculativeDOALL_accessSet_t> &accessSets){
+
+    /*
+     * Find the earliest checkpoint of each granule written across the logs of all cores.
+     */
+    std::unordered_map<uint64_t, SpeculativeDOALL_checkpoint_t *> earliestCheckpoints;
+    for (auto &accessSet : accessSets){
+      for (auto &checkpoint : accessSet.checkpoints){
+        auto earliest = earliestCheckpoints.find(checkpoint.granule);
+        if (  false
+              || (earliest == earliestCheckpoints.end())
+              || (checkpoint.ticket < earliest->second->ticket)
+           ){
+          earliestCheckpoints[checkpoint.granule] = &checkpoint;
+        }
+      }
+    }
+
+    /*
+     * Restore the granules written to the values they had before the invocation.
+     * All cores have completed, so the order of the restores does not matter.
+     */
+    for (auto &granuleCheckpoint : earliestCheckpoints){
+      auto checkpoint = granuleCheckpoint.second;
+      memcpy((void *)(checkpoint->granule * SPECULATIVE_DOALL_GRANULARITY), &checkpoint->oldValue, SPECULATIVE_DOALL_GRANULARITY);
+    }
+
+    return ;
+  }
+
+  static void NOELLE_SpeculativeDOALLReport (void){
+    auto invocations = speculativeDOALLInvocations.load();
+    auto misspeculations = speculativeDOALLMisspeculations.load();
+    std::cerr << "NOELLE: Speculative DOALL: " << misspeculations << " misspeculations out of " << invocations << " invocations (" << ((100.0 * misspeculations) / invocations) << " %)" << std::endl;
+
+    return ;
+  }
+
+  SpeculativeDispatcherInfo NOELLE_SpeculativeDOALLDispatcher (
+    void (*parallelizedLoop)(void *, int64_t, int64_t, int64_t), 
+    void *env, 
+    int64_t maxNumberOfCores, 
+    int64_t chunkSize
+    ){
+
+    /*
+     * Report the misspeculation rate at exit.
+     */
+    static std::once_flag reportRegistered;
+    std::call_once(reportRegistered, [](){
+      atexit(NOELLE_SpeculativeDOALLReport);
+    });
+
+    /*
+     * A loop invoked by a speculative task runs sequentially on the thread of that task.
+     * This keeps its memory accesses tracked by the speculation of the outer loop.
+     * It is not a speculation on its own, so it does not count as an invocation.
+     */
+    if (speculativeDOALLAccessSet != nullptr){
+      DOALL_args_t args;
+      args.parallelizedLoop = parallelizedLoop;
+      args.env = env;
+      args.coreID = 0;
+      args.numCores = 1;
+      args.chunkSize = chunkSize;
+      args.nestingDepth = parallelNestingDepth + 1;
+      args.coresOfTask = 1;
+      NOELLE_DOALLTrampoline(&args);
+
+      SpeculativeDispatcherInfo dispatcherInfo;
+      dispatcherInfo.numberOfThreadsUsed = 1;
+      dispatcherInfo.misspeculated = 0;
+      return dispatcherInfo;
+    }
+    speculativeDOALLInvocations++;
+
+    /*
+     * Set the number of cores to use.
+     */
+    auto isNested = (parallelNestingDepth > 0);
+    auto numCores = NOELLE_getNumberOfCoresForDispatch(maxNumberOfCores);
+    #ifdef RUNTIME_PRINT
+    std::cerr << "Starting speculative dispatcher: num cores " << numCores << ", chunk size: " << chunkSize << std::endl;
+    #endif
+
+    /*
+     * Allocate the memory to store the arguments and the accesses of each core.
+     */
+    SpeculativeDOALL_args_t *argsForAllCores;
+    posix_memalign((void **)&argsForAllCores, CACHE_LINE_SIZE, sizeof(SpeculativeDOALL_args_t) * numCores);
+    std::vector<SpeculativeDOALL_accessSet_t> accessSets(numCores);
+    std::atomic<uint64_t> clock{0};
+
+    /*
+     * Submit DOALL tasks.
+     */
+    std::vector<MARC::TaskFuture<void>> localFutures;
+    for (auto i = 0; i < numCores; ++i) {
+
+      /*
+       * Prepare the arguments.
+       */
+      auto argsPerCore = &argsForAllCores[i];
+      argsPerCore->doallArgs.parallelizedLoop = parallelizedLoop;
+      argsPerCore->doallArgs.env = env;
+      argsPerCore->doallArgs.coreID = i;
+      argsPerCore->doallArgs.numCores = numCores;
+      argsPerCore->doallArgs.chunkSize = chunkSize;
+      argsPerCore->doallArgs.nestingDepth = parallelNestingDepth + 1;
+      argsPerCore->doallArgs.coresOfTask = 1;
+      argsPerCore->accessSet = &accessSets[i];
+      accessSets[i].clock = &clock;
+
+      /*
+       * The current thread of a nested loop runs the first task itself rather than blocking a thread of the pool while waiting.
+       */
+      if (  true
+            && isNested
+            && (i == 0)
+         ){
+        continue ;
+      }
+
+      /*
+       * Submit
+       */
+      localFutures.push_back(pool.submit(NOELLE_SpeculativeDOALLTrampoline, argsPerCore));
+    }
+    if (isNested){
+      NOELLE_SpeculativeDOALLTrampoline(&argsForAllCores[0]);
+    }
+
+    /*
+     * Wait for DOALL tasks.
+     */
+    for (auto& future : localFutures){
+      future.get();
+    }
+
+    /*
+     * Validate the speculation.
+     * On a conflict, bring the memory back to the state it had before the invocation.
+     */
+    SpeculativeDispatcherInfo dispatcherInfo;
+    dispatcherInfo.numberOfThreadsUsed = numCores;
+    dispatcherInfo.misspeculated = 0;
+    if (NOELLE_SpeculativeDOALLHasConflicts(accessSets)){
+      #ifdef RUNTIME_PRINT
+      std::cerr << "Speculative DOALL: misspeculation" << std::endl;
+      #endif
+      NOELLE_SpeculativeDOALLRollback(accessSets);
+      speculativeDOALLMisspeculations++;
+      dispatcherInfo.misspeculated = 1;
+    }
+
+    /*
+     * Free the memory.
+     */
+    free(argsForAllCores);
+
+    return dispatcherInfo;
+  }
+
   #ifdef RUNTIME_PRINT
   void *mySSGlobal = nullptr;
   #endif
@@ -292,7 +832,9 @@ extern "C" {
 
     /*
      * Invoke
+     * Parallelized loops invoked by the task run sequentially because all HELIX tasks must run concurrently.
      */
+    auto previousNesting = NOELLE_enterParallelTask(parallelNestingDepth + 1, 1);
     HELIX_args->parallelizedLoop(
       HELIX_args->env, 
       HELIX_args->loopCarriedArray, 
@@ -302,6 +844,7 @@ extern "C" {
       HELIX_args->numCores,
       HELIX_args->loopIsOverFlag
       );
+    NOELLE_exitParallelTask(previousNesting);
 
     return ;
   }
@@ -343,12 +886,21 @@ extern "C" {
     std::cerr << "HELIX: dispatcher:  Number of cores = " << numCores << std::endl;
     #endif
 
+    /*
+     * A HELIX loop invoked by a task of another parallelized loop runs as a single task on the current thread.
+     * All HELIX tasks must run concurrently, which the threads of the pool cannot guarantee when they are already running the outer loop.
+     */
+    auto isNested = (parallelNestingDepth > 0);
+    if (isNested){
+      numCores = 1;
+    }
+
     /*
      * Assumptions.
      */
     assert(parallelizedLoop != NULL);
     assert(env != NULL);
-    assert(numCores > 1);
+    assert(isNested || (numCores > 1));
 
     /*
      * Allocate the sequential segment arrays.
@@ -454,6 +1006,14 @@ extern "C" {
       argsPerCore->numCores = numCores;
       argsPerCore->loopIsOverFlag = &loopIsOverFlag;
 
+      /*
+       * Run the single task of a nested loop.
+       */
+      if (isNested){
+        NOELLE_HELIXTrampoline(argsPerCore);
+        continue ;
+      }
+
       /*
        * Set the affinity for both the thread and its helper.
        */
@@ -586,8 +1146,11 @@ extern "C" {
 
     /*
      * Invoke
+     * Parallelized loops invoked by the stage run sequentially because all DSWP stages must run concurrently.
      */
+    auto previousNesting = NOELLE_enterParallelTask(parallelNestingDepth + 1, 1);
     DSWPArgs->funcToInvoke(DSWPArgs->env, DSWPArgs->localQueues);
+    NOELLE_exitParallelTask(previousNesting);
 
     return ;
   }
@@ -618,6 +1181,15 @@ extern "C" {
         case 64:
           localQueues[i] = new ThreadSafeLockFreeQueue<int64_t>();
           break;
+        case 128:
+          localQueues[i] = new ThreadSafeLockFreeQueue<queueElement128_t>();
+          break;
+        case 256:
+          localQueues[i] = new ThreadSafeLockFreeQueue<queueElement256_t>();
+          break;
+        case 512:
+          localQueues[i] = new ThreadSafeLockFreeQueue<queueElement512_t>();
+          break;
         default:
           std::cerr << "QUEUE SIZE INCORRECT!\n";
           abort();
@@ -635,8 +1207,14 @@ extern "C" {
 
     /*
      * Submit DSWP tasks
+     *
+     * All stages must run concurrently.
+     * The threads of the pool cannot guarantee it for a DSWP loop invoked by a task of another parallelized loop as they are already running the outer loop.
+     * Hence, the stages of such loops run on threads created for them.
      */
+    auto isNested = (parallelNestingDepth > 0);
     std::vector<MARC::TaskFuture<void>> localFutures;
+    std::vector<std::thread> nestedStageThreads;
     auto allStages = (void **)stages;
     for (auto i = 0; i < numberOfStages; ++i) {
 
@@ -651,6 +1229,10 @@ extern "C" {
       /*
        * Submit
        */
+      if (isNested){
+        nestedStageThreads.push_back(std::thread(NOELLE_DSWPTrampoline, argsPerCore));
+        continue ;
+      }
       localFutures.push_back(pool.submit(NOELLE_DSWPTrampoline, argsPerCore));
       #ifdef RUNTIME_PRINT
       std::cerr << "Submitted stage" << std::endl;
@@ -666,6 +1248,9 @@ extern "C" {
     for (auto& future : localFutures){
       future.get();
     }
+    for (auto &stageThread : nestedStageThreads){
+      stageThread.join();
+    }
     #ifdef RUNTIME_PRINT
     std::cerr << "Got all futures" << std::endl;
     #endif
@@ -690,6 +1275,15 @@ extern "C" {
         case 64:
           delete (ThreadSafeLockFreeQueue<int64_t> *)(localQueues[i]);
           break;
+        case 128:
+          delete (ThreadSafeLockFreeQueue<queueElement128_t> *)(localQueues[i]);
+          break;
+        case 256:
+          delete (ThreadSafeLockFreeQueue<queueElement256_t> *)(localQueues[i]);
+          break;
+        case 512:
+          delete (ThreadSafeLockFreeQueue<queueElement512_t> *)(localQueues[i]);
+          break;
       }
     }
     free(argsForAllCores);
@@ -699,6 +1293,7 @@ extern "C" {
     std::cout << "DSWP: 2 Bytes pushes = " << numberOfPushes16 << std::endl;
     std::cout << "DSWP: 4 Bytes pushes = " << numberOfPushes32 << std::endl;
     std::cout << "DSWP: 8 Bytes pushes = " << numberOfPushes64 << std::endl;
+    std::cout << "DSWP: Packed pushes = " << numberOfPushesPacked << std::endl;
     #endif
 
     DispatcherInfo dispatcherInfo;
@@ -28,6 +28,7 @@ patchInstallDir "noelle-load" ;
 patchInstallDir "noelle-parallel-load" ;
 patchInstallDir "noelle-norm" ;
 patchInstallDir "noelle-pre" ;
+patchInstallDir "noelle-pipeline" ;
 patchInstallDir "noelle-parallelizer" ;
 patchInstallDir "noelle-seq" ;
 patchInstallDir "noelle-inline" ;
@@ -42,6 +43,13 @@ patchInstallDir "noelle-loop-stats" ;
 patchInstallDir "noelle-enable" ;
 patchInstallDir "noelle-deadcode" ;
 patchInstallDir "noelle-prof-coverage" ;
+patchInstallDir "noelle-prof-dependences" ;
+patchInstallDir "noelle-meta-dep-prof-embed" ;
 patchInstallDir "noelle-config" ;
 patchInstallDir "noelle-simplification" ;
 patchInstallDir "loopaa" ;
+patchInstallDir "noelle-arch-calibrate" ;
+
+# Install the runtime sources needed to calibrate the machine and to profile dependences
+mkdir -p ${installDir}/runtime ;
+cp runtime/Parallelizer_utils.cpp runtime/Calibration.cpp runtime/DependenceProfiler.cpp ${installDir}/runtime/ ;
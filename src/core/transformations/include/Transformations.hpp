@@ -26,9 +26,12 @@ namespace llvm::noelle {
     LOOP_WHILIFIER_ID,
     SCEV_SIMPLIFICATION_ID,
     DEVIRTUALIZER_ID,
+    LOOP_COLLAPSE_ID,
+    LOOP_TILING_ID,
+    LOOP_FUSION_ID,
 
     First=DOALL_ID,
-    Last=DEVIRTUALIZER_ID
+    Last=LOOP_FUSION_ID
   };
 
   enum LoopDependenceInfoOptimization {
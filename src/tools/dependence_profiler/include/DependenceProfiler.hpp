@@ -0,0 +1,58 @@
+/*
+ * Copyright 2016 - 2020  Angelo Matni, Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+
+#include "Noelle.hpp"
+
+using namespace llvm;
+
+namespace llvm::noelle {
+
+  /*
+   * Profiler of the loop-carried memory dependences of the PDG.
+   *
+   * It either instruments the program to record which dependences manifest across loop iterations (see the runtime DependenceProfiler.cpp),
+   * or it embeds the resulting profile into the IR so that NOELLE can load it (see DependenceProfiles).
+   */
+  struct DependenceProfiler : public ModulePass {
+    public:
+      static char ID;
+
+      DependenceProfiler();
+
+      bool doInitialization(Module &M) override;
+      void getAnalysisUsage(AnalysisUsage &AU) const override;
+      bool runOnModule(Module &M) override;
+
+    private:
+      struct Dependence {
+        uint64_t loopID;
+        LoopStructure *loop;
+        Instruction *from;
+        Instruction *to;
+      };
+
+      bool instrument;
+      std::string profileToEmbed;
+
+      std::unordered_map<Instruction *, uint64_t> computeInstructionIDs (Module &M) const ;
+
+      std::vector<Dependence> collectLoopCarriedMemoryDependences (
+        Noelle &noelle,
+        std::unordered_map<Instruction *, uint64_t> &ids
+        ) const ;
+
+      bool instrumentProgram (Module &M, Noelle &noelle) ;
+
+      bool embedProfile (Module &M) ;
+  };
+
+}
@@ -0,0 +1,94 @@
+/*
+ * Copyright 2016 - 2020  Angelo Matni, Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "DependenceProfiler.hpp"
+
+using namespace llvm;
+using namespace llvm::noelle;
+
+DependenceProfiler::DependenceProfiler()
+  : ModulePass{ID},
+    instrument{false}
+  {
+
+  return ;
+}
+
+std::unordered_map<Instruction *, uint64_t> DependenceProfiler::computeInstructionIDs (Module &M) const {
+
+  /*
+   * Instructions are identified by their position within the module.
+   * Hence, the profile can only be embedded into the same bitcode that has been instrumented.
+   */
+  std::unordered_map<Instruction *, uint64_t> ids;
+  uint64_t nextID = 0;
+  for (auto &F : M){
+    for (auto &B : F){
+      for (auto &I : B){
+        ids[&I] = nextID++;
+      }
+    }
+  }
+
+  return ids;
+}
+
+std::vector<DependenceProfiler::Dependence> DependenceProfiler::collectLoopCarriedMemoryDependences (
+  Noelle &noelle,
+  std::unordered_map<Instruction *, uint64_t> &ids
+  ) const {
+  std::vector<Dependence> deps;
+
+  /*
+   * Fetch the hot loops.
+   */
+  auto loops = noelle.getLoops();
+
+  for (auto LDI : *loops){
+
+    /*
+     * Loops are identified by the terminator of their header.
+     */
+    auto loopStructure = LDI->getLoopStructure();
+    auto loopID = ids.at(loopStructure->getHeader()->getTerminator());
+
+    /*
+     * Collect the loop-carried memory dependences between loads and stores.
+     * Memory accessed by calls is not tracked, so their dependences are never considered as not manifested.
+     */
+    auto loopDG = LDI->getLoopDG();
+    for (auto edge : loopDG->getEdges()){
+      if (  false
+            || (!edge->isMemoryDependence())
+            || (!edge->isLoopCarriedDependence())
+         ){
+        continue ;
+      }
+      auto from = dyn_cast<Instruction>(edge->getOutgoingT());
+      auto to = dyn_cast<Instruction>(edge->getIncomingT());
+      if (  false
+            || (from == nullptr)
+            || (to == nullptr)
+            || (!isa<LoadInst>(from) && !isa<StoreInst>(from))
+            || (!isa<LoadInst>(to) && !isa<StoreInst>(to))
+         ){
+        continue ;
+      }
+      deps.push_back({loopID, loopStructure, from, to});
+    }
+  }
+
+  /*
+   * Free the memory.
+   */
+  delete loops;
+
+  return deps;
+}
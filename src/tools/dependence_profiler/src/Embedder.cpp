@@ -0,0 +1,117 @@
+/*
+ * Copyright 2016 - 2020  Angelo Matni, Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include <fstream>
+
+#include "DependenceProfiler.hpp"
+
+using namespace llvm;
+using namespace llvm::noelle;
+
+bool DependenceProfiler::embedProfile (Module &M){
+
+  /*
+   * Open the profile.
+   */
+  std::ifstream profile(this->profileToEmbed);
+  if (!profile.good()){
+    errs() << "DependenceProfiler:   ERROR = the profile " << this->profileToEmbed << " could not be read\n";
+    return false;
+  }
+
+  /*
+   * Identify the instructions the same way they have been identified when the program was instrumented.
+   */
+  auto ids = this->computeInstructionIDs(M);
+  std::unordered_map<uint64_t, Instruction *> idToInstruction;
+  for (auto &idPair : ids){
+    idToInstruction[idPair.second] = idPair.first;
+  }
+
+  /*
+   * Define the code to tag an instruction with its ID.
+   */
+  auto &cxt = M.getContext();
+  auto int64 = IntegerType::get(cxt, 64);
+  auto tagInstruction = [&](uint64_t id) -> Instruction * {
+    auto instIt = idToInstruction.find(id);
+    if (instIt == idToInstruction.end()){
+      return nullptr;
+    }
+    auto inst = instIt->second;
+    auto idM = MDNode::get(cxt, ConstantAsMetadata::get(ConstantInt::get(int64, id)));
+    inst->setMetadata(DependenceProfiles::instructionIDMetadataName, idM);
+    return inst;
+  };
+
+  /*
+   * Read the dependences that never manifested.
+   *
+   * A dependence that never manifested is reported only if the training run exercised it.
+   * This requires an invocation of its loop with at least two iterations, and both its end points to have executed inside the loop.
+   */
+  std::unordered_map<Instruction *, std::vector<Metadata *>> neverObserved;
+  uint64_t loopID, fromID, toID, manifested, loopInvocations, loopIterations, fromExecutions, toExecutions;
+  uint64_t profiledDeps = 0;
+  uint64_t neverObservedDeps = 0;
+  uint64_t notExercisedDeps = 0;
+  while (profile >> loopID >> fromID >> toID >> manifested >> loopInvocations >> loopIterations >> fromExecutions >> toExecutions){
+    profiledDeps++;
+    if (manifested > 0){
+      continue ;
+    }
+    if (  false
+          || (loopIterations <= loopInvocations)
+          || (fromExecutions == 0)
+          || (toExecutions == 0)
+       ){
+      notExercisedDeps++;
+      continue ;
+    }
+    neverObservedDeps++;
+
+    /*
+     * Tag the instructions involved.
+     */
+    auto loopTerminator = tagInstruction(loopID);
+    auto from = tagInstruction(fromID);
+    auto to = tagInstruction(toID);
+    if (  false
+          || (loopTerminator == nullptr)
+          || (from == nullptr)
+          || (to == nullptr)
+       ){
+      errs() << "DependenceProfiler:   ERROR = the profile does not match the program\n";
+      return false;
+    }
+
+    /*
+     * Attach the dependence to its destination.
+     */
+    Metadata *depM[] = {
+      ConstantAsMetadata::get(ConstantInt::get(int64, fromID)),
+      ConstantAsMetadata::get(ConstantInt::get(int64, loopID))
+    };
+    neverObserved[to].push_back(MDNode::get(cxt, depM));
+  }
+  for (auto &toPair : neverObserved){
+    toPair.first->setMetadata(DependenceProfiles::neverObservedMetadataName, MDTuple::get(cxt, toPair.second));
+  }
+  errs() << "DependenceProfiler:   " << neverObservedDeps << " out of " << profiledDeps << " profiled dependences never manifested\n";
+  errs() << "DependenceProfiler:   " << notExercisedDeps << " out of " << profiledDeps << " profiled dependences have not been exercised by the training run\n";
+
+  /*
+   * Tag the module.
+   */
+  auto n = M.getOrInsertNamedMetadata(DependenceProfiles::moduleMetadataName);
+  n->addOperand(MDNode::get(cxt, MDString::get(cxt, "true")));
+
+  return true;
+}
@@ -0,0 +1,115 @@
+/*
+ * Copyright 2016 - 2020  Angelo Matni, Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "DependenceProfiler.hpp"
+
+using namespace llvm;
+using namespace llvm::noelle;
+
+bool DependenceProfiler::instrumentProgram (Module &M, Noelle &noelle){
+
+  /*
+   * Identify the instructions before modifying the program.
+   */
+  auto ids = this->computeInstructionIDs(M);
+
+  /*
+   * Fetch the dependences to profile.
+   */
+  auto deps = this->collectLoopCarriedMemoryDependences(noelle, ids);
+  errs() << "DependenceProfiler:   There are " << deps.size() << " loop-carried memory dependences to profile\n";
+  if (deps.size() == 0){
+    return false;
+  }
+
+  /*
+   * Fetch the entry point of the program.
+   */
+  auto mainF = noelle.getEntryFunction();
+  if (mainF == nullptr){
+    errs() << "DependenceProfiler:   ERROR = the entry function of the program could not be found\n";
+    return false;
+  }
+
+  /*
+   * Declare the runtime.
+   */
+  auto &cxt = M.getContext();
+  auto voidType = Type::getVoidTy(cxt);
+  auto int64 = IntegerType::get(cxt, 64);
+  auto int8Ptr = PointerType::getUnqual(IntegerType::get(cxt, 8));
+  auto registerDependence = M.getOrInsertFunction("NOELLE_DependenceProfiler_registerDependence", voidType, int64, int64, int64);
+  auto loopInvocation = M.getOrInsertFunction("NOELLE_DependenceProfiler_loopInvocation", voidType, int64);
+  auto loopIteration = M.getOrInsertFunction("NOELLE_DependenceProfiler_loopIteration", voidType, int64);
+  auto memoryAccess = M.getOrInsertFunction("NOELLE_DependenceProfiler_memoryAccess", voidType, int64, int8Ptr, int64);
+
+  /*
+   * Register the dependences at the beginning of the program.
+   */
+  IRBuilder<> entryBuilder(&*mainF->getEntryBlock().getFirstInsertionPt());
+  for (auto &dep : deps){
+    entryBuilder.CreateCall(registerDependence, {
+      ConstantInt::get(int64, dep.loopID),
+      ConstantInt::get(int64, ids.at(dep.from)),
+      ConstantInt::get(int64, ids.at(dep.to))
+    });
+  }
+
+  /*
+   * Track the invocations and the iterations of the loops.
+   */
+  std::unordered_map<uint64_t, LoopStructure *> loops;
+  for (auto &dep : deps){
+    loops[dep.loopID] = dep.loop;
+  }
+  for (auto &loopPair : loops){
+    auto loopID = ConstantInt::get(int64, loopPair.first);
+    auto loopStructure = loopPair.second;
+
+    IRBuilder<> preheaderBuilder(loopStructure->getPreHeader()->getTerminator());
+    preheaderBuilder.CreateCall(loopInvocation, { loopID });
+
+    IRBuilder<> headerBuilder(&*loopStructure->getHeader()->getFirstInsertionPt());
+    headerBuilder.CreateCall(loopIteration, { loopID });
+  }
+
+  /*
+   * Track the memory accessed by the end points of the dependences.
+   */
+  std::set<Instruction *> accesses;
+  for (auto &dep : deps){
+    accesses.insert(dep.from);
+    accesses.insert(dep.to);
+  }
+  auto &DL = M.getDataLayout();
+  for (auto access : accesses){
+    Value *pointer = nullptr;
+    Type *accessedType = nullptr;
+    if (auto load = dyn_cast<LoadInst>(access)){
+      pointer = load->getPointerOperand();
+      accessedType = load->getType();
+    } else {
+      auto store = cast<StoreInst>(access);
+      pointer = store->getPointerOperand();
+      accessedType = store->getValueOperand()->getType();
+    }
+
+    IRBuilder<> accessBuilder(access);
+    auto pointerAsInt8 = accessBuilder.CreatePointerBitCastOrAddrSpaceCast(pointer, int8Ptr);
+    auto bytes = DL.getTypeStoreSize(accessedType);
+    accessBuilder.CreateCall(memoryAccess, {
+      ConstantInt::get(int64, ids.at(access)),
+      pointerAsInt8,
+      ConstantInt::get(int64, bytes)
+    });
+  }
+
+  return true;
+}
@@ -32,6 +32,7 @@ namespace llvm::noelle {
       DOALL (
         Module &module,
         Hot &p,
+        bool enableSpeculation,
         Verbosity v
       );
 
@@ -47,6 +48,32 @@ namespace llvm::noelle {
         Heuristics *h
       ) const override ;
 
+      /*
+       * Runtime alias checks
+       */
+      bool canSCCBeCheckedAtRuntime (
+        LoopDependenceInfo *LDI,
+        SCC *scc
+      ) const ;
+      std::set<std::pair<Instruction *, Instruction *>> getRuntimeAliasChecks (
+        LoopDependenceInfo *LDI
+      ) const ;
+
+      /*
+       * Speculation
+       */
+      bool isSCCSpeculated (
+        LoopDependenceInfo *LDI,
+        SCC *scc,
+        Noelle &par
+      ) const ;
+      bool requiresSpeculation (
+        LoopDependenceInfo *LDI
+      ) const ;
+      std::vector<Instruction *> getMemoryAccessesToTrackForSpeculation (
+        LoopDependenceInfo *LDI
+      ) const ;
+
 
     protected:
 
@@ -59,13 +86,157 @@ namespace llvm::noelle {
       void addChunkFunctionExecutionAsideOriginalLoop (
         LoopDependenceInfo *LDI,
         Function *loopFunction,
+        Noelle &par,
+        bool speculate,
+        std::set<std::pair<Instruction *, Instruction *>> &aliasChecks
+      );
+
+      /*
+       * Chunking
+       */
+      uint32_t computeChunkSize (
+        LoopDependenceInfo *LDI,
+        std::vector<StoreInst *> &storesToAlignChunksTo
+      ) const ;
+      Value * computeIterationsToPeelForAlignedChunks (
+        LoopDependenceInfo *LDI,
+        IRBuilder<> &entryBuilder,
+        Type *chunkCounterType
+      ) const ;
+      void stepQuotientsAndRemaindersOfIVsWithinChunks (
+        LoopDependenceInfo *LDI
+      );
+
+      /*
+       * Speculation
+       */
+      bool canLoopBeSpeculated (
+        LoopDependenceInfo *LDI
+      ) const ;
+      bool canSCCBeSpeculated (
+        LoopDependenceInfo *LDI,
+        SCC *scc,
         Noelle &par
+      ) const ;
+      void instrumentMemoryAccessesForSpeculation (
+        LoopDependenceInfo *LDI
+      );
+
+      /*
+       * Runtime alias checks
+       */
+      void generateRuntimeAliasChecks (
+        LoopDependenceInfo *LDI,
+        std::set<std::pair<Instruction *, Instruction *>> &aliasChecks,
+        BasicBlock *parallelizedLoopBB,
+        BasicBlock *sequentialLoopBB
+      );
+      bool getLinearMemoryAccess (
+        LoopDependenceInfo *LDI,
+        Instruction *I,
+        Value *&base,
+        int64_t &offset,
+        int64_t &stride,
+        uint64_t &size
+      ) const ;
+
+      /*
+       * Reducible memory locations (e.g., histograms)
+       */
+      std::vector<LoopCarriedMemoryLocation *> getReducibleMemoryLocations (
+        LoopDependenceInfo *LDI
+      ) const ;
+      std::unordered_map<LoopCarriedMemoryLocation *, std::pair<Value *, Value *>> cloneReducibleMemoryLocationsLocally (
+        LoopDependenceInfo *LDI
+      );
+      void mergeReducibleMemoryLocations (
+        LoopDependenceInfo *LDI,
+        std::unordered_map<LoopCarriedMemoryLocation *, std::pair<Value *, Value *>> &privateCopies
+      );
+
+      /*
+       * Early exits (e.g., search loops)
+       */
+      LoopGoverningIVAttribution * fetchLoopGoverningIVAttribution (
+        LoopDependenceInfo *LDI
+      ) const ;
+      bool hasEarlyExits (
+        LoopDependenceInfo *LDI
+      ) const ;
+      bool canEarlyExitsBeParallelized (
+        LoopDependenceInfo *LDI
+      ) const ;
+      bool isSCCOfLoopGoverningIVWithEarlyExits (
+        LoopDependenceInfo *LDI,
+        SCC *scc
+      ) const ;
+      bool isValueComputedByItsIteration (
+        LoopDependenceInfo *LDI,
+        Value *value
+      ) const ;
+      bool isLiveOutPropagatedByLoopGoverningExit (
+        LoopDependenceInfo *LDI,
+        int envIndex
+      ) const ;
+      std::vector<PHINode *> getEarlyExitPHIs (
+        LoopDependenceInfo *LDI
+      ) const ;
+      ConstantInt * getIterationNotExited (
+        LoopDependenceInfo *LDI
+      ) const ;
+      Value * fetchIterationOfEarlyExit (
+        LoopDependenceInfo *LDI,
+        IRBuilder<> &builder,
+        Value *ivValue
+      ) const ;
+      std::vector<Type *> allocateEarlyExitEnvironment (
+        LoopDependenceInfo *LDI,
+        std::set<int> &simpleVars,
+        std::set<int> &reducableVars
+      );
+      void addEarlyExitsToTask (
+        LoopDependenceInfo *LDI
+      );
+      void initializeEarlyExitEnvironment (
+        LoopDependenceInfo *LDI,
+        IRBuilder<> &builder
+      );
+      BasicBlock * propagateEarlyExit (
+        LoopDependenceInfo *LDI,
+        BasicBlock *latestBB,
+        Value *numThreadsUsed
       );
 
       /*
        * Helpers
        */
+      bool isSCCBlockingDOALL (
+        LoopDependenceInfo *LDI,
+        SCC *scc
+      ) const ;
       Value *fetchClone(Value *original) const ;
+
+      /*
+       * Fields
+       */
+      bool enableSpeculation;
+      Function *speculativeTaskDispatcher;
+      Function *speculativeLoad;
+      Function *speculativeStore;
+
+      /*
+       * Chunking of the loop being parallelized
+       */
+      uint32_t chunkSize;
+      std::vector<StoreInst *> storesToAlignChunksTo;
+
+      /*
+       * Environment variables of the early exits of the loop being parallelized
+       */
+      int earliestExitIterationEnvIndex;
+      int exitIterationEnvIndex;
+      int exitBlockEnvIndex;
+      std::unordered_map<PHINode *, int> earlyExitPHIToEnvIndex;
   };
 
 }
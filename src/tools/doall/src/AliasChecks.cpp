@@ -0,0 +1,246 @@
+/*
+ * Copyright 2016 - 2020  Angelo Matni, Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "DOALL.hpp"
+
+using namespace llvm;
+using namespace llvm::noelle;
+
+bool DOALL::getLinearMemoryAccess (
+  LoopDependenceInfo *LDI,
+  Instruction *I,
+  Value *&base,
+  int64_t &offset,
+  int64_t &stride,
+  uint64_t &size
+) const {
+
+  /*
+   * Fetch the type accessed.
+   */
+  Type *accessedType = nullptr;
+  if (auto load = dyn_cast<LoadInst>(I)){
+    accessedType = load->getType();
+  } else if (auto store = dyn_cast<StoreInst>(I)){
+    accessedType = store->getValueOperand()->getType();
+  } else {
+    return false;
+  }
+  size = this->module.getDataLayout().getTypeStoreSize(accessedType);
+
+  /*
+   * The instruction must access memory at base + offset + (stride * iteration).
+   */
+  auto domainSpaceAnalysis = LDI->getLoopIterationDomainSpaceAnalysis();
+  if (!domainSpaceAnalysis->getLinearMemoryAccessAcrossIterations(I, base, offset, stride)){
+    return false;
+  }
+  base = base->stripPointerCasts();
+
+  /*
+   * Accesses of different iterations must not overlap.
+   */
+  auto absoluteStride = (stride < 0) ? -stride : stride;
+  if (size > (uint64_t)absoluteStride){
+    return false;
+  }
+
+  return true;
+}
+
+bool DOALL::canSCCBeCheckedAtRuntime (
+  LoopDependenceInfo *LDI,
+  SCC *scc
+) const {
+
+  /*
+   * The number of iterations must be bounded by values available before executing the loop.
+   */
+  auto attribution = LDI->getLoopGoverningIVAttribution();
+  if (attribution == nullptr){
+    return false;
+  }
+  auto &IV = attribution->getInductionVariable();
+  auto loopStructure = LDI->getLoopStructure();
+  auto conditionValue = attribution->getHeaderCmpInstConditionValue();
+  if (  false
+        || (!IV.getLoopEntryPHI()->getType()->isIntegerTy())
+        || (!isa<ConstantInt>(IV.getSingleComputedStepValue()))
+        || (conditionValue == nullptr)
+        || (!conditionValue->getType()->isIntegerTy())
+        || (isa<Instruction>(conditionValue) && loopStructure->isIncluded(cast<Instruction>(conditionValue)))
+     ){
+    return false;
+  }
+
+  /*
+   * Every loop-carried data dependence must either access memory locations disjoint between iterations,
+   * or be a memory dependence between linear accesses that start from different base pointers.
+   * The latter exists only if the ranges of memory accessed overlap.
+   */
+  auto sccManager = LDI->getSCCManager();
+  auto domainSpaceAnalysis = LDI->getLoopIterationDomainSpaceAnalysis();
+  auto canBeChecked = true;
+  sccManager->iterateOverLoopCarriedDataDependences(scc, [
+    this, LDI, &canBeChecked, domainSpaceAnalysis
+  ](DGEdge<Value> *dep) -> bool {
+    if (dep->isControlDependence()) return false;
+
+    auto fromInst = dyn_cast<Instruction>(dep->getOutgoingT());
+    auto toInst = dyn_cast<Instruction>(dep->getIncomingT());
+    if (  false
+          || (!dep->isMemoryDependence())
+          || (fromInst == nullptr)
+          || (toInst == nullptr)
+       ){
+      canBeChecked = false;
+      return true;
+    }
+    if (domainSpaceAnalysis->areInstructionsAccessingDisjointMemoryLocationsBetweenIterations(fromInst, toInst)){
+      return false;
+    }
+
+    Value *fromBase, *toBase;
+    int64_t fromOffset, toOffset, fromStride, toStride;
+    uint64_t fromSize, toSize;
+    if (  false
+          || (!this->getLinearMemoryAccess(LDI, fromInst, fromBase, fromOffset, fromStride, fromSize))
+          || (!this->getLinearMemoryAccess(LDI, toInst, toBase, toOffset, toStride, toSize))
+          || (fromBase == toBase)
+       ){
+      canBeChecked = false;
+      return true;
+    }
+
+    return false;
+  });
+
+  return canBeChecked;
+}
+
+std::set<std::pair<Instruction *, Instruction *>> DOALL::getRuntimeAliasChecks (
+  LoopDependenceInfo *LDI
+) const {
+  std::set<std::pair<Instruction *, Instruction *>> aliasChecks;
+
+  /*
+   * Collect the pairs of accesses of the SCCs that can be checked at runtime.
+   */
+  auto sccManager = LDI->getSCCManager();
+  auto domainSpaceAnalysis = LDI->getLoopIterationDomainSpaceAnalysis();
+  for (auto scc : sccManager->getSCCsWithLoopCarriedDataDependencies()){
+    if (  false
+          || (!this->isSCCBlockingDOALL(LDI, scc))
+          || (!this->canSCCBeCheckedAtRuntime(LDI, scc))
+       ){
+      continue ;
+    }
+    sccManager->iterateOverLoopCarriedDataDependences(scc, [
+      &aliasChecks, domainSpaceAnalysis
+    ](DGEdge<Value> *dep) -> bool {
+      if (!dep->isMemoryDependence()) return false;
+
+      auto fromInst = cast<Instruction>(dep->getOutgoingT());
+      auto toInst = cast<Instruction>(dep->getIncomingT());
+      if (domainSpaceAnalysis->areInstructionsAccessingDisjointMemoryLocationsBetweenIterations(fromInst, toInst)){
+        return false;
+      }
+
+      /*
+       * The check is symmetric.
+       */
+      if (fromInst > toInst){
+        std::swap(fromInst, toInst);
+      }
+      aliasChecks.insert(std::make_pair(fromInst, toInst));
+      return false;
+    });
+  }
+
+  return aliasChecks;
+}
+
+void DOALL::generateRuntimeAliasChecks (
+  LoopDependenceInfo *LDI,
+  std::set<std::pair<Instruction *, Instruction *>> &aliasChecks,
+  BasicBlock *parallelizedLoopBB,
+  BasicBlock *sequentialLoopBB
+) {
+  IRBuilder<> checkBuilder(this->entryPointOfParallelizedLoop);
+  auto int64 = IntegerType::get(this->module.getContext(), 64);
+
+  /*
+   * Bound the last iteration of the loop by |exit value - start value| / |step| of the loop-governing IV.
+   */
+  auto attribution = LDI->getLoopGoverningIVAttribution();
+  auto &IV = attribution->getInductionVariable();
+  auto isSigned = attribution->getHeaderCmpInst()->isSigned();
+  auto startValue = checkBuilder.CreateIntCast(IV.getStartValue(), int64, isSigned);
+  auto exitValue = checkBuilder.CreateIntCast(attribution->getHeaderCmpInstConditionValue(), int64, isSigned);
+  auto step = cast<ConstantInt>(IV.getSingleComputedStepValue())->getSExtValue();
+  auto absoluteStep = (step < 0) ? -step : step;
+  auto distance = checkBuilder.CreateSub(exitValue, startValue);
+  auto isDistanceNegative = checkBuilder.CreateICmpSLT(distance, ConstantInt::get(int64, 0));
+  auto absoluteDistance = checkBuilder.CreateSelect(isDistanceNegative, checkBuilder.CreateNeg(distance), distance);
+  auto lastIteration = checkBuilder.CreateUDiv(absoluteDistance, ConstantInt::get(int64, absoluteStep));
+
+  /*
+   * Compute the range of memory [low, high) accessed by an instruction across the iterations of the loop.
+   */
+  Value *isTooLong = ConstantInt::getFalse(this->module.getContext());
+  auto computeRange = [&](Instruction *I) -> std::pair<Value *, Value *> {
+    Value *base;
+    int64_t offset, stride;
+    uint64_t size;
+    auto isLinear = this->getLinearMemoryAccess(LDI, I, base, offset, stride, size);
+    assert(isLinear);
+
+    /*
+     * Ranges that cannot be represented are considered overlapping.
+     */
+    auto absoluteStride = (stride < 0) ? -stride : stride;
+    auto maxIteration = ConstantInt::get(int64, INT64_MAX / absoluteStride);
+    isTooLong = checkBuilder.CreateOr(isTooLong, checkBuilder.CreateICmpUGT(lastIteration, maxIteration));
+
+    auto first = checkBuilder.CreateAdd(checkBuilder.CreatePtrToInt(base, int64), ConstantInt::get(int64, offset));
+    auto last = checkBuilder.CreateAdd(first, checkBuilder.CreateMul(lastIteration, ConstantInt::get(int64, stride)));
+    auto low = (stride > 0) ? first : last;
+    auto high = checkBuilder.CreateAdd((stride > 0) ? last : first, ConstantInt::get(int64, size));
+    return std::make_pair(low, high);
+  };
+
+  /*
+   * Check whether any pair of ranges overlaps.
+   */
+  std::unordered_map<Instruction *, std::pair<Value *, Value *>> ranges;
+  Value *overlap = ConstantInt::getFalse(this->module.getContext());
+  for (auto aliasCheck : aliasChecks){
+    for (auto inst : { aliasCheck.first, aliasCheck.second }){
+      if (ranges.find(inst) == ranges.end()){
+        ranges[inst] = computeRange(inst);
+      }
+    }
+    auto rangeA = ranges[aliasCheck.first];
+    auto rangeB = ranges[aliasCheck.second];
+    auto isOverlapping = checkBuilder.CreateAnd(
+      checkBuilder.CreateICmpULT(rangeA.first, rangeB.second),
+      checkBuilder.CreateICmpULT(rangeB.first, rangeA.second)
+    );
+    overlap = checkBuilder.CreateOr(overlap, isOverlapping);
+  }
+  overlap = checkBuilder.CreateOr(overlap, isTooLong);
+
+  /*
+   * Run the parallelized loop only if the ranges are disjoint.
+   */
+  checkBuilder.CreateCondBr(overlap, sequentialLoopBB, parallelizedLoopBB);
+
+  return ;
+}
@@ -53,9 +53,36 @@ void DOALL::rewireLoopToIterateChunks (
    */
   auto clonedStepSizeMap = cloneIVStepValueComputation(LDI, 0, entryBuilder);
 
+  /*
+   * Determine the first iteration executed by the task
+   * core_start_iteration: core_id * chunk_size
+   */
+  Value *coreStartIteration = entryBuilder.CreateMul(task->coreArg, task->chunkSizeArg, "coreIdx_X_chunkSize");
+
+  /*
+   * Shift the chunks to make them start at the beginning of a cache line written by the loop.
+   * The first core peels the iterations before such cache line by starting its first chunk part way through.
+   * core_start_iteration: core_id == 0 ? 0 : core_id * chunk_size - iterations_to_peel
+   */
+  auto iterationsToPeel = this->computeIterationsToPeelForAlignedChunks(LDI, entryBuilder, chunkCounterType);
+  if (iterationsToPeel != nullptr){
+    auto zeroValueForChunking = ConstantInt::get(chunkCounterType, 0);
+    auto isFirstCore = entryBuilder.CreateICmpEQ(task->coreArg, ConstantInt::get(task->coreArg->getType(), 0), "isFirstCore");
+    coreStartIteration = entryBuilder.CreateSelect(
+      isFirstCore,
+      zeroValueForChunking,
+      entryBuilder.CreateSub(coreStartIteration, iterationsToPeel),
+      "coreStartIteration"
+    );
+    chunkPHI->setIncomingValueForBlock(
+      preheaderClone,
+      entryBuilder.CreateSelect(isFirstCore, iterationsToPeel, zeroValueForChunking, "chunkStart")
+    );
+  }
+
   /*
    * Determine start value of the IV for the task
-   * core_start: original_start + original_step_size * core_id * chunk_size
+   * core_start: original_start + original_step_size * core_start_iteration
    */
   for (auto ivInfo : allIVInfo->getInductionVariables(*loopSummary)) {
     auto startOfIV = fetchClone(ivInfo->getStartValue());
@@ -65,7 +92,7 @@ void DOALL::rewireLoopToIterateChunks (
     auto nthCoreOffset = entryBuilder.CreateMul(
       stepOfIV,
       entryBuilder.CreateZExtOrTrunc(
-        entryBuilder.CreateMul(task->coreArg, task->chunkSizeArg, "coreIdx_X_chunkSize"),
+        coreStartIteration,
         stepOfIV->getType()
       ),
       "stepSize_X_coreIdx_X_chunkSize"
@@ -104,11 +131,12 @@ void DOALL::rewireLoopToIterateChunks (
   /*
    * The exit condition needs to be made non-strict to catch iterating past it
    */
-  auto loopGoverningIVAttr = LDI->getLoopGoverningIVAttribution();
+  auto loopGoverningIVAttr = this->fetchLoopGoverningIVAttribution(LDI);
   LoopGoverningIVUtility ivUtility(loopGoverningIVAttr->getInductionVariable(), *loopGoverningIVAttr);
   auto cmpInst = cast<CmpInst>(task->getCloneOfOriginalInstruction(loopGoverningIVAttr->getHeaderCmpInst()));
   auto brInst = cast<BranchInst>(task->getCloneOfOriginalInstruction(loopGoverningIVAttr->getHeaderBrInst()));
-  ivUtility.updateConditionAndBranchToCatchIteratingPastExitValue(cmpInst, brInst, task->getLastBlock(0));
+  auto headerExitClone = task->getCloneOfOriginalBasicBlock(loopGoverningIVAttr->getExitBlockFromHeader());
+  ivUtility.updateConditionAndBranchToCatchIteratingPastExitValue(cmpInst, brInst, headerExitClone);
   auto updatedCmpInst = cmpInst;
 
   /*
@@ -192,6 +220,11 @@ void DOALL::rewireLoopToIterateChunks (
     auto sccInfo = sccManager->getSCCAttrs(scc);
     if (!sccInfo->canExecuteReducibly()) continue;
 
+    /*
+     * Updates of reducible memory locations are not repeatable
+     */
+    if (sccInfo->getSingleLoopCarriedMemoryLocation() != nullptr) continue;
+
     // HACK:
     for (auto nodePair : scc->internalNodePairs()) {
       auto value = nodePair.first;
@@ -248,7 +281,7 @@ void DOALL::rewireLoopToIterateChunks (
       auto clonedCmpInst = updatedCmpInst->clone();
       clonedCmpInst->replaceUsesOfWith(loopGoverningPHI, prevIterationValue);
       latchBuilder.Insert(clonedCmpInst);
-      latchBuilder.CreateCondBr(clonedCmpInst, task->getLastBlock(0), headerClone);
+      latchBuilder.CreateCondBr(clonedCmpInst, headerExitClone, headerClone);
     }
 
     /*
@@ -0,0 +1,320 @@
+/*
+ * Copyright 2019 - 2020  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "DOALL.hpp"
+#include "DOALLTask.hpp"
+#include "Architecture.hpp"
+
+using namespace llvm;
+using namespace llvm::noelle;
+
+uint32_t DOALL::computeChunkSize (
+  LoopDependenceInfo *LDI,
+  std::vector<StoreInst *> &storesToAlignChunksTo
+) const {
+
+  /*
+   * Fetch the chunk size requested.
+   */
+  uint32_t chunkSize = LDI->DOALLChunkSize;
+  if (chunkSize == 0){
+    chunkSize = 1;
+  }
+
+  /*
+   * Collect the stores that write memory at base + offset + (stride * iteration) where a cache line includes an integral number of iterations.
+   * Chunks that are multiple of these iterations avoid cores writing the same cache line (false sharing).
+   * Because vector registers are not larger than a cache line, such chunks are also multiple of the iterations that fill a vector register.
+   */
+  auto cacheLineBytes = Architecture::getCacheLineBytes();
+  if (cacheLineBytes <= 0){
+    return chunkSize;
+  }
+  uint32_t iterationsToAlign = 1;
+  std::vector<std::pair<StoreInst *, int64_t>> alignableStores;
+  auto loopStructure = LDI->getLoopStructure();
+  for (auto bb : loopStructure->orderedBBs){
+    for (auto &inst : *bb){
+      auto store = dyn_cast<StoreInst>(&inst);
+      if (store == nullptr){
+        continue ;
+      }
+
+      /*
+       * Check the memory access of the store.
+       */
+      Value *base = nullptr;
+      int64_t offset = 0;
+      int64_t stride = 0;
+      uint64_t size = 0;
+      if (!this->getLinearMemoryAccess(LDI, store, base, offset, stride, size)){
+        continue ;
+      }
+      auto absoluteStride = (stride < 0) ? -stride : stride;
+      if ((cacheLineBytes % absoluteStride) != 0){
+        continue ;
+      }
+
+      /*
+       * The iterations that write a cache line are a power of two for every store considered.
+       * Hence, their least common multiple is their maximum.
+       */
+      uint32_t iterationsPerCacheLine = cacheLineBytes / absoluteStride;
+      iterationsToAlign = std::max(iterationsToAlign, iterationsPerCacheLine);
+
+      /*
+       * Only stores that walk forward through memory can be used to shift the chunks of the cores to start at a cache line.
+       */
+      if (stride > 0){
+        alignableStores.push_back(std::make_pair(store, stride));
+      }
+    }
+  }
+
+  /*
+   * Round up the chunk size to a multiple of the iterations that write a cache line.
+   */
+  chunkSize = ((chunkSize + iterationsToAlign - 1) / iterationsToAlign) * iterationsToAlign;
+
+  /*
+   * Prefer the stores that write the most iterations per cache line to align the chunks.
+   */
+  std::stable_sort(alignableStores.begin(), alignableStores.end(), [](auto &a, auto &b) -> bool {
+    return a.second < b.second;
+  });
+  for (auto &pair : alignableStores){
+    storesToAlignChunksTo.push_back(pair.first);
+  }
+
+  return chunkSize;
+}
+
+Value * DOALL::computeIterationsToPeelForAlignedChunks (
+  LoopDependenceInfo *LDI,
+  IRBuilder<> &entryBuilder,
+  Type *chunkCounterType
+) const {
+
+  /*
+   * Fetch the task.
+   */
+  auto task = (DOALLTask *)this->tasks[0];
+
+  /*
+   * Find a store whose first accessed address is available at the entry of the task.
+   */
+  auto cacheLineBytes = Architecture::getCacheLineBytes();
+  for (auto store : this->storesToAlignChunksTo){
+    Value *base = nullptr;
+    int64_t offset = 0;
+    int64_t stride = 0;
+    auto domainSpaceAnalysis = LDI->getLoopIterationDomainSpaceAnalysis();
+    if (!domainSpaceAnalysis->getLinearMemoryAccessAcrossIterations(store, base, offset, stride)){
+      continue ;
+    }
+
+    /*
+     * Fetch the base address within the task.
+     * The loop could use either the base or the pointer it has been casted from.
+     */
+    Value *baseClone = nullptr;
+    for (auto candidate : { base, base->stripPointerCasts() }){
+      if (isa<Constant>(candidate)){
+        baseClone = candidate;
+        break ;
+      }
+      if (task->isAnOriginalLiveIn(candidate)){
+        baseClone = task->getCloneOfOriginalLiveIn(candidate);
+        break ;
+      }
+    }
+    if (baseClone == nullptr){
+      continue ;
+    }
+
+    /*
+     * Compute the iterations executed before the store reaches the beginning of a cache line.
+     * iterations_to_peel: ((base + offset) % cache_line_bytes) / stride
+     *
+     * These iterations are less than the iterations that write a cache line, and therefore less than the chunk size.
+     */
+    auto intPtrType = this->module.getDataLayout().getIntPtrType(baseClone->getType());
+    auto firstAddress = entryBuilder.CreateAdd(
+      entryBuilder.CreatePtrToInt(baseClone, intPtrType),
+      ConstantInt::get(intPtrType, offset),
+      "firstAddressWritten"
+    );
+    auto misalignment = entryBuilder.CreateURem(firstAddress, ConstantInt::get(intPtrType, cacheLineBytes), "misalignment");
+    auto iterationsToPeel = entryBuilder.CreateUDiv(misalignment, ConstantInt::get(intPtrType, stride), "iterationsToPeel");
+
+    return entryBuilder.CreateZExtOrTrunc(iterationsToPeel, chunkCounterType);
+  }
+
+  return nullptr;
+}
+
+void DOALL::stepQuotientsAndRemaindersOfIVsWithinChunks (
+  LoopDependenceInfo *LDI
+) {
+
+  /*
+   * Fetch the task and the loop.
+   */
+  auto task = (DOALLTask *)this->tasks[0];
+  auto taskBody = task->getTaskBody();
+  auto &cxt = this->module.getContext();
+  auto loopStructure = LDI->getLoopStructure();
+  auto loopHeader = loopStructure->getHeader();
+  auto headerClone = task->getCloneOfOriginalBasicBlock(loopHeader);
+  auto IVManager = LDI->getInductionVariableManager();
+  auto invariantManager = LDI->getInvariantManager();
+  auto latches = loopStructure->getLatches();
+  std::set<BasicBlock *> latchClones;
+  for (auto latch : latches){
+    latchClones.insert(task->getCloneOfOriginalBasicBlock(latch));
+  }
+
+  /*
+   * Collect the unsigned divisions of an induction variable with step one by a loop invariant that come with the remainder of the same division (e.g., the indices recovered by collapsing a loop nest).
+   * Divisions by constants are already cheap.
+   */
+  std::vector<std::pair<Instruction *, Instruction *>> divisionsAndRemainders;
+  for (auto inst : loopStructure->getInstructions()){
+    auto division = dyn_cast<BinaryOperator>(inst);
+    if (  false
+          || (division == nullptr)
+          || (division->getOpcode() != Instruction::UDiv)
+       ){
+      continue ;
+    }
+    auto dividend = dyn_cast<PHINode>(division->getOperand(0));
+    auto divisor = division->getOperand(1);
+    auto divisionBB = division->getParent();
+    if (  false
+          || (dividend == nullptr)
+          || (dividend->getParent() != loopHeader)
+          || isa<Constant>(divisor)
+          || (!invariantManager->isLoopInvariant(divisor))
+          || (divisionBB == loopHeader)
+          || (latches.find(divisionBB) != latches.end())
+       ){
+      continue ;
+    }
+    auto IV = IVManager->getInductionVariable(*loopStructure, dividend);
+    if (  false
+          || (IV == nullptr)
+          || (IV->getLoopEntryPHI() != dividend)
+          || (!isa<ConstantInt>(IV->getSingleComputedStepValue()))
+          || (!cast<ConstantInt>(IV->getSingleComputedStepValue())->isOne())
+       ){
+      continue ;
+    }
+    for (auto &candidate : *divisionBB){
+      auto remainder = dyn_cast<BinaryOperator>(&candidate);
+      if (  true
+            && (remainder != nullptr)
+            && (remainder->getOpcode() == Instruction::URem)
+            && (remainder->getOperand(0) == dividend)
+            && (remainder->getOperand(1) == divisor)
+            && (!LDI->environment->isProducer(division))
+            && (!LDI->environment->isProducer(remainder))
+         ){
+        divisionsAndRemainders.push_back(std::make_pair(division, remainder));
+        break ;
+      }
+    }
+  }
+
+  for (auto &divisionAndRemainder : divisionsAndRemainders){
+    auto divisionClone = task->getCloneOfOriginalInstruction(divisionAndRemainder.first);
+    auto remainderClone = task->getCloneOfOriginalInstruction(divisionAndRemainder.second);
+    auto ivClone = cast<PHINode>(divisionClone->getOperand(0));
+    auto divisorClone = divisionClone->getOperand(1);
+    auto type = divisionClone->getType();
+    auto divisionBB = divisionClone->getParent();
+
+    /*
+     * The quotient and the remainder of an iteration are stepped from the ones of the previous iteration.
+     * Hence, they must be computed by every iteration that reaches a latch.
+     */
+    DominatorTree DT(*taskBody);
+    auto isComputedByEveryIteration = true;
+    for (auto latchClone : latchClones){
+      if (!DT.dominates(divisionBB, latchClone)){
+        isComputedByEveryIteration = false;
+        break ;
+      }
+    }
+    if (!isComputedByEveryIteration){
+      continue ;
+    }
+
+    /*
+     * Track the value of the induction variable, the quotient, and the remainder of the previous iteration executed by the task.
+     * The first iteration of the task has no previous one.
+     */
+    IRBuilder<> headerBuilder(headerClone->getFirstNonPHI());
+    std::vector<BasicBlock *> headerPreds(pred_begin(headerClone), pred_end(headerClone));
+    auto prevIV = headerBuilder.CreatePHI(type, headerPreds.size(), "prevIV");
+    auto prevQuotient = headerBuilder.CreatePHI(type, headerPreds.size(), "prevQuotient");
+    auto prevRemainder = headerBuilder.CreatePHI(type, headerPreds.size(), "prevRemainder");
+
+    /*
+     * Divide only when the iteration does not follow the previous one of the task (i.e., at the beginning of a chunk).
+     * Otherwise, step the remainder and carry it into the quotient.
+     */
+    remainderClone->moveAfter(divisionClone);
+    auto joinBB = divisionBB->splitBasicBlock(divisionClone);
+    auto divideBB = BasicBlock::Create(cxt, "", taskBody);
+    auto stepBB = BasicBlock::Create(cxt, "", taskBody);
+    divisionBB->getTerminator()->eraseFromParent();
+    IRBuilder<> divisionBuilder(divisionBB);
+    auto isNextIteration = divisionBuilder.CreateICmpEQ(ivClone, divisionBuilder.CreateAdd(prevIV, ConstantInt::get(type, 1)));
+    divisionBuilder.CreateCondBr(isNextIteration, stepBB, divideBB);
+
+    divisionClone->removeFromParent();
+    remainderClone->removeFromParent();
+    IRBuilder<> divideBuilder(divideBB);
+    divideBuilder.Insert(divisionClone);
+    divideBuilder.Insert(remainderClone);
+    divideBuilder.CreateBr(joinBB);
+
+    IRBuilder<> stepBuilder(stepBB);
+    auto nextRemainder = stepBuilder.CreateAdd(prevRemainder, ConstantInt::get(type, 1));
+    auto isWrapped = stepBuilder.CreateICmpEQ(nextRemainder, divisorClone);
+    auto steppedRemainder = stepBuilder.CreateSelect(isWrapped, ConstantInt::get(type, 0), nextRemainder);
+    auto steppedQuotient = stepBuilder.CreateAdd(prevQuotient, stepBuilder.CreateZExt(isWrapped, type));
+    stepBuilder.CreateBr(joinBB);
+
+    IRBuilder<> joinBuilder(&*joinBB->begin());
+    auto quotient = joinBuilder.CreatePHI(type, 2);
+    auto remainder = joinBuilder.CreatePHI(type, 2);
+    divisionClone->replaceAllUsesWith(quotient);
+    remainderClone->replaceAllUsesWith(remainder);
+    quotient->addIncoming(divisionClone, divideBB);
+    quotient->addIncoming(steppedQuotient, stepBB);
+    remainder->addIncoming(remainderClone, divideBB);
+    remainder->addIncoming(steppedRemainder, stepBB);
+
+    for (auto pred : headerPreds){
+      if (latchClones.find(pred) != latchClones.end()){
+        prevIV->addIncoming(ivClone, pred);
+        prevQuotient->addIncoming(quotient, pred);
+        prevRemainder->addIncoming(remainder, pred);
+        continue ;
+      }
+      prevIV->addIncoming(ivClone->getIncomingValueForBlock(pred), pred);
+      prevQuotient->addIncoming(UndefValue::get(type), pred);
+      prevRemainder->addIncoming(UndefValue::get(type), pred);
+    }
+  }
+
+  return ;
+}
@@ -9,6 +9,7 @@
  * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
  */
 #include "DOALL.hpp"
+#include "CompileTimeProfiler.hpp"
 #include "DOALLTask.hpp"
 
 using namespace llvm;
@@ -17,9 +18,20 @@ using namespace llvm::noelle;
 DOALL::DOALL (
   Module &module,
   Hot &p,
+  bool enableSpeculation,
   Verbosity v
 ) :
-  ParallelizationTechnique{module, p, v}
+  ParallelizationTechnique{module, p, v},
+  enableSpeculation{enableSpeculation},
+  speculativeTaskDispatcher{nullptr},
+  speculativeLoad{nullptr},
+  speculativeStore{nullptr},
+  chunkSize{0},
+  storesToAlignChunksTo{},
+  earliestExitIterationEnvIndex{-1},
+  exitIterationEnvIndex{-1},
+  exitBlockEnvIndex{-1},
+  earlyExitPHIToEnvIndex{}
   {
 
   /*
@@ -31,6 +43,23 @@ DOALL::DOALL (
     abort();
   }
 
+  /*
+   * Fetch the runtime functions to use to speculate DOALL loops.
+   */
+  if (this->enableSpeculation){
+    this->speculativeTaskDispatcher = this->module.getFunction("NOELLE_SpeculativeDOALLDispatcher");
+    this->speculativeLoad = this->module.getFunction("NOELLE_SpeculativeDOALL_load");
+    this->speculativeStore = this->module.getFunction("NOELLE_SpeculativeDOALL_store");
+    if (  false
+          || (this->speculativeTaskDispatcher == nullptr)
+          || (this->speculativeLoad == nullptr)
+          || (this->speculativeStore == nullptr)
+       ){
+      errs() << "NOELLE: ERROR = the runtime of the speculative DOALL couldn't be found\n";
+      abort();
+    }
+  }
+
   /*
    * Define the signature of the task, which will be invoked by the DOALL dispatcher.
    */
@@ -63,35 +92,45 @@ bool DOALL::canBeAppliedToLoop (
   auto loopStructure = LDI->getLoopStructure();
 
   /*
-   * The loop must have one single exit path.
+   * The loop must have at least one induction variable.
+   * This is because the trip count must be controlled by an induction variable.
    */
-  if (loopStructure->numberOfExitBasicBlocks() > 1){ 
+  if (!this->fetchLoopGoverningIVAttribution(LDI)) {
     if (this->verbose != Verbosity::Disabled) {
-      errs() << "DOALL:   More than 1 loop exit blocks\n";
+      errs() << "DOALL:   Loop does not have an IV\n";
     }
     return false;
   }
 
   /*
-   * The loop must have all live-out variables to be reducable.
+   * The loop must have one single exit path, unless the other exits are early exits from the loop governed by the IV (e.g., search loops).
    */
   auto sccManager = LDI->getSCCManager();
-  if (!sccManager->areAllLiveOutValuesReducable(LDI->environment)) {
+  if (this->hasEarlyExits(LDI)){
+    if (!this->canEarlyExitsBeParallelized(LDI)){
+      return false;
+    }
     if (this->verbose != Verbosity::Disabled) {
-      errs() << "DOALL:   Some post environment value is not reducable\n";
+      errs() << "DOALL:   The loop has early exits\n";
     }
-    return false;
-  }
 
-  /*
-   * The loop must have at least one induction variable.
-   * This is because the trip count must be controlled by an induction variable.
-   */
-  if (!LDI->getLoopGoverningIVAttribution()) {
-    if (this->verbose != Verbosity::Disabled) {
-      errs() << "DOALL:   Loop does not have an IV\n";
+  } else {
+    if (loopStructure->numberOfExitBasicBlocks() > 1){ 
+      if (this->verbose != Verbosity::Disabled) {
+        errs() << "DOALL:   More than 1 loop exit blocks\n";
+      }
+      return false;
+    }
+
+    /*
+     * The loop must have all live-out variables to be reducable.
+     */
+    if (!sccManager->areAllLiveOutValuesReducable(LDI->environment)) {
+      if (this->verbose != Verbosity::Disabled) {
+        errs() << "DOALL:   Some post environment value is not reducable\n";
+      }
+      return false;
     }
-    return false;
   }
 
   /*
@@ -116,53 +155,36 @@ bool DOALL::canBeAppliedToLoop (
   for (auto scc : nonDOALLSCCs) {
 
     /*
-     * Fetch the SCC metadata.
+     * Check if the SCC blocks the loop to be a DOALL.
      */
-    auto sccInfo = sccManager->getSCCAttrs(scc);
-
-    /*
-     * If the SCC is reducable, then it does not block the loop to be a DOALL.
-     */
-    if (sccInfo->canExecuteReducibly()){
+    if (!this->isSCCBlockingDOALL(LDI, scc)){
       continue ;
     }
 
     /*
-     * If the SCC can be cloned, then it does not block the loop to be a DOALL.
+     * If the loop-carried data dependences of the SCC exist only when two base pointers alias, then they can be checked at runtime.
      */
-    if (sccInfo->canBeCloned()){
+    if (this->canSCCBeCheckedAtRuntime(LDI, scc)){
+      if (this->verbose != Verbosity::Disabled) {
+        errs() << "DOALL:   The loop-carried data dependences of an SCC will be checked at runtime\n";
+      }
       continue ;
     }
 
     /*
-     * If all loop carried data dependencies within the SCC do not overlap between
-     * iterations, then DOALL can ignore them
+     * If the loop-carried data dependences of the SCC never manifested, then they can be speculated.
      */
-    auto areAllDataLCDsFromDisjointMemoryAccesses = true;
-    auto domainSpaceAnalysis = LDI->getLoopIterationDomainSpaceAnalysis();
-    sccManager->iterateOverLoopCarriedDataDependences(scc, [
-      &areAllDataLCDsFromDisjointMemoryAccesses, domainSpaceAnalysis
-    ](DGEdge<Value> *dep) -> bool {
-      if (dep->isControlDependence()) return false;
-
-      if (!dep->isMemoryDependence()) {
-        areAllDataLCDsFromDisjointMemoryAccesses = false;
-        return true;
+    if (this->isSCCSpeculated(LDI, scc, par)){
+      if (this->verbose != Verbosity::Disabled) {
+        errs() << "DOALL:   The loop-carried data dependences of an SCC never manifested in the profiles. They will be speculated\n";
       }
-
-      auto fromInst = dyn_cast<Instruction>(dep->getOutgoingT());
-      auto toInst = dyn_cast<Instruction>(dep->getIncomingT());
-      areAllDataLCDsFromDisjointMemoryAccesses &= fromInst && toInst && domainSpaceAnalysis->
-        areInstructionsAccessingDisjointMemoryLocationsBetweenIterations(fromInst, toInst);
-      return !areAllDataLCDsFromDisjointMemoryAccesses;
-    });
-    if (areAllDataLCDsFromDisjointMemoryAccesses) {
-      // if (this->verbose >= Verbosity::Maximal) {
-      //   scc->printMinimal(errs() << "SCC has memory LCDs that are disjoint between iterations!\n"); errs() << "\n";
-      // }
-      continue;
+      continue ;
     }
 
+    /*
+     * Fetch the SCC metadata.
+     */
+    auto sccInfo = sccManager->getSCCAttrs(scc);
     if (this->verbose != Verbosity::Disabled) {
       errs() << "DOALL:   We found an SCC of type " << sccInfo->getType() << " of the loop that is non clonable and non commutative\n" ;
       if (this->verbose >= Verbosity::Maximal) {
@@ -199,6 +221,8 @@ bool DOALL::apply (
   Noelle &par,
   Heuristics *h
 ) {
+  auto profiledLoop = LDI->getLoopStructure();
+  CompileTimeScope profile("doall-code-generation", *profiledLoop->getFunction(), profiledLoop->getID());
 
   /*
    * Fetch the headers.
@@ -217,13 +241,46 @@ bool DOALL::apply (
    */
   auto loopEnvironment = LDI->environment;
 
+  /*
+   * Check if the loop is a DOALL only thanks to speculating some of its loop-carried data dependences.
+   */
+  auto speculate = this->requiresSpeculation(LDI);
+
+  /*
+   * Fetch the pairs of memory accesses whose ranges must be disjoint to run the parallelized loop.
+   */
+  auto aliasChecks = this->getRuntimeAliasChecks(LDI);
+
+  /*
+   * Check if the loop can be left by an iteration before the loop-governing IV reaches its exit value.
+   */
+  auto earlyExits = this->hasEarlyExits(LDI);
+
+  /*
+   * Compute the number of consecutive iterations given to a core.
+   */
+  this->storesToAlignChunksTo.clear();
+  this->chunkSize = this->computeChunkSize(LDI, this->storesToAlignChunksTo);
+
   /*
    * Print the parallelization request.
    */
   if (this->verbose != Verbosity::Disabled) {
     errs() << "DOALL: Start the parallelization\n";
     errs() << "DOALL:   Number of threads to extract = " << LDI->getMaximumNumberOfCores() << "\n";
-    errs() << "DOALL:   Chunk size = " << LDI->DOALLChunkSize << "\n";
+    errs() << "DOALL:   Chunk size = " << this->chunkSize << "\n";
+    if (this->chunkSize != LDI->DOALLChunkSize){
+      errs() << "DOALL:     Rounded up from " << LDI->DOALLChunkSize << " to be a multiple of the iterations that write a cache line\n";
+    }
+    if (speculate){
+      errs() << "DOALL:   Speculative\n";
+    }
+    if (aliasChecks.size() > 0){
+      errs() << "DOALL:   Runtime alias checks = " << aliasChecks.size() << "\n";
+    }
+    if (earlyExits){
+      errs() << "DOALL:   Early exits\n";
+    }
   }
 
   /*
@@ -240,7 +297,13 @@ bool DOALL::apply (
   auto postEnvRange = loopEnvironment->getEnvIndicesOfLiveOutVars();
   std::set<int> nonReducableVars(preEnvRange.begin(), preEnvRange.end());
   std::set<int> reducableVars(postEnvRange.begin(), postEnvRange.end());
-  this->initializeEnvironmentBuilder(LDI, nonReducableVars, reducableVars);
+  std::vector<Type *> earlyExitVarTypes;
+  this->earlyExitPHIToEnvIndex.clear();
+  this->earliestExitIterationEnvIndex = this->exitIterationEnvIndex = this->exitBlockEnvIndex = -1;
+  if (earlyExits){
+    earlyExitVarTypes = this->allocateEarlyExitEnvironment(LDI, nonReducableVars, reducableVars);
+  }
+  this->initializeEnvironmentBuilder(LDI, nonReducableVars, reducableVars, earlyExitVarTypes);
 
   /*
    * Clone loop into the single task used by DOALL
@@ -258,6 +321,7 @@ bool DOALL::apply (
     envUser->addLiveInIndex(envIndex);
   }
   for (auto envIndex : loopEnvironment->getEnvIndicesOfLiveOutVars()) {
+    if (reducableVars.find(envIndex) == reducableVars.end()) continue;
     envUser->addLiveOutIndex(envIndex);
   }
   this->generateCodeToLoadLiveInVariables(LDI, 0);
@@ -270,6 +334,11 @@ bool DOALL::apply (
     this->cloneMemoryLocationsLocallyAndRewireLoop(LDI, 0);
   }
 
+  /*
+   * Allocate the private accumulators of the reducible memory locations (e.g., histograms) of the task.
+   */
+  auto privateCopiesOfReducibleMemoryLocations = this->cloneReducibleMemoryLocationsLocally(LDI);
+
   /*
    * Fix the data flow within the parallelized loop by redirecting operands of
    * cloned instructions to refer to the other cloned instructions. Currently,
@@ -280,11 +349,32 @@ bool DOALL::apply (
     errs() << "DOALL:  Adjusted data flow\n";
   }
 
+  /*
+   * Track the memory accessed by the parallelized loop to detect misspeculations.
+   */
+  if (speculate){
+    this->instrumentMemoryAccessesForSpeculation(LDI);
+    if (this->verbose >= Verbosity::Maximal) {
+      errs() << "DOALL:  Instrumented memory accesses for speculation\n";
+    }
+  }
+
   this->setReducableVariablesToBeginAtIdentityValue(LDI, 0);
   this->rewireLoopToIterateChunks(LDI);
   if (this->verbose >= Verbosity::Maximal) {
     errs() << "DOALL:  Rewired induction variables and reducible variables\n";
   }
+  this->stepQuotientsAndRemaindersOfIVsWithinChunks(LDI);
+
+  /*
+   * Publish the early exits taken by the task and stop iterating past the earliest one.
+   */
+  if (earlyExits){
+    this->addEarlyExitsToTask(LDI);
+    if (this->verbose >= Verbosity::Maximal) {
+      errs() << "DOALL:  Added early exits\n";
+    }
+  }
 
   /*
    * Add the final return to the single task's exit block.
@@ -303,7 +393,18 @@ bool DOALL::apply (
     errs() << "DOALL:  Stored live outs\n";
   }
 
-  this->addChunkFunctionExecutionAsideOriginalLoop(LDI, loopFunction, par);
+  /*
+   * Merge the private accumulators into the reducible memory locations before the task returns.
+   */
+  this->mergeReducibleMemoryLocations(LDI, privateCopiesOfReducibleMemoryLocations);
+  if (  true
+        && (this->verbose >= Verbosity::Maximal)
+        && (privateCopiesOfReducibleMemoryLocations.size() > 0)
+     ){
+    errs() << "DOALL:  Merged reducible memory locations\n";
+  }
+
+  this->addChunkFunctionExecutionAsideOriginalLoop(LDI, loopFunction, par, speculate, aliasChecks);
 
   /*
    * Final printing.
@@ -328,14 +429,33 @@ bool DOALL::apply (
 void DOALL::addChunkFunctionExecutionAsideOriginalLoop (
   LoopDependenceInfo *LDI,
   Function *loopFunction,
-  Noelle &par
+  Noelle &par,
+  bool speculate,
+  std::set<std::pair<Instruction *, Instruction *>> &aliasChecks
 ) {
 
+  /*
+   * Check at runtime that the memory accessed by the parallelized loop does not overlap.
+   * If it does, then the original loop executes the invocation sequentially.
+   */
+  auto entryPoint = this->entryPointOfParallelizedLoop;
+  if (aliasChecks.size() > 0){
+    auto &cxt = loopFunction->getContext();
+    auto parallelizedLoopBB = BasicBlock::Create(cxt, "", loopFunction);
+    this->misspeculationPointOfParallelizedLoop = BasicBlock::Create(cxt, "", loopFunction);
+    this->generateRuntimeAliasChecks(LDI, aliasChecks, parallelizedLoopBB, this->misspeculationPointOfParallelizedLoop);
+    this->entryPointOfParallelizedLoop = parallelizedLoopBB;
+  }
+
   /*
    * Create the environment.
    */
   this->allocateEnvironmentArray(LDI);
   this->populateLiveInEnvironment(LDI);
+  if (this->earliestExitIterationEnvIndex != -1){
+    IRBuilder<> earlyExitBuilder(this->entryPointOfParallelizedLoop);
+    this->initializeEarlyExitEnvironment(LDI, earlyExitBuilder);
+  }
 
   /*
    * Fetch the pointer to the environment.
@@ -350,13 +470,14 @@ void DOALL::addChunkFunctionExecutionAsideOriginalLoop (
   /*
    * Fetch the chunk size.
    */
-  auto chunkSize = ConstantInt::get(par.int64, LDI->DOALLChunkSize);
+  auto chunkSize = ConstantInt::get(par.int64, this->chunkSize);
 
   /*
    * Call the function that incudes the parallelized loop.
    */
   IRBuilder<> doallBuilder(this->entryPointOfParallelizedLoop);
-  auto doallCallInst = doallBuilder.CreateCall(this->taskDispatcher, ArrayRef<Value *>({
+  auto dispatcher = speculate ? this->speculativeTaskDispatcher : this->taskDispatcher;
+  auto doallCallInst = doallBuilder.CreateCall(dispatcher, ArrayRef<Value *>({
     tasks[0]->getTaskBody(),
     envPtr,
     numCores,
@@ -364,10 +485,38 @@ void DOALL::addChunkFunctionExecutionAsideOriginalLoop (
   }));
   auto numThreadsUsed = doallBuilder.CreateExtractValue(doallCallInst, (uint64_t)0);
 
+  /*
+   * If the speculation failed, then the runtime has already undone the memory modifications of the parallelized loop.
+   * Jump to the misspeculation point, which will be linked to the original loop to re-execute the invocation sequentially.
+   */
+  if (speculate){
+    auto &cxt = loopFunction->getContext();
+    auto misspeculated = doallBuilder.CreateExtractValue(doallCallInst, (uint64_t)1);
+    auto isMisspeculated = doallBuilder.CreateICmpNE(misspeculated, ConstantInt::get(misspeculated->getType(), 0));
+    auto speculationSucceeded = BasicBlock::Create(cxt, "", loopFunction);
+    if (this->misspeculationPointOfParallelizedLoop == nullptr){
+      this->misspeculationPointOfParallelizedLoop = BasicBlock::Create(cxt, "", loopFunction);
+    }
+    doallBuilder.CreateCondBr(isMisspeculated, this->misspeculationPointOfParallelizedLoop, speculationSucceeded);
+
+    /*
+     * Live-out variables are propagated only when the speculation succeeded.
+     */
+    this->entryPointOfParallelizedLoop = speculationSucceeded;
+  }
+
   /*
    * Propagate the last value of live-out variables to the code outside the parallelized loop.
    */
   auto latestBBAfterDOALLCall = this->propagateLiveOutEnvironment(LDI, numThreadsUsed);
+  this->entryPointOfParallelizedLoop = entryPoint;
+
+  /*
+   * Take the exit of the earliest iteration that left the loop, if any.
+   */
+  if (this->earliestExitIterationEnvIndex != -1){
+    latestBBAfterDOALLCall = this->propagateEarlyExit(LDI, latestBBAfterDOALLCall, numThreadsUsed);
+  }
 
   /*
    * Jump to the unique successor of the loop.
@@ -378,6 +527,70 @@ void DOALL::addChunkFunctionExecutionAsideOriginalLoop (
   return ;
 }
 
+bool DOALL::isSCCBlockingDOALL (
+  LoopDependenceInfo *LDI,
+  SCC *scc
+) const {
+
+  /*
+   * Fetch the SCC metadata.
+   */
+  auto sccManager = LDI->getSCCManager();
+  auto sccInfo = sccManager->getSCCAttrs(scc);
+
+  /*
+   * If the SCC is reducable, then it does not block the loop to be a DOALL.
+   */
+  if (sccInfo->canExecuteReducibly()){
+    return false;
+  }
+
+  /*
+   * If the SCC only merges the loop-governing IV with the conditions of the early exits, then tasks can evaluate these conditions for the iterations they execute.
+   */
+  if (this->isSCCOfLoopGoverningIVWithEarlyExits(LDI, scc)){
+    return false;
+  }
+
+  /*
+   * If the SCC can be cloned, then it does not block the loop to be a DOALL.
+   */
+  if (sccInfo->canBeCloned()){
+    return false;
+  }
+
+  /*
+   * If all loop carried data dependencies within the SCC do not overlap between
+   * iterations, then DOALL can ignore them
+   */
+  auto areAllDataLCDsFromDisjointMemoryAccesses = true;
+  auto domainSpaceAnalysis = LDI->getLoopIterationDomainSpaceAnalysis();
+  sccManager->iterateOverLoopCarriedDataDependences(scc, [
+    &areAllDataLCDsFromDisjointMemoryAccesses, domainSpaceAnalysis
+  ](DGEdge<Value> *dep) -> bool {
+    if (dep->isControlDependence()) return false;
+
+    if (!dep->isMemoryDependence()) {
+      areAllDataLCDsFromDisjointMemoryAccesses = false;
+      return true;
+    }
+
+    auto fromInst = dyn_cast<Instruction>(dep->getOutgoingT());
+    auto toInst = dyn_cast<Instruction>(dep->getIncomingT());
+    areAllDataLCDsFromDisjointMemoryAccesses &= fromInst && toInst && domainSpaceAnalysis->
+      areInstructionsAccessingDisjointMemoryLocationsBetweenIterations(fromInst, toInst);
+    return !areAllDataLCDsFromDisjointMemoryAccesses;
+  });
+  if (areAllDataLCDsFromDisjointMemoryAccesses) {
+    // if (this->verbose >= Verbosity::Maximal) {
+    //   scc->printMinimal(errs() << "SCC has memory LCDs that are disjoint between iterations!\n"); errs() << "\n";
+    // }
+    return false;
+  }
+
+  return true;
+}
+
 Value * DOALL::fetchClone (Value *original) const {
   auto task = (DOALLTask *)this->tasks[0];
   if (isa<ConstantData>(original)) return original;
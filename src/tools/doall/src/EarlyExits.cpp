@@ -0,0 +1,706 @@
+/*
+ * Copyright 2016 - 2020  Angelo Matni, Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "DOALL.hpp"
+#include "DOALLTask.hpp"
+#include "llvm/IR/IntrinsicInst.h"
+#include "llvm/Analysis/ValueTracking.h"
+
+using namespace llvm;
+using namespace llvm::noelle;
+
+LoopGoverningIVAttribution * DOALL::fetchLoopGoverningIVAttribution (
+  LoopDependenceInfo *LDI
+) const {
+
+  /*
+   * Check if the loop is governed by an IV and it has no other exits.
+   */
+  auto attribution = LDI->getLoopGoverningIVAttribution();
+  if (attribution != nullptr){
+    return attribution;
+  }
+
+  /*
+   * Check if the loop is governed by an IV, but it can leave earlier (e.g., search loops).
+   */
+  auto loopStructure = LDI->getLoopStructure();
+  auto IVManager = LDI->getInductionVariableManager();
+  return IVManager->getLoopGoverningIVAttributionOfLoopWithEarlyExits(*loopStructure);
+}
+
+bool DOALL::hasEarlyExits (
+  LoopDependenceInfo *LDI
+) const {
+  auto attribution = this->fetchLoopGoverningIVAttribution(LDI);
+  if (attribution == nullptr){
+    return false;
+  }
+
+  return attribution->hasEarlyExits();
+}
+
+bool DOALL::canEarlyExitsBeParallelized (
+  LoopDependenceInfo *LDI
+) const {
+  assert(this->hasEarlyExits(LDI));
+
+  /*
+   * Fetch the loop structure.
+   */
+  auto loopStructure = LDI->getLoopStructure();
+  auto loopHeader = loopStructure->getHeader();
+  auto attribution = this->fetchLoopGoverningIVAttribution(LDI);
+  auto earlyExitBranches = attribution->getEarlyExitBranches();
+
+  /*
+   * Iterations after the earliest exit can be executed by other tasks before they notice the exit.
+   * Hence, these iterations must not modify memory.
+   */
+  for (auto inst : loopStructure->getInstructions()){
+    if (  false
+          || isa<DbgInfoIntrinsic>(inst)
+          || (!inst->mayWriteToMemory())
+       ){
+      continue ;
+    }
+    if (auto call = dyn_cast<CallBase>(inst)){
+      if (call->isLifetimeStartOrEnd()){
+        continue ;
+      }
+    }
+    if (this->verbose != Verbosity::Disabled) {
+      errs() << "DOALL:   The loop has early exits and it modifies memory with " << *inst << "\n";
+    }
+    return false;
+  }
+
+  /*
+   * Iterations after the earliest exit would not run in the original loop.
+   * Hence, they must not trap (e.g., by loading from memory that is not dereferenceable or by dividing by zero).
+   *
+   * Tasks only execute iterations admitted by the loop-governing IV.
+   * Hence, loads that scan memory linearly with the iterations of the loop (e.g., values[i]) only access the range the loop is declared to iterate over.
+   */
+  auto domainSpaceAnalysis = LDI->getLoopIterationDomainSpaceAnalysis();
+  for (auto inst : loopStructure->getInstructions()){
+    if (auto load = dyn_cast<LoadInst>(inst)){
+      Value *base = nullptr;
+      int64_t offset = 0;
+      int64_t stride = 0;
+      if (  true
+            && load->isUnordered()
+            && domainSpaceAnalysis->getLinearMemoryAccessAcrossIterations(load, base, offset, stride)
+         ){
+        continue ;
+      }
+    }
+    if (  false
+          || isa<DbgInfoIntrinsic>(inst)
+          || isa<PHINode>(inst)
+          || inst->isTerminator()
+          || isSafeToSpeculativelyExecute(inst)
+       ){
+      continue ;
+    }
+    if (auto call = dyn_cast<CallBase>(inst)){
+      if (call->isLifetimeStartOrEnd()){
+        continue ;
+      }
+    }
+    if (this->verbose != Verbosity::Disabled) {
+      errs() << "DOALL:   The loop has early exits and it cannot execute speculatively " << *inst << "\n";
+    }
+    return false;
+  }
+
+  /*
+   * The loop can only be left by the loop-governing IV or by the early exits.
+   */
+  for (auto exitEdge : loopStructure->getLoopExitEdges()){
+    auto exitingTerminator = exitEdge.first->getTerminator();
+    if (exitingTerminator == attribution->getHeaderBrInst()){
+      continue ;
+    }
+    if (  true
+          && isa<BranchInst>(exitingTerminator)
+          && (earlyExitBranches.find(cast<BranchInst>(exitingTerminator)) != earlyExitBranches.end())
+       ){
+      continue ;
+    }
+    if (this->verbose != Verbosity::Disabled) {
+      errs() << "DOALL:   The loop has an exit that is not governed by the induction variable " << *exitingTerminator << "\n";
+    }
+    return false;
+  }
+
+  /*
+   * The values propagated by the early exits must be computed by their own iteration.
+   */
+  for (auto phi : this->getEarlyExitPHIs(LDI)){
+    auto phiType = phi->getType();
+    if (  true
+          && (!phiType->isPointerTy())
+          && (!phiType->isFloatingPointTy())
+          && (!phiType->isIntegerTy() || (phiType->getPrimitiveSizeInBits() > 64))
+       ){
+      if (this->verbose != Verbosity::Disabled) {
+        errs() << "DOALL:   The type of a value propagated by an early exit is not supported " << *phi << "\n";
+      }
+      return false;
+    }
+    for (auto i = 0; i < phi->getNumIncomingValues(); ++i){
+      auto exitingBB = phi->getIncomingBlock(i);
+      if (exitingBB == loopHeader){
+        continue ;
+      }
+      if (this->isValueComputedByItsIteration(LDI, phi->getIncomingValue(i))){
+        continue ;
+      }
+      if (this->verbose != Verbosity::Disabled) {
+        errs() << "DOALL:   The value propagated by an early exit depends on previous iterations " << *phi << "\n";
+      }
+      return false;
+    }
+  }
+
+  /*
+   * Live-out variables that leave the loop through its loop-governing IV are reduced as usual.
+   */
+  auto sccManager = LDI->getSCCManager();
+  auto sccdag = sccManager->getSCCDAG();
+  for (auto envIndex : LDI->environment->getEnvIndicesOfLiveOutVars()){
+    if (!this->isLiveOutPropagatedByLoopGoverningExit(LDI, envIndex)){
+      continue ;
+    }
+    auto producer = LDI->environment->producerAt(envIndex);
+    auto sccInfo = sccManager->getSCCAttrs(sccdag->sccOfValue(producer));
+    if (  false
+          || (sccInfo->getType() == SCCAttrs::SCCType::INDEPENDENT)
+          || (sccInfo->getType() == SCCAttrs::SCCType::REDUCIBLE)
+       ){
+      continue ;
+    }
+    if (this->verbose != Verbosity::Disabled) {
+      errs() << "DOALL:   Some post environment value is not reducable\n";
+    }
+    return false;
+  }
+
+  return true;
+}
+
+bool DOALL::isSCCOfLoopGoverningIVWithEarlyExits (
+  LoopDependenceInfo *LDI,
+  SCC *scc
+) const {
+
+  /*
+   * Check if the loop has early exits.
+   */
+  if (!this->hasEarlyExits(LDI)){
+    return false;
+  }
+  auto attribution = this->fetchLoopGoverningIVAttribution(LDI);
+  auto &loopGoverningIV = attribution->getInductionVariable();
+  if (!scc->isInternal(loopGoverningIV.getLoopEntryPHI())){
+    return false;
+  }
+
+  /*
+   * Fetch the instructions of the induction variables.
+   */
+  auto loopStructure = LDI->getLoopStructure();
+  auto loopHeader = loopStructure->getHeader();
+  auto IVManager = LDI->getInductionVariableManager();
+  std::set<Instruction *> ivInstructions;
+  std::set<PHINode *> ivPHIs;
+  for (auto IV : IVManager->getInductionVariables(*loopStructure)){
+    auto insts = IV->getAllInstructions();
+    ivInstructions.insert(insts.begin(), insts.end());
+    ivPHIs.insert(IV->getLoopEntryPHI());
+  }
+  auto earlyExitBranches = attribution->getEarlyExitBranches();
+
+  /*
+   * The SCC can only include the induction variables and the computation of the conditions of the early exits.
+   * The latter cannot have side effects nor carry values across iterations.
+   */
+  for (auto nodePair : scc->internalNodePairs()){
+    auto inst = dyn_cast<Instruction>(nodePair.first);
+    if (inst == nullptr){
+      return false;
+    }
+    if (  false
+          || (ivInstructions.find(inst) != ivInstructions.end())
+          || (inst == attribution->getHeaderCmpInst())
+          || (inst == attribution->getHeaderBrInst())
+       ){
+      continue ;
+    }
+    if (auto br = dyn_cast<BranchInst>(inst)){
+      if (  false
+            || br->isUnconditional()
+            || (earlyExitBranches.find(br) != earlyExitBranches.end())
+         ){
+        continue ;
+      }
+      return false;
+    }
+    if (  false
+          || (isa<PHINode>(inst) && (inst->getParent() == loopHeader))
+          || isa<CallBase>(inst)
+          || inst->isTerminator()
+          || inst->mayHaveSideEffects()
+       ){
+      return false;
+    }
+  }
+
+  /*
+   * The only values carried across iterations must be the ones of the induction variables.
+   */
+  auto sccManager = LDI->getSCCManager();
+  auto onlyIVsAreCarried = true;
+  sccManager->iterateOverLoopCarriedDataDependences(scc, [&onlyIVsAreCarried, &ivPHIs](DGEdge<Value> *dep) -> bool {
+    if (dep->isControlDependence()) return false;
+
+    auto toPHI = dyn_cast<PHINode>(dep->getIncomingT());
+    if (  false
+          || dep->isMemoryDependence()
+          || (toPHI == nullptr)
+          || (ivPHIs.find(toPHI) == ivPHIs.end())
+       ){
+      onlyIVsAreCarried = false;
+      return true;
+    }
+
+    return false;
+  });
+
+  return onlyIVsAreCarried;
+}
+
+bool DOALL::isValueComputedByItsIteration (
+  LoopDependenceInfo *LDI,
+  Value *value
+) const {
+
+  /*
+   * Constants and live-in values do not depend on the iteration.
+   */
+  if (isa<Constant>(value)){
+    return true;
+  }
+  auto loopStructure = LDI->getLoopStructure();
+  auto inst = dyn_cast<Instruction>(value);
+  if (  false
+        || (inst == nullptr)
+        || (!loopStructure->isIncluded(inst))
+     ){
+    return LDI->environment->isLiveIn(value);
+  }
+
+  /*
+   * Values of induction variables are computed by each task from the iteration it executes.
+   */
+  auto IVManager = LDI->getInductionVariableManager();
+  if (IVManager->getInductionVariable(*loopStructure, inst) != nullptr){
+    return true;
+  }
+
+  /*
+   * Check the SCC of the value.
+   */
+  auto sccManager = LDI->getSCCManager();
+  auto scc = sccManager->getSCCDAG()->sccOfValue(inst);
+  auto sccInfo = sccManager->getSCCAttrs(scc);
+  if (sccInfo->getType() == SCCAttrs::SCCType::INDEPENDENT){
+    return true;
+  }
+  if (this->isSCCOfLoopGoverningIVWithEarlyExits(LDI, scc)){
+    return true;
+  }
+
+  return false;
+}
+
+bool DOALL::isLiveOutPropagatedByLoopGoverningExit (
+  LoopDependenceInfo *LDI,
+  int envIndex
+) const {
+  auto loopHeader = LDI->getLoopStructure()->getHeader();
+  auto attribution = this->fetchLoopGoverningIVAttribution(LDI);
+  auto producer = LDI->environment->producerAt(envIndex);
+  for (auto consumer : LDI->environment->consumersOf(producer)){
+    auto phi = dyn_cast<PHINode>(consumer);
+    if (phi == nullptr){
+      return true;
+    }
+    if (phi->getParent() != attribution->getExitBlockFromHeader()){
+      continue ;
+    }
+    auto headerIndex = phi->getBasicBlockIndex(loopHeader);
+    if (  true
+          && (headerIndex != -1)
+          && (phi->getIncomingValue(headerIndex) == producer)
+       ){
+      return true;
+    }
+  }
+
+  return false;
+}
+
+std::vector<PHINode *> DOALL::getEarlyExitPHIs (
+  LoopDependenceInfo *LDI
+) const {
+  std::vector<PHINode *> phis;
+
+  /*
+   * Collect the PHIs of the exit blocks that receive a value from an early exit.
+   */
+  auto attribution = this->fetchLoopGoverningIVAttribution(LDI);
+  auto earlyExitBranches = attribution->getEarlyExitBranches();
+  std::set<BasicBlock *> earlyExitingBBs;
+  for (auto br : earlyExitBranches){
+    earlyExitingBBs.insert(br->getParent());
+  }
+  for (auto exitBB : LDI->getLoopStructure()->getLoopExitBasicBlocks()){
+    for (auto &phi : exitBB->phis()){
+      for (auto i = 0; i < phi.getNumIncomingValues(); ++i){
+        if (earlyExitingBBs.find(phi.getIncomingBlock(i)) == earlyExitingBBs.end()){
+          continue ;
+        }
+        phis.push_back(&phi);
+        break ;
+      }
+    }
+  }
+
+  return phis;
+}
+
+ConstantInt * DOALL::getIterationNotExited (
+  LoopDependenceInfo *LDI
+) const {
+
+  /*
+   * Iterations are numbered from zero (see fetchIterationOfEarlyExit).
+   * A loop would need 2^64 - 1 iterations to reach this number.
+   */
+  return ConstantInt::get(this->module.getContext(), APInt::getMaxValue(64));
+}
+
+Value * DOALL::fetchIterationOfEarlyExit (
+  LoopDependenceInfo *LDI,
+  IRBuilder<> &builder,
+  Value *ivValue
+) const {
+
+  /*
+   * The step of the loop-governing IV is a constant.
+   * Hence, the distance of the IV from its start value counts the iterations in the order the original loop executes them.
+   * The distance is unsigned whatever the signedness of the IV and of the comparison that governs the loop (e.g., EQ and NE).
+   */
+  auto attribution = this->fetchLoopGoverningIVAttribution(LDI);
+  auto &IV = attribution->getInductionVariable();
+  auto isStepNegative = cast<ConstantInt>(IV.getSingleComputedStepValue())->isNegative();
+  auto startValue = this->fetchClone(IV.getStartValue());
+  auto distance = isStepNegative ? builder.CreateSub(startValue, ivValue) : builder.CreateSub(ivValue, startValue);
+  auto int64 = IntegerType::get(this->module.getContext(), 64);
+
+  return builder.CreateIntCast(distance, int64, false);
+}
+
+std::vector<Type *> DOALL::allocateEarlyExitEnvironment (
+  LoopDependenceInfo *LDI,
+  std::set<int> &simpleVars,
+  std::set<int> &reducableVars
+) {
+  std::vector<Type *> types;
+  auto &cxt = this->module.getContext();
+  auto int32 = IntegerType::get(cxt, 32);
+  auto int64 = IntegerType::get(cxt, 64);
+
+  /*
+   * Live-out variables that are only propagated by early exits are taken from the task that exited first.
+   * Hence, they are not reduced.
+   */
+  for (auto envIndex : LDI->environment->getEnvIndicesOfLiveOutVars()){
+    if (this->isLiveOutPropagatedByLoopGoverningExit(LDI, envIndex)){
+      continue ;
+    }
+    reducableVars.erase(envIndex);
+    simpleVars.insert(envIndex);
+  }
+
+  /*
+   * The exit block taken is set once the tasks end.
+   */
+  if (LDI->environment->indexOfExitBlock() != -1){
+    simpleVars.insert(LDI->environment->indexOfExitBlock());
+  }
+
+  /*
+   * Allocate the environment variables that track the earliest iteration that took an early exit.
+   * - The earliest iteration is shared among tasks and it is updated atomically.
+   * - Each task keeps the iteration it exited from, the exit block it took, and the values propagated by that exit.
+   */
+  auto nextEnvIndex = LDI->environment->envSize();
+  this->earliestExitIterationEnvIndex = nextEnvIndex++;
+  simpleVars.insert(this->earliestExitIterationEnvIndex);
+  types.push_back(int64);
+  this->exitIterationEnvIndex = nextEnvIndex++;
+  reducableVars.insert(this->exitIterationEnvIndex);
+  types.push_back(int64);
+  if (LDI->getLoopStructure()->numberOfExitBasicBlocks() > 1){
+    this->exitBlockEnvIndex = nextEnvIndex++;
+    reducableVars.insert(this->exitBlockEnvIndex);
+    types.push_back(int32);
+  }
+  for (auto phi : this->getEarlyExitPHIs(LDI)){
+    this->earlyExitPHIToEnvIndex[phi] = nextEnvIndex++;
+    reducableVars.insert(this->earlyExitPHIToEnvIndex[phi]);
+    types.push_back(phi->getType());
+  }
+
+  return types;
+}
+
+void DOALL::addEarlyExitsToTask (
+  LoopDependenceInfo *LDI
+) {
+
+  /*
+   * Fetch the task.
+   */
+  auto task = (DOALLTask *)tasks[0];
+  auto envUser = this->envBuilder->getUser(0);
+  auto &cxt = this->module.getContext();
+  auto int64 = IntegerType::get(cxt, 64);
+
+  /*
+   * Fetch the loop and its loop-governing IV.
+   */
+  auto loopStructure = LDI->getLoopStructure();
+  auto loopHeader = loopStructure->getHeader();
+  auto headerClone = task->getCloneOfOriginalBasicBlock(loopHeader);
+  auto attribution = this->fetchLoopGoverningIVAttribution(LDI);
+  auto ivPHIClone = cast<PHINode>(this->fetchClone(attribution->getInductionVariable().getLoopEntryPHI()));
+  auto headerExitClone = task->getCloneOfOriginalBasicBlock(attribution->getExitBlockFromHeader());
+
+  /*
+   * Fetch the pointers to the environment variables of the early exits.
+   * The task has not exited from any iteration yet.
+   */
+  IRBuilder<> entryBuilder(task->getEntry()->getTerminator());
+  envUser->createEnvPtr(entryBuilder, this->earliestExitIterationEnvIndex, int64);
+  envUser->createReducableEnvPtr(entryBuilder, this->exitIterationEnvIndex, int64, numTaskInstances, task->getTaskInstanceID());
+  entryBuilder.CreateStore(this->getIterationNotExited(LDI), envUser->getEnvPtr(this->exitIterationEnvIndex));
+  for (auto phiEnvIndex : this->earlyExitPHIToEnvIndex){
+    envUser->createReducableEnvPtr(entryBuilder, phiEnvIndex.second, phiEnvIndex.first->getType(), numTaskInstances, task->getTaskInstanceID());
+  }
+  auto earliestExitIterationPtr = envUser->getEnvPtr(this->earliestExitIterationEnvIndex);
+  auto exitIterationPtr = envUser->getEnvPtr(this->exitIterationEnvIndex);
+
+  /*
+   * Each task stores the index of the exit block it took.
+   */
+  if (this->exitBlockEnvIndex != -1){
+    this->generateCodeToStoreExitBlockIndex(LDI, 0, this->exitBlockEnvIndex);
+  }
+
+  /*
+   * Publish the iteration that takes an early exit.
+   * The task saves the values propagated by the exit, and it lowers the earliest exit iteration shared among tasks.
+   */
+  for (auto br : attribution->getEarlyExitBranches()){
+    auto brClone = cast<BranchInst>(task->getCloneOfOriginalInstruction(br));
+    for (auto i = 0; i < br->getNumSuccessors(); ++i){
+      auto exitBB = br->getSuccessor(i);
+      if (loopStructure->isIncluded(exitBB)){
+        continue ;
+      }
+      auto exitClone = task->getCloneOfOriginalBasicBlock(exitBB);
+      auto publishBB = BasicBlock::Create(cxt, "", task->getTaskBody());
+      brClone->setSuccessor(i, publishBB);
+
+      IRBuilder<> publishBuilder(publishBB);
+      auto iteration = this->fetchIterationOfEarlyExit(LDI, publishBuilder, ivPHIClone);
+      publishBuilder.CreateStore(iteration, exitIterationPtr);
+      for (auto &phi : exitBB->phis()){
+        if (this->earlyExitPHIToEnvIndex.find(&phi) == this->earlyExitPHIToEnvIndex.end()){
+          continue ;
+        }
+        auto incomingIndex = phi.getBasicBlockIndex(br->getParent());
+        if (incomingIndex == -1){
+          continue ;
+        }
+        auto value = phi.getIncomingValue(incomingIndex);
+        auto valueClone = isa<Constant>(value) ? value : this->fetchClone(value);
+        publishBuilder.CreateStore(valueClone, envUser->getEnvPtr(this->earlyExitPHIToEnvIndex[&phi]));
+      }
+      publishBuilder.CreateAtomicRMW(AtomicRMWInst::UMin, earliestExitIterationPtr, iteration, AtomicOrdering::Monotonic);
+      publishBuilder.CreateBr(exitClone);
+    }
+  }
+
+  /*
+   * Stop executing iterations that come after the earliest exit taken by any task.
+   * This is checked before jumping back to the header, where the next iteration of the task is known.
+   */
+  for (auto latch : loopStructure->getLatches()){
+    auto latchClone = task->getCloneOfOriginalBasicBlock(latch);
+    auto latchTerminator = latchClone->getTerminator();
+    for (auto i = 0; i < latchTerminator->getNumSuccessors(); ++i){
+      if (latchTerminator->getSuccessor(i) != headerClone){
+        continue ;
+      }
+      auto checkBB = BasicBlock::Create(cxt, "", task->getTaskBody());
+      latchTerminator->setSuccessor(i, checkBB);
+      for (auto &phi : headerClone->phis()){
+        auto incomingIndex = phi.getBasicBlockIndex(latchClone);
+        if (incomingIndex != -1){
+          phi.setIncomingBlock(incomingIndex, checkBB);
+        }
+      }
+
+      IRBuilder<> checkBuilder(checkBB);
+      auto nextIteration = this->fetchIterationOfEarlyExit(LDI, checkBuilder, ivPHIClone->getIncomingValueForBlock(checkBB));
+      auto earliestExitIteration = checkBuilder.CreateLoad(earliestExitIterationPtr);
+      earliestExitIteration->setAtomic(AtomicOrdering::Monotonic);
+      earliestExitIteration->setAlignment(8);
+      auto isNextIterationNeeded = checkBuilder.CreateICmpULT(nextIteration, earliestExitIteration);
+      checkBuilder.CreateCondBr(isNextIterationNeeded, headerClone, headerExitClone);
+      break ;
+    }
+  }
+
+  return ;
+}
+
+void DOALL::initializeEarlyExitEnvironment (
+  LoopDependenceInfo *LDI,
+  IRBuilder<> &builder
+) {
+
+  /*
+   * No iteration took an early exit yet.
+   */
+  builder.CreateStore(this->getIterationNotExited(LDI), this->envBuilder->getEnvVar(this->earliestExitIterationEnvIndex));
+
+  return ;
+}
+
+BasicBlock * DOALL::propagateEarlyExit (
+  LoopDependenceInfo *LDI,
+  BasicBlock *latestBB,
+  Value *numThreadsUsed
+) {
+
+  /*
+   * Fetch the loop.
+   */
+  auto loopStructure = LDI->getLoopStructure();
+  auto loopHeader = loopStructure->getHeader();
+  auto attribution = this->fetchLoopGoverningIVAttribution(LDI);
+  auto headerExitBB = attribution->getExitBlockFromHeader();
+  auto loopExitBlocks = loopStructure->getLoopExitBasicBlocks();
+  auto int32 = IntegerType::get(this->module.getContext(), 32);
+
+  /*
+   * Pick the exit and the values of the task that exited from the earliest iteration.
+   * This is a min/max reduction of the exit iterations where the exit and the propagated values are tracked as its indices.
+   * When no early exit has been taken, the loop left from its header.
+   */
+  std::unordered_map<int, int> reducableBinaryOps;
+  std::unordered_map<int, Value *> initialValues;
+  std::unordered_map<int, CmpInst::Predicate> minMaxPredicates;
+  std::unordered_map<int, std::pair<int, CmpInst::Predicate>> indicesOfMinMax;
+  auto iterationNotExited = this->getIterationNotExited(LDI);
+  initialValues[this->exitIterationEnvIndex] = iterationNotExited;
+  minMaxPredicates[this->exitIterationEnvIndex] = CmpInst::ICMP_ULT;
+  if (this->exitBlockEnvIndex != -1){
+    auto headerExitIndex = std::find(loopExitBlocks.begin(), loopExitBlocks.end(), headerExitBB) - loopExitBlocks.begin();
+    initialValues[this->exitBlockEnvIndex] = ConstantInt::get(int32, headerExitIndex);
+    indicesOfMinMax[this->exitBlockEnvIndex] = std::make_pair(this->exitIterationEnvIndex, CmpInst::ICMP_ULT);
+  }
+  for (auto phiEnvIndex : this->earlyExitPHIToEnvIndex){
+    auto phiType = phiEnvIndex.first->getType();
+    initialValues[phiEnvIndex.second] = UndefValue::get(phiType);
+    auto tiePredicate = phiType->isFloatingPointTy() ? CmpInst::FCMP_OLT : CmpInst::ICMP_ULT;
+    indicesOfMinMax[phiEnvIndex.second] = std::make_pair(this->exitIterationEnvIndex, tiePredicate);
+  }
+  IRBuilder<> reductionBuilder(latestBB);
+  auto afterReductionBB = this->envBuilder->reduceLiveOutVariables(
+    latestBB,
+    reductionBuilder,
+    reducableBinaryOps,
+    initialValues,
+    minMaxPredicates,
+    indicesOfMinMax,
+    numThreadsUsed
+  );
+  IRBuilder<> afterReductionBuilder(afterReductionBB);
+  auto earliestExitIteration = this->envBuilder->getAccumulatedReducableEnvVar(this->exitIterationEnvIndex);
+  auto isEarlyExitTaken = afterReductionBuilder.CreateICmpNE(earliestExitIteration, iterationNotExited);
+
+  /*
+   * Set the exit block taken, which is read when jumping out of the parallelized loop.
+   */
+  if (this->exitBlockEnvIndex != -1){
+    auto loopExitBlockEnvIndex = LDI->environment->indexOfExitBlock();
+    auto exitBlockTaken = afterReductionBuilder.CreateIntCast(
+      this->envBuilder->getAccumulatedReducableEnvVar(this->exitBlockEnvIndex),
+      LDI->environment->typeOfEnv(loopExitBlockEnvIndex),
+      false
+    );
+    afterReductionBuilder.CreateStore(exitBlockTaken, this->envBuilder->getEnvVar(loopExitBlockEnvIndex));
+  }
+
+  /*
+   * Propagate the values of the exit taken to the PHIs of the exit blocks.
+   */
+  for (auto phiEnvIndex : this->earlyExitPHIToEnvIndex){
+    auto phi = phiEnvIndex.first;
+
+    /*
+     * Fetch the value the PHI would get from the loop-governing exit.
+     */
+    Value *valueFromHeader = UndefValue::get(phi->getType());
+    auto headerIndex = phi->getBasicBlockIndex(loopHeader);
+    if (  true
+          && (phi->getParent() == headerExitBB)
+          && (headerIndex != -1)
+       ){
+      valueFromHeader = phi->getIncomingValue(headerIndex);
+      for (auto envIndex : LDI->environment->getEnvIndicesOfLiveOutVars()){
+        if (LDI->environment->producerAt(envIndex) != valueFromHeader){
+          continue ;
+        }
+        valueFromHeader = this->envBuilder->getAccumulatedReducableEnvVar(envIndex);
+        break ;
+      }
+    }
+
+    /*
+     * Replace the values set by propagating the live-out variables.
+     */
+    while (phi->getBasicBlockIndex(this->exitPointOfParallelizedLoop) != -1){
+      phi->removeIncomingValue(this->exitPointOfParallelizedLoop, false);
+    }
+    auto valueFromEarlyExit = this->envBuilder->getAccumulatedReducableEnvVar(phiEnvIndex.second);
+    auto value = afterReductionBuilder.CreateSelect(isEarlyExitTaken, valueFromEarlyExit, valueFromHeader);
+    phi->addIncoming(value, this->exitPointOfParallelizedLoop);
+  }
+
+  return afterReductionBB;
+}
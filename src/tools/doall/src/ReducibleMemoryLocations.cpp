@@ -0,0 +1,211 @@
+/*
+ * Copyright 2016 - 2020  Angelo Matni, Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "DOALL.hpp"
+#include "DOALLTask.hpp"
+
+using namespace llvm;
+using namespace llvm::noelle;
+
+std::vector<LoopCarriedMemoryLocation *> DOALL::getReducibleMemoryLocations (
+  LoopDependenceInfo *LDI
+) const {
+  std::vector<LoopCarriedMemoryLocation *> locations;
+
+  auto sccManager = LDI->getSCCManager();
+  for (auto scc : sccManager->getSCCsWithLoopCarriedDataDependencies()){
+    auto sccInfo = sccManager->getSCCAttrs(scc);
+    if (!sccInfo->canExecuteReducibly()){
+      continue ;
+    }
+    auto location = sccInfo->getSingleLoopCarriedMemoryLocation();
+    if (location == nullptr){
+      continue ;
+    }
+    locations.push_back(location);
+  }
+
+  return locations;
+}
+
+std::unordered_map<LoopCarriedMemoryLocation *, std::pair<Value *, Value *>> DOALL::cloneReducibleMemoryLocationsLocally (
+  LoopDependenceInfo *LDI
+){
+  std::unordered_map<LoopCarriedMemoryLocation *, std::pair<Value *, Value *>> privateCopies;
+
+  /*
+   * Fetch the task.
+   */
+  auto task = this->tasks[0];
+  auto loopStructure = LDI->getLoopStructure();
+  auto &cxt = this->module.getContext();
+  auto &DL = this->module.getDataLayout();
+  auto int8 = IntegerType::get(cxt, 8);
+  auto int64 = IntegerType::get(cxt, 64);
+  auto mallocFunction = this->module.getOrInsertFunction("malloc", FunctionType::get(PointerType::getUnqual(int8), ArrayRef<Type *>({ int64 }), false));
+
+  for (auto location : this->getReducibleMemoryLocations(LDI)){
+
+    /*
+     * Fetch the array shared among the tasks.
+     */
+    auto pointers = location->getPointersToMemoryLocation();
+    auto anyPointer = *pointers.begin();
+    Value *sharedArray = anyPointer;
+    if (!isa<Constant>(anyPointer)){
+      assert(task->isAnOriginalLiveIn(anyPointer));
+      sharedArray = task->getCloneOfOriginalLiveIn(anyPointer);
+    }
+
+    /*
+     * Allocate the private accumulators of the current task once, when the task starts.
+     * Each element begins at the identity value of the reducing operator.
+     */
+    IRBuilder<> entryBuilder(task->getEntry());
+    auto sizeInBytes = location->getNumberOfElements() * DL.getTypeAllocSize(location->getElementType());
+    auto privateArray = entryBuilder.CreateCall(mallocFunction, ArrayRef<Value *>({ ConstantInt::get(int64, sizeInBytes) }));
+    auto identityByte = (location->getReducingOperator() == Instruction::And) ? 0xFF : 0;
+    entryBuilder.CreateMemSet(privateArray, ConstantInt::get(int8, identityByte), sizeInBytes, 1);
+
+    /*
+     * Redirect the updates of the parallelized loop to the private accumulators.
+     */
+    for (auto pointer : pointers){
+      auto privateArrayCast = entryBuilder.CreateBitCast(privateArray, pointer->getType());
+      for (auto user : pointer->users()){
+        auto gep = dyn_cast<GetElementPtrInst>(user);
+        if (  false
+              || (gep == nullptr)
+              || (!loopStructure->isIncluded(gep))
+           ){
+          continue ;
+        }
+        auto gepClone = task->getCloneOfOriginalInstruction(gep);
+        gepClone->setOperand(GetElementPtrInst::getPointerOperandIndex(), privateArrayCast);
+      }
+    }
+
+    privateCopies[location] = std::make_pair(sharedArray, privateArray);
+  }
+
+  return privateCopies;
+}
+
+void DOALL::mergeReducibleMemoryLocations (
+  LoopDependenceInfo *LDI,
+  std::unordered_map<LoopCarriedMemoryLocation *, std::pair<Value *, Value *>> &privateCopies
+){
+  if (privateCopies.size() == 0){
+    return ;
+  }
+
+  /*
+   * Fetch the task.
+   */
+  auto task = this->tasks[0];
+  auto taskBody = task->getTaskBody();
+  auto &cxt = this->module.getContext();
+  auto int8 = IntegerType::get(cxt, 8);
+  auto int64 = IntegerType::get(cxt, 64);
+
+  /*
+   * The merge happens after the task executed its chunks and just before it returns.
+   */
+  auto exitBlock = task->getExit();
+  auto returnBlock = exitBlock->splitBasicBlock(exitBlock->getTerminator());
+  exitBlock->getTerminator()->eraseFromParent();
+
+  /*
+   * Merge the private accumulators of the task into the shared arrays.
+   * Tasks merge in parallel by atomically combining only the elements they updated.
+   */
+  auto currentBlock = exitBlock;
+  for (auto &privateCopy : privateCopies){
+    auto location = privateCopy.first;
+    auto elementType = location->getElementType();
+    auto elementPtrType = PointerType::getUnqual(elementType);
+    auto reducingOperator = location->getReducingOperator();
+
+    auto headerBB = BasicBlock::Create(cxt, "", taskBody);
+    auto bodyBB = BasicBlock::Create(cxt, "", taskBody);
+    auto mergeBB = BasicBlock::Create(cxt, "", taskBody);
+    auto latchBB = BasicBlock::Create(cxt, "", taskBody);
+    auto nextBB = BasicBlock::Create(cxt, "", taskBody);
+
+    IRBuilder<> builder(currentBlock);
+    auto sharedElements = builder.CreateBitCast(privateCopy.second.first, elementPtrType);
+    auto privateElements = builder.CreateBitCast(privateCopy.second.second, elementPtrType);
+    builder.CreateBr(headerBB);
+
+    IRBuilder<> headerBuilder(headerBB);
+    auto index = headerBuilder.CreatePHI(int64, 2);
+    index->addIncoming(ConstantInt::get(int64, 0), currentBlock);
+    auto isInBounds = headerBuilder.CreateICmpULT(index, ConstantInt::get(int64, location->getNumberOfElements()));
+    headerBuilder.CreateCondBr(isInBounds, bodyBB, nextBB);
+
+    /*
+     * Skip the elements that still hold the identity value.
+     */
+    IRBuilder<> bodyBuilder(bodyBB);
+    auto privateElement = bodyBuilder.CreateInBoundsGEP(elementType, privateElements, index);
+    auto partialValue = bodyBuilder.CreateLoad(elementType, privateElement);
+    Value *isIdentity = nullptr;
+    if (elementType->isFloatingPointTy()){
+      isIdentity = bodyBuilder.CreateFCmpOEQ(partialValue, ConstantFP::get(elementType, 0));
+    } else if (reducingOperator == Instruction::And){
+      isIdentity = bodyBuilder.CreateICmpEQ(partialValue, Constant::getAllOnesValue(elementType));
+    } else {
+      isIdentity = bodyBuilder.CreateICmpEQ(partialValue, Constant::getNullValue(elementType));
+    }
+    bodyBuilder.CreateCondBr(isIdentity, latchBB, mergeBB);
+
+    IRBuilder<> mergeBuilder(mergeBB);
+    auto sharedElement = mergeBuilder.CreateInBoundsGEP(elementType, sharedElements, index);
+    AtomicRMWInst::BinOp atomicOperator;
+    switch (reducingOperator){
+      case Instruction::FAdd:
+        atomicOperator = AtomicRMWInst::FAdd;
+        break ;
+      case Instruction::Or:
+        atomicOperator = AtomicRMWInst::Or;
+        break ;
+      case Instruction::And:
+        atomicOperator = AtomicRMWInst::And;
+        break ;
+      case Instruction::Xor:
+        atomicOperator = AtomicRMWInst::Xor;
+        break ;
+      default:
+        assert(reducingOperator == Instruction::Add);
+        atomicOperator = AtomicRMWInst::Add;
+    }
+    mergeBuilder.CreateAtomicRMW(atomicOperator, sharedElement, partialValue, AtomicOrdering::Monotonic);
+    mergeBuilder.CreateBr(latchBB);
+
+    IRBuilder<> latchBuilder(latchBB);
+    auto nextIndex = latchBuilder.CreateAdd(index, ConstantInt::get(int64, 1));
+    index->addIncoming(nextIndex, latchBB);
+    latchBuilder.CreateBr(headerBB);
+
+    currentBlock = nextBB;
+  }
+
+  /*
+   * Free the private accumulators.
+   */
+  IRBuilder<> builder(currentBlock);
+  auto freeFunction = this->module.getOrInsertFunction("free", FunctionType::get(Type::getVoidTy(cxt), ArrayRef<Type *>({ PointerType::getUnqual(int8) }), false));
+  for (auto &privateCopy : privateCopies){
+    builder.CreateCall(freeFunction, ArrayRef<Value *>({ privateCopy.second.second }));
+  }
+  builder.CreateBr(returnBlock);
+
+  return ;
+}
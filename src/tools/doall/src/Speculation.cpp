@@ -0,0 +1,267 @@
+/*
+ * Copyright 2016 - 2020  Angelo Matni, Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "DOALL.hpp"
+#include "DOALLTask.hpp"
+#include "llvm/Analysis/ValueTracking.h"
+#include "llvm/IR/IntrinsicInst.h"
+
+using namespace llvm;
+using namespace llvm::noelle;
+
+bool DOALL::canLoopBeSpeculated (
+  LoopDependenceInfo *LDI
+) const {
+
+  /*
+   * A misspeculated invocation is re-executed sequentially after undoing its stores.
+   * Hence, the loop cannot modify memory through calls as their modifications cannot be undone.
+   */
+  auto loopStructure = LDI->getLoopStructure();
+  for (auto inst : loopStructure->getInstructions()){
+    auto call = dyn_cast<CallBase>(inst);
+    if (call == nullptr){
+      continue ;
+    }
+    if (  false
+          || isa<DbgInfoIntrinsic>(call)
+          || call->isLifetimeStartOrEnd()
+          || (!call->mayWriteToMemory())
+       ){
+      continue ;
+    }
+    if (this->verbose != Verbosity::Disabled) {
+      errs() << "DOALL:   The loop cannot be speculated because of " << *call << "\n";
+    }
+    return false;
+  }
+
+  /*
+   * The merge of the private accumulators of reducible memory locations cannot be undone.
+   */
+  if (this->getReducibleMemoryLocations(LDI).size() > 0){
+    if (this->verbose != Verbosity::Disabled) {
+      errs() << "DOALL:   The loop cannot be speculated because it reduces memory locations\n";
+    }
+    return false;
+  }
+
+  return true;
+}
+
+bool DOALL::canSCCBeSpeculated (
+  LoopDependenceInfo *LDI,
+  SCC *scc,
+  Noelle &par
+) const {
+
+  /*
+   * Speculation relies on the dependence profiles.
+   */
+  auto dependenceProfiles = par.getDependenceProfiles();
+  if (!dependenceProfiles->isAvailable()){
+    return false;
+  }
+
+  /*
+   * Every loop-carried data dependence must either access memory locations disjoint between iterations,
+   * or be a memory dependence between loads and stores that never manifested.
+   */
+  auto loopStructure = LDI->getLoopStructure();
+  auto sccManager = LDI->getSCCManager();
+  auto domainSpaceAnalysis = LDI->getLoopIterationDomainSpaceAnalysis();
+  auto canBeSpeculated = true;
+  sccManager->iterateOverLoopCarriedDataDependences(scc, [
+    &canBeSpeculated, domainSpaceAnalysis, dependenceProfiles, loopStructure
+  ](DGEdge<Value> *dep) -> bool {
+    if (dep->isControlDependence()) return false;
+
+    auto fromInst = dyn_cast<Instruction>(dep->getOutgoingT());
+    auto toInst = dyn_cast<Instruction>(dep->getIncomingT());
+    if (  false
+          || (!dep->isMemoryDependence())
+          || (fromInst == nullptr)
+          || (toInst == nullptr)
+       ){
+      canBeSpeculated = false;
+      return true;
+    }
+    if (domainSpaceAnalysis->areInstructionsAccessingDisjointMemoryLocationsBetweenIterations(fromInst, toInst)){
+      return false;
+    }
+
+    if (  false
+          || (!isa<LoadInst>(fromInst) && !isa<StoreInst>(fromInst))
+          || (!isa<LoadInst>(toInst) && !isa<StoreInst>(toInst))
+          || (!dependenceProfiles->isNeverObserved(fromInst, toInst, loopStructure))
+       ){
+      canBeSpeculated = false;
+      return true;
+    }
+
+    return false;
+  });
+
+  return canBeSpeculated;
+}
+
+bool DOALL::requiresSpeculation (
+  LoopDependenceInfo *LDI
+) const {
+  if (!this->enableSpeculation){
+    return false;
+  }
+
+  /*
+   * The loop has been accepted as a DOALL.
+   * Hence, the SCCs that would block it, and that cannot be checked at runtime, have been accepted because their dependences are speculated.
+   */
+  auto sccManager = LDI->getSCCManager();
+  for (auto scc : sccManager->getSCCsWithLoopCarriedDataDependencies()){
+    if (  true
+          && this->isSCCBlockingDOALL(LDI, scc)
+          && (!this->canSCCBeCheckedAtRuntime(LDI, scc))
+       ){
+      return true;
+    }
+  }
+
+  return false;
+}
+
+bool DOALL::isSCCSpeculated (
+  LoopDependenceInfo *LDI,
+  SCC *scc,
+  Noelle &par
+) const {
+  return true
+         && this->enableSpeculation
+         && this->canLoopBeSpeculated(LDI)
+         && this->canSCCBeSpeculated(LDI, scc, par);
+}
+
+std::vector<Instruction *> DOALL::getMemoryAccessesToTrackForSpeculation (
+  LoopDependenceInfo *LDI
+) const {
+  std::vector<Instruction *> accesses;
+  auto &DL = this->module.getDataLayout();
+
+  /*
+   * Collect the loads that are at the end points of the speculated dependences.
+   * Conflicts that involve other loads have been excluded by the dependence analysis.
+   */
+  std::unordered_set<Instruction *> speculatedLoads;
+  auto sccManager = LDI->getSCCManager();
+  for (auto scc : sccManager->getSCCsWithLoopCarriedDataDependencies()){
+    if (  false
+          || (!this->isSCCBlockingDOALL(LDI, scc))
+          || this->canSCCBeCheckedAtRuntime(LDI, scc)
+       ){
+      continue ;
+    }
+    sccManager->iterateOverLoopCarriedDataDependences(scc, [&speculatedLoads](DGEdge<Value> *dep) -> bool {
+      if (!dep->isMemoryDependence()) return false;
+      for (auto value : { dep->getOutgoingT(), dep->getIncomingT() }){
+        if (auto load = dyn_cast<LoadInst>(value)){
+          speculatedLoads.insert(load);
+        }
+      }
+      return false;
+    });
+  }
+
+  /*
+   * Collect the memory accesses of the loop.
+   * All stores are tracked because they must be undone on a misspeculation.
+   */
+  auto loopStructure = LDI->getLoopStructure();
+  auto memoryCloningAnalysis = LDI->getMemoryCloningAnalysis();
+  auto isMemoryCloningEnabled = LDI->isOptimizationEnabled(LoopDependenceInfoOptimization::MEMORY_CLONING_ID);
+  for (auto originalInst : loopStructure->getInstructions()){
+
+    /*
+     * Fetch the access.
+     */
+    Value *pointer = nullptr;
+    if (auto load = dyn_cast<LoadInst>(originalInst)){
+      if (speculatedLoads.find(load) == speculatedLoads.end()){
+        continue ;
+      }
+      pointer = load->getPointerOperand();
+
+    } else if (auto store = dyn_cast<StoreInst>(originalInst)){
+      pointer = store->getPointerOperand();
+
+    } else {
+      continue ;
+    }
+
+    /*
+     * Stack locations private to the task do not need to be tracked.
+     * They are the ones allocated within the loop and the ones the task privatizes.
+     * The other stack locations of the function that runs the loop are reached through the environment, so they are shared between cores.
+     */
+    if (auto alloca = dyn_cast<AllocaInst>(GetUnderlyingObject(pointer, DL))){
+      if (loopStructure->isIncluded(alloca)){
+        continue ;
+      }
+      auto location = isMemoryCloningEnabled ? memoryCloningAnalysis->getClonableMemoryLocationFor(originalInst) : nullptr;
+      if (  true
+            && (location != nullptr)
+            && (location->getAllocation() == alloca)
+         ){
+        continue ;
+      }
+    }
+
+    accesses.push_back(originalInst);
+  }
+
+  return accesses;
+}
+
+void DOALL::instrumentMemoryAccessesForSpeculation (
+  LoopDependenceInfo *LDI
+) {
+
+  /*
+   * Fetch the task.
+   */
+  auto task = (DOALLTask *)this->tasks[0];
+  auto &DL = this->module.getDataLayout();
+  auto &cxt = this->module.getContext();
+  auto int8Ptr = PointerType::getUnqual(IntegerType::get(cxt, 8));
+  auto int64 = IntegerType::get(cxt, 64);
+
+  /*
+   * Track the accesses within the task.
+   */
+  for (auto originalInst : this->getMemoryAccessesToTrackForSpeculation(LDI)){
+    Type *accessedType = nullptr;
+    Function *hook = nullptr;
+    if (auto load = dyn_cast<LoadInst>(originalInst)){
+      accessedType = load->getType();
+      hook = this->speculativeLoad;
+    } else {
+      accessedType = cast<StoreInst>(originalInst)->getValueOperand()->getType();
+      hook = this->speculativeStore;
+    }
+
+    auto clonedInst = task->getCloneOfOriginalInstruction(originalInst);
+    assert(clonedInst != nullptr);
+    auto clonedPointer = isa<LoadInst>(clonedInst) ? cast<LoadInst>(clonedInst)->getPointerOperand() : cast<StoreInst>(clonedInst)->getPointerOperand();
+    IRBuilder<> builder(clonedInst);
+    auto address = builder.CreatePointerCast(clonedPointer, int8Ptr);
+    auto bytes = ConstantInt::get(int64, DL.getTypeStoreSize(accessedType));
+    builder.CreateCall(hook, ArrayRef<Value *>({ address, bytes }));
+  }
+
+  return ;
+}
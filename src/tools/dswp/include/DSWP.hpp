@@ -20,6 +20,7 @@
 #include "ParallelizationTechniqueForLoopsWithLoopCarriedDataDependences.hpp"
 #include "DSWPTask.hpp"
 #include "LoopDependenceInfo.hpp"
+#include "IVStepperUtility.hpp"
 
 namespace llvm::noelle {
 
@@ -64,6 +65,13 @@ namespace llvm::noelle {
       std::unordered_map<SCC *, DSWPTask *> sccToStage;
       std::vector<std::unique_ptr<QueueInfo>> queues;
 
+      /*
+       * Stage executed by more than one core (PS-DSWP), if any.
+       * Queues connected to it are implemented by one physical queue per replica.
+       */
+      DSWPTask *replicatedStage;
+      uint32_t numberOfQueueSlots;
+
       /*
        * Types for arrays storing dependencies and stages
        */
@@ -89,6 +97,13 @@ namespace llvm::noelle {
       void popValueQueues (LoopDependenceInfo *LDI, Noelle &par, int taskIndex);
       void pushValueQueues (LoopDependenceInfo *LDI, Noelle &par, int taskIndex);
       void createPipelineFromStages (LoopDependenceInfo *LDI, Noelle &par);
+      Value * fetchQueuePointer (
+        LoopDependenceInfo *LDI,
+        Noelle &par,
+        DSWPTask *task,
+        int queueIndex,
+        IRBuilder<> &builder
+      );
       Value * createStagesArrayFromStages (
         LoopDependenceInfo *LDI,
         IRBuilder<> funcBuilder,
@@ -100,6 +115,15 @@ namespace llvm::noelle {
         Noelle &par
       );
 
+      /*
+       * Parallel stages (PS-DSWP)
+       */
+      void replicateParallelStage (LoopDependenceInfo *LDI, std::vector<Task *> &techniqueTasks);
+      bool canStageBeReplicated (LoopDependenceInfo *LDI, DSWPTask *stage) const ;
+      void mapQueuesToReplicas (void);
+      void rewireReplicaToExecuteItsIterations (LoopDependenceInfo *LDI, int taskIndex);
+      void computeIterationIndex (LoopDependenceInfo *LDI, Noelle &par, int taskIndex);
+
       /*
        * Recursively inline queue push/pop functions in DSWP Utils and ThreadPool API
        */
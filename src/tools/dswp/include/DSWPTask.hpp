@@ -38,6 +38,7 @@ namespace llvm::noelle {
        * DSWP specific task function arguments
        */
       Value *queueArg;
+      Value *queuesArray;
 
       /*
        * Original loops' relevant structures
@@ -45,6 +46,21 @@ namespace llvm::noelle {
       std::set<SCC *> stageSCCs;
       std::set<SCC *> clonableSCCs;
 
+      /*
+       * A stage without loop-carried dependences can be executed by several replicas (PS-DSWP).
+       * Replica i executes the iterations i, i + numberOfReplicas, i + 2 * numberOfReplicas, ...
+       * The replica 0 keeps track of the other ones.
+       */
+      uint32_t replicaID;
+      uint32_t numberOfReplicas;
+      std::vector<DSWPTask *> replicas;
+
+      /*
+       * Index of the current iteration.
+       * This is only needed by stages that exchange values with a replicated stage.
+       */
+      PHINode *iterationIndex;
+
       /*
        * Maps from producer to the queues they push to
        */
@@ -74,31 +90,65 @@ namespace llvm::noelle {
     int bitLength;
     bool isMemoryDependence;
 
+    /*
+     * Physical queues used to implement this one.
+     * There is one per replica when the queue is connected to a replicated stage.
+     */
+    int firstSlot;
+    uint32_t numberOfSlots;
+
     Instruction * producer;
     std::set<Instruction *> consumers;
     unordered_map<Instruction *, int> consumerToPushIndex;
 
+    /*
+     * All producers of the same basic block that send values to the same stage share the queue.
+     * Their values are packed into a single element (a struct), which is pushed once all of them have been produced.
+     * Producers in memoryProducers only need the push to happen (i.e., they send a token).
+     */
+    std::vector<Instruction *> producers;
+    std::set<Instruction *> memoryProducers;
+    bool isPacked;
+
     QueueInfo(Instruction *p, Instruction *c, Type *type, bool isMemoryDependence)
-        : producer{p}, dependentType{type}, isMemoryDependence{isMemoryDependence} {
+        : producer{p}, dependentType{type}, isMemoryDependence{isMemoryDependence}, firstSlot{-1}, numberOfSlots{1}, isPacked{false} {
       consumers.insert(c);
+      producers.push_back(p);
       if (isMemoryDependence) {
-        dependentType = IntegerType::get(c->getContext(), 1);
-        bitLength = 1;
-      } else if (dependentType->isPointerTy()) {
-        bitLength = DataLayout(p->getModule()).getTypeAllocSize(dependentType) * 8;
-      } else {
-        bitLength = dependentType->getPrimitiveSizeInBits();
-        // NOTE(angelo): Round up to the nearest power of 2
-        bitLength = pow(2, ceil(log2(bitLength)));
+        memoryProducers.insert(p);
       }
+      computeTypeOfElements(producers, memoryProducers, dependentType, bitLength, this->isMemoryDependence, isPacked);
     }
 
+    bool canAddProducer (Instruction *p, bool isMemoryDependence) const ;
+
+    void addProducer (Instruction *p, bool isMemoryDependence) ;
+
+    std::vector<Instruction *> getProducersOfValues (void) const ;
+
+    Instruction * getLastProducer (void) const ;
+
     raw_ostream &print (raw_ostream &stream, std::string prefixToUse = "") {
       producer->print(stream << prefixToUse
         << "From stage: " << fromStage << " To stage: " << toStage
         << " Number of bits: " << bitLength << " Producer: ");
       return stream << "\n";
     }
+
+    /*
+     * Maximum number of bits of an element of a queue
+     */
+    static const int maximumBitLength = 512;
+
+    private:
+      static void computeTypeOfElements (
+        const std::vector<Instruction *> &producers,
+        const std::set<Instruction *> &memoryProducers,
+        Type *&dependentType,
+        int &bitLength,
+        bool &isMemoryDependence,
+        bool &isPacked
+      );
   };
 
   struct QueueInstrs {
@@ -9,6 +9,7 @@
  * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
  */
 #include "DSWP.hpp"
+#include "CompileTimeProfiler.hpp"
 
 using namespace llvm;
 using namespace llvm::noelle;
@@ -23,6 +24,7 @@ DSWP::DSWP (
   ParallelizationTechniqueForLoopsWithLoopCarriedDataDependences{module, p, forceParallelization, v},
   enableMergingSCC{enableSCCMerging},
   queues{}, queueArrayType{nullptr},
+  replicatedStage{nullptr}, numberOfQueueSlots{0},
   sccToStage{}, stageArrayType{nullptr},
   zeroIndexForBaseArray{nullptr}
   {
@@ -55,6 +57,8 @@ void DSWP::reset () {
     queue.release();
   }
   queues.clear();
+  replicatedStage = nullptr;
+  numberOfQueueSlots = 0;
 
   queueArrayType = nullptr;
   stageArrayType = nullptr;
@@ -188,6 +192,8 @@ bool DSWP::apply (
   Noelle &par,
   Heuristics *h
 ) {
+  auto profiledLoop = LDI->getLoopStructure();
+  CompileTimeScope profile("dswp-code-generation", *profiledLoop->getFunction(), profiledLoop->getID());
 
   /*
    * Start.
@@ -246,6 +252,7 @@ bool DSWP::apply (
    */
   collectDataAndMemoryQueueInfo(LDI, par);
   collectControlQueueInfo(LDI, par);
+  mapQueuesToReplicas();
   // assert(areQueuesAcyclical());
   // writeStageQueuesAsDot(*LDI);
 
@@ -284,7 +291,7 @@ bool DSWP::apply (
    * Helper declarations
    */
   this->zeroIndexForBaseArray = cast<Value>(ConstantInt::get(par.int64, 0));
-  this->queueArrayType = ArrayType::get(PointerType::getUnqual(par.int8), this->queues.size());
+  this->queueArrayType = ArrayType::get(PointerType::getUnqual(par.int8), this->numberOfQueueSlots);
   this->stageArrayType = ArrayType::get(PointerType::getUnqual(par.int8), this->tasks.size());
 
   /*
@@ -354,6 +361,16 @@ bool DSWP::apply (
     IRBuilder<> entryBuilder(task->getEntry());
     entryBuilder.CreateBr(task->getCloneOfOriginalBasicBlock(loopHeader));
 
+    /*
+     * Replicas of a parallel stage execute only their own iterations.
+     * Stages connected to them need the index of the current iteration to pick the right queue.
+     */
+    if (task->numberOfReplicas > 1) {
+      rewireReplicaToExecuteItsIterations(LDI, i);
+    } else if (task->iterationIndex != nullptr) {
+      computeIterationIndex(LDI, par, i);
+    }
+
     /*
      * Add the return instruction at the end of the exit basic block.
      */
@@ -19,8 +19,13 @@ DSWPTask::DSWPTask (
   Module &M
   )
   : Task{ID, taskSignature, M},
+    queuesArray{nullptr},
     stageSCCs{},
-    clonableSCCs{}
+    clonableSCCs{},
+    replicaID{0},
+    numberOfReplicas{1},
+    replicas{},
+    iterationIndex{nullptr}
   {
 
   return ;
@@ -37,3 +42,149 @@ void DSWPTask::extractFuncArgs (void) {
 
   return ;
 }
+
+bool QueueInfo::canAddProducer (Instruction *p, bool isMemoryDependence) const {
+
+  /*
+   * Values are pushed together only if they are produced by the same basic block
+   */
+  if (p->getParent() != this->producer->getParent()){
+    return false;
+  }
+
+  /*
+   * Check that the packed element would fit in a queue
+   */
+  auto newProducers = this->producers;
+  auto newMemoryProducers = this->memoryProducers;
+  if (std::find(newProducers.begin(), newProducers.end(), p) == newProducers.end()){
+    newProducers.push_back(p);
+    if (isMemoryDependence){
+      newMemoryProducers.insert(p);
+    }
+  } else if (!isMemoryDependence){
+    newMemoryProducers.erase(p);
+  }
+  Type *newType = nullptr;
+  int newBitLength = 0;
+  bool newIsMemoryDependence, newIsPacked;
+  computeTypeOfElements(newProducers, newMemoryProducers, newType, newBitLength, newIsMemoryDependence, newIsPacked);
+
+  return newBitLength <= QueueInfo::maximumBitLength;
+}
+
+void QueueInfo::addProducer (Instruction *p, bool isMemoryDependence) {
+  assert(this->canAddProducer(p, isMemoryDependence));
+
+  if (std::find(this->producers.begin(), this->producers.end(), p) == this->producers.end()){
+    this->producers.push_back(p);
+    if (isMemoryDependence){
+      this->memoryProducers.insert(p);
+    }
+  } else if (!isMemoryDependence){
+    this->memoryProducers.erase(p);
+  }
+  computeTypeOfElements(this->producers, this->memoryProducers, this->dependentType, this->bitLength, this->isMemoryDependence, this->isPacked);
+
+  return ;
+}
+
+std::vector<Instruction *> QueueInfo::getProducersOfValues (void) const {
+  std::vector<Instruction *> producersOfValues;
+  for (auto p : this->producers){
+    if (this->memoryProducers.find(p) != this->memoryProducers.end()){
+      continue ;
+    }
+    producersOfValues.push_back(p);
+  }
+
+  return producersOfValues;
+}
+
+Instruction * QueueInfo::getLastProducer (void) const {
+  Instruction *lastProducer = nullptr;
+  for (auto &I : *this->producer->getParent()){
+    if (std::find(this->producers.begin(), this->producers.end(), &I) == this->producers.end()){
+      continue ;
+    }
+    lastProducer = &I;
+  }
+  assert(lastProducer != nullptr);
+
+  return lastProducer;
+}
+
+void QueueInfo::computeTypeOfElements (
+  const std::vector<Instruction *> &producers,
+  const std::set<Instruction *> &memoryProducers,
+  Type *&dependentType,
+  int &bitLength,
+  bool &isMemoryDependence,
+  bool &isPacked
+) {
+  auto anyProducer = producers.front();
+  auto &cxt = anyProducer->getContext();
+  DataLayout DL(anyProducer->getModule());
+
+  /*
+   * Fetch the values to send.
+   * Producers of memory dependences do not need a field: the push itself orders them.
+   */
+  std::vector<Type *> fieldTypes;
+  for (auto p : producers){
+    if (memoryProducers.find(p) != memoryProducers.end()){
+      continue ;
+    }
+    fieldTypes.push_back(p->getType());
+  }
+
+  /*
+   * Only tokens need to be sent
+   */
+  isMemoryDependence = false;
+  isPacked = false;
+  if (fieldTypes.size() == 0){
+    dependentType = IntegerType::get(cxt, 1);
+    bitLength = 1;
+    isMemoryDependence = true;
+    return ;
+  }
+
+  /*
+   * A single value that fits in one of the scalar queues
+   */
+  if (fieldTypes.size() == 1){
+    dependentType = fieldTypes[0];
+    if (dependentType->isPointerTy()) {
+      bitLength = DL.getTypeAllocSize(dependentType) * 8;
+      return ;
+    }
+    auto primitiveBitLength = dependentType->getPrimitiveSizeInBits();
+    if (  true
+          && (primitiveBitLength > 0)
+          && (primitiveBitLength <= 64)
+      ){
+      // NOTE(angelo): Round up to the nearest power of 2
+      bitLength = pow(2, ceil(log2(primitiveBitLength)));
+      return ;
+    }
+  }
+
+  /*
+   * Pack the values into a struct.
+   * The struct is padded to the size of the element of the queue used.
+   */
+  isPacked = true;
+  auto fieldsType = StructType::get(cxt, fieldTypes);
+  int fieldsBitLength = DL.getTypeAllocSize(fieldsType) * 8;
+  bitLength = 128;
+  while (bitLength < fieldsBitLength){
+    bitLength *= 2;
+  }
+  if (fieldsBitLength < bitLength){
+    fieldTypes.push_back(ArrayType::get(IntegerType::get(cxt, 8), (bitLength - fieldsBitLength) / 8));
+  }
+  dependentType = StructType::get(cxt, fieldTypes);
+
+  return ;
+}
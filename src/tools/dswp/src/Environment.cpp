@@ -43,6 +43,13 @@ void DSWP::collectLiveInEnvInfo (LoopDependenceInfo *LDI) {
       auto task = this->sccToStage.at(consumerSCC);
       auto id = task->getID();
       envBuilder->getUser(id)->addLiveInIndex(envIndex);
+
+      /*
+       * Replicas of the stage need the live-in as well
+       */
+      for (auto replica : task->replicas) {
+        envBuilder->getUser(replica->getID())->addLiveInIndex(envIndex);
+      }
     }
   }
 }
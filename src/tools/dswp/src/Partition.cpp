@@ -33,11 +33,10 @@ void DSWP::partitionSCCDAG (LoopDependenceInfo *LDI, Heuristics *h) {
    * with their incoming values so that the value produced by that partitioned set is
    * at the same loop nesting level as the consumer of that LCSSA PHI
    *
-   * NOTE: For memory dependencies, synchronization needs to be in place; until then,
-   * merge all memory dependencies into single sets
+   * NOTE: Memory dependencies between sets are synchronized by token queues,
+   * so they do not need to be merged into single sets
    */
   // partitioner->mergeLCSSAPhisWithTheValuesTheyPropagate();
-  partitioner->mergeAlongMemoryEdges();
 
   /*
    * Check if we can cluster SCCs.
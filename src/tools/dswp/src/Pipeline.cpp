@@ -39,9 +39,16 @@ void DSWP::generateStagesFromPartitionedSCCs (LoopDependenceInfo *LDI) {
       this->sccToStage[scc] = task;
     }
   }
+  auto numberOfStages = techniqueTasks.size();
+
+  /*
+   * Replicate a stage without loop-carried dependences if there are cores left.
+   */
+  this->replicateParallelStage(LDI, techniqueTasks);
+
   this->addPredecessorAndSuccessorsBasicBlocksToTasks(LDI, techniqueTasks);
   this->numTaskInstances = techniqueTasks.size();
-  assert(this->numTaskInstances == this->partitioner->numberOfPartitions());
+  assert(numberOfStages == this->partitioner->numberOfPartitions());
 
   return ;
 }
@@ -147,7 +154,7 @@ void DSWP::createPipelineFromStages (LoopDependenceInfo *LDI, Noelle &par) {
   /*
    * Call the stage dispatcher with the environment, queues array, and stages array
    */
-  auto queuesCount = cast<Value>(ConstantInt::get(par.int64, this->queues.size()));
+  auto queuesCount = cast<Value>(ConstantInt::get(par.int64, this->numberOfQueueSlots));
   auto stagesCount = cast<Value>(ConstantInt::get(par.int64, this->numTaskInstances));
 
   /*
@@ -199,16 +206,22 @@ Value * DSWP::createQueueSizesArrayFromStages (
   IRBuilder<> funcBuilder,
   Noelle &par
 ) {
-  auto queuesAlloca = cast<Value>(funcBuilder.CreateAlloca(ArrayType::get(par.int64, this->queues.size())));
+  auto queuesAlloca = cast<Value>(funcBuilder.CreateAlloca(ArrayType::get(par.int64, this->numberOfQueueSlots)));
   for (int i = 0; i < this->queues.size(); ++i) {
     auto &queue = this->queues[i];
-    auto queueIndex = cast<Value>(ConstantInt::get(par.int64, i));
-    auto queuePtr = funcBuilder.CreateInBoundsGEP(queuesAlloca, ArrayRef<Value*>({
-      this->zeroIndexForBaseArray,
-      queueIndex
-    }));
-    auto queueCast = funcBuilder.CreateBitCast(queuePtr, PointerType::getUnqual(par.int64));
-    funcBuilder.CreateStore(ConstantInt::get(par.int64, queue->bitLength), queueCast);
+
+    /*
+     * A queue connected to a replicated stage is implemented by one physical queue per replica.
+     */
+    for (auto slot = queue->firstSlot; slot < queue->firstSlot + (int)queue->numberOfSlots; ++slot) {
+      auto queueIndex = cast<Value>(ConstantInt::get(par.int64, slot));
+      auto queuePtr = funcBuilder.CreateInBoundsGEP(queuesAlloca, ArrayRef<Value*>({
+        this->zeroIndexForBaseArray,
+        queueIndex
+      }));
+      auto queueCast = funcBuilder.CreateBitCast(queuePtr, PointerType::getUnqual(par.int64));
+      funcBuilder.CreateStore(ConstantInt::get(par.int64, queue->bitLength), queueCast);
+    }
   }
 
   return cast<Value>(funcBuilder.CreateBitCast(queuesAlloca, PointerType::getUnqual(par.int64)));
@@ -71,7 +71,9 @@ void DSWP::printStageQueues (LoopDependenceInfo *LDI) const {
   int count = 0;
   for (auto &queue : this->queues) {
     errs() << "DSWP:    Queue: " << count++ << "\n";
-    queue->producer->print(errs() << "DSWP:     Producer:\t"); errs() << "\n";
+    for (auto producer : queue->producers) {
+      producer->print(errs() << "DSWP:     Producer:\t"); errs() << "\n";
+    }
     for (auto consumer : queue->consumers) {
       consumer->print(errs() << "DSWP:     Consumer:\t"); errs() << "\n";
     }
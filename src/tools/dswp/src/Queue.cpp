@@ -24,31 +24,40 @@ void DSWP::registerQueue (
 ) {
 
   /*
-   * Find/create the push queue in the producer stage
+   * Find/create the push queue in the producer stage.
+   *
+   * Values produced by the same basic block and sent to the same stage share a queue,
+   * so they are sent with a single push.
+   * A queue that carries the produced value also orders the memory accesses of its producer.
    */
   int queueIndex = this->queues.size();
   QueueInfo *queueInfo = nullptr;
-  for (auto queueI : fromStage->producerToQueues[producer]) {
-    if (this->queues[queueI]->toStage != toStage->getID()) continue;
+  for (auto queueI = 0; queueI < this->queues.size(); ++queueI) {
+    auto existingQueue = this->queues[queueI].get();
+    if (existingQueue->fromStage != fromStage->getID()) continue;
+    if (existingQueue->toStage != toStage->getID()) continue;
+    if (!existingQueue->canAddProducer(producer, isMemoryDependence)) continue;
     queueIndex = queueI;
-    queueInfo = this->queues[queueIndex].get();
+    queueInfo = existingQueue;
+    queueInfo->addProducer(producer, isMemoryDependence);
+    fromStage->producerToQueues[producer].insert(queueIndex);
     break;
   }
   if (queueIndex == this->queues.size()) {
     this->queues.push_back(std::move(std::make_unique<QueueInfo>(producer, consumer, producer->getType(), isMemoryDependence)));
     fromStage->producerToQueues[producer].insert(queueIndex);
     queueInfo = this->queues[queueIndex].get();
+  }
 
-    /*
-     * Confirm a new queue is of a size handled by the parallelizer
-     */
-    auto& queueTypes = par.queues.queueSizeToIndex;
-    bool byteSize = queueTypes.find(queueInfo->bitLength) != queueTypes.end();
-    if (!byteSize) {
-      errs() << "NOT SUPPORTED BYTE SIZE (" << queueInfo->bitLength << "): "; producer->getType()->print(errs()); errs() <<  "\n";
-      producer->print(errs() << "Producer: "); errs() << "\n";
-      abort();
-    }
+  /*
+   * Confirm the queue is of a size handled by the parallelizer
+   */
+  auto& queueTypes = par.queues.queueSizeToIndex;
+  bool byteSize = queueTypes.find(queueInfo->bitLength) != queueTypes.end();
+  if (!byteSize) {
+    errs() << "NOT SUPPORTED BYTE SIZE (" << queueInfo->bitLength << "): "; producer->getType()->print(errs()); errs() <<  "\n";
+    producer->print(errs() << "Producer: "); errs() << "\n";
+    abort();
   }
 
   /*
@@ -149,6 +158,7 @@ void DSWP::collectControlQueueInfo (LoopDependenceInfo *LDI, Noelle &par) {
     for (auto techniqueTask : tasksControlledByCondition) {
       auto taskControlledByCondition = (DSWPTask *)techniqueTask;
       if (taskOfCondition == taskControlledByCondition) continue;
+      if (taskControlledByCondition->replicaID > 0) continue;
 
       for (auto condition : conditionsOfConditionalBranch) {
         registerQueue(par, LDI, taskOfCondition, taskControlledByCondition, condition, conditionalBranch, false);
@@ -210,6 +220,12 @@ void DSWP::collectDataAndMemoryQueueInfo (LoopDependenceInfo *LDI, Noelle &par)
   auto &allLoops = LDI->getLoopHierarchyStructures();
   for (auto techniqueTask : this->tasks) {
     auto toStage = (DSWPTask *)techniqueTask;
+
+    /*
+     * Replicas share the queues of the stage they replicate
+     */
+    if (toStage->replicaID > 0) continue;
+
     std::set<SCC *> allSCCs(toStage->clonableSCCs.begin(), toStage->clonableSCCs.end());
     allSCCs.insert(toStage->stageSCCs.begin(), toStage->stageSCCs.end());
 
@@ -234,10 +250,10 @@ void DSWP::collectDataAndMemoryQueueInfo (LoopDependenceInfo *LDI, Noelle &par)
           auto consumer = cast<Instruction>(instructionEdge->getIncomingT());
 
           /*
-           * TODO: Handle memory dependencies and enable synchronization queues
+           * Memory dependencies are enforced by queues of tokens:
+           * the consumer stage waits for the producer to execute before continuing.
            */
           auto isMemoryDependence = instructionEdge->isMemoryDependence();
-          assert(!isMemoryDependence && "FIXME: Support memory synchronization with queues");
 
           registerQueue(par, LDI, fromStage, toStage, producer, consumer, isMemoryDependence);
         }
@@ -288,29 +304,47 @@ void DSWP::generateLoadsOfQueuePointers (
     task->queueArg,
     PointerType::getUnqual(this->queueArrayType)
   );
+  task->queuesArray = queuesArray;
 
   /*
    * Load this stage's relevant queues
    */
   auto loadQueuePtrFromIndex = [&](int queueIndex) -> void {
     auto queueInfo = this->queues[queueIndex].get();
-    auto queueIndexValue = cast<Value>(ConstantInt::get(par.int64, queueIndex));
-    auto queuePtr = entryBuilder.CreateInBoundsGEP(queuesArray, ArrayRef<Value*>({
-      this->zeroIndexForBaseArray,
-      queueIndexValue
-    }));
     auto parQueueIndex = par.queues.queueSizeToIndex[queueInfo->bitLength];
-    auto queueType = par.queues.queueTypes[parQueueIndex];
     auto queueElemType = par.queues.queueElementTypes[parQueueIndex];
-    auto queueCast = entryBuilder.CreateBitCast(queuePtr, PointerType::getUnqual(queueType));
 
     auto queueInstrs = std::make_unique<QueueInstrs>();
-    queueInstrs->queuePtr = entryBuilder.CreateLoad(queueCast);
+    queueInstrs->queuePtr = nullptr;
     queueInstrs->alloca = entryBuilder.CreateAlloca(queueInfo->dependentType);
     queueInstrs->allocaCast = entryBuilder.CreateBitCast(
       queueInstrs->alloca,
       PointerType::getUnqual(queueElemType)
     );
+
+    /*
+     * A queue connected to a replicated stage is picked at every iteration by the other stage.
+     * Each replica always uses its own.
+     */
+    if (  true
+          && (queueInfo->numberOfSlots > 1)
+          && (task->numberOfReplicas == 1)
+      ){
+      task->queueInstrMap[queueIndex] = std::move(queueInstrs);
+      return ;
+    }
+    auto slot = queueInfo->firstSlot;
+    if (queueInfo->numberOfSlots > 1) {
+      slot += task->replicaID;
+    }
+    auto queueIndexValue = cast<Value>(ConstantInt::get(par.int64, slot));
+    auto queuePtr = entryBuilder.CreateInBoundsGEP(queuesArray, ArrayRef<Value*>({
+      this->zeroIndexForBaseArray,
+      queueIndexValue
+    }));
+    auto queueType = par.queues.queueTypes[parQueueIndex];
+    auto queueCast = entryBuilder.CreateBitCast(queuePtr, PointerType::getUnqual(queueType));
+    queueInstrs->queuePtr = entryBuilder.CreateLoad(queueCast);
     task->queueInstrMap[queueIndex] = std::move(queueInstrs);
   };
 
@@ -318,32 +352,102 @@ void DSWP::generateLoadsOfQueuePointers (
   for (auto queueIndex : task->popValueQueues) loadQueuePtrFromIndex(queueIndex);
 }
 
+Value * DSWP::fetchQueuePointer (
+  LoopDependenceInfo *LDI,
+  Noelle &par,
+  DSWPTask *task,
+  int queueIndex,
+  IRBuilder<> &builder
+) {
+  auto queueInstrs = task->queueInstrMap[queueIndex].get();
+  if (queueInstrs->queuePtr != nullptr) {
+    return queueInstrs->queuePtr;
+  }
+
+  /*
+   * The queue is connected to a replicated stage.
+   * The values of the iteration i are exchanged with the replica i % numberOfReplicas.
+   */
+  if (task->iterationIndex == nullptr) {
+    auto loopHeader = LDI->getLoopStructure()->getHeader();
+    auto headerClone = task->getCloneOfOriginalBasicBlock(loopHeader);
+    IRBuilder<> headerBuilder(&*headerClone->begin());
+    task->iterationIndex = headerBuilder.CreatePHI(par.int64, 2);
+  }
+  auto queueInfo = this->queues[queueIndex].get();
+  auto replicaIndex = builder.CreateURem(
+    task->iterationIndex,
+    ConstantInt::get(par.int64, queueInfo->numberOfSlots)
+  );
+  auto slot = builder.CreateAdd(replicaIndex, ConstantInt::get(par.int64, queueInfo->firstSlot));
+  auto queuePtr = builder.CreateInBoundsGEP(task->queuesArray, ArrayRef<Value*>({
+    this->zeroIndexForBaseArray,
+    slot
+  }));
+  auto parQueueIndex = par.queues.queueSizeToIndex[queueInfo->bitLength];
+  auto queueType = par.queues.queueTypes[parQueueIndex];
+  auto queueCast = builder.CreateBitCast(queuePtr, PointerType::getUnqual(queueType));
+
+  return builder.CreateLoad(queueCast);
+}
+
 void DSWP::popValueQueues (LoopDependenceInfo *LDI, Noelle &par, int taskIndex) {
   auto task = (DSWPTask *)this->tasks[taskIndex];
   auto &allLoops = LDI->getLoopHierarchyStructures();
+  auto loopHeader = LDI->getLoopStructure()->getHeader();
 
   for (auto queueIndex : task->popValueQueues) {
     auto &queueInfo = this->queues[queueIndex];
     auto queueInstrs = task->queueInstrMap[queueIndex].get();
-    auto queueCallArgs = ArrayRef<Value*>({ queueInstrs->queuePtr, queueInstrs->allocaCast });
 
     /*
      * Determine the clone of the basic block of the original producer
      * Insert load right there
+     *
+     * Replicas do not execute the header of the iterations of the other replicas.
+     * Hence, they pop values produced in the header at the beginning of the body.
      */
     auto originalB = queueInfo->producer->getParent();
+    if (  true
+          && (task->numberOfReplicas > 1)
+          && (originalB == loopHeader)
+      ){
+      auto loopGoverningIVAttr = LDI->getLoopGoverningIVAttribution();
+      auto headerBr = loopGoverningIVAttr->getHeaderBrInst();
+      auto headerExit = loopGoverningIVAttr->getExitBlockFromHeader();
+      originalB = headerBr->getSuccessor(0) == headerExit ? headerBr->getSuccessor(1) : headerBr->getSuccessor(0);
+    }
     assert(task->isAnOriginalBasicBlock(originalB));
     auto clonedB = task->getCloneOfOriginalBasicBlock(originalB);
     Instruction *insertionPoint = clonedB->getFirstNonPHIOrDbgOrLifetime();
     IRBuilder<> builder(insertionPoint);
+    auto queuePtr = this->fetchQueuePointer(LDI, par, task, queueIndex, builder);
     auto queuePopFunction = par.queues.queuePops[par.queues.queueSizeToIndex[queueInfo->bitLength]];
-    queueInstrs->queueCall = builder.CreateCall(queuePopFunction, queueCallArgs);
-    queueInstrs->load = builder.CreateLoad(queueInstrs->alloca);
+    queueInstrs->queueCall = builder.CreateCall(queuePopFunction, ArrayRef<Value*>({ queuePtr, queueInstrs->allocaCast }));
 
     /*
-     * Map from producer to queue load 
+     * Tokens carry no value: popping them is enough to order the memory accesses
      */
-    task->addInstruction(queueInfo->producer, cast<Instruction>(queueInstrs->load));
+    if (queueInfo->isMemoryDependence) {
+      queueInstrs->load = nullptr;
+      continue ;
+    }
+
+    /*
+     * Map from producers to queue loads
+     */
+    auto producersOfValues = queueInfo->getProducersOfValues();
+    if (!queueInfo->isPacked) {
+      assert(producersOfValues.size() == 1);
+      queueInstrs->load = builder.CreateLoad(queueInstrs->alloca);
+      task->addInstruction(producersOfValues[0], cast<Instruction>(queueInstrs->load));
+      continue ;
+    }
+    for (auto field = 0; field < producersOfValues.size(); ++field) {
+      auto fieldPtr = builder.CreateStructGEP(queueInstrs->alloca, field);
+      queueInstrs->load = builder.CreateLoad(fieldPtr);
+      task->addInstruction(producersOfValues[field], cast<Instruction>(queueInstrs->load));
+    }
   }
 }
 
@@ -354,23 +458,34 @@ void DSWP::pushValueQueues (LoopDependenceInfo *LDI, Noelle &par, int taskIndex)
   for (auto queueIndex : task->pushValueQueues) {
     auto queueInstrs = task->queueInstrMap[queueIndex].get();
     auto queueInfo = this->queues[queueIndex].get();
-    auto queueCallArgs = ArrayRef<Value*>({ queueInstrs->queuePtr, queueInstrs->allocaCast });
     auto queuePushFunction = par.queues.queuePushes[par.queues.queueSizeToIndex[queueInfo->bitLength]];
 
     /*
-     * Store the produced value immediately
-     * Push the value immediately
+     * Store the produced values and push them as soon as the last one has been produced
      */
-    auto producerBlock = queueInfo->producer->getParent();
-    auto producerClone = task->getCloneOfOriginalInstruction(queueInfo->producer);
-    auto producerCloneBlock = producerClone->getParent();
-    auto insertPoint = producerClone->getNextNode();
+    auto lastProducerClone = task->getCloneOfOriginalInstruction(queueInfo->getLastProducer());
+    auto producerCloneBlock = lastProducerClone->getParent();
+    auto insertPoint = lastProducerClone->getNextNode();
     if (isa<PHINode>(insertPoint)) {
       insertPoint = producerCloneBlock->getFirstNonPHIOrDbgOrLifetime();
     }
     IRBuilder<> builder(insertPoint);
-    builder.CreateStore(producerClone, queueInstrs->alloca);
-    queueInstrs->queueCall = builder.CreateCall(queuePushFunction, queueCallArgs);
+    auto producersOfValues = queueInfo->getProducersOfValues();
+    if (queueInfo->isMemoryDependence) {
+      builder.CreateStore(ConstantInt::getTrue(lastProducerClone->getContext()), queueInstrs->alloca);
+    } else if (!queueInfo->isPacked) {
+      assert(producersOfValues.size() == 1);
+      auto producerClone = task->getCloneOfOriginalInstruction(producersOfValues[0]);
+      builder.CreateStore(producerClone, queueInstrs->alloca);
+    } else {
+      for (auto field = 0; field < producersOfValues.size(); ++field) {
+        auto producerClone = task->getCloneOfOriginalInstruction(producersOfValues[field]);
+        auto fieldPtr = builder.CreateStructGEP(queueInstrs->alloca, field);
+        builder.CreateStore(producerClone, fieldPtr);
+      }
+    }
+    auto queuePtr = this->fetchQueuePointer(LDI, par, task, queueIndex, builder);
+    queueInstrs->queueCall = builder.CreateCall(queuePushFunction, ArrayRef<Value*>({ queuePtr, queueInstrs->allocaCast }));
 
   }
 }
@@ -0,0 +1,263 @@
+/*
+ * Copyright 2016 - 2020  Angelo Matni, Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "DSWP.hpp"
+
+using namespace llvm;
+using namespace llvm::noelle;
+
+void DSWP::replicateParallelStage (LoopDependenceInfo *LDI, std::vector<Task *> &techniqueTasks) {
+  this->replicatedStage = nullptr;
+
+  /*
+   * Check if there are cores left after assigning one to each stage.
+   */
+  uint32_t numberOfStages = techniqueTasks.size();
+  auto maximumNumberOfCores = LDI->getMaximumNumberOfCores();
+  if (maximumNumberOfCores <= numberOfStages){
+    return ;
+  }
+  auto numberOfReplicas = maximumNumberOfCores - numberOfStages + 1;
+
+  /*
+   * Pick the heaviest stage that can be replicated.
+   */
+  DSWPTask *heaviestStage = nullptr;
+  uint64_t heaviestStageInsts = 0;
+  for (auto techniqueTask : techniqueTasks) {
+    auto stage = (DSWPTask *)techniqueTask;
+    if (!this->canStageBeReplicated(LDI, stage)){
+      continue ;
+    }
+
+    uint64_t stageInsts = 0;
+    for (auto scc : stage->stageSCCs) {
+      stageInsts += this->profile.getTotalInstructions(scc);
+    }
+    if (  false
+          || (heaviestStage == nullptr)
+          || (stageInsts > heaviestStageInsts)
+      ){
+      heaviestStage = stage;
+      heaviestStageInsts = stageInsts;
+    }
+  }
+  if (heaviestStage == nullptr){
+    return ;
+  }
+
+  /*
+   * Create the replicas.
+   * They are appended after the stages so the IDs of the latter do not change.
+   */
+  heaviestStage->numberOfReplicas = numberOfReplicas;
+  for (uint32_t replicaID = 1; replicaID < numberOfReplicas; replicaID++) {
+    auto replica = new DSWPTask(techniqueTasks.size(), this->taskSignature, this->module);
+    replica->stageSCCs = heaviestStage->stageSCCs;
+    replica->replicaID = replicaID;
+    replica->numberOfReplicas = numberOfReplicas;
+    heaviestStage->replicas.push_back(replica);
+    techniqueTasks.push_back(replica);
+  }
+  this->replicatedStage = heaviestStage;
+
+  if (this->verbose != Verbosity::Disabled) {
+    errs() << "DSWP:  Stage " << heaviestStage->getID() << " has no loop-carried dependences and it will run on " << numberOfReplicas << " cores\n";
+  }
+
+  return ;
+}
+
+bool DSWP::canStageBeReplicated (LoopDependenceInfo *LDI, DSWPTask *stage) const {
+
+  /*
+   * Replicas execute interleaved iterations by stepping the induction variables of the loop.
+   * Hence, the loop must be governed by an induction variable and all of them must have a constant integer step.
+   */
+  auto loopStructure = LDI->getLoopStructure();
+  auto loopHeader = loopStructure->getHeader();
+  if (loopStructure->numberOfExitBasicBlocks() != 1){
+    return false;
+  }
+  auto loopGoverningIVAttr = LDI->getLoopGoverningIVAttribution();
+  if (loopGoverningIVAttr == nullptr){
+    return false;
+  }
+  auto ivManager = LDI->getInductionVariableManager();
+  for (auto ivInfo : ivManager->getInductionVariables(*loopStructure)) {
+    auto stepValue = ivInfo->getSingleComputedStepValue();
+    if (  false
+          || (stepValue == nullptr)
+          || (!isa<ConstantInt>(stepValue))
+          || (!ivInfo->getLoopEntryPHI()->getType()->isIntegerTy())
+      ){
+      return false;
+    }
+  }
+
+  /*
+   * Values produced by the header are popped by the replicas at the beginning of the body.
+   * Hence, the body must start with a basic block that executes once per iteration.
+   */
+  auto headerBr = loopGoverningIVAttr->getHeaderBrInst();
+  auto headerExit = loopGoverningIVAttr->getExitBlockFromHeader();
+  if (headerBr->getNumSuccessors() != 2){
+    return false;
+  }
+  auto bodyEntry = headerBr->getSuccessor(0) == headerExit ? headerBr->getSuccessor(1) : headerBr->getSuccessor(0);
+  if (bodyEntry->getSinglePredecessor() != loopHeader){
+    return false;
+  }
+
+  /*
+   * The stage must not have loop-carried dependences and it must not execute in the header.
+   */
+  auto sccManager = LDI->getSCCManager();
+  auto sccdag = sccManager->getSCCDAG();
+  for (auto scc : stage->stageSCCs) {
+    if (!sccManager->getSCCAttrs(scc)->canExecuteIndependently()){
+      return false;
+    }
+    for (auto nodePair : scc->internalNodePairs()) {
+      auto inst = cast<Instruction>(nodePair.first);
+      if (inst->getParent() == loopHeader){
+        return false;
+      }
+    }
+  }
+
+  /*
+   * Live-out values must be produced by a single task that executes all iterations.
+   */
+  for (auto envIndex : LDI->environment->getEnvIndicesOfLiveOutVars()) {
+    auto producer = LDI->environment->producerAt(envIndex);
+    auto producerSCC = sccdag->sccOfValue(producer);
+    if (  false
+          || sccManager->getSCCAttrs(producerSCC)->canBeCloned()
+          || (stage->stageSCCs.find(producerSCC) != stage->stageSCCs.end())
+      ){
+      return false;
+    }
+  }
+
+  return true;
+}
+
+void DSWP::mapQueuesToReplicas (void) {
+
+  /*
+   * Assign the physical queues.
+   * A queue connected to the replicated stage needs one physical queue per replica.
+   */
+  this->numberOfQueueSlots = 0;
+  for (auto &queueInfo : this->queues) {
+    queueInfo->firstSlot = this->numberOfQueueSlots;
+    if (  true
+          && (this->replicatedStage != nullptr)
+          && (  false
+                || (queueInfo->fromStage == this->replicatedStage->getID())
+                || (queueInfo->toStage == this->replicatedStage->getID())
+             )
+      ){
+      queueInfo->numberOfSlots = this->replicatedStage->numberOfReplicas;
+    }
+    this->numberOfQueueSlots += queueInfo->numberOfSlots;
+  }
+  if (this->replicatedStage == nullptr){
+    return ;
+  }
+
+  /*
+   * Replicas use the same queues of the stage they replicate.
+   */
+  for (auto replica : this->replicatedStage->replicas) {
+    replica->producerToQueues = this->replicatedStage->producerToQueues;
+    replica->producedPopQueue = this->replicatedStage->producedPopQueue;
+    replica->pushValueQueues = this->replicatedStage->pushValueQueues;
+    replica->popValueQueues = this->replicatedStage->popValueQueues;
+  }
+
+  return ;
+}
+
+void DSWP::rewireReplicaToExecuteItsIterations (LoopDependenceInfo *LDI, int taskIndex) {
+  auto task = (DSWPTask *)this->tasks[taskIndex];
+  assert(task->numberOfReplicas > 1);
+
+  /*
+   * Fetch the loop.
+   */
+  auto loopStructure = LDI->getLoopStructure();
+  auto preheaderClone = task->getCloneOfOriginalBasicBlock(loopStructure->getPreHeader());
+
+  /*
+   * Replica r starts from the iteration r and it jumps numberOfReplicas iterations at a time:
+   * start: original_start + original_step * r
+   * step: original_step * numberOfReplicas
+   */
+  auto ivManager = LDI->getInductionVariableManager();
+  for (auto ivInfo : ivManager->getInductionVariables(*loopStructure)) {
+    auto originalIVPHI = ivInfo->getLoopEntryPHI();
+    if (!task->isAnOriginalInstruction(originalIVPHI)){
+      continue ;
+    }
+    auto ivPHI = cast<PHINode>(task->getCloneOfOriginalInstruction(originalIVPHI));
+    auto ivType = ivPHI->getType();
+    auto stepOfIV = cast<ConstantInt>(ivInfo->getSingleComputedStepValue())->getSExtValue();
+
+    auto startOfIV = ivPHI->getIncomingValueForBlock(preheaderClone);
+    auto replicaOffset = ConstantInt::getSigned(ivType, stepOfIV * task->replicaID);
+    auto offsetStartValue = IVUtility::offsetIVPHI(preheaderClone, ivPHI, startOfIV, replicaOffset);
+    ivPHI->setIncomingValueForBlock(preheaderClone, offsetStartValue);
+
+    auto jumpStepSize = ConstantInt::getSigned(ivType, stepOfIV * (task->numberOfReplicas - 1));
+    IVUtility::stepInductionVariablePHI(preheaderClone, ivPHI, jumpStepSize);
+  }
+
+  /*
+   * Make sure the loop exits even if the exit value is jumped over.
+   */
+  auto loopGoverningIVAttr = LDI->getLoopGoverningIVAttribution();
+  assert(loopGoverningIVAttr != nullptr);
+  auto &loopGoverningIV = loopGoverningIVAttr->getInductionVariable();
+  LoopGoverningIVUtility ivUtility(loopGoverningIV, *loopGoverningIVAttr);
+  assert(task->isAnOriginalInstruction(loopGoverningIVAttr->getHeaderCmpInst()));
+  auto cmpInst = cast<CmpInst>(task->getCloneOfOriginalInstruction(loopGoverningIVAttr->getHeaderCmpInst()));
+  auto brInst = cast<BranchInst>(task->getCloneOfOriginalInstruction(loopGoverningIVAttr->getHeaderBrInst()));
+  auto cloneHeaderExit = task->getCloneOfOriginalBasicBlock(loopGoverningIVAttr->getExitBlockFromHeader());
+  ivUtility.updateConditionAndBranchToCatchIteratingPastExitValue(cmpInst, brInst, cloneHeaderExit);
+
+  return ;
+}
+
+void DSWP::computeIterationIndex (LoopDependenceInfo *LDI, Noelle &par, int taskIndex) {
+  auto task = (DSWPTask *)this->tasks[taskIndex];
+  auto iterationIndex = task->iterationIndex;
+  assert(iterationIndex != nullptr);
+
+  /*
+   * The index starts from 0 and it is incremented at every back edge.
+   */
+  auto headerClone = iterationIndex->getParent();
+  std::unordered_map<BasicBlock *, Value *> incomingValues;
+  for (auto predecessor : predecessors(headerClone)) {
+    if (incomingValues.find(predecessor) == incomingValues.end()) {
+      if (predecessor == task->getEntry()) {
+        incomingValues[predecessor] = ConstantInt::get(par.int64, 0);
+      } else {
+        IRBuilder<> latchBuilder(predecessor->getTerminator());
+        incomingValues[predecessor] = latchBuilder.CreateAdd(iterationIndex, ConstantInt::get(par.int64, 1));
+      }
+    }
+    iterationIndex->addIncoming(incomingValues[predecessor], predecessor);
+  }
+
+  return ;
+}
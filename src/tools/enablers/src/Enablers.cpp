@@ -9,6 +9,7 @@
  * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
  */
 #include "EnablersManager.hpp"
+#include "Architecture.hpp"
 
 using namespace llvm;
 using namespace llvm::noelle;
@@ -17,10 +18,13 @@ bool EnablersManager::applyEnablers (
     LoopDependenceInfo *LDI,
     Noelle &par,
     LoopDistribution &loopDist,
+    LoopFusion &loopFusion,
     LoopUnroll &loopUnroll,
     LoopWhilifier &loopWhilifier,
     LoopInvariantCodeMotion &loopInvariantCodeMotion,
-    SCEVSimplification &scevSimplification
+    SCEVSimplification &scevSimplification,
+    LoopTiling &loopTiling,
+    LoopCollapse &loopCollapse
     ){
 
   /*
@@ -34,6 +38,17 @@ bool EnablersManager::applyEnablers (
     }
   }
 
+  /*
+  * Fuse the loop with the one that follows it.
+  */
+  if (par.isTransformationEnabled(Transformation::LOOP_FUSION_ID)){
+    errs() << "EnablersManager:   Try to fuse loops\n";
+    if (this->applyLoopFusion(LDI, par, loopFusion)){
+      errs() << "EnablersManager:     Fused loops\n";
+      return true;
+    }
+  }
+
   /*
   * Try to devirtualize functions.
   */
@@ -86,6 +101,28 @@ bool EnablersManager::applyEnablers (
     }
   }
 
+  /*
+  * Tile loop nests to improve the locality of their memory accesses.
+  */
+  if (par.isTransformationEnabled(Transformation::LOOP_TILING_ID)){
+    errs() << "EnablersManager:   Try to tile loop nests\n";
+    if (this->applyLoopTiling(LDI, par, loopTiling)){
+      errs() << "EnablersManager:     The loop nest has been tiled\n";
+      return true;
+    }
+  }
+
+  /*
+  * Collapse loop nests whose outermost loop does not have enough iterations for all cores.
+  */
+  if (par.isTransformationEnabled(Transformation::LOOP_COLLAPSE_ID)){
+    errs() << "EnablersManager:   Try to collapse loop nests\n";
+    if (this->applyLoopCollapse(LDI, par, loopCollapse)){
+      errs() << "EnablersManager:     The loop nest has been collapsed\n";
+      return true;
+    }
+  }
+
   return false;
 }
 
@@ -174,6 +211,62 @@ bool EnablersManager::applyLoopDistribution (
   return false;
 }
 
+bool EnablersManager::applyLoopFusion (
+    LoopDependenceInfo *LDI,
+    Noelle &par,
+    LoopFusion &loopFusion
+    ){
+
+  /*
+  * Fetch the loop that starts right after the current one exits.
+  */
+  auto ls = LDI->getLoopStructure();
+  auto exitBlocks = ls->getLoopExitBasicBlocks();
+  if (exitBlocks.size() != 1){
+    return false;
+  }
+  auto loopFunction = ls->getFunction();
+  auto functionLoops = par.getLoopStructures(loopFunction);
+  LoopStructure *nextLoop = nullptr;
+  for (auto otherLoop : *functionLoops){
+    if (otherLoop->getPreHeader() == exitBlocks[0]){
+      nextLoop = otherLoop;
+      break ;
+    }
+  }
+  if (nextLoop == nullptr){
+    delete functionLoops;
+    return false;
+  }
+
+  /*
+  * Fusing loops only pays off if the fused loop can be parallelized as the original ones.
+  */
+  auto nextLDI = par.getLoop(nextLoop);
+  auto modified = false;
+  if (  true
+        && this->canIterationsRunInParallel(LDI)
+        && this->canIterationsRunInParallel(nextLDI)
+     ){
+
+    /*
+    * Fuse the loops.
+    */
+    auto functionDG = par.getFunctionDependenceGraph(loopFunction);
+    auto& LI = getAnalysis<LoopInfoWrapperPass>(*loopFunction).getLoopInfo();
+    auto& SE = getAnalysis<ScalarEvolutionWrapperPass>(*loopFunction).getSE();
+    modified = loopFusion.fuseLoops(*LDI, *nextLDI, functionDG, LI, SE);
+  }
+
+  /*
+  * Free the memory.
+  */
+  delete nextLDI;
+  delete functionLoops;
+
+  return modified;
+}
+
 bool EnablersManager::applyDevirtualizer (
     LoopDependenceInfo *LDI,
     Noelle &par,
@@ -287,3 +380,125 @@ bool EnablersManager::applyDevirtualizer (
 
   return modified;
 }
+
+bool EnablersManager::applyLoopTiling (
+    LoopDependenceInfo *LDI,
+    Noelle &par,
+    LoopTiling &loopTiling
+    ){
+
+  /*
+  * Tiling changes the order of the iterations of a loop nest.
+  * Hence, both the outer loop and its only sub-loop must have independent iterations.
+  */
+  auto ls = LDI->getLoopStructure();
+  auto subLoops = ls->getChildren();
+  if (  false
+        || (subLoops.size() != 1)
+        || ((*subLoops.begin())->getChildren().size() > 0)
+     ){
+    return false;
+  }
+  if (!this->canIterationsRunInParallel(LDI)){
+    return false;
+  }
+  auto innerLDI = par.getLoop(*subLoops.begin());
+  auto isInnerLoopParallel = this->canIterationsRunInParallel(innerLDI);
+  delete innerLDI;
+  if (!isInnerLoopParallel){
+    return false;
+  }
+
+  /*
+  * Tile the loop nest for the L2 cache.
+  */
+  auto &loopFunction = *ls->getFunction();
+  auto& LI = getAnalysis<LoopInfoWrapperPass>(loopFunction).getLoopInfo();
+  auto& SE = getAnalysis<ScalarEvolutionWrapperPass>(loopFunction).getSE();
+  auto modified = loopTiling.tileLoopNest(*LDI, LI, SE, Architecture::getL2CacheBytes(), Architecture::getCacheLineBytes());
+
+  return modified;
+}
+
+bool EnablersManager::applyLoopCollapse (
+    LoopDependenceInfo *LDI,
+    Noelle &par,
+    LoopCollapse &loopCollapse
+    ){
+
+  /*
+  * Collapsing a loop nest only pays off if the iterations of the collapsed loop can then run in parallel.
+  * This is the case when both the outer loop and its only sub-loop have independent iterations.
+  */
+  auto ls = LDI->getLoopStructure();
+  auto subLoops = ls->getChildren();
+  if (subLoops.size() != 1){
+    return false;
+  }
+  if (!this->canIterationsRunInParallel(LDI)){
+    return false;
+  }
+  auto innerLDI = par.getLoop(*subLoops.begin());
+  auto isInnerLoopParallel = this->canIterationsRunInParallel(innerLDI);
+  delete innerLDI;
+  if (!isInnerLoopParallel){
+    return false;
+  }
+
+  /*
+  * Collapse the loop nest.
+  */
+  auto &loopFunction = *ls->getFunction();
+  auto& LI = getAnalysis<LoopInfoWrapperPass>(loopFunction).getLoopInfo();
+  auto& SE = getAnalysis<ScalarEvolutionWrapperPass>(loopFunction).getSE();
+  auto modified = loopCollapse.collapseLoopNest(*LDI, LI, SE, par.getMaximumNumberOfCores());
+
+  return modified;
+}
+
+bool EnablersManager::canIterationsRunInParallel (
+    LoopDependenceInfo *LDI
+    ) const {
+
+  /*
+  * Check every SCC that has loop-carried data dependences.
+  */
+  auto sccManager = LDI->getSCCManager();
+  auto domainSpaceAnalysis = LDI->getLoopIterationDomainSpaceAnalysis();
+  for (auto scc : sccManager->getSCCsWithLoopCarriedDataDependencies()){
+
+    /*
+    * SCCs that can be cloned (e.g., induction variables) do not serialize iterations.
+    */
+    auto sccInfo = sccManager->getSCCAttrs(scc);
+    if (sccInfo->canBeCloned()){
+      continue ;
+    }
+
+    /*
+    * Loop-carried data dependences must be due to memory accesses that are disjoint between iterations.
+    */
+    auto areAllDataLCDsFromDisjointMemoryAccesses = true;
+    sccManager->iterateOverLoopCarriedDataDependences(scc, [
+      &areAllDataLCDsFromDisjointMemoryAccesses, domainSpaceAnalysis
+    ](DGEdge<Value> *dep) -> bool {
+      if (dep->isControlDependence()) return false;
+
+      if (!dep->isMemoryDependence()) {
+        areAllDataLCDsFromDisjointMemoryAccesses = false;
+        return true;
+      }
+
+      auto fromInst = dyn_cast<Instruction>(dep->getOutgoingT());
+      auto toInst = dyn_cast<Instruction>(dep->getIncomingT());
+      areAllDataLCDsFromDisjointMemoryAccesses &= fromInst && toInst && domainSpaceAnalysis->
+        areInstructionsAccessingDisjointMemoryLocationsBetweenIterations(fromInst, toInst);
+      return !areAllDataLCDsFromDisjointMemoryAccesses;
+    });
+    if (!areAllDataLCDsFromDisjointMemoryAccesses){
+      return false;
+    }
+  }
+
+  return true;
+}
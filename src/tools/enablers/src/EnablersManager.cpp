@@ -11,7 +11,10 @@
 #include "EnablersManager.hpp"
 #include "Noelle.hpp"
 #include "LoopDistribution.hpp"
+#include "LoopFusion.hpp"
 #include "LoopUnroll.hpp"
+#include "LoopCollapse.hpp"
+#include "LoopTiling.hpp"
 
 using namespace llvm;
 using namespace llvm::noelle;
@@ -43,10 +46,13 @@ bool EnablersManager::runOnModule (Module &M) {
   * Create the enablers.
   */
   auto loopDist = LoopDistribution();
+  auto loopFusion = LoopFusion();
   auto loopUnroll = LoopUnroll();
   auto loopWhilify = LoopWhilifier(noelle);
   auto loopInvariantCodeMotion = LoopInvariantCodeMotion(noelle);
   auto scevSimplification = SCEVSimplification(noelle);
+  auto loopTiling = LoopTiling();
+  auto loopCollapse = LoopCollapse();
 
   /*
   * Fetch all the loops we want to parallelize.
@@ -86,10 +92,13 @@ bool EnablersManager::runOnModule (Module &M) {
       loop,
       noelle,
       loopDist,
+      loopFusion,
       loopUnroll,
       loopWhilify,
       loopInvariantCodeMotion,
-      scevSimplification
+      scevSimplification,
+      loopTiling,
+      loopCollapse
     );
     modified |= modifiedFunctions[f];
   }
@@ -19,8 +19,11 @@
 #include "PDGAnalysis.hpp"
 #include "Noelle.hpp"
 #include "LoopDistribution.hpp"
+#include "LoopFusion.hpp"
 #include "LoopUnroll.hpp"
 #include "LoopWhilify.hpp"
+#include "LoopCollapse.hpp"
+#include "LoopTiling.hpp"
 #include "LoopInvariantCodeMotion.hpp"
 #include "SCEVSimplification.hpp"
 
@@ -61,10 +64,13 @@ namespace llvm::noelle {
         LoopDependenceInfo *LDI,
         Noelle &par,
         LoopDistribution &loopDist,
+        LoopFusion &loopFusion,
         LoopUnroll &loopUnroll,
         LoopWhilifier &LoopWhilifier,
         LoopInvariantCodeMotion &loopInvariantCodeMotion,
-        SCEVSimplification &scevSimplification
+        SCEVSimplification &scevSimplification,
+        LoopTiling &loopTiling,
+        LoopCollapse &loopCollapse
         );
 
       bool applyLoopWhilifier (
@@ -79,11 +85,33 @@ namespace llvm::noelle {
           LoopDistribution &loopDist
         );
 
+      bool applyLoopFusion (
+          LoopDependenceInfo *LDI,
+          Noelle &par,
+          LoopFusion &loopFusion
+        );
+
       bool applyDevirtualizer (
         LoopDependenceInfo *LDI,
         Noelle &par,
         LoopUnroll &loopUnroll
         );
+
+      bool applyLoopTiling (
+        LoopDependenceInfo *LDI,
+        Noelle &par,
+        LoopTiling &loopTiling
+        );
+
+      bool applyLoopCollapse (
+        LoopDependenceInfo *LDI,
+        Noelle &par,
+        LoopCollapse &loopCollapse
+        );
+
+      bool canIterationsRunInParallel (
+        LoopDependenceInfo *LDI
+        ) const ;
   };
 
 }
@@ -37,6 +37,7 @@ namespace llvm::noelle {
         Module &module,
         Hot &p,
         bool forceParallelization,
+        bool enableChunking,
         Verbosity v
       );
 
@@ -149,6 +150,8 @@ namespace llvm::noelle {
         LoopDependenceInfo *LDI
       );
 
+      void chunkLoopIterations (void) ;
+
     private:
       Function *waitSSCall, *signalSSCall;
       LoopDependenceInfo *originalLDI;
@@ -161,6 +164,16 @@ namespace llvm::noelle {
 
       bool enableInliner;
 
+      /*
+       * Iteration chunking: each core executes chunkSize consecutive iterations before handing over to the next core.
+       */
+      bool enableChunking;
+      uint32_t chunkSize;
+      PHINode *chunkPHI;
+      std::vector<std::pair<PHINode *, Value *>> chunkedIVs;
+
+      uint32_t computeChunkSize (LoopDependenceInfo *LDI) const ;
+
       void squeezeSequentialSegment (
         LoopDependenceInfo *LDI,
         DataFlowResult *reachabilityDFR,
@@ -169,6 +182,12 @@ namespace llvm::noelle {
 
       DataFlowResult *computeReachabilityFromInstructions (LoopDependenceInfo *LDI) ;
 
+      void mergeSequentialSegments (
+        LoopDependenceInfo *originalLDI,
+        std::unordered_map<SCC *, SCC *> &taskToOriginalFunctionSCCMap,
+        std::function<bool (SCCSet *)> requireSS
+      );
+
   };
 
   class SpilledLoopCarriedDependency {
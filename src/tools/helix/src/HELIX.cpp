@@ -9,7 +9,9 @@
  * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
  */
 #include "HELIX.hpp"
+#include "CompileTimeProfiler.hpp"
 #include "HELIXTask.hpp"
+#include "Architecture.hpp"
 
 namespace llvm::noelle{
 
@@ -17,13 +19,17 @@ HELIX::HELIX (
   Module &module, 
   Hot &p,
   bool forceParallelization,
+  bool enableChunking,
   Verbosity v
   )
   : ParallelizationTechniqueForLoopsWithLoopCarriedDataDependences{module, p, forceParallelization, v},
     loopCarriedEnvBuilder{nullptr}, 
     taskFunctionDG{nullptr},
     lastIterationExecutionBlock{nullptr},
-    enableInliner{true}
+    enableInliner{true},
+    enableChunking{enableChunking},
+    chunkSize{1},
+    chunkPHI{nullptr}
   {
 
   /*
@@ -89,6 +95,9 @@ void HELIX::reset () {
   }
   lastIterationExecutionDuplicateMap.clear();
 
+  chunkSize = 1;
+  chunkPHI = nullptr;
+  chunkedIVs.clear();
 }
 
 bool HELIX::canBeAppliedToLoop (LoopDependenceInfo *LDI, Noelle &par, Heuristics *h) const {
@@ -143,6 +152,8 @@ bool HELIX::apply (
   Noelle &par,
   Heuristics *h
 ) {
+  auto profiledLoop = LDI->getLoopStructure();
+  CompileTimeScope profile("helix-code-generation", *profiledLoop->getFunction(), profiledLoop->getID());
 
   /*
    * If a task has not been defined, create such a task from the
@@ -181,12 +192,18 @@ void HELIX::createParallelizableTask (
    */
   this->originalLDI = LDI;
 
+  /*
+   * Decide how many consecutive iterations each core executes.
+   */
+  this->chunkSize = this->computeChunkSize(LDI);
+
   /*
    * Print the parallelization request.
    */
   if (this->verbose != Verbosity::Disabled) {
     errs() << "HELIX: Start the parallelization\n";
     errs() << "HELIX:   Number of threads to extract = " << LDI->getMaximumNumberOfCores() << "\n";
+    errs() << "HELIX:   Chunk size = " << this->chunkSize << "\n";
     auto nonDOALLSCCs = sccManager->getSCCsWithLoopCarriedDependencies();
     for (auto scc : nonDOALLSCCs) {
 
@@ -449,6 +466,11 @@ bool HELIX::synchronizeTask (
     }
   }
 
+  /*
+   * Chunk the iterations now that the sequential segments have been identified.
+   */
+  this->chunkLoopIterations();
+
   /*
    * Add synchronization instructions.
    */
@@ -554,6 +576,46 @@ bool HELIX::synchronizeTask (
   return true;
 }
 
+uint32_t HELIX::computeChunkSize (LoopDependenceInfo *LDI) const {
+
+  /*
+   * Check if chunking has been enabled.
+   * Chunking relies on re-wiring the loop governing IV to catch iterating past its exit value.
+   */
+  if (  false
+        || (!this->enableChunking)
+        || (LDI->getLoopGoverningIVAttribution() == nullptr)
+        || (!this->profile.isAvailable())
+     ){
+    return 1;
+  }
+
+  /*
+   * Fetch the profiled latency of an iteration.
+   */
+  auto loopStructure = LDI->getLoopStructure();
+  if (this->profile.getIterations(loopStructure) == 0){
+    return 1;
+  }
+  auto timePerIteration = this->profile.getAverageTotalInstructionsPerIteration(loopStructure);
+
+  /*
+   * Signals are sent once per chunk.
+   * Choose the smallest chunk whose execution covers the latency of a signal.
+   */
+  auto signalLatency = (double)Architecture::getLatencyOfSequentialSegmentSignal();
+  auto maximumChunkSize = 64;
+  uint32_t chunkSize = 1;
+  while (  true
+           && (chunkSize < maximumChunkSize)
+           && ((chunkSize * timePerIteration) < signalLatency)
+        ){
+    chunkSize++;
+  }
+
+  return chunkSize;
+}
+
 Function * HELIX::getTaskFunction (void) const {
   return tasks[0]->getTaskBody();
 }
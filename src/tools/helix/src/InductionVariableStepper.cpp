@@ -77,8 +77,9 @@ void HELIX::rewireLoopForIVsToIterateNthIterations(LoopDependenceInfo *LDI) {
 
   /*
    * Determine start value of the IV for the task
-   * core_start: original_start + original_step_size * core_id
+   * core_start: original_start + original_step_size * core_id * chunk_size
    */
+  auto chunkSizeValue = ConstantInt::get(task->coreArg->getType(), this->chunkSize);
   for (auto ivInfo : ivInfos) {
     auto startOfIV = fetchClone(ivInfo->getStartValue());
     auto stepOfIV = clonedStepSizeMap.at(ivInfo);
@@ -88,10 +89,10 @@ void HELIX::rewireLoopForIVsToIterateNthIterations(LoopDependenceInfo *LDI) {
     auto nthCoreOffset = entryBuilder.CreateMul(
       stepOfIV,
       entryBuilder.CreateZExtOrTrunc(
-        task->coreArg,
+        entryBuilder.CreateMul(task->coreArg, chunkSizeValue, "coreIdx_X_chunkSize"),
         stepOfIV->getType()
       ),
-      "stepSize_X_coreIdx"
+      "stepSize_X_coreIdx_X_chunkSize"
     );
 
     auto offsetStartValue = IVUtility::offsetIVPHI(preheaderClone, ivPHI, startOfIV, nthCoreOffset);
@@ -100,7 +101,10 @@ void HELIX::rewireLoopForIVsToIterateNthIterations(LoopDependenceInfo *LDI) {
 
   /*
    * Determine additional step size to account for n cores each executing the task
-   * jump_step_size: original_step_size * (num_cores - 1)
+   * jump_step_size: original_step_size * (num_cores - 1) * chunk_size
+   *
+   * When iterations are chunked, the jump only happens at the end of a chunk.
+   * It is added by chunkLoopIterations once sequential segments have been identified, so the task loop keeps plain induction variables until then.
    */
   for (auto ivInfo : ivInfos) {
     auto stepOfIV = clonedStepSizeMap.at(ivInfo);
@@ -109,17 +113,24 @@ void HELIX::rewireLoopForIVsToIterateNthIterations(LoopDependenceInfo *LDI) {
 
     auto jumpStepSize = entryBuilder.CreateMul(
       stepOfIV,
-      entryBuilder.CreateSub(
-        entryBuilder.CreateZExtOrTrunc(
-          task->numCoresArg,
-          stepOfIV->getType()
+      entryBuilder.CreateZExtOrTrunc(
+        entryBuilder.CreateMul(
+          entryBuilder.CreateSub(
+            task->numCoresArg,
+            ConstantInt::get(task->numCoresArg->getType(), 1)
+          ),
+          chunkSizeValue
         ),
-        ConstantInt::get(stepOfIV->getType(), 1)
+        stepOfIV->getType()
       ),
       "nCoresStepSize"
     );
 
-    IVUtility::stepInductionVariablePHI(preheaderClone, ivPHI, jumpStepSize);
+    if (this->chunkSize == 1){
+      IVUtility::stepInductionVariablePHI(preheaderClone, ivPHI, jumpStepSize);
+      continue ;
+    }
+    this->chunkedIVs.push_back(std::make_pair(ivPHI, jumpStepSize));
   }
 
   /*
@@ -225,6 +236,8 @@ void HELIX::rewireLoopForIVsToIterateNthIterations(LoopDependenceInfo *LDI) {
     /*
      * Compute the loop governing IV's value the previous iteration
      * (regardless of what core it would have executed on)
+     *
+     * NOTE: This holds for chunked iterations as well. The previous iteration is either the previous one of the same chunk or the last one of the previous core's chunk.
      */
     auto originalGoverningPHI = loopGoverningIV.getLoopEntryPHI();
     auto cloneGoverningPHI = task->getCloneOfOriginalInstruction(originalGoverningPHI);
@@ -312,3 +325,39 @@ void HELIX::rewireLoopForIVsToIterateNthIterations(LoopDependenceInfo *LDI) {
 
   }
 }
+
+void HELIX::chunkLoopIterations (void) {
+
+  /*
+   * Check if iterations need to be chunked.
+   */
+  if (this->chunkSize == 1){
+    return ;
+  }
+
+  /*
+   * Fetch the loop.
+   */
+  auto task = static_cast<HELIXTask *>(this->tasks[0]);
+  auto loopStructure = this->originalLDI->getLoopStructure();
+  auto preheaderClone = task->getCloneOfOriginalBasicBlock(loopStructure->getPreHeader());
+  auto headerClone = task->getCloneOfOriginalBasicBlock(loopStructure->getHeader());
+
+  /*
+   * Generate PHI to track progress on the current chunk
+   */
+  auto chunkCounterType = task->coreArg->getType();
+  auto chunkSizeValue = ConstantInt::get(chunkCounterType, this->chunkSize);
+  this->chunkPHI = IVUtility::createChunkPHI(preheaderClone, headerClone, chunkCounterType, chunkSizeValue);
+
+  /*
+   * Jump to the next chunk of the current core once the current chunk is completed.
+   */
+  for (auto chunkedIV : this->chunkedIVs){
+    auto ivPHI = chunkedIV.first;
+    auto chunkStepSize = chunkedIV.second;
+    IVUtility::chunkInductionVariablePHI(preheaderClone, ivPHI, this->chunkPHI, chunkStepSize);
+  }
+
+  return ;
+}
@@ -10,6 +10,7 @@
  */
 #include "HELIX.hpp"
 #include "HELIXTask.hpp"
+#include "Architecture.hpp"
 
 using namespace llvm;
 using namespace llvm::noelle;
@@ -100,26 +101,15 @@ std::vector<SequentialSegment *> HELIX::identifySequentialSegments (
   auto preambleSCC = (*preambleSCCNodes.begin())->getT();
   bool wasOriginalLoopIVGoverned = originalLDI->getLoopGoverningIVAttribution() != nullptr;
 
-  /*
-   * Fetch the subsets.
-   */
-  auto sets = this->partitioner->getDepthOrderedSets();
-
   /*
    * Fetch the set of SCCs that have loop-carried data dependences.
    */
   auto depsSCCs = sccManager->getSCCsWithLoopCarriedDataDependencies();
 
   /*
-   * Allocate the sequential segments, one per partition.
+   * Check if a set of SCCs requires a sequential segment.
    */
-  int32_t ssID = 0;
-  for (auto set : sets){
-
-    /*
-     * Check if the current set of SCCs require a sequential segments.
-     */
-    auto requireSS = false;
+  auto requireSS = [&](SCCSet *set) -> bool {
     for (auto scc : set->sccs){
 
       /*
@@ -150,6 +140,13 @@ std::vector<SequentialSegment *> HELIX::identifySequentialSegments (
         continue ;
       }
 
+      /*
+       * Reducible memory locations (e.g., histograms) are privatized by DOALL only; HELIX needs to synchronize them.
+       */
+      if (sccInfo->getSingleLoopCarriedMemoryLocation() != nullptr) {
+        return true;
+      }
+
       /*
        * Fetch the type of the SCC.
        */
@@ -160,11 +157,33 @@ std::vector<SequentialSegment *> HELIX::identifySequentialSegments (
        * FIXME: A reducible SCC should not be sequential in nature
        */
       if (sccType == SCCAttrs::SEQUENTIAL) {
-        requireSS = true;
-        break ;
+        return true;
       }
     }
-    if (!requireSS){
+
+    return false;
+  };
+
+  /*
+   * Merge sequential segments when the synchronization they require costs more than the serialization merging them introduces.
+   */
+  this->mergeSequentialSegments(originalLDI, taskToOriginalFunctionSCCMap, requireSS);
+
+  /*
+   * Fetch the subsets.
+   */
+  auto sets = this->partitioner->getDepthOrderedSets();
+
+  /*
+   * Allocate the sequential segments, one per partition.
+   */
+  int32_t ssID = 0;
+  for (auto set : sets){
+
+    /*
+     * Check if the current set of SCCs require a sequential segments.
+     */
+    if (!requireSS(set)){
       continue ;
     }
 
@@ -182,3 +201,134 @@ std::vector<SequentialSegment *> HELIX::identifySequentialSegments (
 
   return sss;
 }
+
+void HELIX::mergeSequentialSegments (
+  LoopDependenceInfo *originalLDI,
+  std::unordered_map<SCC *, SCC *> &taskToOriginalFunctionSCCMap,
+  std::function<bool (SCCSet *)> requireSS
+){
+
+  /*
+   * Merging decisions rely on the time spent in each sequential segment, which only profiles can tell us.
+   */
+  auto originalLoop = originalLDI->getLoopStructure();
+  if (  false
+        || (!this->profile.isAvailable())
+        || (this->profile.getIterations(originalLoop) == 0)
+     ){
+    return ;
+  }
+  auto iterations = (double)this->profile.getIterations(originalLoop);
+  auto timePerIteration = this->profile.getAverageTotalInstructionsPerIteration(originalLoop);
+  auto cores = (double)originalLDI->getMaximumNumberOfCores();
+  auto signalLatency = (double)Architecture::getLatencyOfSequentialSegmentSignal();
+
+  /*
+   * Compute the time spent per iteration by the SCCs of a set.
+   */
+  auto timePerIterationOfSet = [&](SCCSet *set) -> double {
+    uint64_t instructions = 0;
+    for (auto scc : set->sccs){
+      auto originalSCC = taskToOriginalFunctionSCCMap.find(scc);
+      if (originalSCC == taskToOriginalFunctionSCCMap.end()){
+        continue ;
+      }
+      instructions += this->profile.getTotalInstructions(originalSCC->second);
+    }
+    return ((double)instructions) / iterations;
+  };
+
+  /*
+   * Estimate the time per iteration of the parallelized loop.
+   * It is bounded by the iteration itself split among the cores plus one wait/signal pair per sequential segment,
+   * and by the biggest sequential segment plus the signal that lets the next core enter it.
+   */
+  auto estimateTimePerIteration = [&](uint64_t numberOfSSs, double biggestSS) -> double {
+    auto parallelTime = (timePerIteration / cores) + (numberOfSSs * signalLatency);
+    auto serialTime = biggestSS + signalLatency;
+    return std::max(parallelTime, serialTime);
+  };
+
+  while (true){
+
+    /*
+     * Fetch the sets that require a sequential segment.
+     */
+    std::vector<SCCSet *> ssSets;
+    for (auto set : this->partitioner->getDepthOrderedSets()){
+      if (requireSS(set)){
+        ssSets.push_back(set);
+      }
+    }
+    if (ssSets.size() < 2){
+      break ;
+    }
+
+    /*
+     * Estimate the time per iteration with the current sequential segments.
+     */
+    std::unordered_map<SCCSet *, double> ssTimes;
+    double biggestSS = 0;
+    for (auto set : ssSets){
+      ssTimes[set] = timePerIterationOfSet(set);
+      biggestSS = std::max(biggestSS, ssTimes[set]);
+    }
+    auto bestTime = estimateTimePerIteration(ssSets.size(), biggestSS);
+
+    /*
+     * Find the pair of consecutive sequential segments that benefits the most from being merged.
+     * Merging two sets also merges the sets that depend on one and are depended on by the other.
+     */
+    SCCSet *bestA = nullptr;
+    SCCSet *bestB = nullptr;
+    for (auto i = 0; (i + 1) < ssSets.size(); i++){
+      auto setA = ssSets[i];
+      auto setB = ssSets[i + 1];
+      auto mergedSets = this->partitioner->getCycleIntroducedByMerging(setA, setB);
+
+      /*
+       * Compute the sequential segment that results from merging.
+       */
+      double mergedSS = 0;
+      uint64_t mergedNumberOfSSs = 0;
+      for (auto set : mergedSets){
+        mergedSS += timePerIterationOfSet(set);
+        if (requireSS(set)){
+          mergedNumberOfSSs++;
+        }
+      }
+
+      /*
+       * Estimate the time per iteration after merging.
+       */
+      auto newBiggestSS = mergedSS;
+      for (auto set : ssSets){
+        if (mergedSets.find(set) != mergedSets.end()){
+          continue ;
+        }
+        newBiggestSS = std::max(newBiggestSS, ssTimes[set]);
+      }
+      auto newNumberOfSSs = ssSets.size() - mergedNumberOfSSs + 1;
+      auto newTime = estimateTimePerIteration(newNumberOfSSs, newBiggestSS);
+      if (newTime >= bestTime){
+        continue ;
+      }
+      bestTime = newTime;
+      bestA = setA;
+      bestB = setB;
+    }
+    if (bestA == nullptr){
+      break ;
+    }
+
+    /*
+     * Merge the sequential segments.
+     */
+    if (this->verbose != Verbosity::Disabled){
+      errs() << "HELIX:  Merge two sequential segments. The estimated time per iteration becomes " << bestTime << "\n";
+    }
+    this->partitioner->mergePair(bestA, bestB);
+  }
+
+  return ;
+}
@@ -120,6 +120,29 @@ void HELIX::addSynchronizations (
     ssStates.push_back(ssStateAlloca);
   }
 
+  /*
+   * When iterations are chunked, only the last iteration of a chunk signals the next core.
+   * The other iterations signal a location private to the task instead.
+   */
+  Value *privateSignalPtr = nullptr;
+  if (this->chunkPHI != nullptr){
+    auto privateSignalAlloca = entryBuilder.CreateAlloca(int64);
+    privateSignalAlloca->moveBefore(helixTask->getEntry()->getFirstNonPHIOrDbgOrLifetime());
+    privateSignalPtr = entryBuilder.CreateBitCast(privateSignalAlloca, helixTask->ssFutureArrayArg->getType());
+  }
+  auto fetchSignalTarget = [&](IRBuilder<> &builder, SequentialSegment *ss, bool isWithinIteration) -> Value * {
+    auto ssFuturePtr = ssFuturePtrs.at(ss->getID());
+    if (  false
+          || (!isWithinIteration)
+          || (this->chunkPHI == nullptr)
+       ){
+      return ssFuturePtr;
+    }
+    auto lastIterationOfChunk = ConstantInt::get(this->chunkPHI->getType(), this->chunkSize - 1);
+    auto isLastIterationOfChunk = builder.CreateICmpEQ(this->chunkPHI, lastIterationOfChunk);
+    return builder.CreateSelect(isLastIterationOfChunk, ssFuturePtr, privateSignalPtr);
+  };
+
   /*
    * Define the code that inject wait instructions.
    */
@@ -182,7 +205,7 @@ void HELIX::addSynchronizations (
   /*
    * Define the code that inject wait instructions.
    */
-  auto injectSignal = [&](SequentialSegment *ss, Instruction *justBeforeExit) -> void {
+  auto injectSignal = [&](SequentialSegment *ss, Instruction *justBeforeExit, bool isWithinIteration) -> void {
 
     /*
      * Inject a call to HELIX_signal just after "justBeforeExit" 
@@ -194,14 +217,16 @@ void HELIX::addSynchronizations (
     if (!justBeforeExitBr || justBeforeExitBr->isUnconditional()) {
       Instruction *insertPoint = terminator == justBeforeExit ? terminator : justBeforeExit->getNextNode();
       IRBuilder<> beforeExitBuilder(insertPoint);
-      auto signal = beforeExitBuilder.CreateCall(this->signalSSCall, { ssFuturePtrs.at(ss->getID()) });
+      auto signalTarget = fetchSignalTarget(beforeExitBuilder, ss, isWithinIteration);
+      auto signal = beforeExitBuilder.CreateCall(this->signalSSCall, { signalTarget });
       helixTask->signals.insert(cast<CallInst>(signal));
       return;
     }
 
     for (auto successorBlock : successors(block)) {
       IRBuilder<> beforeExitBuilder(successorBlock->getFirstNonPHIOrDbgOrLifetime());
-      auto signal = beforeExitBuilder.CreateCall(this->signalSSCall, { ssFuturePtrs.at(ss->getID()) });
+      auto signalTarget = fetchSignalTarget(beforeExitBuilder, ss, isWithinIteration);
+      auto signal = beforeExitBuilder.CreateCall(this->signalSSCall, { signalTarget });
       helixTask->signals.insert(cast<CallInst>(signal));
     }
   };
@@ -230,7 +255,7 @@ void HELIX::addSynchronizations (
     auto loopExitTerminator = loopExitBlock->getTerminator();
     for (auto ss : *sss) {
       injectWait(ss, loopExitBlock->getFirstNonPHI());
-      injectSignal(ss, loopExitTerminator);
+      injectSignal(ss, loopExitTerminator, false);
     }
   }
 
@@ -271,7 +296,7 @@ void HELIX::addSynchronizations (
 
     IRBuilder<> failedCheckBuilder(failedCheckBB);
     auto brToExit = failedCheckBuilder.CreateBr(helixTask->getExit());
-    for (auto ss : *sss) injectSignal(ss, brToExit);
+    for (auto ss : *sss) injectSignal(ss, brToExit, false);
   };
 
   /*
@@ -283,10 +308,19 @@ void HELIX::addSynchronizations (
      * Reset the value of ssState at the beginning of the iteration
      * NOTE: This has to be done BEFORE any preamble synchronization, so this
      * insertion comes after the check exit logic has already been inserted
+     *
+     * NOTE: When iterations are chunked, reset it only at the beginning of a chunk.
+     * The wait executed by a previous iteration of the chunk still holds because the previous core signals only at the end of its chunk.
      */
     auto firstLoopInst = loopHeader->getFirstNonPHIOrDbgOrLifetime();
     IRBuilder<> headerBuilder(firstLoopInst);
-    headerBuilder.CreateStore(ConstantInt::get(int64, 0), ssStates.at(ss->getID()));
+    Value *ssStateResetValue = ConstantInt::get(int64, 0);
+    if (this->chunkPHI != nullptr){
+      auto isFirstIterationOfChunk = headerBuilder.CreateICmpEQ(this->chunkPHI, ConstantInt::get(this->chunkPHI->getType(), 0));
+      auto currentSSState = headerBuilder.CreateLoad(ssStates.at(ss->getID()));
+      ssStateResetValue = headerBuilder.CreateSelect(isFirstIterationOfChunk, ssStateResetValue, currentSSState);
+    }
+    headerBuilder.CreateStore(ssStateResetValue, ssStates.at(ss->getID()));
 
     /*
      * Inject waits.
@@ -309,6 +343,7 @@ void HELIX::addSynchronizations (
      * to a set of all exits; then signal at all unique exits determined
      */
     std::unordered_set<Instruction *> exits;
+    std::unordered_set<Instruction *> loopExits;
     ss->forEachExit([&exits](Instruction *justBeforeExit) -> void {
       auto block = justBeforeExit->getParent();
       auto terminator = block->getTerminator();
@@ -330,6 +365,7 @@ void HELIX::addSynchronizations (
       for (auto exitBlock : loopStructure->getLoopExitBasicBlocks()) {
         auto beginningOfExitBlock = exitBlock->getFirstNonPHIOrDbgOrLifetime();
         exits.insert(beginningOfExitBlock);
+        loopExits.insert(beginningOfExitBlock);
       }
     }
 
@@ -340,7 +376,8 @@ void HELIX::addSynchronizations (
      * so that the set instruction is placed before the signal call
      */
     for (auto exit : exits) {
-      injectSignal(ss, exit);
+      auto isWithinIteration = (loopExits.find(exit) == loopExits.end());
+      injectSignal(ss, exit, isWithinIteration);
       if (preambleSS == ss &&
         !loopStructure->isIncluded(exit)) {
         injectExitFlagSet(exit);
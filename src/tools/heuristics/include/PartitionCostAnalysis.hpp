@@ -43,6 +43,14 @@ namespace llvm::noelle {
 
     void printCandidate (raw_ostream &stream);
 
+    /*
+     * Estimate the latency of the current partition if the sets @setsToMerge were replaced by @mergedSet.
+     */
+    uint64_t estimateCostOfPartitionAfterMerging (
+      std::unordered_set<SCCSet *> &setsToMerge,
+      SCCSet *mergedSet
+    );
+
     const static std::string prefix;
    protected:
 
@@ -8,6 +8,7 @@
  * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
  * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
  */
+#include "Architecture.hpp"
 #include "InvocationLatency.hpp"
 
 using namespace llvm;
@@ -41,11 +42,14 @@ uint64_t InvocationLatency::latencyPerInvocation (SCC *scc){
  * The execution time of all subsets is approx:
  *  1) The maximum internal execution of any subset +
  *  2) The time spent en/de-queueing for all subsets
+ *
+ * Values produced and consumed within the same subset do not need a queue.
  */
 uint64_t InvocationLatency::latencyPerInvocation (
   SCCDAGAttrs *attrs,
   std::unordered_set<SCCSet *> &sets
 ) {
+  auto sccdag = attrs->getSCCDAG();
   uint64_t maxInternalCost = 0;
   std::set<Value *> queueValues;
   for (auto set : sets) {
@@ -58,8 +62,13 @@ uint64_t InvocationLatency::latencyPerInvocation (
 
     uint64_t internalCost = 0;
     for (auto scc : subsetSCCs) {
-      auto &externals = memoizeExternals(attrs, scc);
-      queueValues.insert(externals.begin(), externals.end());
+      for (auto external : memoizeExternals(attrs, scc)) {
+        auto producerSCC = sccdag->sccOfValue(external);
+        if (subsetSCCs.find(producerSCC) != subsetSCCs.end()) {
+          continue ;
+        }
+        queueValues.insert(external);
+      }
       internalCost += this->latencyPerInvocation(scc);
     }
     if (internalCost > maxInternalCost) maxInternalCost = internalCost;
@@ -92,13 +101,52 @@ uint64_t InvocationLatency::latencyPerInvocation (Instruction *inst){
   return latency;
 }
 
+/*
+ * The time spent communicating a value through a queue is the latency of a push/pop pair on the current machine
+ * (see Architecture) times the number of values sent.
+ */
 uint64_t InvocationLatency::queueLatency (Value *queueVal){
-  // TODO(angelo): use primitive size of bits of type of value?
-  return 100;
+
+  /*
+   * Check if we have already computed the latency of this queue.
+   */
+  auto queueCostIt = this->queueValToCost.find(queueVal);
+  if (queueCostIt != this->queueValToCost.end()) {
+    return queueCostIt->second;
+  }
+
+  /*
+   * Fetch the width of the queue.
+   */
+  auto queueType = queueVal->getType();
+  uint32_t bitwidth = 64;
+  if (!queueType->isPointerTy()){
+    bitwidth = queueType->getPrimitiveSizeInBits();
+  }
+
+  /*
+   * Compute the number of values sent through the queue.
+   */
+  uint64_t valuesSent = 1;
+  if (auto queueInst = dyn_cast<Instruction>(queueVal)) {
+    auto invocations = this->profiles->getInvocations(queueInst);
+    if (invocations > 0) {
+      valuesSent = invocations;
+    }
+  }
+
+  /*
+   * Compute the latency.
+   */
+  auto latencyPerValue = Architecture::getLatencyOfQueuePushAndPop(bitwidth);
+  auto cost = (uint64_t)(latencyPerValue * valuesSent);
+  this->queueValToCost[queueVal] = cost;
+
+  return cost;
 }
 
 /*
- * Retrieve or memoize all values the SCC is dependent on.
+ * Retrieve or memoize all values the SCC is dependent on (i.e., the values produced outside the SCC that need to be sent to it).
  * This does NOT include values within clonable parents as they will be present during execution (because they are cloned).
  */
 std::set<Value *> &InvocationLatency::memoizeExternals (SCCDAGAttrs *attrs, SCC *scc) {
@@ -107,18 +155,19 @@ std::set<Value *> &InvocationLatency::memoizeExternals (SCCDAGAttrs *attrs, SCC
     return externalsIter->second;
   }
 
+  auto &externals = incomingExternals[scc];
   for (auto edge : attrs->edgesViaClones[scc]) {
-    auto parent = edge->getIncomingT();
+    auto parent = edge->getOutgoingT();
     auto parentInfo = attrs->getSCCAttrs(parent);
     if (parentInfo->canBeCloned()) {
       continue;
     }
 
     for (auto subEdge : edge->getSubEdges()) {
-      incomingExternals[scc].insert(subEdge->getIncomingT());
+      externals.insert(subEdge->getOutgoingT());
     }
   }
-  return incomingExternals[scc];
+  return externals;
 }
 
 /*
@@ -16,9 +16,9 @@ using namespace llvm::noelle;
 void MinMaxSizePartitionAnalysis::checkIfShouldMerge (SCCSet *sA, SCCSet *sB) {
 
   /*
-   * Hard stop merging once we have fewer partitions than cores
+   * Check if we have more partitions than cores
    */
-  if (partitioner.getPartitionGraph()->numNodes() <= numCores) return ;
+  auto moreSetsThanCores = partitioner.getPartitionGraph()->numNodes() > numCores;
 
   /*
    * Compute all sets that have to be merged if the two target sets are merged
@@ -40,23 +40,51 @@ void MinMaxSizePartitionAnalysis::checkIfShouldMerge (SCCSet *sA, SCCSet *sB) {
   uint64_t costOnceMerged = IL.latencyPerInvocation(&dagAttrs, singleSet);
 
   /*
-   * Only merge if it is the cheapest of the merges
+   * Compute the cost saved by merging.
+   * This is the communication between the merged sets that is removed minus the parallelism that is lost.
    */
-  if (costOnceMerged > this->costOfMergedSet) return ;
+  auto costOfPartitionOnceMerged = this->estimateCostOfPartitionAfterMerging(setsInMerge, &potentialMerge);
+  uint64_t savedCost = 0;
+  if (costOfPartitionOnceMerged < this->costIfAllSetsRunOnSeparateCores) {
+    savedCost = this->costIfAllSetsRunOnSeparateCores - costOfPartitionOnceMerged;
+  }
 
-  /*
-   * Only merge if it is the smallest of equally cost effective merges
-   */
-  if (costOnceMerged == this->costOfMergedSet
-    && instCountOfMerge > this->numInstructionsInSetsBeingMerged) return ;
+  if (moreSetsThanCores) {
+
+    /*
+     * Only merge if it is the cheapest of the merges
+     */
+    if (costOnceMerged > this->costOfMergedSet) return ;
+
+    /*
+     * Only merge if it is the smallest of equally cost effective merges
+     */
+    if (costOnceMerged == this->costOfMergedSet
+      && instCountOfMerge > this->numInstructionsInSetsBeingMerged) return ;
+
+  } else {
+
+    /*
+     * We have enough cores to run every partition on its own core.
+     * Only merge if the communication latency of the machine makes the merge lower the overall cost.
+     */
+    if (savedCost == 0) return ;
+
+    /*
+     * Only merge if it is the merge that saves the most
+     */
+    if (savedCost < this->savedCostByMerging) return ;
+    if (savedCost == this->savedCostByMerging
+      && costOnceMerged >= this->costOfMergedSet) return ;
+  }
 
   /*
    * Save merge candidate
-   * TODO: Compute saved cost by merging
    */
   this->minSetsToMerge = setsInMerge;
   this->costOfMergedSet = costOnceMerged;
   this->numInstructionsInSetsBeingMerged = instCountOfMerge;
+  this->savedCostByMerging = savedCost;
 
   if (verbose >= Verbosity::Maximal) {
     errs() << prefix << "Lowered cost: " << savedCostByMerging
@@ -85,6 +85,30 @@ bool PartitionCostAnalysis::mergeCandidateSubsets () {
   return true;
 }
 
+uint64_t PartitionCostAnalysis::estimateCostOfPartitionAfterMerging (
+  std::unordered_set<SCCSet *> &setsToMerge,
+  SCCSet *mergedSet
+) {
+
+  /*
+   * Compute the sets of the partition once the merge is performed.
+   */
+  std::unordered_set<SCCSet *> setsOnceMerged{ mergedSet };
+  for (auto set : partitioner.getSets()) {
+    if (setsToMerge.find(set) != setsToMerge.end()) {
+      continue ;
+    }
+    setsOnceMerged.insert(set);
+  }
+
+  /*
+   * Estimate the latency of the new partition.
+   */
+  auto cost = IL.latencyPerInvocation(&dagAttrs, setsOnceMerged);
+
+  return cost;
+}
+
 void PartitionCostAnalysis::printCandidate (raw_ostream &stream) {
   if (verbose == Verbosity::Disabled) return;
 
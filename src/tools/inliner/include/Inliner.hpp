@@ -46,6 +46,7 @@ namespace llvm::noelle {
        * Inlining procedure
        */
       void getLoopsToInline (Noelle &noelle, Hot *profiles) ;
+      void getLoopsToInline (Noelle &noelle, Hot *profiles, Function *F) ;
       bool registerRemainingLoops (std::string filename) ;
       bool inlineCallsInvolvedInLoopCarriedDataDependences (Noelle &noelle, noelle::CallGraph *pcg) ;
       bool inlineCallsInvolvedInLoopCarriedDataDependencesWithinLoop (Function *F, LoopDependenceInfo *LDI, noelle::CallGraph *pcg) ;
@@ -62,6 +63,7 @@ namespace llvm::noelle {
       int getNextPreorderLoopAfter (Function *F, CallInst *call) ;
       void adjustLoopOrdersAfterInline (Function *F, Function *childF, int nextLoop) ;
       void adjustFnGraphAfterInline (Function *F, Function *childF, int callInd) ;
+      void updateAnalysesAfterInlining (Noelle &noelle, noelle::CallGraph *pcg, Function *main) ;
 
       /*
        * Function and loop order tracking
@@ -98,6 +100,7 @@ namespace llvm::noelle {
        * Updated called function order as inlines occur
        */
       std::set<Function *> fnsAffected;
+      std::unordered_map<Function *, std::unordered_set<Instruction *>> instructionsAddedByInlining;
       std::unordered_map<Function *, std::vector<CallInst *>> orderedCalls;
       std::unordered_map<Function *, std::vector<Function *>> orderedCalled;
 
@@ -112,6 +115,7 @@ namespace llvm::noelle {
        */
       std::set<LoopStructure *> loopSummaries;
       Verbosity verbose;
+      bool inlineOneRoundPerInvocation;
     };
 
 }
@@ -100,11 +100,36 @@ bool Inliner::runOnModule (Module &M) {
   getLoopsToInline(noelle, profiles);
 
   /*
-  * Perform the inlining.
+  * Perform the inlining until a fixed point is reached.
+  * Between rounds, only the analyses of the functions modified by the last round are updated.
   */
-  auto inlined = this->inlineCallsInvolvedInLoopCarriedDataDependences(noelle, pcg);
+  auto inlined = false;
+  auto rounds = 0;
+  while (this->inlineCallsInvolvedInLoopCarriedDataDependences(noelle, pcg)){
+    inlined = true;
+    rounds++;
+    if (this->verbose != Verbosity::Disabled){
+      errs() << "Inliner:   Round " << rounds << " modified " << this->fnsAffected.size() << " functions\n";
+    }
+    if (this->inlineOneRoundPerInvocation){
+      break ;
+    }
+    this->updateAnalysesAfterInlining(noelle, pcg, main);
+  }
   if (inlined){
-    writeToContinueFile();
+
+    /*
+    * Loops are hoisted to main after the code has been normalized.
+    * So, if hoisting has been requested, we need to be invoked again.
+    * We also need to be invoked again if only one round is performed per invocation.
+    */
+    ifstream doHoistFile("dgsimplify_do_hoist.txt");
+    if (  false
+          || doHoistFile.good()
+          || this->inlineOneRoundPerInvocation
+       ){
+      writeToContinueFile();
+    }
 
     /*
     * Free the memory.
@@ -185,31 +210,38 @@ bool Inliner::runOnModule (Module &M) {
 * Progress Tracking using file system
 */
 void Inliner::getLoopsToInline (Noelle &noelle, Hot *profiles) {
+  for (auto funcLoops : preOrderedLoops) {
+    getLoopsToInline(noelle, profiles, funcLoops.first);
+  }
+}
+
+void Inliner::getLoopsToInline (Noelle &noelle, Hot *profiles, Function *F) {
   assert(profiles != nullptr);
 
-  for (auto funcLoops : preOrderedLoops) {
-    auto F = funcLoops.first;
-    for (auto summary : *funcLoops.second) {
+  auto funcLoops = preOrderedLoops.find(F);
+  if (funcLoops == preOrderedLoops.end()) {
+    return ;
+  }
+  for (auto summary : *funcLoops->second) {
 
-      /*
-      * Check if the profile is available.
+    /*
+    * Check if the profile is available.
+    */
+    if (profiles->isAvailable()){
+      
+      /* 
+      * Check if the loop is hot enough.
       */
-      if (profiles->isAvailable()){
-        
-        /* 
-        * Check if the loop is hot enough.
-        */
-        auto hotness = profiles->getDynamicTotalInstructionCoverage(summary);
-        if (hotness < noelle.getMinimumHotness()){
+      auto hotness = profiles->getDynamicTotalInstructionCoverage(summary);
+      if (hotness < noelle.getMinimumHotness()){
 
-          /*
-          * The loop isn't hot enough.
-          */
-          continue ;
-        }
+        /*
+        * The loop isn't hot enough.
+        */
+        continue ;
       }
-      loopsToCheck[F].push_back(summary);
     }
+    loopsToCheck[F].push_back(summary);
   }
 }
 
@@ -357,9 +389,29 @@ bool Inliner::inlineFunctionCall (Function *F, Function *childF, CallInst *call)
   auto &parentCalls = orderedCalls[F];
   auto callInd = std::find(parentCalls.begin(), parentCalls.end(), call) - parentCalls.begin();
 
-  InlineFunctionInfo IFI;
+  /*
+  * Keep the LLVM call graph up to date, so it can be used by the next rounds of inlining.
+  */
+  auto &callGraph = getAnalysis<CallGraphWrapperPass>().getCallGraph();
+
+  /*
+  * Keep track of the instructions that exist before inlining, so the ones added by inlining can be identified.
+  * The call is excluded as it gets deleted by inlining, and its pointer can be reused by an added instruction.
+  */
+  std::unordered_set<Instruction *> instructionsBeforeInlining;
+  for (auto &I : instructions(F)) {
+    if (&I == call) continue;
+    instructionsBeforeInlining.insert(&I);
+  }
+
+  InlineFunctionInfo IFI(&callGraph);
   if (InlineFunction(call, IFI)) {
     fnsAffected.insert(F);
+    auto &addedInstructions = instructionsAddedByInlining[F];
+    for (auto &I : instructions(F)) {
+      if (instructionsBeforeInlining.find(&I) != instructionsBeforeInlining.end()) continue;
+      addedInstructions.insert(&I);
+    }
     adjustLoopOrdersAfterInline(F, childF, loopIndAfterCall);
     adjustFnGraphAfterInline(F, childF, callInd);
     return true;
@@ -455,6 +507,69 @@ void Inliner::adjustFnGraphAfterInline (Function *parentF, Function *childF, int
   }
 }
 
+void Inliner::updateAnalysesAfterInlining (Noelle &noelle, noelle::CallGraph *pcg, Function *main) {
+
+  /*
+  * Fetch the functions modified by the last round of inlining.
+  * They can be modified again by the next round.
+  */
+  auto modifiedFns = fnsAffected;
+  auto addedInstructions = instructionsAddedByInlining;
+  fnsAffected.clear();
+  instructionsAddedByInlining.clear();
+
+  /*
+  * Update the profiles to include the inlined code.
+  */
+  auto profiles = noelle.getProfiles();
+  if (profiles->isAvailable()){
+    noelle.updateProfiles();
+  }
+
+  /*
+  * Update the call graphs and the dependences of the modified functions.
+  * The LLVM call graph has been already updated while inlining.
+  */
+  auto &callGraph = getAnalysis<CallGraphWrapperPass>().getCallGraph();
+  for (auto F : modifiedFns) {
+    pcg->updateCallsOf(*F);
+
+    for (auto childF : childrenFns[F]) {
+      parentFns[childF].erase(F);
+    }
+    childrenFns[F].clear();
+    collectFnCallsAndCalled(callGraph, F);
+    std::set<Function *> orderedFns;
+    for (auto childF : orderedCalled[F]) {
+      if (orderedFns.find(childF) != orderedFns.end()) continue;
+      orderedFns.insert(childF);
+      childrenFns[F].push_back(childF);
+      parentFns[childF].insert(F);
+    }
+
+    noelle.invalidateFunctionDependenceGraph(F, addedInstructions[F]);
+  }
+
+  /*
+  * The depth of functions depends on the whole function graph.
+  */
+  collectInDepthOrderFns(main);
+
+  /*
+  * Recompute the loops of the modified functions, which now include the inlined ones.
+  */
+  for (auto F : modifiedFns) {
+    auto orderedLoops = preOrderedLoops.find(F);
+    if (orderedLoops != preOrderedLoops.end()) {
+      delete orderedLoops->second;
+      preOrderedLoops.erase(orderedLoops);
+    }
+    loopsToCheck.erase(F);
+    createPreOrderedLoopSummariesFor(F);
+    getLoopsToInline(noelle, profiles, F);
+  }
+}
+
 void Inliner::collectFnGraph (Function *main) {
   auto &callGraph = getAnalysis<CallGraphWrapperPass>().getCallGraph();
   std::queue<Function *> funcToTraverse;
@@ -83,6 +83,7 @@ bool Inliner::inlineCallsInvolvedInLoopCarriedDataDependences (Noelle &noelle, n
       DOALL doall{
         *noelle.getProgram(),
         *noelle.getProfiles(),
+        false,
         noelle.getVerbosity()
       };
       if (  true
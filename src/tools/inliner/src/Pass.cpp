@@ -18,9 +18,11 @@ using namespace llvm::noelle;
  * Options of the dependence graph simplifier pass.
  */
 static cl::opt<int> Verbose("noelle-inliner-verbose", cl::ZeroOrMore, cl::Hidden, cl::desc("Verbose output (0: disabled, 1: minimal, 2: maximal"));
+static cl::opt<bool> InlineOneRoundPerInvocation("noelle-inliner-one-round", cl::ZeroOrMore, cl::Hidden, cl::desc("Perform one round of inlining per invocation and ask to be invoked again (the analyses are recomputed from scratch between rounds)"));
 
 bool Inliner::doInitialization (Module &M) {
   this->verbose = static_cast<Verbosity>(Verbose.getValue());
+  this->inlineOneRoundPerInvocation = (InlineOneRoundPerInvocation.getNumOccurrences() > 0);
 
   return false;
 }
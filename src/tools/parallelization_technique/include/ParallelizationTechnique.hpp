@@ -55,8 +55,10 @@ namespace llvm::noelle {
       ) const = 0 ;
 
       Value * getEnvArray () { return envBuilder->getEnvArray(); }
+      int getEnvVarOffset (int envIndex) { return envBuilder->getEnvVarOffset(envIndex); }
       BasicBlock *getParLoopEntryPoint () { return entryPointOfParallelizedLoop; }
       BasicBlock *getParLoopExitPoint () { return exitPointOfParallelizedLoop; }
+      BasicBlock *getParLoopMisspeculationPoint () { return misspeculationPointOfParallelizedLoop; }
 
       virtual void reset () ;
 
@@ -94,6 +96,16 @@ namespace llvm::noelle {
         std::set<int> reducableVars
       );
 
+      /*
+       * The additional variables are appended to the loop environment (their indices start at LDI->environment->envSize()).
+       */
+      void initializeEnvironmentBuilder (
+        LoopDependenceInfo *LDI,
+        std::set<int> simpleVars,
+        std::set<int> reducableVars,
+        std::vector<Type *> &additionalVarTypes
+      );
+
       void allocateEnvironmentArray (LoopDependenceInfo *LDI);
 
       void populateLiveInEnvironment (LoopDependenceInfo *LDI);
@@ -118,6 +130,17 @@ namespace llvm::noelle {
         int taskIndex
       );
 
+      void cloneGlobalVariableLocallyAndRewireLoop (
+        const ClonableMemoryLocation *location,
+        std::unordered_set<Instruction *> &taskInstructions,
+        int taskIndex
+      );
+
+      void freePrivateCopyAtTaskExit (
+        Value *privateCopy,
+        int taskIndex
+      );
+
       std::unordered_map<InductionVariable *, Value *> cloneIVStepValueComputation (
         LoopDependenceInfo *LDI,
         int taskIndex,
@@ -160,6 +183,12 @@ namespace llvm::noelle {
         int taskIndex
       );
 
+      void generateCodeToStoreExitBlockIndex (
+        LoopDependenceInfo *LDI,
+        int taskIndex,
+        int exitBlockEnvIndex
+      );
+
       std::set<BasicBlock *> determineLatestPointsToInsertLiveOutStore (
         LoopDependenceInfo *LDI,
         int taskIndex,
@@ -226,6 +255,7 @@ namespace llvm::noelle {
       Function *taskDispatcher;
       FunctionType *taskSignature;
       BasicBlock *entryPointOfParallelizedLoop, *exitPointOfParallelizedLoop;
+      BasicBlock *misspeculationPointOfParallelizedLoop;
       std::vector<Task *> tasks;
       int numTaskInstances;
 
@@ -18,7 +18,7 @@ ParallelizationTechnique::ParallelizationTechnique (
   Hot &p,
   Verbosity v
   )
-  : module{module}, verbose{v}, tasks{}, envBuilder{0}, profile{p}
+  : module{module}, verbose{v}, tasks{}, envBuilder{0}, misspeculationPointOfParallelizedLoop{nullptr}, profile{p}
   {
 
   return ;
@@ -47,6 +47,19 @@ void ParallelizationTechnique::initializeEnvironmentBuilder (
   LoopDependenceInfo *LDI,
   std::set<int> simpleVars,
   std::set<int> reducableVars
+) {
+  std::vector<Type *> emptyTypes{};
+
+  this->initializeEnvironmentBuilder(LDI, simpleVars, reducableVars, emptyTypes);
+
+  return ;
+}
+
+void ParallelizationTechnique::initializeEnvironmentBuilder (
+  LoopDependenceInfo *LDI,
+  std::set<int> simpleVars,
+  std::set<int> reducableVars,
+  std::vector<Type *> &additionalVarTypes
 ) {
   if (tasks.size() == 0) {
     errs() << "ERROR: Parallelization technique tasks haven't been created yet!\n"
@@ -62,8 +75,23 @@ void ParallelizationTechnique::initializeEnvironmentBuilder (
     varTypes.push_back(LDI->environment->typeOfEnv(i));
   }
 
+  /*
+   * Append the variables needed only by the parallelization technique.
+   * Their indices follow the ones of the loop environment.
+   */
+  varTypes.insert(varTypes.end(), additionalVarTypes.begin(), additionalVarTypes.end());
+
+  /*
+   * Collect the live-in variables.
+   * These are only read by the tasks, so they can be packed together in the environment.
+   */
+  std::set<int> readOnlyVars;
+  for (auto envIndex : LDI->environment->getEnvIndicesOfLiveInVars()){
+    readOnlyVars.insert(envIndex);
+  }
+
   this->envBuilder = new EnvBuilder(module.getContext());
-  this->envBuilder->createEnvVariables(varTypes, simpleVars, reducableVars, this->numTaskInstances);
+  this->envBuilder->createEnvVariables(varTypes, simpleVars, reducableVars, this->numTaskInstances, readOnlyVars);
 
   this->envBuilder->createEnvUsers(tasks.size());
   for (auto i = 0; i < tasks.size(); ++i) {
@@ -141,6 +169,8 @@ BasicBlock * ParallelizationTechnique::propagateLiveOutEnvironment (LoopDependen
    */
   std::unordered_map<int, int> reducableBinaryOps;
   std::unordered_map<int, Value *> initialValues;
+  std::unordered_map<int, CmpInst::Predicate> minMaxPredicates;
+  std::unordered_map<int, std::pair<int, CmpInst::Predicate>> indicesOfMinMax;
   for (auto envInd : LDI->environment->getEnvIndicesOfLiveOutVars()) {
     auto isReduced = envBuilder->isReduced(envInd);
     if (!isReduced) continue;
@@ -148,13 +178,46 @@ BasicBlock * ParallelizationTechnique::propagateLiveOutEnvironment (LoopDependen
     auto producer = LDI->environment->producerAt(envInd);
     auto producerSCC = sccManager->getSCCDAG()->sccOfValue(producer);
     auto producerSCCAttributes = sccManager->getSCCAttrs(producerSCC);
+    auto variable = producerSCCAttributes->getSingleLoopCarriedVariable();
 
-    /*
-     * HACK: Need to get accumulator that feeds directly into producer PHI, not any intermediate one
-     */
-    auto firstAccumI = *(producerSCCAttributes->getAccumulators().begin());
-    auto binOpCode = firstAccumI->getOpcode();
-    reducableBinaryOps[envInd] = sccManager->accumOpInfo.accumOpForType(binOpCode, producer->getType());
+    if (  true
+          && variable != nullptr
+          && variable->getMinMaxPredicate() != CmpInst::BAD_ICMP_PREDICATE
+      ){
+
+      /*
+       * Min/max variables are reduced by comparing partial values
+       */
+      minMaxPredicates[envInd] = variable->getMinMaxPredicate();
+
+    } else if (  true
+                 && variable != nullptr
+                 && variable->getMinMaxVariableOfIndex() != nullptr
+      ){
+
+      /*
+       * Indices of min/max variables are reduced along with the live-out min/max they track
+       */
+      auto minMaxSCC = sccManager->getSCCDAG()->sccOfValue(variable->getMinMaxVariableOfIndex()->getMinMaxUpdate());
+      auto minMaxEnvInd = -1;
+      for (auto otherEnvInd : LDI->environment->getEnvIndicesOfLiveOutVars()) {
+        if (minMaxSCC->isInternal(LDI->environment->producerAt(otherEnvInd))) {
+          minMaxEnvInd = otherEnvInd;
+          break;
+        }
+      }
+      assert(minMaxEnvInd != -1 && "The min/max of a reduced index must be a live-out variable");
+      indicesOfMinMax[envInd] = std::make_pair(minMaxEnvInd, variable->getIndexTiePredicate());
+
+    } else {
+
+      /*
+       * HACK: Need to get accumulator that feeds directly into producer PHI, not any intermediate one
+       */
+      auto firstAccumI = *(producerSCCAttributes->getAccumulators().begin());
+      auto binOpCode = firstAccumI->getOpcode();
+      reducableBinaryOps[envInd] = sccManager->accumOpInfo.accumOpForType(binOpCode, producer->getType());
+    }
 
     PHINode *loopEntryProducerPHI = fetchLoopEntryPHIOfProducer(LDI, producer);
     auto initValPHIIndex = loopEntryProducerPHI->getBasicBlockIndex(loopPreHeader);
@@ -167,6 +230,8 @@ BasicBlock * ParallelizationTechnique::propagateLiveOutEnvironment (LoopDependen
     *builder,
     reducableBinaryOps,
     initialValues,
+    minMaxPredicates,
+    indicesOfMinMax,
     numberOfThreadsExecuted);
 
   /*
@@ -251,6 +316,7 @@ void ParallelizationTechnique::addPredecessorAndSuccessorsBasicBlocksToTasks (
   auto &cxt = loopFunction->getContext();
   this->entryPointOfParallelizedLoop = BasicBlock::Create(cxt, "", loopFunction);
   this->exitPointOfParallelizedLoop = BasicBlock::Create(cxt, "", loopFunction);
+  this->misspeculationPointOfParallelizedLoop = nullptr;
 
   this->numTaskInstances = taskStructs.size();
   for (auto i = 0; i < numTaskInstances; ++i) {
@@ -367,12 +433,20 @@ void ParallelizationTechnique::cloneMemoryLocationsLocallyAndRewireLoop (
     }
     if (taskInstructions.size() == 0) continue;
 
+    /*
+     * Global variables are referenced by constants rather than by live-in instructions
+     */
+    if (location->isGlobalVariable()) {
+      this->cloneGlobalVariableLocallyAndRewireLoop(location, taskInstructions, taskIndex);
+      continue;
+    }
+
     /*
      * If so, traverse operands of loop instructions to clone
      * all live-in references (casts and GEPs) of the allocation to clone
      * State all cloned instructions in the task's instruction map for data flow adjustment later
      */
-    auto alloca = location->getAllocation();
+    auto allocation = cast<Instruction>(location->getAllocation());
     auto &entryBlock = (*task->getTaskBody()->begin());
     IRBuilder<> entryBuilder(&entryBlock);
     std::queue<Instruction *> instructionsToConvertOperandsOf;
@@ -430,15 +504,115 @@ void ParallelizationTechnique::cloneMemoryLocationsLocallyAndRewireLoop (
 
     /*
      * Clone the allocation and all other necessary instructions
+     * NOTE: Heap allocations are cloned once per task instance and deallocated when the task ends
      */
-    auto allocaClone = alloca->clone();
+    auto allocationClone = allocation->clone();
     auto firstInst = &*entryBlock.begin();
     entryBuilder.SetInsertPoint(firstInst);
-    entryBuilder.Insert(allocaClone);
-    task->addInstruction(alloca, allocaClone);
+    entryBuilder.Insert(allocationClone);
+    task->addInstruction(allocation, allocationClone);
+    if (task->isAnOriginalLiveIn(allocation)) {
+      task->addLiveIn(allocation, allocationClone);
+    }
+    if (location->isHeapAllocation()) {
+      this->freePrivateCopyAtTaskExit(allocationClone, taskIndex);
+    }
   }
 }
 
+void ParallelizationTechnique::cloneGlobalVariableLocallyAndRewireLoop (
+  const ClonableMemoryLocation *location,
+  std::unordered_set<Instruction *> &taskInstructions,
+  int taskIndex
+){
+  auto task = this->tasks[taskIndex];
+  auto global = location->getAllocation();
+  auto &cxt = this->module.getContext();
+  auto int8PtrType = PointerType::getUnqual(IntegerType::get(cxt, 8));
+  auto int64Type = IntegerType::get(cxt, 64);
+
+  /*
+   * Allocate the private copy of the global variable when the task starts
+   */
+  auto &entryBlock = (*task->getTaskBody()->begin());
+  IRBuilder<> entryBuilder(&*entryBlock.begin());
+  auto mallocFunction = this->module.getOrInsertFunction("malloc", FunctionType::get(int8PtrType, ArrayRef<Type *>({ int64Type }), false));
+  auto sizeInBytes = ConstantInt::get(int64Type, location->getSizeInBits() / 8);
+  auto privateCopyAsBytes = entryBuilder.CreateCall(mallocFunction, ArrayRef<Value *>({ sizeInBytes }));
+  auto privateCopy = entryBuilder.CreateBitCast(privateCopyAsBytes, global->getType());
+  this->freePrivateCopyAtTaskExit(privateCopyAsBytes, taskIndex);
+
+  /*
+   * Rewire the task to use the private copy
+   * Constant expressions that refer to the global variable are turned into instructions of the task
+   */
+  std::function<bool (Value *)> refersToGlobal = [&](Value *v) -> bool {
+    if (v == global) return true;
+    auto constantExpr = dyn_cast<ConstantExpr>(v);
+    if (!constantExpr) return false;
+    for (auto &op : constantExpr->operands()) {
+      if (refersToGlobal(op.get())) return true;
+    }
+    return false;
+  };
+  std::queue<Instruction *> instructionsToRewire;
+  for (auto I : taskInstructions) {
+    instructionsToRewire.push(task->getCloneOfOriginalInstruction(I));
+  }
+  while (!instructionsToRewire.empty()) {
+    auto cloneI = instructionsToRewire.front();
+    instructionsToRewire.pop();
+
+    for (auto i = 0; i < cloneI->getNumOperands(); ++i) {
+      auto op = cloneI->getOperand(i);
+      if (!refersToGlobal(op)) continue;
+
+      if (op == global) {
+        cloneI->setOperand(i, privateCopy);
+        continue;
+      }
+
+      /*
+       * Materialize the constant expression right before its use
+       * NOTE: Uses by PHIs are materialized at the end of the incoming block
+       */
+      auto opI = cast<ConstantExpr>(op)->getAsInstruction();
+      auto insertPoint = cloneI;
+      if (auto phi = dyn_cast<PHINode>(cloneI)) {
+        insertPoint = phi->getIncomingBlock(i)->getTerminator();
+      }
+      opI->insertBefore(insertPoint);
+      cloneI->setOperand(i, opI);
+      instructionsToRewire.push(opI);
+    }
+  }
+
+  return ;
+}
+
+void ParallelizationTechnique::freePrivateCopyAtTaskExit (
+  Value *privateCopy,
+  int taskIndex
+){
+  auto task = this->tasks[taskIndex];
+  auto &cxt = this->module.getContext();
+  auto int8PtrType = PointerType::getUnqual(IntegerType::get(cxt, 8));
+
+  /*
+   * The exit block of the task might not have its terminator yet
+   */
+  auto exitBlock = task->getExit();
+  IRBuilder<> exitBuilder(exitBlock);
+  if (auto terminator = exitBlock->getTerminator()) {
+    exitBuilder.SetInsertPoint(terminator);
+  }
+  auto freeFunction = this->module.getOrInsertFunction("free", FunctionType::get(Type::getVoidTy(cxt), ArrayRef<Type *>({ int8PtrType }), false));
+  auto privateCopyAsBytes = exitBuilder.CreateBitCast(privateCopy, int8PtrType);
+  exitBuilder.CreateCall(freeFunction, ArrayRef<Value *>({ privateCopyAsBytes }));
+
+  return ;
+}
+
 void ParallelizationTechnique::generateCodeToLoadLiveInVariables (
   LoopDependenceInfo *LDI, 
   int taskIndex
@@ -921,6 +1095,20 @@ Value * ParallelizationTechnique::getIdentityValueForEnvironmentValue (
    * Fetch the attributes about the producer SCC.
    */
   auto sccAttrs = sccManager->getSCCAttrs(producerSCC);
+
+  /*
+   * Min/max variables start from the most extreme value of their type, while their indices can start from any value
+   */
+  auto variable = sccAttrs->getSingleLoopCarriedVariable();
+  if (variable != nullptr) {
+    auto minMaxPredicate = variable->getMinMaxPredicate();
+    if (minMaxPredicate != CmpInst::BAD_ICMP_PREDICATE) {
+      return sccManager->accumOpInfo.generateIdentityForMinMax(minMaxPredicate, typeForValue);
+    }
+    if (variable->getMinMaxVariableOfIndex() != nullptr) {
+      return ConstantInt::get(typeForValue, 0);
+    }
+  }
   assert(sccAttrs->numberOfAccumulators() > 0 && "The environment value isn't accumulated!");
 
   /*
@@ -943,6 +1131,18 @@ void ParallelizationTechnique::generateCodeToStoreExitBlockIndex (
   LoopDependenceInfo *LDI,
   int taskIndex
 ){
+  auto exitBlockEnvIndex = LDI->environment->indexOfExitBlock();
+
+  this->generateCodeToStoreExitBlockIndex(LDI, taskIndex, exitBlockEnvIndex);
+
+  return ;
+}
+
+void ParallelizationTechnique::generateCodeToStoreExitBlockIndex (
+  LoopDependenceInfo *LDI,
+  int taskIndex,
+  int exitBlockEnvIndex
+){
 
   /*
    * Check whether there are multiple exit blocks or not.
@@ -957,15 +1157,19 @@ void ParallelizationTechnique::generateCodeToStoreExitBlockIndex (
    * There are multiple exit blocks.
    *
    * Fetch the pointer of the location where the exit block ID taken will be stored.
+   * This location is private to the task if the variable is reduced (e.g., DOALL picks the exit of the earliest iteration after the tasks end).
    */
-  auto exitBlockEnvIndex = LDI->environment->indexOfExitBlock();
   assert(exitBlockEnvIndex != -1);
   auto envUser = this->envBuilder->getUser(taskIndex);
   auto entryTerminator = task->getEntry()->getTerminator();
   IRBuilder<> entryBuilder(entryTerminator);
 
-  auto envType = LDI->environment->typeOfEnv(exitBlockEnvIndex);
-  envUser->createEnvPtr(entryBuilder, exitBlockEnvIndex, envType);
+  auto envType = LDI->environment->typeOfEnv(LDI->environment->indexOfExitBlock());
+  if (envBuilder->isReduced(exitBlockEnvIndex)) {
+    envUser->createReducableEnvPtr(entryBuilder, exitBlockEnvIndex, envType, numTaskInstances, task->getTaskInstanceID());
+  } else {
+    envUser->createEnvPtr(entryBuilder, exitBlockEnvIndex, envType);
+  }
 
   /*
    * Add a store instruction to specify to the code outside the parallelized loop which exit block is taken.
@@ -1143,6 +1347,13 @@ float ParallelizationTechnique::computeSequentialFractionOfExecution (
     totalInstructionCount += numInstructionsInSCC;
     bool mustBeSynchronized = sccType == SCCAttrs::SCCType::SEQUENTIAL
       && !sccInfo->canBeCloned();
+
+    /*
+     * Reducible memory locations (e.g., histograms) are privatized by DOALL only; HELIX and DSWP synchronize their updates.
+     */
+    if (sccInfo->getSingleLoopCarriedMemoryLocation() != nullptr) {
+      mustBeSynchronized = true;
+    }
     if (mustBeSynchronized) {
       sequentialInstructionCount += numInstructionsInSCC;
     }
@@ -16,8 +16,8 @@ using namespace llvm::noelle;
 namespace llvm::noelle {
 
   bool Parallelizer::collectThreadPoolHelperFunctionsAndTypes (Module &M, Noelle &par) {
-    std::string pushers[4] = { "queuePush8", "queuePush16", "queuePush32", "queuePush64" };
-    std::string poppers[4] = { "queuePop8", "queuePop16", "queuePop32", "queuePop64" };
+    std::string pushers[7] = { "queuePush8", "queuePush16", "queuePush32", "queuePush64", "queuePush128", "queuePush256", "queuePush512" };
+    std::string poppers[7] = { "queuePop8", "queuePop16", "queuePop32", "queuePop64", "queuePop128", "queuePop256", "queuePop512" };
     for (auto pusher : pushers) {
       auto pushFunction = M.getFunction(pusher);
       if (pushFunction == nullptr){
@@ -36,9 +36,14 @@ namespace llvm::noelle {
     }
     for (auto queueF : par.queues.queuePushes) {
       par.queues.queueTypes.push_back(queueF->arg_begin()->getType());
+
+      /*
+       * The element type is the one pointed by the second argument (e.g., i8 for 8 bits, a struct for packed values)
+       */
+      auto elementPointerType = cast<PointerType>(std::next(queueF->arg_begin())->getType());
+      par.queues.queueElementTypes.push_back(elementPointerType->getElementType());
     }
-    par.queues.queueSizeToIndex = unordered_map<int, int>({ { 1, 0 }, { 8, 0 }, { 16, 1 }, { 32, 2 }, { 64, 3 }});
-    par.queues.queueElementTypes = std::vector<Type *>({ par.int8, par.int16, par.int32, par.int64 });
+    par.queues.queueSizeToIndex = unordered_map<int, int>({ { 1, 0 }, { 8, 0 }, { 16, 1 }, { 32, 2 }, { 64, 3 }, { 128, 4 }, { 256, 5 }, { 512, 6 }});
 
     return true;
   }
@@ -18,6 +18,7 @@ namespace llvm::noelle {
   std::vector<LoopDependenceInfo *> Parallelizer::selectTheOrderOfLoopsToParallelize (
     Noelle &noelle, 
     Hot *profiles,
+    DOALL &doall,
     noelle::StayConnectedNestedLoopForestNode *tree
     ) {
     std::vector<LoopDependenceInfo *> selectedLoops{};
@@ -31,7 +32,9 @@ namespace llvm::noelle {
     * Compute the amount of time that can be saved by a parallelization technique per loop.
     */
     std::map<LoopDependenceInfo *, uint64_t> timeSavedLoops;
-    auto selector = [&noelle, &timeSavedLoops, profiles](StayConnectedNestedLoopForestNode *n, uint32_t treeLevel) -> bool {
+    std::unordered_map<StayConnectedNestedLoopForestNode *, LoopDependenceInfo *> nodeToLoop;
+    ParallelizationCostModel costModel{noelle, profiles, doall};
+    auto selector = [&noelle, &timeSavedLoops, &nodeToLoop, &costModel](StayConnectedNestedLoopForestNode *n, uint32_t treeLevel) -> bool {
 
       /*
       * Fetch the loop.
@@ -39,89 +42,80 @@ namespace llvm::noelle {
       auto ls = n->getLoop();
       auto optimizations = { LoopDependenceInfoOptimization::MEMORY_CLONING_ID };
       auto ldi = noelle.getLoop(ls, optimizations);
+      nodeToLoop[n] = ldi;
 
       /*
-      * Fetch the set of sequential SCCs.
-      */
-      auto sccManager = ldi->getSCCManager();
-      auto sequentialSCCs = sccManager->getSCCsOfType(SCCAttrs::SCCType::SEQUENTIAL);
-
-      /*
-      * Find the biggest sequential SCC.
+      * Compute the maximum amount of time saved by any parallelization technique.
+      *
+      * DOALL is considered only if no SCC needs to execute sequentially (SCCs that DOALL checks at runtime or speculates do not).
       */
-      uint64_t biggestSCCTime = 0;
-      for (auto sequentialSCC : sequentialSCCs){
-        assert(sequentialSCC->mustExecuteSequentially());
-
-        /*
-        * Fetch the SCC.
-        */
-        auto currentSCC = sequentialSCC->getSCC();
-
-        /*
-        * Check if the SCC can be removed by a transformation.
-        */
-        if (sequentialSCC->isInductionVariableSCC()){
-          continue ;
-        }
-        if (sequentialSCC->canBeCloned()){
-          continue ;
-        }
-        if (sequentialSCC->canBeClonedUsingLocalMemoryLocations()){
-          continue ;
-        }
-
-        auto areAllDataLCDsFromDisjointMemoryAccesses = true;
-        auto domainSpaceAnalysis = ldi->getLoopIterationDomainSpaceAnalysis();
-        sccManager->iterateOverLoopCarriedDataDependences(currentSCC, [
-          &areAllDataLCDsFromDisjointMemoryAccesses, domainSpaceAnalysis
-        ](DGEdge<Value> *dep) -> bool {
-          if (dep->isControlDependence()) return false;
-
-          if (!dep->isMemoryDependence()) {
-            areAllDataLCDsFromDisjointMemoryAccesses = false;
-            return true;
-          }
-
-          auto fromInst = dyn_cast<Instruction>(dep->getOutgoingT());
-          auto toInst = dyn_cast<Instruction>(dep->getIncomingT());
-          areAllDataLCDsFromDisjointMemoryAccesses &= fromInst && toInst && domainSpaceAnalysis->
-            areInstructionsAccessingDisjointMemoryLocationsBetweenIterations(fromInst, toInst);
-          return !areAllDataLCDsFromDisjointMemoryAccesses;
-        });
-        if (areAllDataLCDsFromDisjointMemoryAccesses) {
-          continue;
+      timeSavedLoops[ldi] = 0;
+      if (!costModel.canEstimate(ldi)){
+        return false;
+      }
+      std::vector<ParallelizationEstimate> estimates;
+      if (costModel.getSCCsThatMustExecuteSequentially(ldi, DOALL_ID).size() == 0){
+        estimates.push_back(costModel.estimateDOALL(ldi));
+      } else {
+        estimates.push_back(costModel.estimateHELIX(ldi));
+        estimates.push_back(costModel.estimateDSWP(ldi));
+      }
+      for (auto &estimate : estimates){
+        auto timeSaved = estimate.getTimeSaved();
+        if (timeSaved > timeSavedLoops[ldi]){
+          timeSavedLoops[ldi] = (uint64_t)timeSaved;
         }
+      }
 
-        /*
-        * Fetch the time spent in the current SCC.
-        */
-        auto currentSCCTime = profiles->getTotalInstructions(currentSCC);
+      return false;
+    };
+    tree->visitPreOrder(selector);
 
-        /*
-        * Compute the biggest SCC.
-        */
-        if (currentSCCTime > biggestSCCTime){
-          biggestSCCTime = currentSCCTime;
-        }
+    /*
+    * Find the set of loops that are not nested within each other and that maximize the time saved.
+    *
+    * Parallelizing a loop rules out parallelizing the loops nested within it.
+    * So, for every node of the tree, the best we can do is the maximum between the time saved by parallelizing the loop of the node
+    * and the sum of the best time saved within each subtree rooted by its children.
+    * The savings estimated by the cost model already account for the parallelization overhead.
+    */
+    std::unordered_map<StayConnectedNestedLoopForestNode *, uint64_t> bestTimeSavedInTree;
+    std::function<uint64_t (StayConnectedNestedLoopForestNode *)> computeBestTimeSaved;
+    computeBestTimeSaved = [&computeBestTimeSaved, &bestTimeSavedInTree, &timeSavedLoops, &nodeToLoop](StayConnectedNestedLoopForestNode *n) -> uint64_t {
+      uint64_t timeSavedByChildren = 0;
+      for (auto child : n->getDescendants()){
+        timeSavedByChildren += computeBestTimeSaved(child);
       }
+      auto timeSaved = timeSavedLoops[nodeToLoop[n]];
+      bestTimeSavedInTree[n] = std::max(timeSaved, timeSavedByChildren);
 
-      /*
-      * Compute the maximum amount of time saved by any parallelization technique.
-      */
-      timeSavedLoops[ldi] = 0;
-      if (profiles->getIterations(ls) > 0){
-        auto instsPerIteration = profiles->getAverageTotalInstructionsPerIteration(ls);
-        auto instsInBiggestSCCPerIteration = ((double)biggestSCCTime) / ((double)profiles->getIterations(ls));
-        assert(instsInBiggestSCCPerIteration <= instsPerIteration);
-        auto timeSavedPerIteration = (double)(instsPerIteration - instsInBiggestSCCPerIteration);
-        auto timeSaved = timeSavedPerIteration * profiles->getIterations(ls);
-        timeSavedLoops[ldi] = (uint64_t)timeSaved;
+      return bestTimeSavedInTree[n];
+    };
+    computeBestTimeSaved(tree);
+
+    /*
+    * Collect the loops of the best set.
+    * On ties, the outer loop is preferred because it pays the parallelization overhead less often.
+    * Loops that save nothing are never part of the best set.
+    */
+    std::unordered_set<LoopDependenceInfo *> bestLoops;
+    std::function<void (StayConnectedNestedLoopForestNode *)> collectBestLoops;
+    collectBestLoops = [&collectBestLoops, &bestLoops, &bestTimeSavedInTree, &timeSavedLoops, &nodeToLoop](StayConnectedNestedLoopForestNode *n) {
+      auto ldi = nodeToLoop[n];
+      if (  true
+            && (timeSavedLoops[ldi] > 0)
+            && (timeSavedLoops[ldi] == bestTimeSavedInTree[n])
+         ){
+        bestLoops.insert(ldi);
+        return ;
+      }
+      for (auto child : n->getDescendants()){
+        collectBestLoops(child);
       }
 
-      return false;
+      return ;
     };
-    tree->visitPreOrder(selector);
+    collectBestLoops(tree);
 
     /*
     * Sort the loops depending on the amount of time that can be saved by a parallelization technique.
@@ -155,6 +149,14 @@ namespace llvm::noelle {
     };
     std::sort(selectedLoops.begin(), selectedLoops.end(), compareOperator);
 
+    /*
+    * The loops of the best set come first.
+    * The other ones are kept as fall backs in case the loops of the best set cannot be parallelized.
+    */
+    std::stable_partition(selectedLoops.begin(), selectedLoops.end(), [&bestLoops](LoopDependenceInfo *l) -> bool {
+      return bestLoops.find(l) != bestLoops.end();
+    });
+
     /*
     * Print the order and the savings.
     */
@@ -165,7 +167,11 @@ namespace llvm::noelle {
         auto ls = l->getLoopStructure();
         auto savedTimeRelative = ((double)timeSavedLoops[l]) / ((double) profiles->getTotalInstructions(ls));
         savedTimeRelative *= 100;
-        errs() << "Parallelizer: LoopSelector:    Loop " << l->getID() << " savings = " << savedTimeRelative << "%\n";
+        errs() << "Parallelizer: LoopSelector:    Loop " << l->getID() << " savings = " << savedTimeRelative << "%";
+        if (bestLoops.find(l) != bestLoops.end()){
+          errs() << " (selected)";
+        }
+        errs() << "\n";
       }
       errs() << "Parallelizer: LoopSelector: End\n";
     }
@@ -0,0 +1,376 @@
+/*
+ * Copyright 2016 - 2020  Angelo Matni, Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "ParallelizationCostModel.hpp"
+#include "Architecture.hpp"
+
+using namespace llvm;
+using namespace llvm::noelle;
+
+namespace llvm::noelle {
+
+  double ParallelizationEstimate::getSpeedup (void) const {
+    if (this->parallelTime <= 0){
+      return 1;
+    }
+
+    return this->sequentialTime / this->parallelTime;
+  }
+
+  double ParallelizationEstimate::getTimeSaved (void) const {
+    return this->sequentialTime - this->parallelTime;
+  }
+
+  ParallelizationCostModel::ParallelizationCostModel (Noelle &noelle, Hot *profiles, DOALL &doall)
+    : noelle{noelle}
+    , profiles{profiles}
+    , doall{doall}
+    , invocationLatency{profiles}
+    {
+
+    return ;
+  }
+
+  bool ParallelizationCostModel::canEstimate (LoopDependenceInfo *LDI) const {
+    if (!this->profiles->isAvailable()){
+      return false;
+    }
+
+    auto ls = LDI->getLoopStructure();
+    if (this->profiles->getIterations(ls) == 0){
+      return false;
+    }
+
+    return true;
+  }
+
+  ParallelizationEstimate ParallelizationCostModel::estimate (LoopDependenceInfo *LDI, Transformation technique) {
+    switch (technique){
+      case DOALL_ID:
+        return this->estimateDOALL(LDI);
+      case HELIX_ID:
+        return this->estimateHELIX(LDI);
+      case DSWP_ID:
+        return this->estimateDSWP(LDI);
+      default:
+        abort();
+    }
+  }
+
+  /*
+   * All iterations run in parallel.
+   * The overhead is the dispatch of the tasks, which grows with the number of cores, and the runtime alias checks executed before every invocation.
+   * Speculated loops also track their memory accesses, which happens in parallel like the rest of the iterations.
+   */
+  ParallelizationEstimate ParallelizationCostModel::estimateDOALL (LoopDependenceInfo *LDI) {
+
+    /*
+    * Fetch the profiles of the loop.
+    */
+    auto ls = LDI->getLoopStructure();
+    auto sequentialTime = (double)this->profiles->getTotalInstructions(ls);
+    auto invocations = (double)this->profiles->getInvocations(ls);
+    auto dispatchLatency = Architecture::getLatencyOfDOALLDispatchPerCore();
+    auto checkTime = this->getTimeSpentInRuntimeAliasChecks(LDI);
+    auto trackingTime = this->getTimeSpentTrackingSpeculativeAccesses(LDI);
+
+    /*
+    * Find the number of cores that minimizes the execution time.
+    */
+    ParallelizationEstimate best{DOALL_ID, 1, sequentialTime, sequentialTime};
+    for (uint32_t cores = 2; cores <= LDI->getMaximumNumberOfCores(); cores++){
+      auto parallelTime = ((sequentialTime + trackingTime) / cores) + (invocations * cores * dispatchLatency) + checkTime;
+      if (parallelTime < best.parallelTime){
+        best.cores = cores;
+        best.parallelTime = parallelTime;
+      }
+    }
+
+    return best;
+  }
+
+  /*
+   * Iterations run in parallel, but every sequential SCC becomes a sequential segment.
+   * A sequential segment must travel from core to core once per iteration.
+   * Hence, an iteration cannot start its segment earlier than the time the previous iteration took to execute it plus the time to signal the next core.
+   */
+  ParallelizationEstimate ParallelizationCostModel::estimateHELIX (LoopDependenceInfo *LDI) {
+
+    /*
+    * Fetch the profiles of the loop.
+    */
+    auto ls = LDI->getLoopStructure();
+    auto sequentialTime = (double)this->profiles->getTotalInstructions(ls);
+    auto invocations = (double)this->profiles->getInvocations(ls);
+    auto iterations = (double)this->profiles->getIterations(ls);
+    auto timePerIteration = sequentialTime / iterations;
+    auto dispatchLatency = Architecture::getLatencyOfDOALLDispatchPerCore();
+    auto signalLatency = Architecture::getLatencyOfSequentialSegmentSignal();
+
+    /*
+    * Compute the size of the sequential segments per iteration.
+    */
+    auto sequentialSCCs = this->getSCCsThatMustExecuteSequentially(LDI, HELIX_ID);
+    double biggestSegmentPerIteration = 0;
+    for (auto scc : sequentialSCCs){
+      auto segmentPerIteration = ((double)this->profiles->getTotalInstructions(scc)) / iterations;
+      biggestSegmentPerIteration = std::max(biggestSegmentPerIteration, segmentPerIteration);
+    }
+    auto signalsPerIteration = sequentialSCCs.size() * signalLatency;
+
+    /*
+    * Find the number of cores that minimizes the execution time.
+    */
+    ParallelizationEstimate best{HELIX_ID, 1, sequentialTime, sequentialTime};
+    for (uint32_t cores = 2; cores <= LDI->getMaximumNumberOfCores(); cores++){
+      auto parallelTimePerIteration = std::max(
+        (timePerIteration / cores) + signalsPerIteration,
+        biggestSegmentPerIteration + signalLatency
+        );
+      auto parallelTime = (iterations * parallelTimePerIteration) + (invocations * cores * dispatchLatency);
+      if (parallelTime < best.parallelTime){
+        best.cores = cores;
+        best.parallelTime = parallelTime;
+      }
+    }
+
+    return best;
+  }
+
+  /*
+   * The loop runs as a pipeline with at most one stage per SCC.
+   * The pipeline cannot be faster than its biggest sequential stage, and it pays for every value sent between stages.
+   */
+  ParallelizationEstimate ParallelizationCostModel::estimateDSWP (LoopDependenceInfo *LDI) {
+
+    /*
+    * Fetch the profiles of the loop.
+    */
+    auto ls = LDI->getLoopStructure();
+    auto sequentialTime = (double)this->profiles->getTotalInstructions(ls);
+    auto invocations = (double)this->profiles->getInvocations(ls);
+    auto iterations = (double)this->profiles->getIterations(ls);
+    auto timePerIteration = sequentialTime / iterations;
+    auto dispatchLatency = Architecture::getLatencyOfDOALLDispatchPerCore();
+
+    /*
+    * Compute the number of stages we can have.
+    * A stage without loop-carried dependences can be replicated to use the cores left.
+    */
+    auto sccManager = LDI->getSCCManager();
+    uint32_t stages = 0;
+    auto isThereAParallelStage = false;
+    for (auto nodePair : sccManager->getSCCDAG()->internalNodePairs()) {
+      auto sccInfo = sccManager->getSCCAttrs(nodePair.first);
+      if (sccInfo->canBeCloned()){
+        continue ;
+      }
+      stages++;
+      if (sccInfo->canExecuteIndependently()){
+        isThereAParallelStage = true;
+      }
+    }
+    auto cores = std::min(stages, LDI->getMaximumNumberOfCores());
+    if (isThereAParallelStage){
+      cores = LDI->getMaximumNumberOfCores();
+    }
+    ParallelizationEstimate estimate{DSWP_ID, 1, sequentialTime, sequentialTime};
+    if (cores < 2){
+      return estimate;
+    }
+
+    /*
+    * Compute the biggest stage per iteration.
+    */
+    double biggestStagePerIteration = 0;
+    for (auto scc : this->getSCCsThatMustExecuteSequentially(LDI, DSWP_ID)){
+      auto stagePerIteration = ((double)this->profiles->getTotalInstructions(scc)) / iterations;
+      biggestStagePerIteration = std::max(biggestStagePerIteration, stagePerIteration);
+    }
+
+    /*
+    * Compute the execution time of the pipeline.
+    */
+    auto parallelTimePerIteration = std::max(timePerIteration / cores, biggestStagePerIteration);
+    auto queueTime = this->getTimeSpentInQueues(LDI);
+    estimate.cores = cores;
+    estimate.parallelTime = (iterations * parallelTimePerIteration) + (queueTime / cores) + (invocations * cores * dispatchLatency);
+
+    return estimate;
+  }
+
+  std::vector<SCC *> ParallelizationCostModel::getSCCsThatMustExecuteSequentially (LoopDependenceInfo *LDI, Transformation technique) const {
+    std::vector<SCC *> sccs;
+
+    auto sccManager = LDI->getSCCManager();
+    auto domainSpaceAnalysis = LDI->getLoopIterationDomainSpaceAnalysis();
+    for (auto sequentialSCC : sccManager->getSCCsOfType(SCCAttrs::SCCType::SEQUENTIAL)){
+      assert(sequentialSCC->mustExecuteSequentially());
+
+      /*
+      * Fetch the SCC.
+      */
+      auto currentSCC = sequentialSCC->getSCC();
+
+      /*
+      * Check if the SCC can be removed by a transformation.
+      */
+      if (sequentialSCC->isInductionVariableSCC()){
+        continue ;
+      }
+      if (sequentialSCC->canBeCloned()){
+        continue ;
+      }
+      if (sequentialSCC->canBeClonedUsingLocalMemoryLocations()){
+        continue ;
+      }
+
+      auto areAllDataLCDsFromDisjointMemoryAccesses = true;
+      sccManager->iterateOverLoopCarriedDataDependences(currentSCC, [
+        &areAllDataLCDsFromDisjointMemoryAccesses, domainSpaceAnalysis
+      ](DGEdge<Value> *dep) -> bool {
+        if (dep->isControlDependence()) return false;
+
+        if (!dep->isMemoryDependence()) {
+          areAllDataLCDsFromDisjointMemoryAccesses = false;
+          return true;
+        }
+
+        auto fromInst = dyn_cast<Instruction>(dep->getOutgoingT());
+        auto toInst = dyn_cast<Instruction>(dep->getIncomingT());
+        areAllDataLCDsFromDisjointMemoryAccesses &= fromInst && toInst && domainSpaceAnalysis->
+          areInstructionsAccessingDisjointMemoryLocationsBetweenIterations(fromInst, toInst);
+        return !areAllDataLCDsFromDisjointMemoryAccesses;
+      });
+      if (areAllDataLCDsFromDisjointMemoryAccesses) {
+        continue;
+      }
+
+      /*
+      * DOALL removes the loop-carried data dependences that exist only when base pointers alias by checking them at runtime,
+      * and the ones that never manifested in the dependence profiles by speculating them (if speculation is enabled).
+      * The model assumes the checks pass and the speculation succeeds.
+      */
+      if (technique == DOALL_ID){
+        if (  false
+              || this->doall.canSCCBeCheckedAtRuntime(LDI, currentSCC)
+              || this->doall.isSCCSpeculated(LDI, currentSCC, this->noelle)
+           ){
+          continue ;
+        }
+      }
+
+      sccs.push_back(currentSCC);
+    }
+
+    /*
+    * Reducible memory locations (e.g., histograms) are privatized by DOALL only.
+    * The other techniques synchronize their updates.
+    */
+    if (technique != DOALL_ID){
+      for (auto reducibleSCC : sccManager->getSCCsOfType(SCCAttrs::SCCType::REDUCIBLE)){
+        if (reducibleSCC->getSingleLoopCarriedMemoryLocation() == nullptr){
+          continue ;
+        }
+        sccs.push_back(reducibleSCC->getSCC());
+      }
+    }
+
+    return sccs;
+  }
+
+  /*
+   * Every value produced by an SCC that cannot be cloned and consumed by another SCC is sent through a queue.
+   */
+  double ParallelizationCostModel::getTimeSpentInQueues (LoopDependenceInfo *LDI) {
+    auto sccManager = LDI->getSCCManager();
+
+    std::set<Value *> queueValues;
+    for (auto nodePair : sccManager->getSCCDAG()->internalNodePairs()) {
+      auto scc = nodePair.first;
+      auto &externals = this->invocationLatency.memoizeExternals(sccManager, scc);
+      queueValues.insert(externals.begin(), externals.end());
+    }
+
+    double queueTime = 0;
+    for (auto queueValue : queueValues){
+      queueTime += this->invocationLatency.queueLatency(queueValue);
+    }
+
+    return queueTime;
+  }
+
+  /*
+   * DOALL checks once per invocation whether the ranges of memory accessed by the instructions of its alias checks overlap.
+   * Computing the last iteration and branching takes a few instructions,
+   * computing the range of an instruction takes 7 instructions, and comparing two ranges takes 4.
+   */
+  double ParallelizationCostModel::getTimeSpentInRuntimeAliasChecks (LoopDependenceInfo *LDI) const {
+    auto aliasChecks = this->doall.getRuntimeAliasChecks(LDI);
+    if (aliasChecks.size() == 0){
+      return 0;
+    }
+
+    std::unordered_set<Instruction *> ranges;
+    for (auto aliasCheck : aliasChecks){
+      ranges.insert(aliasCheck.first);
+      ranges.insert(aliasCheck.second);
+    }
+    auto instructionsPerInvocation = 9 + (7 * ranges.size()) + (4 * aliasChecks.size());
+
+    auto ls = LDI->getLoopStructure();
+    auto invocations = (double)this->profiles->getInvocations(ls);
+
+    return invocations * instructionsPerInvocation;
+  }
+
+  /*
+   * A speculated DOALL calls the runtime for every execution of the memory accesses it tracks.
+   * The latencies include the detection of conflicts at the end of the invocation.
+   */
+  double ParallelizationCostModel::getTimeSpentTrackingSpeculativeAccesses (LoopDependenceInfo *LDI) const {
+    if (!this->doall.requiresSpeculation(LDI)){
+      return 0;
+    }
+
+    double trackingTime = 0;
+    for (auto access : this->doall.getMemoryAccessesToTrackForSpeculation(LDI)){
+      auto latency = isa<LoadInst>(access) ? Architecture::getLatencyOfSpeculativeLoadTracking() : Architecture::getLatencyOfSpeculativeStoreTracking();
+      trackingTime += ((double)this->profiles->getInvocations(access)) * latency;
+    }
+
+    return trackingTime;
+  }
+
+  void ParallelizationCostModel::printEstimate (const std::string &prefix, const ParallelizationEstimate &estimate) const {
+    std::string techniqueName;
+    switch (estimate.technique){
+      case DOALL_ID:
+        techniqueName = "DOALL";
+        break ;
+      case HELIX_ID:
+        techniqueName = "HELIX";
+        break ;
+      case DSWP_ID:
+        techniqueName = "DSWP";
+        break ;
+      default:
+        abort();
+    }
+
+    errs() << prefix << techniqueName << ": cores = " << estimate.cores
+      << ", sequential time = " << (uint64_t)estimate.sequentialTime
+      << ", parallel time = " << (uint64_t)estimate.parallelTime
+      << ", speedup = " << estimate.getSpeedup() << "x\n";
+
+    return ;
+  }
+
+}
@@ -0,0 +1,82 @@
+/*
+ * Copyright 2016 - 2020  Angelo Matni, Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+
+#include "SystemHeaders.hpp"
+#include "LoopDependenceInfo.hpp"
+#include "SCC.hpp"
+#include "SCCDAG.hpp"
+#include "Noelle.hpp"
+#include "InvocationLatency.hpp"
+#include "DOALL.hpp"
+
+namespace llvm::noelle {
+
+  /*
+   * Estimated outcome of parallelizing a loop with a given technique.
+   * Times are expressed in number of instructions executed across all invocations of the loop.
+   */
+  struct ParallelizationEstimate {
+    Transformation technique;
+    uint32_t cores;
+    double sequentialTime;
+    double parallelTime;
+
+    double getSpeedup (void) const ;
+
+    double getTimeSaved (void) const ;
+  };
+
+  /*
+   * Cost model used to compare DOALL, HELIX, and DSWP on a loop and to pick the number of cores to use.
+   *
+   * The model relies on the profiles (see Hot), on the SCCDAG of the loop, on the size of the sequential segments,
+   * on the traffic sent through queues, and on the latencies of the runtime (see Architecture).
+   * DOALL is queried to know which SCCs it removes with runtime alias checks or speculation.
+   */
+  class ParallelizationCostModel {
+    public:
+      ParallelizationCostModel (Noelle &noelle, Hot *profiles, DOALL &doall);
+
+      /*
+       * Return true if the model has the profiles it needs to estimate the execution time of loops.
+       */
+      bool canEstimate (LoopDependenceInfo *LDI) const ;
+
+      ParallelizationEstimate estimateDOALL (LoopDependenceInfo *LDI) ;
+
+      ParallelizationEstimate estimateHELIX (LoopDependenceInfo *LDI) ;
+
+      ParallelizationEstimate estimateDSWP (LoopDependenceInfo *LDI) ;
+
+      ParallelizationEstimate estimate (LoopDependenceInfo *LDI, Transformation technique) ;
+
+      /*
+       * Return the SCCs of @LDI that @technique cannot remove (e.g., by cloning them), and therefore must execute sequentially.
+       */
+      std::vector<SCC *> getSCCsThatMustExecuteSequentially (LoopDependenceInfo *LDI, Transformation technique) const ;
+
+      void printEstimate (const std::string &prefix, const ParallelizationEstimate &estimate) const ;
+
+    private:
+      Noelle &noelle;
+      Hot *profiles;
+      DOALL &doall;
+      InvocationLatency invocationLatency;
+
+      double getTimeSpentInQueues (LoopDependenceInfo *LDI) ;
+
+      double getTimeSpentInRuntimeAliasChecks (LoopDependenceInfo *LDI) const ;
+
+      double getTimeSpentTrackingSpeculativeAccesses (LoopDependenceInfo *LDI) const ;
+  };
+
+}
@@ -58,15 +58,95 @@ namespace llvm::noelle {
     }
 
     /*
-    * Parallelize the loop.
+    * Collect the techniques that can parallelize the loop.
+    * The order of this list is the order of preference when the cost model cannot tell them apart.
     */
-    auto codeModified = false;
-    ParallelizationTechnique *usedTechnique = nullptr;
+    std::vector<Transformation> applicableTechniques;
     if (  true
           && par.isTransformationEnabled(DOALL_ID)
           && LDI->isTransformationEnabled(DOALL_ID)
           && doall.canBeAppliedToLoop(LDI, par, h)
       ){
+      applicableTechniques.push_back(DOALL_ID);
+    }
+    if (  true
+          && par.isTransformationEnabled(HELIX_ID)
+          && LDI->isTransformationEnabled(HELIX_ID)
+          && helix.canBeAppliedToLoop(LDI, par, h)
+      ){
+      applicableTechniques.push_back(HELIX_ID);
+    }
+    if (  true
+          && par.isTransformationEnabled(DSWP_ID)
+          && LDI->isTransformationEnabled(DSWP_ID)
+          && dswp.canBeAppliedToLoop(LDI, par, h)
+      ){
+      applicableTechniques.push_back(DSWP_ID);
+    }
+    if (applicableTechniques.size() == 0){
+      errs() << "Parallelizer: Exit (no code modified)\n";
+      return false;
+    }
+
+    /*
+    * Select the technique and the number of cores to use.
+    */
+    auto selectedTechnique = applicableTechniques[0];
+    ParallelizationCostModel costModel{par, par.getProfiles(), doall};
+    if (costModel.canEstimate(LDI)){
+
+      /*
+      * Estimate the outcome of every applicable technique and pick the fastest.
+      */
+      if (verbose != Verbosity::Disabled) {
+        errs() << "Parallelizer:  Cost model\n";
+      }
+      ParallelizationEstimate bestEstimate{};
+      auto hasBestEstimate = false;
+      for (auto technique : applicableTechniques){
+        auto estimate = costModel.estimate(LDI, technique);
+        if (verbose != Verbosity::Disabled) {
+          costModel.printEstimate("Parallelizer:    ", estimate);
+        }
+        if (  false
+              || (!hasBestEstimate)
+              || (estimate.parallelTime < bestEstimate.parallelTime)
+          ){
+          bestEstimate = estimate;
+          hasBestEstimate = true;
+        }
+      }
+      selectedTechnique = bestEstimate.technique;
+      if (verbose != Verbosity::Disabled) {
+        errs() << "Parallelizer:    Selected technique: ";
+        costModel.printEstimate("", bestEstimate);
+      }
+
+      /*
+      * Check if the parallelization is worth it.
+      */
+      if (  true
+            && (!this->forceParallelization)
+            && (bestEstimate.getSpeedup() <= 1)
+        ){
+        errs() << "Parallelizer: Exit (no technique is estimated to speed up the loop)\n";
+        return false;
+      }
+
+      /*
+      * Set the number of cores to use.
+      */
+      if (bestEstimate.cores > 1){
+        LDI->setMaximumNumberOfCores(bestEstimate.cores);
+      }
+    }
+
+    /*
+    * Parallelize the loop.
+    */
+    auto codeModified = false;
+    ParallelizationTechnique *usedTechnique = nullptr;
+    if (selectedTechnique == DOALL_ID){
 
       /*
       * Apply DOALL.
@@ -75,11 +155,7 @@ namespace llvm::noelle {
       codeModified = doall.apply(LDI, par, h);
       usedTechnique = &doall;
 
-    } else if ( true
-                && par.isTransformationEnabled(HELIX_ID)
-                && LDI->isTransformationEnabled(HELIX_ID)
-                && helix.canBeAppliedToLoop(LDI, par, h)   
-      ){
+    } else if (selectedTechnique == HELIX_ID){
 
       /*
       * Apply HELIX
@@ -111,11 +187,8 @@ namespace llvm::noelle {
       codeModified = helix.apply(newLDI, par, h);
       usedTechnique = &helix;
 
-    } else if ( true
-                && par.isTransformationEnabled(DSWP_ID)
-                && LDI->isTransformationEnabled(DSWP_ID)
-                && dswp.canBeAppliedToLoop(LDI, par, h)
-      ) {
+    } else {
+      assert(selectedTechnique == DSWP_ID);
 
       /*
       * Apply DSWP.
@@ -154,7 +227,8 @@ namespace llvm::noelle {
     if (verbose != Verbosity::Disabled) {
       errs() << "Parallelizer:  Link the parallelize loop\n";
     }
-    auto exitIndex = cast<Value>(ConstantInt::get(par.int64, LDI->environment->indexOfExitBlock()));
+    auto exitBlockEnvIndex = LDI->environment->indexOfExitBlock();
+    auto exitOffset = cast<Value>(ConstantInt::get(par.int64, exitBlockEnvIndex >= 0 ? usedTechnique->getEnvVarOffset(exitBlockEnvIndex) : -1));
     auto loopExitBlocks = loopStructure->getLoopExitBasicBlocks();
     par.linkTransformedLoopToOriginalFunction(
       loopFunction->getParent(),
@@ -162,8 +236,9 @@ namespace llvm::noelle {
       entryPoint,
       exitPoint, 
       envArray,
-      exitIndex,
-      loopExitBlocks
+      exitOffset,
+      loopExitBlocks,
+      usedTechnique->getParLoopMisspeculationPoint()
     );
     // if (verbose >= Verbosity::Maximal) {
     //   loopFunction->print(errs() << "Final printout:\n"); errs() << "\n";
@@ -39,6 +39,7 @@
 #include "DSWP.hpp"
 #include "DOALL.hpp"
 #include "HELIX.hpp"
+#include "ParallelizationCostModel.hpp"
 
 namespace llvm::noelle {
 
@@ -65,6 +66,8 @@ namespace llvm::noelle {
        */
       bool forceParallelization;
       bool forceNoSCCPartition;
+      bool enableHELIXChunking;
+      bool enableDOALLSpeculation;
 
       /*
        * Methods
@@ -85,6 +88,7 @@ namespace llvm::noelle {
       std::vector<LoopDependenceInfo *> selectTheOrderOfLoopsToParallelize (
         Noelle &noelle, 
         Hot *profiles,
+        DOALL &doall,
         noelle::StayConnectedNestedLoopForestNode *tree
         ) ;
 
@@ -19,12 +19,16 @@ using namespace llvm::noelle;
 */
 static cl::opt<bool> ForceParallelization("noelle-parallelizer-force", cl::ZeroOrMore, cl::Hidden, cl::desc("Force the parallelization"));
 static cl::opt<bool> ForceNoSCCPartition("dswp-no-scc-merge", cl::ZeroOrMore, cl::Hidden, cl::desc("Force no SCC merging when parallelizing"));
+static cl::opt<bool> EnableHELIXChunking("helix-chunking", cl::ZeroOrMore, cl::Hidden, cl::desc("Execute consecutive iterations on the same core to reduce HELIX synchronizations"));
+static cl::opt<bool> EnableDOALLSpeculation("doall-speculation", cl::ZeroOrMore, cl::Hidden, cl::desc("Speculate memory dependences that never manifested in the dependence profiles to parallelize loops with DOALL"));
   
 Parallelizer::Parallelizer()
   :
   ModulePass{ID}, 
   forceParallelization{false},
-  forceNoSCCPartition{false}
+  forceNoSCCPartition{false},
+  enableHELIXChunking{false},
+  enableDOALLSpeculation{false}
   {
 
   return ;
@@ -33,6 +37,8 @@ Parallelizer::Parallelizer()
 bool Parallelizer::doInitialization (Module &M) {
   this->forceParallelization = (ForceParallelization.getNumOccurrences() > 0);
   this->forceNoSCCPartition = (ForceNoSCCPartition.getNumOccurrences() > 0);
+  this->enableHELIXChunking = (EnableHELIXChunking.getNumOccurrences() > 0);
+  this->enableDOALLSpeculation = (EnableDOALLSpeculation.getNumOccurrences() > 0);
 
   return false; 
 }
@@ -69,12 +75,14 @@ bool Parallelizer::runOnModule (Module &M) {
   DOALL doall{
     M,
     *profiles,
+    this->enableDOALLSpeculation,
     verbosity
   };
   HELIX helix{
     M,
     *profiles,
     this->forceParallelization,
+    this->enableHELIXChunking,
     verbosity
   };
 
@@ -241,7 +249,18 @@ bool Parallelizer::runOnModule (Module &M) {
     /*
     * Select the loops to parallelize.
     */
-    auto loopsToParallelize = this->selectTheOrderOfLoopsToParallelize(noelle, profiles, tree);
+    auto loopsToParallelize = this->selectTheOrderOfLoopsToParallelize(noelle, profiles, doall, tree);
+
+    /*
+    * Map the loops to their nodes of the nesting tree.
+    * This allows us to know whether a loop is nested (even through calls) within a loop that has already been parallelized.
+    */
+    std::unordered_map<BasicBlock *, noelle::StayConnectedNestedLoopForestNode *> headerToNode;
+    tree->visitPreOrder([&headerToNode](noelle::StayConnectedNestedLoopForestNode *n, uint32_t treeLevel) -> bool {
+      headerToNode[n->getLoop()->getHeader()] = n;
+      return false;
+    });
+    std::unordered_set<noelle::StayConnectedNestedLoopForestNode *> parallelizedNodes;
 
     /*
     * Parallelize the loops.
@@ -259,9 +278,33 @@ bool Parallelizer::runOnModule (Module &M) {
           break ;
         }
       }
+      auto loopNode = headerToNode[ls->getHeader()];
+      assert(loopNode != nullptr);
+      for (auto parentNode = loopNode->getParent(); parentNode != nullptr; parentNode = parentNode->getParent()){
+        if (parallelizedNodes.find(parentNode) != parallelizedNodes.end()){
+          safe = false;
+          break ;
+        }
+      }
+
+      /*
+      * Loops nested (even through calls) within this one could have been parallelized already (e.g., this loop is a fall back of the best set).
+      * Parallelizing this loop as well would nest the parallelized code within another parallelized loop.
+      */
+      for (auto parallelizedNode : parallelizedNodes){
+        for (auto parentNode = parallelizedNode->getParent(); parentNode != nullptr; parentNode = parentNode->getParent()){
+          if (parentNode == loopNode){
+            safe = false;
+            break ;
+          }
+        }
+        if (!safe){
+          break ;
+        }
+      }
       auto loopID = ls->getID();
       if (!safe){
-        errs() << "Parallelizer:    Loop " << loopID << " cannot be parallelized because one of its parent has been parallelized already\n";
+        errs() << "Parallelizer:    Loop " << loopID << " cannot be parallelized because one of its parent or nested loops has been parallelized already\n";
         continue ;
       }
 
@@ -279,6 +322,7 @@ bool Parallelizer::runOnModule (Module &M) {
         for (auto bb : ls->getBasicBlocks()){
           modifiedBBs[bb] = true;
         }
+        parallelizedNodes.insert(loopNode);
       }
     }
 
@@ -0,0 +1,376 @@
+/*
+ * Copyright 2019 - 2020  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include <fstream>
+
+#include "llvm/ADT/Hashing.h"
+#include "llvm/IR/DebugInfo.h"
+#include "llvm/PassRegistry.h"
+#include "llvm/PassInfo.h"
+
+#include "Pipeline.hpp"
+
+using namespace llvm;
+using namespace llvm::noelle;
+
+Pipeline::Pipeline ()
+  :
+  ModulePass{ID},
+  verbose{false}
+  {
+
+  /*
+   * Passes of noelle-norm.
+   */
+  this->normalizationPasses = {
+    "basicaa", "mem2reg", "break-constgeps", "lowerswitch", "mergereturn", "break-crit-edges", "loop-simplify", "lcssa", "indvars"
+  };
+
+  /*
+   * Passes of noelle-simplification.
+   */
+  this->simplificationPasses = {
+    "basicaa", "mem2reg", "simplifycfg", "instcombine", "tailcallelim", "loop-simplify", "lcssa", "licm", "loop-unswitch", "globalopt", "instcombine", "ipsccp", "dce", "gvn", "dse", "adce", "loop-simplify", "lcssa", "indvars", "loop-deletion", "instcombine", "indvars", "break-constgeps", "lowerswitch", "mergereturn", "break-crit-edges", "loop-simplify", "lcssa"
+  };
+
+  /*
+   * Analyses that noelle-load makes available to the NOELLE passes.
+   */
+  this->noelleAnalyses = {
+    "globals-aa", "cfl-steens-aa", "tbaa", "scev-aa", "cfl-anders-aa",
+    "basic-loop-aa", "scev-loop-aa", "auto-restrict-aa", "intrinsic-aa", "global-malloc-aa", "pure-fun-aa", "semi-local-fun-aa",
+    "phi-maze-aa", "no-capture-global-aa", "no-capture-src-aa", "type-aa", "no-escape-fields-aa", "acyclic-aa",
+    "disjoint-fields-aa", "field-malloc-aa", "loop-variant-allocation-aa", "std-in-out-err-aa", "array-of-structures-aa",
+    "kill-flow-aa", "callsite-depth-combinator-aa", "unique-access-paths-aa",
+    "llvm-aa-results",
+    "scalar-evolution", "loops", "domtree", "postdomtree"
+  };
+
+  return ;
+}
+
+bool Pipeline::runOnModule (Module &M) {
+  if (this->verbose){
+    errs() << "NOELLE: Pipeline: Start\n";
+  }
+
+  /*
+   * The PDG is embedded by the first stage that computes it (see noelle-pipeline), and later stages reuse it.
+   * Check whether the module came with it, so the PDG embedded by the pipeline can be removed at the end.
+   */
+  auto wasPDGEmbedded = (M.getNamedMetadata("noelle.module.pdg") != nullptr);
+
+  /*
+   * Strip debugging symbols.
+   */
+  StripDebugInfo(M);
+  this->runStage(M, "Strip debug declarations", { "strip-debug-declare" }, false);
+
+  /*
+   * Delete dead functions.
+   */
+  auto deleteDeadFunctions = [this, &M](void) -> void {
+    this->runStage(M, "Normalization", this->normalizationPasses, false);
+    this->runStageUntilFixedPoint(M, "Dead functions", { "noelle-dfe" });
+  };
+  deleteDeadFunctions();
+
+  /*
+   * Normalize the code.
+   */
+  this->runStage(M, "Simplification", this->simplificationPasses, false);
+
+  /*
+   * Inline functions.
+   * First, inline calls involved in loop-carried data dependences.
+   * Then, inline functions to hoist loops to main.
+   */
+  this->runInliner(M, false);
+  this->runInliner(M, true);
+  this->runStage(M, "Simplification", this->simplificationPasses, false);
+
+  /*
+   * Delete the functions that are now dead.
+   */
+  deleteDeadFunctions();
+  this->runStage(M, "Simplification", this->simplificationPasses, false);
+
+  /*
+   * Run the enablers.
+   */
+  this->runStageUntilFixedPoint(M, "Enablers", { "enablers" });
+  this->runStage(M, "Simplification", this->simplificationPasses, false);
+
+  /*
+   * Add metadata to all loops of the program.
+   */
+  this->runStage(M, "Loop metadata", { "LoopMetadata" }, true);
+
+  /*
+   * Remove the PDG embedded by the pipeline.
+   */
+  if (!wasPDGEmbedded){
+    this->removeEmbeddedPDG(M);
+  }
+
+  if (this->verbose){
+    errs() << "NOELLE: Pipeline: Exit\n";
+  }
+
+  return true;
+}
+
+std::set<std::string> Pipeline::runStage (
+  Module &M,
+  const std::string &stageName,
+  const std::vector<std::string> &passNames,
+  bool requiresNoelleAnalyses
+){
+
+  /*
+   * Fingerprint the functions before running the stage.
+   */
+  auto functionsBefore = this->fingerprintFunctions(M);
+
+  /*
+   * Create the passes of the stage.
+   * They all run within the same pass manager, so they share the analyses they require.
+   */
+  legacy::PassManager passManager;
+  auto passRegistry = PassRegistry::getPassRegistry();
+  if (requiresNoelleAnalyses){
+    for (auto &analysisName : this->noelleAnalyses){
+
+      /*
+       * Analyses of libraries that have not been loaded are skipped like opt would reject them.
+       */
+      auto analysisInfo = passRegistry->getPassInfo(analysisName);
+      if (  false
+            || (analysisInfo == nullptr)
+            || (analysisInfo->getNormalCtor() == nullptr)
+         ){
+        continue ;
+      }
+      passManager.add(analysisInfo->createPass());
+    }
+  }
+  for (auto &passName : passNames){
+    auto passInfo = passRegistry->getPassInfo(passName);
+    if (  false
+          || (passInfo == nullptr)
+          || (passInfo->getNormalCtor() == nullptr)
+       ){
+      errs() << "NOELLE: Pipeline: ERROR = pass " << passName << " couldn't be found\n";
+      abort();
+    }
+    passManager.add(passInfo->createPass());
+  }
+
+  /*
+   * Run the stage.
+   */
+  if (this->verbose){
+    errs() << "NOELLE: Pipeline:   " << stageName << "\n";
+  }
+  passManager.run(M);
+
+  /*
+   * Identify the functions that have been modified, added, or deleted by the stage.
+   */
+  std::set<std::string> modifiedFunctions;
+  auto functionsAfter = this->fingerprintFunctions(M);
+  for (auto &pair : functionsBefore){
+    auto functionAfter = functionsAfter.find(pair.first);
+    if (  false
+          || (functionAfter == functionsAfter.end())
+          || (functionAfter->second != pair.second)
+       ){
+      modifiedFunctions.insert(pair.first);
+    }
+  }
+  for (auto &pair : functionsAfter){
+    if (functionsBefore.find(pair.first) == functionsBefore.end()){
+      modifiedFunctions.insert(pair.first);
+    }
+  }
+  if (this->verbose){
+    errs() << "NOELLE: Pipeline:     Functions modified = " << modifiedFunctions.size() << "\n";
+  }
+
+  /*
+   * Invalidate the analysis results that the stage made stale.
+   */
+  this->invalidateEmbeddedPDG(M, modifiedFunctions);
+
+  return modifiedFunctions;
+}
+
+std::set<std::string> Pipeline::runStageUntilFixedPoint (
+  Module &M,
+  const std::string &stageName,
+  const std::vector<std::string> &passNames
+){
+  std::set<std::string> modifiedFunctions;
+
+  /*
+   * Run the stage until it does not modify the code anymore.
+   * The code is normalized after every invocation that modified it.
+   */
+  while (true){
+    auto modifiedFunctionsByInvocation = this->runStage(M, stageName, passNames, true);
+    if (modifiedFunctionsByInvocation.size() == 0){
+      break ;
+    }
+    modifiedFunctions.insert(modifiedFunctionsByInvocation.begin(), modifiedFunctionsByInvocation.end());
+
+    this->runStage(M, "Normalization", this->normalizationPasses, false);
+  }
+
+  return modifiedFunctions;
+}
+
+bool Pipeline::runInliner (
+  Module &M,
+  bool hoistLoopsToMain
+){
+
+  /*
+   * The inliner communicates through files whether it should hoist loops to main and whether it must be invoked again.
+   */
+  auto removeInlinerFiles = [](void) -> void {
+    std::remove("dgsimplify_continue.txt");
+    std::remove("dgsimplify_do_hoist.txt");
+    std::remove("dgsimplify_loop_hoisting.txt");
+  };
+  auto doesInlinerWantToContinue = [](void) -> bool {
+    std::ifstream continueFile("dgsimplify_continue.txt");
+    return continueFile.good();
+  };
+  removeInlinerFiles();
+  if (hoistLoopsToMain){
+    std::ofstream doHoistFile("dgsimplify_do_hoist.txt");
+  }
+
+  /*
+   * Invoke the inliner until it has nothing left to do.
+   */
+  auto modified = false;
+  do {
+    std::remove("dgsimplify_continue.txt");
+    auto modifiedFunctions = this->runStage(M, "Inliner", { "inliner" }, true);
+    modified |= (modifiedFunctions.size() > 0);
+    this->runStage(M, "Normalization", this->normalizationPasses, false);
+  } while (doesInlinerWantToContinue());
+
+  /*
+   * Clean the files of the inliner.
+   */
+  removeInlinerFiles();
+
+  return modified;
+}
+
+std::map<std::string, size_t> Pipeline::fingerprintFunctions (
+  Module &M
+) const {
+  std::map<std::string, size_t> fingerprints;
+
+  /*
+   * Hash the structure of the code rather than its textual form.
+   * Transformations that change the code create, delete, or rewire instructions and basic blocks, or they change the opcodes, the types, the flags, or the predicates of instructions.
+   * Changes to metadata are not tracked as they do not change the dependences of the code.
+   */
+  for (auto &F : M){
+    auto fingerprint = hash_combine(F.getFunctionType(), F.size());
+    for (auto &BB : F){
+      fingerprint = hash_combine(fingerprint, &BB);
+      for (auto &I : BB){
+        fingerprint = hash_combine(fingerprint, &I, I.getOpcode(), I.getType(), I.getRawSubclassOptionalData());
+        for (auto &operand : I.operands()){
+          fingerprint = hash_combine(fingerprint, operand.get());
+        }
+        if (auto phi = dyn_cast<PHINode>(&I)){
+          for (auto incomingBB : phi->blocks()){
+            fingerprint = hash_combine(fingerprint, incomingBB);
+          }
+        }
+        if (auto cmp = dyn_cast<CmpInst>(&I)){
+          fingerprint = hash_combine(fingerprint, cmp->getPredicate());
+        }
+      }
+    }
+    fingerprints[F.getName().str()] = fingerprint;
+  }
+
+  return fingerprints;
+}
+
+void Pipeline::invalidateEmbeddedPDG (
+  Module &M,
+  const std::set<std::string> &modifiedFunctions
+){
+
+  /*
+   * The embedded PDG is still valid if the code did not change.
+   */
+  auto pdgMetadata = M.getNamedMetadata("noelle.module.pdg");
+  if (  false
+        || (pdgMetadata == nullptr)
+        || (modifiedFunctions.size() == 0)
+     ){
+    return ;
+  }
+
+  /*
+   * The dependences of a function only depend on the semantics of the other functions, which transformations preserve.
+   * Hence, only the embedded dependence graphs of the modified functions are dropped.
+   * The next stage that needs the PDG computes them again (see PDGAnalysis::hasFunctionDGAsMetadata).
+   */
+  if (this->verbose){
+    errs() << "NOELLE: Pipeline:     Invalidate the embedded PDG of " << modifiedFunctions.size() << " functions\n";
+  }
+  for (auto &functionName : modifiedFunctions) {
+    auto F = M.getFunction(functionName);
+    if (F == nullptr) {
+      continue ;
+    }
+    this->removeEmbeddedFunctionDG(*F);
+  }
+
+  return ;
+}
+
+void Pipeline::removeEmbeddedPDG (
+  Module &M
+){
+  auto pdgMetadata = M.getNamedMetadata("noelle.module.pdg");
+  if (pdgMetadata == nullptr){
+    return ;
+  }
+  for (auto &F : M) {
+    this->removeEmbeddedFunctionDG(F);
+  }
+  M.eraseNamedMetadata(pdgMetadata);
+
+  return ;
+}
+
+void Pipeline::removeEmbeddedFunctionDG (
+  Function &F
+){
+  F.setMetadata("noelle.pdg.function", nullptr);
+  F.setMetadata("noelle.pdg.args.id", nullptr);
+  F.setMetadata("noelle.pdg.edges", nullptr);
+  for (auto &I : instructions(F)) {
+    I.setMetadata("noelle.pdg.inst.id", nullptr);
+  }
+
+  return ;
+}
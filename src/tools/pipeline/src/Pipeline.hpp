@@ -0,0 +1,87 @@
+/*
+ * Copyright 2019 - 2020  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+
+#include "SystemHeaders.hpp"
+
+namespace llvm::noelle {
+
+  /*
+   * Run the stages of noelle-pre (strip debug information, dead function elimination, simplification, inlining, enablers, and loop metadata) within a single process.
+   * The module is loaded once, and the passes of each stage share the analyses they require.
+   * The PDG is embedded once, and the stages that modify the code invalidate the embedded dependence graphs of the functions they modified.
+   */
+  class Pipeline : public ModulePass {
+    public:
+
+      Pipeline ();
+
+      bool doInitialization (Module &M) override ;
+
+      bool runOnModule (Module &M) override ;
+
+      void getAnalysisUsage (AnalysisUsage &AU) const override ;
+
+      /*
+       * Class fields
+       */
+      static char ID;
+
+    private:
+
+      /*
+       * Methods
+       */
+      std::set<std::string> runStage (
+        Module &M,
+        const std::string &stageName,
+        const std::vector<std::string> &passNames,
+        bool requiresNoelleAnalyses
+      );
+
+      std::set<std::string> runStageUntilFixedPoint (
+        Module &M,
+        const std::string &stageName,
+        const std::vector<std::string> &passNames
+      );
+
+      bool runInliner (
+        Module &M,
+        bool hoistLoopsToMain
+      );
+
+      std::map<std::string, size_t> fingerprintFunctions (
+        Module &M
+      ) const ;
+
+      void invalidateEmbeddedPDG (
+        Module &M,
+        const std::set<std::string> &modifiedFunctions
+      );
+
+      void removeEmbeddedPDG (
+        Module &M
+      );
+
+      void removeEmbeddedFunctionDG (
+        Function &F
+      );
+
+      /*
+       * Fields
+       */
+      bool verbose;
+      std::vector<std::string> normalizationPasses;
+      std::vector<std::string> simplificationPasses;
+      std::vector<std::string> noelleAnalyses;
+  };
+
+}
@@ -0,0 +1,61 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+/*
+ * The rows of the matrix are much longer than the tiles the L2 cache can hold (even with one tile per core).
+ * Hence, the loop nest of transposeAndScale is tiled.
+ */
+#define ROWS 128
+#define COLUMNS 65536
+
+static double matrix[ROWS][COLUMNS];
+static double transposed[COLUMNS][ROWS];
+
+void transposeAndScale (double scale){
+
+  /*
+   * The accesses to matrix are contiguous while the ones to transposed jump by a whole row at every iteration of the inner loop.
+   */
+  for (long long int i = 0; i < ROWS; i++){
+    for (long long int j = 0; j < COLUMNS; j++){
+      transposed[j][i] = matrix[i][j] * scale + 1.0;
+    }
+  }
+
+  return ;
+}
+
+int main (int argc, char *argv[]){
+
+  /*
+   * Check the inputs.
+   */
+  if (argc < 2){
+    fprintf(stderr, "USAGE: %s REPETITIONS\n", argv[0]);
+    return -1;
+  }
+  auto repetitions = atoll(argv[1]);
+
+  for (auto i = 0; i < ROWS; i++){
+    for (auto j = 0; j < COLUMNS; j++){
+      matrix[i][j] = (i * COLUMNS + j) % 100;
+    }
+  }
+
+  /*
+   * Transpose the matrix.
+   */
+  for (auto t = 0; t < repetitions; t++){
+    transposeAndScale(0.5 + t);
+  }
+
+  double checksum = 0;
+  for (auto j = 0; j < COLUMNS; j += ROWS + 1){
+    for (auto i = 0; i < ROWS; i++){
+      checksum += transposed[j][i];
+    }
+  }
+  printf("%f\n", checksum);
+
+  return 0;
+}
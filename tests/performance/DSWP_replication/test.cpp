@@ -0,0 +1,46 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+
+int main (int argc, char *argv[]){
+
+  /*
+   * Check the inputs.
+   */
+  if (argc < 4){
+    fprintf(stderr, "USAGE: %s LOOP_ITERATIONS SEQUENTIAL_ITERATIONS PARALLEL_ITERATIONS\n", argv[0]);
+    return -1;
+  }
+  auto iterations = atoll(argv[1]);
+  auto sequentialIterations = atoll(argv[2]);
+  auto parallelIterations = atoll(argv[3]);
+
+  auto v1 = argc;
+  auto v2 = ((argc * 5) / 2) + 1;
+
+  for (auto i = 0; i < iterations; ++i) {
+
+    // SCC 1
+    for (auto iter = 0; iter < sequentialIterations; iter++){
+      v1 = v1 * 3;
+      v1 = v1 / 2;
+    }
+
+    // Parallel stage: it has no loop-carried dependences
+    int64_t w = v1 + i;
+    for (auto iter = 0; iter < parallelIterations; iter++){
+      w = ((w * 7) + iter) % 1000003;
+    }
+
+    // SCC 2
+    for (auto iter = 0; iter < sequentialIterations; iter++){
+      v2 = v2 + w;
+      v2 = v2 / 2;
+    }
+
+  }
+
+  printf("%d, %d\n", v1, v2);
+
+  return 0;
+}
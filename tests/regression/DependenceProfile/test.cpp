@@ -0,0 +1,48 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+/*
+ * Each iteration writes the element read by the iteration that is DISTANCE iterations later.
+ * The compiler cannot tell whether this loop-carried dependence exists, but the dependence profiler observes it.
+ */
+void computation (long long int *values, int *destinations, long long int iters){
+  for (auto i=0; i < iters; ++i){
+    values[destinations[i]] = (values[i] * 3 + 1) % 1000003;
+  }
+
+  return ;
+}
+
+int main (int argc, char *argv[]){
+
+  /*
+   * Check the inputs.
+   */
+  if (argc < 3){
+    fprintf(stderr, "USAGE: %s LOOP_ITERATIONS DISTANCE\n", argv[0]);
+    return -1;
+  }
+  auto iterations = atoll(argv[1]);
+  auto distance = atoll(argv[2]);
+  if (iterations < 0){
+    iterations = 0;
+  }
+  if (distance < 0){
+    distance = 0;
+  }
+  long long int *values = (long long int *) calloc(iterations + distance + 1, sizeof(long long int));
+  int *destinations = (int *) calloc(iterations + 1, sizeof(int));
+  for (auto i=0; i < iterations; ++i){
+    destinations[i] = i + distance;
+  }
+
+  computation(values, destinations, iterations);
+
+  long long int s = 0;
+  for (auto i=0; i < iterations + distance + 1; ++i){
+    s = (s * 31 + values[i]) % 1000000007;
+  }
+  printf("%lld\n", s);
+
+  return 0;
+}
@@ -0,0 +1,48 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+long long int computation (long long int *values, long long int iters, long long int key){
+  for (auto i=0; i < iters; ++i){
+
+    /*
+     * The first position of the key.
+     */
+    if (values[i] == key){
+      return i;
+    }
+  }
+
+  return -1;
+}
+
+int main (int argc, char *argv[]){
+
+  /*
+   * Check the inputs.
+   */
+  if (argc < 2){
+    fprintf(stderr, "USAGE: %s LOOP_ITERATIONS\n", argv[0]);
+    return -1;
+  }
+  auto iterations = atoll(argv[1]);
+  if (iterations < 2){
+    iterations = 2;
+  }
+  long long int *values = (long long int *) calloc(iterations, sizeof(long long int));
+  for (auto i=0; i < iterations; ++i){
+    values[i] = i * 7 + 3;
+  }
+
+  /*
+   * Search keys found at the first iteration, in the middle, close to the end, and never.
+   * The last search has no iterations.
+   */
+  auto atStart = computation(values, iterations, values[0]);
+  auto inTheMiddle = computation(values, iterations, values[iterations / 3]);
+  auto atEnd = computation(values, iterations, values[iterations - 2]);
+  auto missing = computation(values, iterations, 1);
+  auto empty = computation(values, 0, values[0]);
+  printf("%lld %lld %lld %lld %lld\n", atStart, inTheMiddle, atEnd, missing, empty);
+
+  return 0;
+}
@@ -0,0 +1,51 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#define BINS 64
+
+static long long int histogram[BINS];
+
+void computation (int *keys, long long int *weights, long long int iters){
+  for (auto i=0; i < iters; ++i){
+    histogram[keys[i]] += weights[i];
+  }
+
+  return ;
+}
+
+int main (int argc, char *argv[]){
+
+  /*
+   * Check the inputs.
+   */
+  if (argc < 2){
+    fprintf(stderr, "USAGE: %s LOOP_ITERATIONS\n", argv[0]);
+    return -1;
+  }
+  auto iterations = atoll(argv[1]);
+  if (iterations < 0){
+    iterations = 0;
+  }
+  int *keys = (int *) calloc(iterations + 3, sizeof(int));
+  long long int *weights = (long long int *) calloc(iterations + 3, sizeof(long long int));
+  for (auto i=0; i < iterations + 3; ++i){
+    keys[i] = (i * 7) % BINS;
+    weights[i] = i % 13 + 1;
+  }
+
+  /*
+   * Reduce loops with no iteration, fewer iterations than cores, and the number of iterations requested.
+   */
+  long long int itersToTest[] = { 0, 1, 3, iterations };
+  for (auto iters : itersToTest){
+    computation(keys, weights, iters);
+
+    long long int s = 0;
+    for (auto i=0; i < BINS; ++i){
+      s += histogram[i] * (i + 1);
+    }
+    printf("%lld\n", s);
+  }
+
+  return 0;
+}
@@ -0,0 +1,45 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+/*
+ * The loop of main carries a dependence through the memory accessed by the calls it invokes.
+ * Inlining step exposes the call to accumulate in the loop, which is then inlined by the next round of the inliner.
+ */
+long long int accumulate (long long int *acc, long long int value){
+  *acc = (*acc * 3 + value) % 1000003;
+
+  return *acc;
+}
+
+long long int step (long long int *acc, long long int i){
+  auto value = accumulate(acc, i * 7);
+
+  return value % 17;
+}
+
+int main (int argc, char *argv[]){
+
+  /*
+   * Check the inputs.
+   */
+  if (argc < 2){
+    fprintf(stderr, "USAGE: %s LOOP_ITERATIONS\n", argv[0]);
+    return -1;
+  }
+  auto iterations = atoll(argv[1]);
+
+  /*
+   * Compute with no iteration, fewer iterations than cores, and the number of iterations requested.
+   */
+  long long int itersToTest[] = { 0, 1, 3, iterations };
+  for (auto iters : itersToTest){
+    long long int acc = 1;
+    long long int sum = 0;
+    for (auto i=0; i < iters; ++i){
+      sum += step(&acc, i);
+    }
+    printf("%lld %lld\n", acc, sum);
+  }
+
+  return 0;
+}
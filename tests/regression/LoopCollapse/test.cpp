@@ -0,0 +1,49 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#define ROWS 3
+
+void computation (long long int *matrix, long long int columns){
+
+  /*
+   * The outer loop has fewer iterations than cores.
+   */
+  for (auto i=0; i < ROWS; ++i){
+    for (auto j=0; j < columns; ++j){
+      matrix[i * columns + j] = (i + 1) * (j + 3);
+    }
+  }
+
+  return ;
+}
+
+int main (int argc, char *argv[]){
+
+  /*
+   * Check the inputs.
+   */
+  if (argc < 2){
+    fprintf(stderr, "USAGE: %s LOOP_ITERATIONS\n", argv[0]);
+    return -1;
+  }
+  auto iterations = atoll(argv[1]);
+  if (iterations < 1){
+    iterations = 1;
+  }
+  long long int *matrix = (long long int *) calloc(ROWS * (iterations + 5), sizeof(long long int));
+
+  /*
+   * Collapse nests whose rows are empty, shorter than a chunk, and not a multiple of the chunk size.
+   */
+  long long int checksum = 0;
+  long long int columnsToTest[] = { 0, 1, 5, iterations, iterations + 1 };
+  for (auto columns : columnsToTest){
+    computation(matrix, columns);
+    for (auto i=0; i < ROWS * columns; ++i){
+      checksum += matrix[i] * (i % 7 + columns);
+    }
+  }
+  printf("%lld\n", checksum);
+
+  return 0;
+}
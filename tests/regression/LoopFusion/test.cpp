@@ -0,0 +1,55 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+void computation (long long int *a, long long int *b, long long int iters){
+
+  /*
+   * Two adjacent loops over the same range.
+   * The second loop only reads the elements written by the same iteration of the first loop.
+   */
+  for (auto i=0; i < iters; ++i){
+    a[i] = i * 3;
+  }
+  for (auto i=0; i < iters; ++i){
+    b[i] = a[i] + 7;
+  }
+
+  return ;
+}
+
+int main (int argc, char *argv[]){
+
+  /*
+   * Check the inputs.
+   */
+  if (argc < 2){
+    fprintf(stderr, "USAGE: %s LOOP_ITERATIONS\n", argv[0]);
+    return -1;
+  }
+  auto iterations = atoll(argv[1]);
+  if (iterations < 0){
+    iterations = 0;
+  }
+  long long int *a = (long long int *) calloc(iterations + 3, sizeof(long long int));
+  long long int *b = (long long int *) calloc(iterations + 3, sizeof(long long int));
+
+  /*
+   * Run the fused loop with no iteration, fewer iterations than cores, and the number of iterations requested.
+   */
+  long long int itersToTest[] = { 0, 1, 3, iterations };
+  for (auto iters : itersToTest){
+    for (auto i=0; i < iterations + 3; ++i){
+      a[i] = -1;
+      b[i] = -1;
+    }
+    computation(a, b, iters);
+
+    long long int checksum = 0;
+    for (auto i=0; i < iterations + 3; ++i){
+      checksum += (a[i] + b[i] * 2) * (i % 5 + 1);
+    }
+    printf("%lld\n", checksum);
+  }
+
+  return 0;
+}
@@ -0,0 +1,60 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+long long int computation (long long int *values, long long int iters, long long int *minValue, long long int *bits){
+  long long int maxValue = values[0];
+  long long int maxIndex = 0;
+  long long int m = values[0];
+  long long int x = 0;
+  for (auto i=0; i < iters; ++i){
+    auto v = values[i];
+
+    /*
+     * Running maximum and its first position.
+     */
+    maxIndex = v > maxValue ? i : maxIndex;
+    maxValue = v > maxValue ? v : maxValue;
+
+    /*
+     * Running minimum and bitwise xor.
+     */
+    m = v < m ? v : m;
+    x ^= v;
+  }
+  *minValue = m;
+  *bits = x;
+
+  return maxIndex;
+}
+
+int main (int argc, char *argv[]){
+
+  /*
+   * Check the inputs.
+   */
+  if (argc < 2){
+    fprintf(stderr, "USAGE: %s LOOP_ITERATIONS\n", argv[0]);
+    return -1;
+  }
+  auto iterations = atoll(argv[1]);
+  if (iterations < 0){
+    iterations = 0;
+  }
+  long long int *values = (long long int *) calloc(iterations + 3, sizeof(long long int));
+  for (auto i=0; i < iterations + 3; ++i){
+    values[i] = (i * 37 + 11) % 101 - 50;
+  }
+
+  /*
+   * Reduce loops with no iteration, fewer iterations than cores, and the number of iterations requested.
+   * The values repeat every 101 elements, so long loops have ties for the first position of the maximum.
+   */
+  long long int itersToTest[] = { 0, 1, 3, iterations };
+  for (auto iters : itersToTest){
+    long long int minValue, bits;
+    auto maxIndex = computation(values, iters, &minValue, &bits);
+    printf("%lld %lld %lld\n", maxIndex, minValue, bits);
+  }
+
+  return 0;
+}
@@ -0,0 +1,56 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#define CACHE_LINE_BYTES 64
+
+void computation (long long int *a, long long int iters){
+  for (auto i=0; i < iters; ++i){
+    a[i] = (i * 7) % 13 + iters;
+  }
+
+  return ;
+}
+
+int main (int argc, char *argv[]){
+
+  /*
+   * Check the inputs.
+   */
+  if (argc < 2){
+    fprintf(stderr, "USAGE: %s LOOP_ITERATIONS\n", argv[0]);
+    return -1;
+  }
+  auto iterations = atoll(argv[1]);
+  if (iterations < 0){
+    iterations = 0;
+  }
+
+  /*
+   * The array starts at the beginning of a cache line.
+   */
+  auto elements = iterations + CACHE_LINE_BYTES;
+  auto bytes = ((elements * sizeof(long long int) + CACHE_LINE_BYTES - 1) / CACHE_LINE_BYTES) * CACHE_LINE_BYTES;
+  long long int *array = (long long int *) aligned_alloc(CACHE_LINE_BYTES, bytes);
+
+  /*
+   * Start the loop at addresses that are not aligned to a cache line, so the first core peels the iterations before the first aligned chunk.
+   * Peeling must also work when the loop has fewer iterations than the ones to peel.
+   */
+  long long int checksum = 0;
+  long long int offsetsToTest[] = { 0, 1, 3, 7 };
+  long long int itersToTest[] = { 0, 2, iterations };
+  for (auto offset : offsetsToTest){
+    for (auto iters : itersToTest){
+      for (auto i=0; i < elements; ++i){
+        array[i] = -1;
+      }
+      computation(array + offset, iters);
+      for (auto i=0; i < elements; ++i){
+        checksum = (checksum * 31 + array[i] + 2) % 1000000007;
+      }
+    }
+  }
+  printf("%lld\n", checksum);
+
+  return 0;
+}
@@ -0,0 +1,53 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+/*
+ * The loop of this function invokes itself through recursion.
+ * Its iterations carry a value that cannot be reduced, so the loop is parallelized by HELIX or DSWP.
+ * Hence, the parallelized loop is also invoked by its own tasks, which must not wait for the threads that run them.
+ */
+long long int computation (long long int *values, long long int iters, long long int depth){
+  long long int acc = 1;
+  for (auto i=0; i < iters; ++i){
+    acc = (acc * 3 + values[i]) % 1000003;
+    if (  true
+          && (depth > 0)
+          && ((i % 16) == 0)
+       ){
+      acc += computation(values, iters / 4, depth - 1);
+    }
+  }
+
+  return acc;
+}
+
+int main (int argc, char *argv[]){
+
+  /*
+   * Check the inputs.
+   */
+  if (argc < 2){
+    fprintf(stderr, "USAGE: %s LOOP_ITERATIONS\n", argv[0]);
+    return -1;
+  }
+  auto iterations = atoll(argv[1]);
+  if (iterations < 0){
+    iterations = 0;
+  }
+  long long int *values = (long long int *) calloc(iterations + 17, sizeof(long long int));
+  for (auto i=0; i < iterations + 17; ++i){
+    values[i] = (i * 37) % 101;
+  }
+
+  /*
+   * Run loops with no iteration, loops whose nested invocations have no iteration or fewer iterations than cores,
+   * and loops with the number of iterations requested.
+   */
+  long long int itersToTest[] = { 0, 1, 17, iterations };
+  for (auto iters : itersToTest){
+    auto result = computation(values, iters, 2);
+    printf("%lld\n", result);
+  }
+
+  return 0;
+}
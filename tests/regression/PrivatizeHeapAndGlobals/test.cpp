@@ -0,0 +1,64 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define WINDOW 8
+
+/*
+ * Every iteration overwrites the whole global before reading it, so it can be privatized.
+ */
+static long long int scratch[WINDOW];
+
+long long int computation (long long int *input, long long int iters){
+  long long int s = 0;
+
+  /*
+   * Every iteration overwrites the whole heap object before reading it, so it can be privatized.
+   */
+  long long int *window = (long long int *) malloc(sizeof(long long int) * WINDOW);
+
+  for (auto i=0; i < iters; ++i){
+    memcpy(window, &input[i], sizeof(long long int) * WINDOW);
+    memset(scratch, 0, sizeof(scratch));
+    for (auto j=0; j < WINDOW; ++j){
+      scratch[(j * 3) % WINDOW] += window[j] * (j + 1);
+    }
+    for (auto j=0; j < WINDOW; ++j){
+      s += scratch[j] ^ window[WINDOW - 1 - j];
+    }
+  }
+
+  free(window);
+
+  return s;
+}
+
+int main (int argc, char *argv[]){
+
+  /*
+   * Check the inputs.
+   */
+  if (argc < 2){
+    fprintf(stderr, "USAGE: %s LOOP_ITERATIONS\n", argv[0]);
+    return -1;
+  }
+  auto iterations = atoll(argv[1]);
+  if (iterations < 0){
+    iterations = 0;
+  }
+  long long int *input = (long long int *) malloc(sizeof(long long int) * (iterations + WINDOW));
+  for (auto i=0; i < iterations + WINDOW; ++i){
+    input[i] = (i * 37) % 101;
+  }
+
+  /*
+   * Run loops with no iteration, a single iteration, and the number of iterations requested.
+   */
+  long long int itersToTest[] = { 0, 1, iterations };
+  for (auto iters : itersToTest){
+    auto s = computation(input, iters);
+    printf("%lld\n", s);
+  }
+
+  return 0;
+}
@@ -0,0 +1,52 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+void computation (long long int *dst, long long int *src, long long int iters){
+  for (auto i=0; i < iters; ++i){
+    dst[i] = (src[i] * 3 + 1) % 1000;
+  }
+
+  return ;
+}
+
+int main (int argc, char *argv[]){
+
+  /*
+   * Check the inputs.
+   */
+  if (argc < 2){
+    fprintf(stderr, "USAGE: %s LOOP_ITERATIONS\n", argv[0]);
+    return -1;
+  }
+  auto iterations = atoll(argv[1]);
+  if (iterations < 0){
+    iterations = 0;
+  }
+
+  /*
+   * Both pointers point within the same buffer, so only the runtime alias checks can tell whether they overlap.
+   */
+  long long int *buffer = (long long int *) calloc(2 * (iterations + 1), sizeof(long long int));
+  for (auto i=0; i < 2 * (iterations + 1); ++i){
+    buffer[i] = i % 13;
+  }
+
+  /*
+   * The ranges accessed are disjoint, so the checks pass and the parallelized loop runs.
+   */
+  computation(buffer + iterations + 1, buffer, iterations);
+  computation(buffer, buffer + iterations + 1, iterations / 2);
+
+  /*
+   * The ranges accessed overlap, so the checks fail and the original loop runs.
+   */
+  computation(buffer + 1, buffer, iterations);
+
+  long long int s = 0;
+  for (auto i=0; i < 2 * (iterations + 1); ++i){
+    s = (s * 31 + buffer[i]) % 1000000007;
+  }
+  printf("%lld\n", s);
+
+  return 0;
+}
@@ -0,0 +1,50 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+void computation (long long int *values, int *indices, long long int *increments, long long int iters){
+  for (auto i=0; i < iters; ++i){
+    values[indices[i]] += increments[i];
+  }
+
+  return ;
+}
+
+int main (int argc, char *argv[]){
+
+  /*
+   * Check the inputs.
+   */
+  if (argc < 4){
+    fprintf(stderr, "USAGE: %s LOOP_ITERATIONS ROUNDS CONFLICT_PERIOD\n", argv[0]);
+    return -1;
+  }
+  auto iterations = atoll(argv[1]);
+  auto rounds = atoll(argv[2]);
+  auto conflictPeriod = atoll(argv[3]);
+  long long int *values = (long long int *) calloc(iterations + 1, sizeof(long long int));
+  int *indices = (int *) calloc(iterations + 1, sizeof(int));
+  long long int *increments = (long long int *) calloc(iterations + 1, sizeof(long long int));
+
+  for (auto r=0; r < rounds; ++r){
+
+    /*
+     * Rounds that conflict accumulate into few elements, so iterations of different cores write the same memory.
+     * The other rounds write each element once.
+     */
+    auto conflicts = (conflictPeriod > 0) && ((r % conflictPeriod) == 0);
+    for (auto i=0; i < iterations; ++i){
+      indices[i] = conflicts ? (i % 4) : ((i + r) % iterations);
+      increments[i] = (i * r) % 17 + 1;
+    }
+
+    computation(values, indices, increments, iterations);
+  }
+
+  long long int s = 0;
+  for (auto i=0; i < iterations; ++i){
+    s += values[i] * (i + 1);
+  }
+  printf("%lld\n", s);
+
+  return 0;
+}
@@ -0,0 +1,60 @@
+#!/bin/bash
+
+# Check that the inliner takes the same decisions when it inlines to a fixed point within one invocation and when it performs one round per invocation (the analyses are then recomputed from scratch between rounds).
+
+function inliningDecisions {
+  local options="$1" ;
+  local bitcodeFile="$2" ;
+  local decisionsFile="$3" ;
+
+  noelle-inline "-noelle-inliner-verbose=1 ${options}" ${bitcodeFile} 2>&1 | sed -n 's/^Inliner:   Inlining in: \([^,]*\), .*call [^@]*@\([^(]*\)(.*/\1 -> \2/p' | sort > ${decisionsFile} ;
+
+  return ;
+}
+
+export PATH=`pwd`/../install/bin:$PATH
+
+cd regression ;
+
+checked_tests=0 ;
+passed_tests=0 ;
+dirs_of_failed_tests="" ;
+for i in `ls`; do
+  if ! test -d $i ; then
+    continue ;
+  fi
+  checked_tests=`echo "$checked_tests + 1" | bc` ;
+  cd $i ;
+  echo -n -e "\r   Successes $passed_tests : Testing `basename $i`                                                 " ;
+
+  # Generate the bitcode
+  rm -f inliner_*.bc inliner_*.txt ;
+  clang++ -std=c++14 -O0 -Xclang -disable-O0-optnone -emit-llvm -c test.cpp -o inliner_baseline.bc &> /dev/null ;
+  noelle-norm inliner_baseline.bc -o inliner_baseline.bc &> /dev/null ;
+  cp inliner_baseline.bc inliner_one_round.bc ;
+  cp inliner_baseline.bc inliner_fixed_point.bc ;
+
+  # Inline
+  inliningDecisions "-noelle-inliner-one-round" inliner_one_round.bc inliner_one_round.txt ;
+  inliningDecisions "" inliner_fixed_point.bc inliner_fixed_point.txt ;
+
+  # Compare the decisions
+  cmp inliner_one_round.txt inliner_fixed_point.txt &> /dev/null ;
+  if test $? -ne 0 ; then
+    dirs_of_failed_tests="${i} ${dirs_of_failed_tests}" ;
+  else
+    passed_tests=`echo "$passed_tests + 1" | bc` ;
+    rm -f inliner_*.txt ;
+  fi
+
+  rm -f inliner_*.bc ;
+  cd ../ ;
+done
+
+# Print the results
+echo -n -e "\r   Tests passed: ${passed_tests} / ${checked_tests}                                                                   " ;
+echo "" ;
+if test "${dirs_of_failed_tests}" != "" ; then
+  echo "    Tests failed: ${dirs_of_failed_tests}" ;
+  exit 1 ;
+fi
@@ -99,6 +99,7 @@ runningTestsWrapper -noelle-parallelizer-force -noelle-disable-doall -noelle-dis
 
 runningTestsWrapper -noelle-parallelizer-force -noelle-disable-doall -noelle-disable-dswp ;
 runningTestsWrapper -noelle-parallelizer-force -noelle-disable-doall -noelle-disable-dswp -dswp-no-scc-merge ;
+runningTestsWrapper -noelle-parallelizer-force -noelle-disable-doall -noelle-disable-dswp -helix-chunking ;
 
 cd ../ ;
 